@@ -0,0 +1,80 @@
+//
+//  AssetCache.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetCache.h"
+
+void AssetCache::setMaxSize(qint64 maxSize) {
+    QMutexLocker locker(&_mutex);
+    _maxSize = maxSize;
+    evict(maxSize);
+}
+
+QByteArray AssetCache::get(const QString& hexHash) {
+    QMutexLocker locker(&_mutex);
+
+    auto it = _entries.find(hexHash);
+    if (it == _entries.end()) {
+        ++_misses;
+        return QByteArray();
+    }
+
+    ++_hits;
+    _lru.splice(_lru.begin(), _lru, it->lruPosition);
+    return it->contents;
+}
+
+void AssetCache::insert(const QString& hexHash, const QByteArray& contents) {
+    if (!isCacheable(contents.size())) {
+        return;
+    }
+
+    QMutexLocker locker(&_mutex);
+
+    if (_entries.contains(hexHash)) {
+        // another task read the same asset at the same time
+        return;
+    }
+
+    evict(_maxSize - contents.size());
+
+    _lru.push_front(hexHash);
+    _entries.insert(hexHash, { contents, _lru.begin() });
+    _size += contents.size();
+}
+
+void AssetCache::remove(const QString& hexHash) {
+    QMutexLocker locker(&_mutex);
+
+    auto it = _entries.find(hexHash);
+    if (it != _entries.end()) {
+        _size -= it->contents.size();
+        _lru.erase(it->lruPosition);
+        _entries.erase(it);
+    }
+}
+
+qint64 AssetCache::getSize() const {
+    QMutexLocker locker(&_mutex);
+    return _size;
+}
+
+int AssetCache::getCount() const {
+    QMutexLocker locker(&_mutex);
+    return _entries.size();
+}
+
+void AssetCache::evict(qint64 maxSize) {
+    while (_size > maxSize && !_lru.empty()) {
+        auto it = _entries.find(_lru.back());
+        _size -= it->contents.size();
+        _entries.erase(it);
+        _lru.pop_back();
+    }
+}
@@ -0,0 +1,70 @@
+//
+//  AssetCache.h
+//  assignment-client/src/assets
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetCache_h
+#define hifi_AssetCache_h
+
+#include <atomic>
+#include <list>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+// A bounded least-recently-used cache of the contents of asset files, keyed by hex hash.
+// Shared by the asset server's SendAssetTasks, so popular assets are read from disk once rather than once per request.
+// Assets are content addressed, so an entry only goes stale when its file is removed or rewritten.
+class AssetCache {
+public:
+    static const qint64 DEFAULT_MAX_SIZE = 256 * 1024 * 1024;
+
+    void setMaxSize(qint64 maxSize);
+
+    // returns the cached contents of the asset, or a null QByteArray (the contents are shared, not copied)
+    QByteArray get(const QString& hexHash);
+    // caches the contents of the asset, if the asset is small enough that caching it won't flush the rest of the cache
+    void insert(const QString& hexHash, const QByteArray& contents);
+    void remove(const QString& hexHash);
+
+    bool isCacheable(qint64 size) const { return size > 0 && size <= _maxSize / MAX_ENTRY_FRACTION_OF_CACHE; }
+
+    void addBytesServed(qint64 bytes) { _bytesServed += bytes; }
+
+    qint64 getSize() const;
+    int getCount() const;
+    quint64 getHits() const { return _hits; }
+    quint64 getMisses() const { return _misses; }
+    quint64 getBytesServed() const { return _bytesServed; }
+
+private:
+    using LRUList = std::list<QString>;
+
+    struct Entry {
+        QByteArray contents;
+        LRUList::iterator lruPosition;
+    };
+
+    static const int MAX_ENTRY_FRACTION_OF_CACHE = 8;
+
+    void evict(qint64 maxSize);
+
+    mutable QMutex _mutex;
+    QHash<QString, Entry> _entries;
+    LRUList _lru; // most recently used first
+    qint64 _size { 0 };
+    std::atomic<qint64> _maxSize { DEFAULT_MAX_SIZE };
+
+    std::atomic<quint64> _hits { 0 };
+    std::atomic<quint64> _misses { 0 };
+    std::atomic<quint64> _bytesServed { 0 };
+};
+
+#endif // hifi_AssetCache_h
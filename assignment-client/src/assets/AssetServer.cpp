@@ -145,6 +145,14 @@ void AssetServer::completeSetup() {
                     " (" << maxBandwidth << "bits/s)";
     }
 
+    static const QString HOT_ASSET_CACHE_SIZE_OPTION = "hot_asset_cache_size";
+    auto hotAssetCacheSizeValue = assetServerObject[HOT_ASSET_CACHE_SIZE_OPTION];
+    if (hotAssetCacheSizeValue.isDouble()) {
+        const qint64 BYTES_PER_MEGABYTE = 1024 * 1024;
+        _assetCache.setMaxSize(hotAssetCacheSizeValue.toInt() * BYTES_PER_MEGABYTE);
+        qInfo() << "Set hot asset cache size to" << hotAssetCacheSizeValue.toInt() << "MB.";
+    }
+
     // get the path to the asset folder from the domain server settings
     static const QString ASSETS_PATH_OPTION = "assets_path";
     auto assetsJSONValue = assetServerObject[ASSETS_PATH_OPTION];
@@ -216,6 +224,7 @@ void AssetServer::cleanupUnmappedFiles() {
             if (!mappedHashes.contains(fileInfo.fileName())) {
                 // remove the unmapped file
                 QFile removeableFile { fileInfo.absoluteFilePath() };
+                _assetCache.remove(fileInfo.fileName());
 
                 if (removeableFile.remove()) {
                     qDebug() << "\tDeleted" << fileInfo.fileName() << "from asset files directory since it is unmapped.";
@@ -388,7 +397,7 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, _assetCache);
     _taskPool.start(task);
 }
 
@@ -397,7 +406,7 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     if (senderNode->getCanWriteToAssetServer()) {
         qDebug() << "Starting an UploadAssetTask for upload from" << uuidStringWithoutCurlyBraces(senderNode->getUUID());
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory);
+        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _assetCache);
         _taskPool.start(task);
     } else {
         // this is a node the domain told us is not allowed to rez entities
@@ -484,6 +493,14 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     }
 
+    QJsonObject cacheStats;
+    cacheStats["1. Hits"] = (double)_assetCache.getHits();
+    cacheStats["2. Misses"] = (double)_assetCache.getMisses();
+    cacheStats["3. Cached Assets"] = _assetCache.getCount();
+    cacheStats["4. Cached Bytes"] = (double)_assetCache.getSize();
+    cacheStats["5. Bytes Served"] = (double)_assetCache.getBytesServed();
+    serverStats["Hot Asset Cache"] = cacheStats;
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -670,6 +687,7 @@ bool AssetServer::deleteMappings(AssetPathList& paths) {
         for (auto& hash : hashesToCheckForDeletion) {
             // remove the unmapped file
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
+            _assetCache.remove(hash);
 
             if (removeableFile.remove()) {
                 qDebug() << "\tDeleted" << hash << "from asset files directory since it is now unmapped.";
@@ -17,6 +17,7 @@
 
 #include <ThreadedAssignment.h>
 
+#include "AssetCache.h"
 #include "AssetUtils.h"
 #include "ReceivedMessage.h"
 
@@ -67,6 +68,7 @@ private:
 
     QDir _resourcesDirectory;
     QDir _filesDirectory;
+    AssetCache _assetCache; // declared before _taskPool, which waits for the tasks using it when destroyed
     QThreadPool _taskPool;
 };
 
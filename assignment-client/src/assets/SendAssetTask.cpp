@@ -23,11 +23,13 @@
 #include "AssetUtils.h"
 #include "ClientServerUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
+SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                             AssetCache& cache) :
     QRunnable(),
     _message(message),
     _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
+    _resourcesDir(resourcesDir),
+    _cache(cache)
 {
     
 }
@@ -56,29 +58,48 @@ void SendAssetTask::run() {
 
     replyPacketList->writePrimitive(messageID);
 
-    if (end <= start) {
+    if (start < 0 || end <= start) {
         replyPacketList->writePrimitive(AssetServerError::InvalidByteRange);
+        qCDebug(networking) << "Bad byte range: " << hexHash << " " << start << ":" << end;
     } else {
+        // popular assets are served from the cache, the rest straight from a mapping of the file
         QString filePath = _resourcesDir.filePath(QString(hexHash));
-        
         QFile file { filePath };
 
-        if (file.open(QIODevice::ReadOnly)) {
-            if (file.size() < end) {
-                replyPacketList->writePrimitive(AssetServerError::InvalidByteRange);
-                qCDebug(networking) << "Bad byte range: " << hexHash << " " << start << ":" << end;
+        // only the assets small enough to be cached are looked up, so the large ones don't count as misses
+        QByteArray contents;
+        bool found = file.open(QIODevice::ReadOnly);
+        if (found && _cache.isCacheable(file.size())) {
+            contents = _cache.get(hexHash);
+            if (contents.isNull()) {
+                contents = file.readAll();
+                _cache.insert(hexHash, contents);
+            }
+        }
+
+        if (!found) {
+            qCDebug(networking) << "Asset not found: " << filePath << "(" << hexHash << ")";
+            replyPacketList->writePrimitive(AssetServerError::AssetNotFound);
+        } else if ((contents.isNull() ? file.size() : contents.size()) < end) {
+            replyPacketList->writePrimitive(AssetServerError::InvalidByteRange);
+            qCDebug(networking) << "Bad byte range: " << hexHash << " " << start << ":" << end;
+        } else {
+            auto size = end - start;
+            replyPacketList->writePrimitive(AssetServerError::NoError);
+            replyPacketList->writePrimitive(size);
+
+            if (!contents.isNull()) {
+                replyPacketList->write(contents.constData() + start, size);
+            } else if (uchar* mapped = file.map(start, size)) {
+                replyPacketList->write(reinterpret_cast<const char*>(mapped), size);
+                file.unmap(mapped);
             } else {
-                auto size = end - start;
                 file.seek(start);
-                replyPacketList->writePrimitive(AssetServerError::NoError);
-                replyPacketList->writePrimitive(size);
                 replyPacketList->write(file.read(size));
-                qCDebug(networking) << "Sending asset: " << hexHash;
             }
-            file.close();
-        } else {
-            qCDebug(networking) << "Asset not found: " << filePath << "(" << hexHash << ")";
-            replyPacketList->writePrimitive(AssetServerError::AssetNotFound);
+
+            _cache.addBytesServed(size);
+            qCDebug(networking) << "Sending asset: " << hexHash;
         }
     }
 
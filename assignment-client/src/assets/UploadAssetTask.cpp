@@ -22,10 +22,11 @@
 
 
 UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
-                                 const QDir& resourcesDir) :
+                                 const QDir& resourcesDir, AssetCache& cache) :
     _receivedMessage(receivedMessage),
     _senderNode(senderNode),
-    _resourcesDir(resourcesDir)
+    _resourcesDir(resourcesDir),
+    _cache(cache)
 {
     
 }
@@ -79,6 +80,9 @@ void UploadAssetTask::run() {
         }
 
         if (!existingCorrectFile) {
+            // the cache may hold the contents of the file being replaced
+            _cache.remove(hexHash);
+
             if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize)) {
                 qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
                 file.close();
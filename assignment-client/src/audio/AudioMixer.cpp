@@ -39,6 +39,8 @@
 
 static const float DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE = 0.5f;    // attenuation = -6dB * log2(distance)
 static const float DEFAULT_NOISE_MUTING_THRESHOLD = 1.0f;
+static const float DEFAULT_AUDIBLE_RANGE = 0.0f;
+static const float MIN_AUDIBLE_RANGE = 1.0f;
 static const QString AUDIO_MIXER_LOGGING_TARGET_NAME = "audio-mixer";
 static const QString AUDIO_ENV_GROUP_KEY = "audio_env";
 static const QString AUDIO_BUFFER_GROUP_KEY = "audio_buffer";
@@ -47,6 +49,7 @@ static const QString AUDIO_THREADING_GROUP_KEY = "audio_threading";
 int AudioMixer::_numStaticJitterFrames{ -1 };
 float AudioMixer::_noiseMutingThreshold{ DEFAULT_NOISE_MUTING_THRESHOLD };
 float AudioMixer::_attenuationPerDoublingInDistance{ DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE };
+float AudioMixer::_audibleRange{ DEFAULT_AUDIBLE_RANGE };
 std::map<QString, std::shared_ptr<CodecPlugin>> AudioMixer::_availableCodecs{ };
 QStringList AudioMixer::_codecPreferenceOrder{};
 QHash<QString, AABox> AudioMixer::_audioZones;
@@ -366,18 +369,21 @@ void AudioMixer::start() {
         auto frameTimer = _frameTiming.timer();
 
         nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
-            // prepare frames; pop off any new audio from their streams
+            // prepare frames; pop off any new audio from their streams, and snapshot them for the slaves
             {
                 auto prepareTimer = _prepareTiming.timer();
+                _streamSnapshot.clear(_audibleRange);
                 std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
                     _stats.sumStreams += prepareFrame(node, frame);
+                    _streamSnapshot.addNode(node);
                 });
+                _streamSnapshot.build();
             }
 
             // mix across slave threads
             {
                 auto mixTimer = _mixTiming.timer();
-                _slavePool.mix(cbegin, cend, frame, _throttlingRatio);
+                _slavePool.mix(cbegin, cend, frame, _throttlingRatio, _streamSnapshot);
             }
         });
 
@@ -600,6 +606,17 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
             }
         }
 
+        const QString AUDIBLE_RANGE = "audible_range";
+        if (audioEnvGroupObject[AUDIBLE_RANGE].isString()) {
+            bool ok = false;
+            float audibleRange = audioEnvGroupObject[AUDIBLE_RANGE].toString().toFloat(&ok);
+            if (ok) {
+                // a small range would spread the streams over too many cells
+                _audibleRange = audibleRange > 0.0f ? std::max(audibleRange, MIN_AUDIBLE_RANGE) : 0.0f;
+                qDebug() << "Audible range changed to" << _audibleRange;
+            }
+        }
+
         const QString AUDIO_ZONES = "zones";
         if (audioEnvGroupObject[AUDIO_ZONES].isObject()) {
             const QJsonObject& zones = audioEnvGroupObject[AUDIO_ZONES].toObject();
@@ -667,6 +684,12 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
                     if (ok && settings.coefficient >= 0.0f && settings.coefficient <= 1.0f &&
                         _audioZones.contains(settings.source) && _audioZones.contains(settings.listener)) {
 
+                        if (_zoneSettings.size() == AudioMixerStreamSnapshot::MAX_ZONE_SETTINGS) {
+                            qWarning() << "Ignoring Coefficient:" << settings.source << settings.listener
+                                << "- no more than" << AudioMixerStreamSnapshot::MAX_ZONE_SETTINGS << "are supported";
+                            continue;
+                        }
+
                         _zoneSettings.push_back(settings);
                         qDebug() << "Added Coefficient:" << settings.source << settings.listener << settings.coefficient;
                     }
@@ -20,6 +20,7 @@
 
 #include "AudioMixerStats.h"
 #include "AudioMixerSlavePool.h"
+#include "AudioMixerStreamSnapshot.h"
 
 class PositionalAudioStream;
 class AvatarAudioStream;
@@ -46,6 +47,7 @@ public:
     static int getStaticJitterFrames() { return _numStaticJitterFrames; }
     static bool shouldMute(float quietestFrame) { return quietestFrame > _noiseMutingThreshold; }
     static float getAttenuationPerDoublingInDistance() { return _attenuationPerDoublingInDistance; }
+    static float getAudibleRange() { return _audibleRange; }
     static const QHash<QString, AABox>& getAudioZones() { return _audioZones; }
     static const QVector<ZoneSettings>& getZoneSettings() { return _zoneSettings; }
     static const QVector<ReverbSettings>& getReverbSettings() { return _zoneReverbSettings; }
@@ -89,6 +91,7 @@ private:
     AudioMixerStats _stats;
 
     AudioMixerSlavePool _slavePool;
+    AudioMixerStreamSnapshot _streamSnapshot; // rebuilt every frame, read by the slaves
 
     class Timer {
     public:
@@ -122,6 +125,7 @@ private:
     static int _numStaticJitterFrames; // -1 denotes dynamic jitter buffering
     static float _noiseMutingThreshold;
     static float _attenuationPerDoublingInDistance;
+    static float _audibleRange; // 0 denotes no limit
     static std::map<QString, CodecPluginPointer> _availableCodecs;
     static QStringList _codecPreferenceOrder;
     static QHash<QString, AABox> _audioZones;
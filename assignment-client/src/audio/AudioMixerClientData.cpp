@@ -27,7 +27,6 @@
 AudioMixerClientData::AudioMixerClientData(const QUuid& nodeID) :
     NodeData(nodeID),
     audioLimiter(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO),
-    _ignoreZone(*this),
     _outgoingMixedAudioSequenceNumber(0),
     _downstreamAudioStreamStats()
 {
@@ -516,95 +515,37 @@ void AudioMixerClientData::cleanupCodec() {
     }
 }
 
-AudioMixerClientData::IgnoreZone& AudioMixerClientData::IgnoreZoneMemo::get(unsigned int frame) {
-    // check for a memoized zone
-    if (frame != _frame.load(std::memory_order_acquire)) {
-        AvatarAudioStream* stream = _data.getAvatarAudioStream();
+AABox AudioMixerClientData::getIgnoreZone() {
+    AvatarAudioStream* stream = getAvatarAudioStream();
 
-        // get the initial dimensions from the stream
-        glm::vec3 corner = stream ? stream->getAvatarBoundingBoxCorner() : glm::vec3(0);
-        glm::vec3 scale = stream ? stream->getAvatarBoundingBoxScale() : glm::vec3(0);
+    // get the initial dimensions from the stream
+    glm::vec3 corner = stream ? stream->getAvatarBoundingBoxCorner() : glm::vec3(0);
+    glm::vec3 scale = stream ? stream->getAvatarBoundingBoxScale() : glm::vec3(0);
 
-        // enforce a minimum scale
-        static const glm::vec3 MIN_IGNORE_BOX_SCALE = glm::vec3(0.3f, 1.3f, 0.3f);
-        if (glm::any(glm::lessThan(scale, MIN_IGNORE_BOX_SCALE))) {
-            scale = MIN_IGNORE_BOX_SCALE;
-        }
-
-        // quadruple the scale (this is arbitrary number chosen for comfort)
-        const float IGNORE_BOX_SCALE_FACTOR = 4.0f;
-        scale *= IGNORE_BOX_SCALE_FACTOR;
-
-        // create the box (we use a box for the zone for convenience)
-        AABox box(corner, scale);
-
-        // update the memoized zone
-        // This may be called by multiple threads concurrently,
-        // so take a lock and only update the memo if this call is first.
-        // This prevents concurrent updates from invalidating the returned reference
-        // (contingent on the preconditions listed in the header).
-        std::lock_guard<std::mutex> lock(_mutex);
-        if (frame != _frame.load(std::memory_order_acquire)) {
-            _zone = box;
-            unsigned int oldFrame = _frame.exchange(frame, std::memory_order_release);
-            Q_UNUSED(oldFrame);
-        }
+    // enforce a minimum scale
+    static const glm::vec3 MIN_IGNORE_BOX_SCALE = glm::vec3(0.3f, 1.3f, 0.3f);
+    if (glm::any(glm::lessThan(scale, MIN_IGNORE_BOX_SCALE))) {
+        scale = MIN_IGNORE_BOX_SCALE;
     }
 
-    return _zone;
-}
-
-void AudioMixerClientData::IgnoreNodeCache::cache(bool shouldIgnore) {
-    if (!_isCached) {
-        _shouldIgnore = shouldIgnore;
-        _isCached = true;
-    }
-}
-
-bool AudioMixerClientData::IgnoreNodeCache::isCached() {
-    return _isCached;
-}
+    // quadruple the scale (this is arbitrary number chosen for comfort)
+    const float IGNORE_BOX_SCALE_FACTOR = 4.0f;
+    scale *= IGNORE_BOX_SCALE_FACTOR;
 
-bool AudioMixerClientData::IgnoreNodeCache::shouldIgnore() {
-    bool ignore = _shouldIgnore;
-    _isCached = false;
-    return ignore;
+    // create the box (we use a box for the zone for convenience)
+    return AABox(corner, scale);
 }
 
-bool AudioMixerClientData::shouldIgnore(const SharedNodePointer self, const SharedNodePointer node, unsigned int frame) {
-    // this is symmetric over self / node; if computed, it is cached in the other
-
-    // check the cache to avoid computation
-    auto& cache = _nodeSourcesIgnoreMap[node->getUUID()];
-    if (cache.isCached()) {
-        return cache.shouldIgnore();
-    }
-
+bool AudioMixerClientData::shouldIgnore(const SharedNodePointer& self, const SharedNodePointer& node) {
+    // this is symmetric over self / node
     AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
     if (!nodeData) {
         return false;
     }
 
-    // compute shouldIgnore
-    bool shouldIgnore = true;
-    if ( // the nodes are not ignoring each other explicitly (or are but get data regardless)
-            (!self->isIgnoringNodeWithID(node->getUUID()) ||
-             (nodeData->getRequestsDomainListData() && node->getCanKick())) &&
-            (!node->isIgnoringNodeWithID(self->getUUID()) ||
-             (getRequestsDomainListData() && self->getCanKick())))  {
-
-        // if either node is enabling an ignore radius, check their proximity
-        if ((self->isIgnoreRadiusEnabled() || node->isIgnoreRadiusEnabled())) {
-            auto& zone = _ignoreZone.get(frame);
-            auto& nodeZone = nodeData->_ignoreZone.get(frame);
-            shouldIgnore = zone.touches(nodeZone);
-        } else {
-            shouldIgnore = false;
-        }
-    }
-
-    // cache in node
-    nodeData->_nodeSourcesIgnoreMap[self->getUUID()].cache(shouldIgnore);
-
-    return shouldIgnore;
+    // the nodes are ignoring each other explicitly (and don't get data regardless)
+    return (self->isIgnoringNodeWithID(node->getUUID()) &&
+            !(nodeData->getRequestsDomainListData() && node->getCanKick())) ||
+        (node->isIgnoringNodeWithID(self->getUUID()) &&
+            !(getRequestsDomainListData() && self->getCanKick()));
 }
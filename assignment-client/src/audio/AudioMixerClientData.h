@@ -41,11 +41,17 @@ public:
 
     // locks the mutex to make a copy
     AudioStreamMap getAudioStreams() { QReadLocker readLock { &_streamsLock }; return _audioStreams; }
+    // locks the mutex and calls functor with the streams, without copying them
+    template <typename F>
+    void withAudioStreams(F functor) { QReadLocker readLock { &_streamsLock }; functor(_audioStreams); }
     AvatarAudioStream* getAvatarAudioStream();
 
-    // returns whether self (this data's node) should ignore node, memoized by frame
-    // precondition: frame is increasing after first call (including overflow wrap)
-    bool shouldIgnore(SharedNodePointer self, SharedNodePointer node, unsigned int frame);
+    // returns whether self (this data's node) and node explicitly ignore each other
+    // the ignore radius is applied by the AudioMixerStreamSnapshot, for all nodes at once
+    bool shouldIgnore(const SharedNodePointer& self, const SharedNodePointer& node);
+
+    // the zone around this node's avatar that other nodes are not heard in, when either enables its ignore radius
+    AABox getIgnoreZone();
 
     // the following methods should be called from the AudioMixer assignment thread ONLY
     // they are not thread-safe
@@ -57,7 +63,7 @@ public:
     void removeHRTFForStream(const QUuid& nodeID, const QUuid& streamID = QUuid());
 
     // remove all sources and data from this node
-    void removeNode(const QUuid& nodeID) { _nodeSourcesIgnoreMap.unsafe_erase(nodeID); _nodeSourcesHRTFMap.erase(nodeID); }
+    void removeNode(const QUuid& nodeID) { _nodeSourcesHRTFMap.erase(nodeID); }
 
     void removeAgentAvatarAudioStream();
 
@@ -124,44 +130,6 @@ private:
     QReadWriteLock _streamsLock;
     AudioStreamMap _audioStreams; // microphone stream from avatar is stored under key of null UUID
 
-    using IgnoreZone = AABox;
-    class IgnoreZoneMemo {
-    public:
-        IgnoreZoneMemo(AudioMixerClientData& data) : _data(data) {}
-
-        // returns an ignore zone, memoized by frame (lockless if the zone is already memoized)
-        // preconditions:
-        //  - frame is increasing after first call (including overflow wrap)
-        //  - there are no references left from calls to getIgnoreZone(frame - 1)
-        IgnoreZone& get(unsigned int frame);
-
-    private:
-        AudioMixerClientData& _data;
-        IgnoreZone _zone;
-        std::atomic<unsigned int> _frame { 0 };
-        std::mutex _mutex;
-    };
-    IgnoreZoneMemo _ignoreZone;
-
-    class IgnoreNodeCache {
-    public:
-        // std::atomic is not copyable - always initialize uncached
-        IgnoreNodeCache() {}
-        IgnoreNodeCache(const IgnoreNodeCache& other) {}
-
-        void cache(bool shouldIgnore);
-        bool isCached();
-        bool shouldIgnore();
-
-    private:
-        std::atomic<bool> _isCached { false };
-        bool _shouldIgnore { false };
-    };
-    struct IgnoreNodeCacheHasher { std::size_t operator()(const QUuid& key) const { return qHash(key); } };
-
-    using NodeSourcesIgnoreMap = tbb::concurrent_unordered_map<QUuid, IgnoreNodeCache, IgnoreNodeCacheHasher>;
-    NodeSourcesIgnoreMap _nodeSourcesIgnoreMap;
-
     using HRTFMap = std::unordered_map<QUuid, AudioHRTF>;
     using NodeSourcesHRTFMap = std::unordered_map<QUuid, HRTFMap>;
     NodeSourcesHRTFMap _nodeSourcesHRTFMap;
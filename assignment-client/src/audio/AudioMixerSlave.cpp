@@ -49,7 +49,7 @@ void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData&
 inline float approximateGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
         const glm::vec3& relativePosition);
 inline float computeGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
-        const glm::vec3& relativePosition, bool isEcho);
+        const glm::vec3& relativePosition, bool isEcho, float attenuationPerDoublingInDistance);
 inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
         const glm::vec3& relativePosition);
 
@@ -60,11 +60,13 @@ void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     }
 }
 
-void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio) {
+void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio,
+        const AudioMixerStreamSnapshot* snapshot) {
     _begin = begin;
     _end = end;
     _frame = frame;
     _throttlingRatio = throttlingRatio;
+    _snapshot = snapshot;
 }
 
 void AudioMixerSlave::mix(const SharedNodePointer& node) {
@@ -128,15 +130,35 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     memset(_mixSamples, 0, sizeof(_mixSamples));
 
     bool isThrottling = _throttlingRatio > 0.0f;
-    std::vector<std::pair<float, SharedNodePointer>> throttledNodes;
+    std::vector<std::pair<float, int>> throttledSources;
+
+    using Stream = AudioMixerStreamSnapshot::Stream;
+    auto& sources = _snapshot->getSources();
+    auto& streams = _snapshot->getStreams();
+
+    // only visit the streams within the audible range of the listener
+    _snapshot->findAudibleStreams(listenerAudioStream->getPosition(), _audibleStreams);
+    auto listenerZones = _snapshot->getListenerZones(listenerAudioStream->getPosition());
+    int listenerSource = _snapshot->getSourceIndex(listener->getUUID());
+
+    // group the audible streams by source (they are sorted, so each source's streams are contiguous)
+    _audibleSources.clear();
+    for (int i = 0; i < (int)_audibleStreams.size(); ++i) {
+        int source = streams[_audibleStreams[i]].source;
+        if (_audibleSources.empty() || _audibleSources.back().source != source) {
+            _audibleSources.push_back({ source, i, i });
+        }
+        ++_audibleSources.back().streamsEnd;
+    }
 
     typedef void (AudioMixerSlave::*MixFunctor)(
-            AudioMixerClientData&, const QUuid&, const AvatarAudioStream&, const PositionalAudioStream&);
-    auto forAllStreams = [&](const SharedNodePointer& node, AudioMixerClientData* nodeData, MixFunctor mixFunctor) {
-        auto nodeID = node->getUUID();
-        for (auto& streamPair : nodeData->getAudioStreams()) {
-            auto nodeStream = streamPair.second;
-            (this->*mixFunctor)(*listenerData, nodeID, *listenerAudioStream, *nodeStream);
+            AudioMixerClientData&, const QUuid&, const AvatarAudioStream&, const PositionalAudioStream&, float);
+    auto forAllStreams = [&](const AudibleSource& audibleSource, MixFunctor mixFunctor) {
+        auto nodeID = sources[audibleSource.source].node->getUUID();
+        for (int i = audibleSource.streamsBegin; i < audibleSource.streamsEnd; ++i) {
+            auto& stream = streams[_audibleStreams[i]];
+            float attenuation = _snapshot->getAttenuationPerDoublingInDistance(stream, listenerZones);
+            (this->*mixFunctor)(*listenerData, nodeID, *listenerAudioStream, *stream.stream, attenuation);
         }
     };
 
@@ -144,74 +166,68 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     auto mixStart = p_high_resolution_clock::now();
 #endif
 
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
-        if (!nodeData) {
-            return;
-        }
+    for (int audibleIndex = 0; audibleIndex < (int)_audibleSources.size(); ++audibleIndex) {
+        auto& audibleSource = _audibleSources[audibleIndex];
+        auto& node = sources[audibleSource.source].node;
 
         if (*node == *listener) {
             // only mix the echo, if requested
-            for (auto& streamPair : nodeData->getAudioStreams()) {
-                auto nodeStream = streamPair.second;
-                if (nodeStream->shouldLoopbackForNode()) {
-                    mixStream(*listenerData, node->getUUID(), *listenerAudioStream, *nodeStream);
+            for (int i = audibleSource.streamsBegin; i < audibleSource.streamsEnd; ++i) {
+                auto& stream = streams[_audibleStreams[i]];
+                if (stream.stream->shouldLoopbackForNode()) {
+                    float attenuation = _snapshot->getAttenuationPerDoublingInDistance(stream, listenerZones);
+                    mixStream(*listenerData, node->getUUID(), *listenerAudioStream, *stream.stream, attenuation);
                 }
             }
-        } else if (!listenerData->shouldIgnore(listener, node, _frame)) {
+        } else if (!_snapshot->isIgnoredByRadius(listenerSource, audibleSource.source) &&
+                   !listenerData->shouldIgnore(listener, node)) {
             if (!isThrottling) {
-                forAllStreams(node, nodeData, &AudioMixerSlave::mixStream);
+                forAllStreams(audibleSource, &AudioMixerSlave::mixStream);
             } else {
                 auto nodeID = node->getUUID();
 
                 // compute the node's max relative volume
-                float nodeVolume;
-                for (auto& streamPair : nodeData->getAudioStreams()) {
-                    auto nodeStream = streamPair.second;
+                float nodeVolume = 0.0f;
+                for (int i = audibleSource.streamsBegin; i < audibleSource.streamsEnd; ++i) {
+                    const Stream& stream = streams[_audibleStreams[i]];
 
                     // approximate the gain
-                    glm::vec3 relativePosition = nodeStream->getPosition() - listenerAudioStream->getPosition();
-                    float gain = approximateGain(*listenerAudioStream, *nodeStream, relativePosition);
+                    glm::vec3 relativePosition = stream.position - listenerAudioStream->getPosition();
+                    float gain = approximateGain(*listenerAudioStream, *stream.stream, relativePosition);
 
                     // modify by hrtf gain adjustment
-                    auto& hrtf = listenerData->hrtfForStream(nodeID, nodeStream->getStreamIdentifier());
+                    auto& hrtf = listenerData->hrtfForStream(nodeID, stream.stream->getStreamIdentifier());
                     gain *= hrtf.getGainAdjustment();
 
-                    auto streamVolume = nodeStream->getLastPopOutputTrailingLoudness() * gain;
+                    auto streamVolume = stream.trailingLoudness * gain;
                     nodeVolume = std::max(streamVolume, nodeVolume);
                 }
 
                 // max-heapify the nodes by relative volume
-                throttledNodes.push_back(std::make_pair(nodeVolume, node));
-                if (!throttledNodes.empty()) {
-                    std::push_heap(throttledNodes.begin(), throttledNodes.end());
-                }
+                throttledSources.push_back(std::make_pair(nodeVolume, audibleIndex));
+                std::push_heap(throttledSources.begin(), throttledSources.end());
             }
         }
-    });
+    }
 
     if (isThrottling) {
         // pop the loudest nodes off the heap and mix their streams
         int numToRetain = (int)(std::distance(_begin, _end) * (1 - _throttlingRatio));
         for (int i = 0; i < numToRetain; i++) {
-            if (throttledNodes.empty()) {
+            if (throttledSources.empty()) {
                 break;
             }
 
-            std::pop_heap(throttledNodes.begin(), throttledNodes.end());
+            std::pop_heap(throttledSources.begin(), throttledSources.end());
 
-            auto& node = throttledNodes.back().second;
-            AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
-            forAllStreams(node, nodeData, &AudioMixerSlave::mixStream);
+            forAllStreams(_audibleSources[throttledSources.back().second], &AudioMixerSlave::mixStream);
 
-            throttledNodes.pop_back();
+            throttledSources.pop_back();
         }
 
         // throttle the remaining nodes' streams
-        for (const std::pair<float, SharedNodePointer>& nodePair : throttledNodes) {
-            auto& node = nodePair.second;
-            AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
-            forAllStreams(node, nodeData, &AudioMixerSlave::throttleStream);
+        for (const std::pair<float, int>& sourcePair : throttledSources) {
+            forAllStreams(_audibleSources[sourcePair.second], &AudioMixerSlave::throttleStream);
         }
     }
 
@@ -236,18 +252,20 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 }
 
 void AudioMixerSlave::throttleStream(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
-        const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd) {
-    addStream(listenerNodeData, sourceNodeID, listeningNodeStream, streamToAdd, true);
+        const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
+        float attenuationPerDoublingInDistance) {
+    addStream(listenerNodeData, sourceNodeID, listeningNodeStream, streamToAdd, attenuationPerDoublingInDistance, true);
 }
 
 void AudioMixerSlave::mixStream(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
-        const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd) {
-    addStream(listenerNodeData, sourceNodeID, listeningNodeStream, streamToAdd, false);
+        const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
+        float attenuationPerDoublingInDistance) {
+    addStream(listenerNodeData, sourceNodeID, listeningNodeStream, streamToAdd, attenuationPerDoublingInDistance, false);
 }
 
 void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
         const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
-        bool throttle) {
+        float attenuationPerDoublingInDistance, bool throttle) {
     ++stats.totalMixes;
 
     // to reduce artifacts we call the HRTF functor for every source, even if throttled or silent
@@ -259,7 +277,7 @@ void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QU
     glm::vec3 relativePosition = streamToAdd.getPosition() - listeningNodeStream.getPosition();
 
     float distance = glm::max(glm::length(relativePosition), EPSILON);
-    float gain = computeGain(listeningNodeStream, streamToAdd, relativePosition, isEcho);
+    float gain = computeGain(listeningNodeStream, streamToAdd, relativePosition, isEcho, attenuationPerDoublingInDistance);
     float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
     const int HRTF_DATASET_INDEX = 1;
 
@@ -480,7 +498,7 @@ float approximateGain(const AvatarAudioStream& listeningNodeStream, const Positi
 }
 
 float computeGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
-        const glm::vec3& relativePosition, bool isEcho) {
+        const glm::vec3& relativePosition, bool isEcho, float attenuationPerDoublingInDistance) {
     float gain = 1.0f;
 
     // injector: apply attenuation
@@ -501,19 +519,7 @@ float computeGain(const AvatarAudioStream& listeningNodeStream, const Positional
         gain *= offAxisCoefficient;
     }
 
-    auto& audioZones = AudioMixer::getAudioZones();
-    auto& zoneSettings = AudioMixer::getZoneSettings();
-
-    // find distance attenuation coefficient
-    float attenuationPerDoublingInDistance = AudioMixer::getAttenuationPerDoublingInDistance();
-    for (int i = 0; i < zoneSettings.length(); ++i) {
-        if (audioZones[zoneSettings[i].source].contains(streamToAdd.getPosition()) &&
-            audioZones[zoneSettings[i].listener].contains(listeningNodeStream.getPosition())) {
-            attenuationPerDoublingInDistance = zoneSettings[i].coefficient;
-            break;
-        }
-    }
-
+    // the distance attenuation coefficient of the zones is resolved once per frame, in the stream snapshot
     // distance attenuation
     const float ATTENUATION_START_DISTANCE = 1.0f;
     float distance = glm::length(relativePosition);
@@ -20,6 +20,7 @@
 #include <NodeList.h>
 
 #include "AudioMixerStats.h"
+#include "AudioMixerStreamSnapshot.h"
 
 class PositionalAudioStream;
 class AvatarAudioStream;
@@ -34,7 +35,8 @@ public:
     void processPackets(const SharedNodePointer& node);
 
     // configure a round of mixing
-    void configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio);
+    void configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio,
+            const AudioMixerStreamSnapshot* snapshot);
 
     // mix and broadcast non-ignored streams to the node (requires configuration using configureMix, above)
     // returns true if a mixed packet was sent to the node
@@ -46,12 +48,14 @@ private:
     // create mix, returns true if mix has audio
     bool prepareMix(const SharedNodePointer& listener);
     void throttleStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
-            const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer);
+            const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer,
+            float attenuationPerDoublingInDistance);
     void mixStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
-            const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer);
+            const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer,
+            float attenuationPerDoublingInDistance);
     void addStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
             const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer,
-            bool throttle);
+            float attenuationPerDoublingInDistance, bool throttle);
 
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
@@ -62,6 +66,16 @@ private:
     ConstIter _end;
     unsigned int _frame { 0 };
     float _throttlingRatio { 0.0f };
+    const AudioMixerStreamSnapshot* _snapshot { nullptr };
+
+    // audible streams of the current listener, reused across listeners
+    struct AudibleSource {
+        int source; // index in the snapshot's sources
+        int streamsBegin; // range of this source's streams in _audibleStreams
+        int streamsEnd;
+    };
+    std::vector<int> _audibleStreams;
+    std::vector<AudibleSource> _audibleSources;
 };
 
 #endif // hifi_AudioMixerSlave_h
@@ -0,0 +1,211 @@
+//
+//  AudioMixerStreamSnapshot.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerStreamSnapshot.h"
+
+#include <algorithm>
+
+#include <glm/gtx/norm.hpp>
+
+#include "AudioMixer.h"
+
+// each cell coordinate is packed into 21 bits of the cell key
+static const int CELL_COORDINATE_BITS = 21;
+static const int CELL_COORDINATE_OFFSET = 1 << (CELL_COORDINATE_BITS - 1);
+static const uint64_t CELL_COORDINATE_MASK = (1ULL << CELL_COORDINATE_BITS) - 1;
+
+void AudioMixerStreamSnapshot::clear(float audibleRange) {
+    // keep the capacity, the number of nodes and streams changes little from frame to frame
+    _sources.clear();
+    _streams.clear();
+    _cells.clear();
+    _sourceIndexes.clear();
+    _ignoredSources.clear();
+
+    _audibleRange = audibleRange;
+
+    // resolve the zone names once per frame, rather than for every listener and stream
+    _zones.clear();
+    auto& audioZones = AudioMixer::getAudioZones();
+    for (auto& settings : AudioMixer::getZoneSettings()) {
+        if ((int)_zones.size() == MAX_ZONE_SETTINGS) {
+            break;
+        }
+        _zones.push_back({ audioZones[settings.source], audioZones[settings.listener], settings.coefficient });
+    }
+    _defaultAttenuation = AudioMixer::getAttenuationPerDoublingInDistance();
+}
+
+void AudioMixerStreamSnapshot::addNode(const SharedNodePointer& node) {
+    AudioMixerClientData* data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+    if (!data) {
+        return;
+    }
+
+    int sourceIndex = (int)_sources.size();
+    Source source { node, data, (int)_streams.size(), 0, data->getIgnoreZone(), node->isIgnoreRadiusEnabled() };
+
+    data->withAudioStreams([&](const AudioMixerClientData::AudioStreamMap& streams) {
+        for (auto& streamPair : streams) {
+            auto& stream = streamPair.second;
+            auto position = stream->getPosition();
+
+            ZoneMask sourceZones = 0;
+            for (int i = 0; i < (int)_zones.size(); ++i) {
+                if (_zones[i].source.contains(position)) {
+                    sourceZones |= (ZoneMask)1 << i;
+                }
+            }
+
+            _streams.push_back({ stream, position, stream->getLastPopOutputTrailingLoudness(), sourceIndex, sourceZones });
+        }
+    });
+
+    source.streamsEnd = (int)_streams.size();
+    _sources.push_back(source);
+    _sourceIndexes[node->getUUID()] = sourceIndex;
+}
+
+void AudioMixerStreamSnapshot::build() {
+    buildIgnoredSources();
+
+    if (_audibleRange <= 0.0f) {
+        return;
+    }
+
+    for (int i = 0; i < (int)_streams.size(); ++i) {
+        _cells.push_back({ cellKeyFor(cellFor(_streams[i].position, _audibleRange)), i });
+    }
+    std::sort(_cells.begin(), _cells.end());
+}
+
+void AudioMixerStreamSnapshot::buildIgnoredSources() {
+    // cells as wide as the largest ignore zone, so two zones that touch are always in neighbouring cells
+    float cellSize = 0.0f;
+    bool hasIgnoreRadius = false;
+    for (auto& source : _sources) {
+        auto& scale = source.ignoreZone.getScale();
+        cellSize = std::max(cellSize, std::max(scale.x, std::max(scale.y, scale.z)));
+        hasIgnoreRadius = hasIgnoreRadius || source.isIgnoreRadiusEnabled;
+    }
+
+    if (!hasIgnoreRadius || cellSize <= 0.0f) {
+        return;
+    }
+
+    std::vector<std::pair<CellKey, int>> cells;
+    cells.reserve(_sources.size());
+    for (int i = 0; i < (int)_sources.size(); ++i) {
+        cells.push_back({ cellKeyFor(cellFor(_sources[i].ignoreZone.calcCenter(), cellSize)), i });
+    }
+    std::sort(cells.begin(), cells.end());
+
+    for (int i = 0; i < (int)_sources.size(); ++i) {
+        auto& source = _sources[i];
+        if (!source.isIgnoreRadiusEnabled) {
+            continue;
+        }
+
+        glm::ivec3 center = cellFor(source.ignoreZone.calcCenter(), cellSize);
+        for (int x = -1; x <= 1; ++x) {
+            for (int y = -1; y <= 1; ++y) {
+                for (int z = -1; z <= 1; ++z) {
+                    CellKey key = cellKeyFor(center + glm::ivec3(x, y, z));
+                    auto it = std::lower_bound(cells.begin(), cells.end(), std::make_pair(key, 0));
+                    for (; it != cells.end() && it->first == key; ++it) {
+                        int other = it->second;
+
+                        // a pair where both have the radius enabled is found from the side of the lower index only
+                        if (other == i || (_sources[other].isIgnoreRadiusEnabled && other < i)) {
+                            continue;
+                        }
+
+                        if (source.ignoreZone.touches(_sources[other].ignoreZone)) {
+                            _ignoredSources.push_back({ i, other });
+                            _ignoredSources.push_back({ other, i });
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    std::sort(_ignoredSources.begin(), _ignoredSources.end());
+}
+
+int AudioMixerStreamSnapshot::getSourceIndex(const QUuid& nodeID) const {
+    auto it = _sourceIndexes.find(nodeID);
+    return it != _sourceIndexes.end() ? it->second : -1;
+}
+
+bool AudioMixerStreamSnapshot::isIgnoredByRadius(int listenerSource, int source) const {
+    return std::binary_search(_ignoredSources.begin(), _ignoredSources.end(), std::make_pair(listenerSource, source));
+}
+
+void AudioMixerStreamSnapshot::findAudibleStreams(const glm::vec3& position, std::vector<int>& audibleStreams) const {
+    audibleStreams.clear();
+
+    if (_audibleRange <= 0.0f) {
+        for (int i = 0; i < (int)_streams.size(); ++i) {
+            audibleStreams.push_back(i);
+        }
+        return;
+    }
+
+    // a cell is as wide as the audible range, so the audible streams are all in the neighbouring cells
+    float audibleRangeSquared = _audibleRange * _audibleRange;
+    glm::ivec3 center = cellFor(position, _audibleRange);
+    for (int x = -1; x <= 1; ++x) {
+        for (int y = -1; y <= 1; ++y) {
+            for (int z = -1; z <= 1; ++z) {
+                CellKey key = cellKeyFor(center + glm::ivec3(x, y, z));
+                auto it = std::lower_bound(_cells.begin(), _cells.end(), std::make_pair(key, 0));
+                for (; it != _cells.end() && it->first == key; ++it) {
+                    if (glm::distance2(_streams[it->second].position, position) <= audibleRangeSquared) {
+                        audibleStreams.push_back(it->second);
+                    }
+                }
+            }
+        }
+    }
+
+    std::sort(audibleStreams.begin(), audibleStreams.end());
+}
+
+AudioMixerStreamSnapshot::ZoneMask AudioMixerStreamSnapshot::getListenerZones(const glm::vec3& position) const {
+    ZoneMask listenerZones = 0;
+    for (int i = 0; i < (int)_zones.size(); ++i) {
+        if (_zones[i].listener.contains(position)) {
+            listenerZones |= (ZoneMask)1 << i;
+        }
+    }
+    return listenerZones;
+}
+
+float AudioMixerStreamSnapshot::getAttenuationPerDoublingInDistance(const Stream& stream, ZoneMask listenerZones) const {
+    // the first setting that matches both the source and the listener wins
+    ZoneMask zones = stream.sourceZones & listenerZones;
+    for (int i = 0; zones; ++i, zones >>= 1) {
+        if (zones & 1) {
+            return _zones[i].coefficient;
+        }
+    }
+    return _defaultAttenuation;
+}
+
+AudioMixerStreamSnapshot::CellKey AudioMixerStreamSnapshot::cellKeyFor(const glm::ivec3& cell) const {
+    return (((uint64_t)(cell.x + CELL_COORDINATE_OFFSET) & CELL_COORDINATE_MASK) << (2 * CELL_COORDINATE_BITS)) |
+        (((uint64_t)(cell.y + CELL_COORDINATE_OFFSET) & CELL_COORDINATE_MASK) << CELL_COORDINATE_BITS) |
+        ((uint64_t)(cell.z + CELL_COORDINATE_OFFSET) & CELL_COORDINATE_MASK);
+}
+
+glm::ivec3 AudioMixerStreamSnapshot::cellFor(const glm::vec3& position, float cellSize) const {
+    return glm::ivec3(glm::floor(position / cellSize));
+}
@@ -0,0 +1,118 @@
+//
+//  AudioMixerStreamSnapshot.h
+//  assignment-client/src/audio
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerStreamSnapshot_h
+#define hifi_AudioMixerStreamSnapshot_h
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AABox.h>
+#include <Node.h>
+#include <UUIDHasher.h>
+
+#include "AudioMixerClientData.h"
+
+// The audio streams of every node for one frame, flattened into one array.
+// It is built once per frame by the AudioMixer (after the streams have popped their frame)
+// and is then read, but never modified, by every AudioMixerSlave while it mixes.
+//
+// When the domain sets an audible range, the streams are also bucketed into a uniform grid of cells
+// as wide as that range, so a listener only visits the streams in the 27 cells around it.
+//
+// The ignore radius is applied while the snapshot is built: the ignore zones of the nodes are bucketed into a grid of
+// their own, and the pairs of nodes that don't hear each other are found once per frame rather than per listener.
+class AudioMixerStreamSnapshot {
+public:
+    using SharedStreamPointer = AudioMixerClientData::SharedStreamPointer;
+
+    // zone membership is kept as a bitmask per stream, one bit per attenuation coefficient setting
+    static const int MAX_ZONE_SETTINGS = 64;
+    using ZoneMask = uint64_t;
+
+    struct Stream {
+        SharedStreamPointer stream; // keeps the stream alive until the next frame
+        glm::vec3 position;
+        float trailingLoudness;
+        int source; // index of the source this stream belongs to
+        ZoneMask sourceZones; // the settings whose source zone contains this stream
+    };
+
+    struct Source {
+        SharedNodePointer node;
+        AudioMixerClientData* data;
+        int streamsBegin; // range of this node's streams in the snapshot
+        int streamsEnd;
+        AABox ignoreZone;
+        bool isIgnoreRadiusEnabled;
+    };
+
+    // resets the snapshot for a new frame, and picks up the current audio zone settings
+    void clear(float audibleRange);
+
+    // adds the node and its streams, if it has client data
+    void addNode(const SharedNodePointer& node);
+
+    // indexes the streams added since clear, call once every node has been added
+    void build();
+
+    const std::vector<Source>& getSources() const { return _sources; }
+    const std::vector<Stream>& getStreams() const { return _streams; }
+
+    const Stream* streamsBegin(const Source& source) const { return _streams.data() + source.streamsBegin; }
+    const Stream* streamsEnd(const Source& source) const { return _streams.data() + source.streamsEnd; }
+
+    int getNumStreams() const { return (int)_streams.size(); }
+
+    // the index of the node's source, or -1 if it wasn't added
+    int getSourceIndex(const QUuid& nodeID) const;
+
+    // true if one of the two sources has its ignore radius enabled, and their ignore zones touch
+    bool isIgnoredByRadius(int listenerSource, int source) const;
+
+    // fills audibleStreams with the indexes of the streams within the audible range of position, in order
+    // (so the streams of a source stay contiguous); every stream is audible when there is no audible range
+    void findAudibleStreams(const glm::vec3& position, std::vector<int>& audibleStreams) const;
+
+    // the settings whose listener zone contains position
+    ZoneMask getListenerZones(const glm::vec3& position) const;
+    // the attenuation between a stream and a listener in the given zones, the domain default if no zone setting applies
+    float getAttenuationPerDoublingInDistance(const Stream& stream, ZoneMask listenerZones) const;
+
+private:
+    struct Zone {
+        AABox source;
+        AABox listener;
+        float coefficient;
+    };
+
+    using CellKey = uint64_t;
+    CellKey cellKeyFor(const glm::ivec3& cell) const;
+    glm::ivec3 cellFor(const glm::vec3& position, float cellSize) const;
+
+    void buildIgnoredSources();
+
+    std::vector<Source> _sources;
+    std::vector<Stream> _streams;
+
+    std::vector<Zone> _zones;
+    float _defaultAttenuation { 0.0f };
+
+    float _audibleRange { 0.0f };
+    std::vector<std::pair<CellKey, int>> _cells; // (cell, stream index), sorted by cell
+
+    std::unordered_map<QUuid, int, UUIDHasher> _sourceIndexes;
+    std::vector<std::pair<int, int>> _ignoredSources; // (listener, source) pairs ignored by radius, both ways, sorted
+};
+
+#endif // hifi_AudioMixerStreamSnapshot_h
@@ -9,8 +9,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <cfloat>
-#include <random>
 #include <memory>
 
 #include <QtCore/QCoreApplication>
@@ -32,8 +32,6 @@
 
 const QString AVATAR_MIXER_LOGGING_NAME = "avatar-mixer";
 
-// FIXME - what we'd actually like to do is send to users at ~50% of their present rate down to 30hz. Assume 90 for now.
-const int AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 45;
 const unsigned int AVATAR_DATA_SEND_INTERVAL_MSECS = (1.0f / (float) AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND) * 1000;
 
 AvatarMixer::AvatarMixer(ReceivedMessage& message) :
@@ -65,10 +63,6 @@ AvatarMixer::~AvatarMixer() {
     _broadcastThread.wait();
 }
 
-// An 80% chance of sending a identity packet within a 5 second interval.
-// assuming 60 htz update rate.
-const float IDENTITY_SEND_PROBABILITY = 1.0f / 187.0f;
-
 void AvatarMixer::sendIdentityPacket(AvatarMixerClientData* nodeData, const SharedNodePointer& destinationNode) {
     QByteArray individualData = nodeData->getAvatar().identityByteArray();
 
@@ -80,6 +74,7 @@ void AvatarMixer::sendIdentityPacket(AvatarMixerClientData* nodeData, const Shar
 
     DependencyManager::get<NodeList>()->sendPacket(std::move(identityPacket), *destinationNode);
 
+    std::lock_guard<std::mutex> lock(_statsMutex);
     ++_sumIdentityPackets;
 }
 
@@ -96,8 +91,6 @@ void AvatarMixer::broadcastAvatarData() {
         idleTime = std::chrono::duration_cast<std::chrono::microseconds>(idleDuration).count();
     }
 
-    ++_numStatFrames;
-
     const float STRUGGLE_TRIGGER_SLEEP_PERCENTAGE_THRESHOLD = 0.10f;
     const float BACK_OFF_TRIGGER_SLEEP_PERCENTAGE_THRESHOLD = 0.20f;
 
@@ -109,13 +102,6 @@ void AvatarMixer::broadcastAvatarData() {
     const float CURRENT_FRAME_RATIO = 1.0f / TRAILING_AVERAGE_FRAMES;
     const float PREVIOUS_FRAMES_RATIO = 1.0f - CURRENT_FRAME_RATIO;
 
-    // only send extra avatar data (avatars out of view, ignored) every Nth AvatarData frame
-    // Extra avatar data will be sent (AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND/EXTRA_AVATAR_DATA_FRAME_RATIO) times
-    // per second.
-    // This value should be a power of two for performance purposes, as the mixer performs a modulo operation every frame
-    // to determine whether the extra data should be sent.
-    const int EXTRA_AVATAR_DATA_FRAME_RATIO = 16; 
-    
     // NOTE: The following code calculates the _performanceThrottlingRatio based on how much the avatar-mixer was
     // able to sleep. This will eventually be used to ask for an additional avatar-mixer to help out. Currently the value
     // is unused as it is assumed this should not be hit before the avatar-mixer hits the desired bandwidth limit per client.
@@ -159,334 +145,51 @@ void AvatarMixer::broadcastAvatarData() {
 
     auto nodeList = DependencyManager::get<NodeList>();
 
-    // setup for distributed random floating point values
-    std::random_device randomDevice;
-    std::mt19937 generator(randomDevice());
-    std::uniform_real_distribution<float> distribution;
-
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-            if (!node->getLinkedData()) {
-                return false;
-            }
-            if (node->getType() != NodeType::Agent) {
-                return false;
-            }
-            if (!node->getActiveSocket()) {
-                return false;
-            }
-            return true;
-        },
-        [&](const SharedNodePointer& node) {
-            AvatarMixerClientData* nodeData = reinterpret_cast<AvatarMixerClientData*>(node->getLinkedData());
-            MutexTryLocker lock(nodeData->getMutex());
-            if (!lock.isLocked()) {
-                return;
-            }
-            ++_sumListeners;
-            nodeData->resetInViewStats();
-
-            AvatarData& avatar = nodeData->getAvatar();
-            glm::vec3 myPosition = avatar.getClientGlobalPosition();
-
-            // reset the internal state for correct random number distribution
-            distribution.reset();
-
-            // reset the max distance for this frame
-            float maxAvatarDistanceThisFrame = 0.0f;
-
-            // reset the number of sent avatars
-            nodeData->resetNumAvatarsSentLastFrame();
-
-            // keep a counter of the number of considered avatars
-            int numOtherAvatars = 0;
-
-            // keep track of outbound data rate specifically for avatar data
-            int numAvatarDataBytes = 0;
-
-            // keep track of the number of other avatars held back in this frame
-            int numAvatarsHeldBack = 0;
-
-            // keep track of the number of other avatar frames skipped
-            int numAvatarsWithSkippedFrames = 0;
-
-            // use the data rate specifically for avatar data for FRD adjustment checks
-            float avatarDataRateLastSecond = nodeData->getOutboundAvatarDataKbps();
+    nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+        // parse the queued avatar data packets across slave threads
+        _slavePool.processIncomingPackets(cbegin, cend);
 
-            // When this is true, the AvatarMixer will send Avatar data to a client about avatars that are not in the view frustrum
-            bool getsOutOfView = nodeData->getRequestsDomainListData();
-
-            // When this is true, the AvatarMixer will send Avatar data to a client about avatars that they've ignored
-            bool getsIgnoredByMe = getsOutOfView;
-            
-            // When this is true, the AvatarMixer will send Avatar data to a client about avatars that have ignored them
-            bool getsAnyIgnored = getsIgnoredByMe && node->getCanKick();
-
-            // Check if it is time to adjust what we send this client based on the observed
-            // bandwidth to this node. We do this once a second, which is also the window for
-            // the bandwidth reported by node->getOutboundBandwidth();
-            if (nodeData->getNumFramesSinceFRDAdjustment() > AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND) {
-
-                const float FRD_ADJUSTMENT_ACCEPTABLE_RATIO = 0.8f;
-                const float HYSTERISIS_GAP = (1 - FRD_ADJUSTMENT_ACCEPTABLE_RATIO);
-                const float HYSTERISIS_MIDDLE_PERCENTAGE =  (1 - (HYSTERISIS_GAP * 0.5f));
-
-                // get the current full rate distance so we can work with it
-                float currentFullRateDistance = nodeData->getFullRateDistance();
-
-                if (avatarDataRateLastSecond > _maxKbpsPerNode) {
-
-                    // is the FRD greater than the farthest avatar?
-                    // if so, before we calculate anything, set it to that distance
-                    currentFullRateDistance = std::min(currentFullRateDistance, nodeData->getMaxAvatarDistance());
-
-                    // we're adjusting the full rate distance to target a bandwidth in the middle
-                    // of the hysterisis gap
-                    currentFullRateDistance *= (_maxKbpsPerNode * HYSTERISIS_MIDDLE_PERCENTAGE) / avatarDataRateLastSecond;
-
-                    nodeData->setFullRateDistance(currentFullRateDistance);
-                    nodeData->resetNumFramesSinceFRDAdjustment();
-                } else if (currentFullRateDistance < nodeData->getMaxAvatarDistance()
-                           && avatarDataRateLastSecond < _maxKbpsPerNode * FRD_ADJUSTMENT_ACCEPTABLE_RATIO) {
-                    // we are constrained AND we've recovered to below the acceptable ratio
-                    // lets adjust the full rate distance to target a bandwidth in the middle of the hyterisis gap
-                    currentFullRateDistance *= (_maxKbpsPerNode * HYSTERISIS_MIDDLE_PERCENTAGE) / avatarDataRateLastSecond;
-
-                    nodeData->setFullRateDistance(currentFullRateDistance);
-                    nodeData->resetNumFramesSinceFRDAdjustment();
-                }
-            } else {
-                nodeData->incrementNumFramesSinceFRDAdjustment();
-            }
-
-            // setup a PacketList for the avatarPackets
-            auto avatarPacketList = NLPacketList::create(PacketType::BulkAvatarData);
-
-            if (nodeData->getAvatarSessionDisplayNameMustChange()) {
-                const QString& existingBaseDisplayName = nodeData->getBaseDisplayName();
-                if (--_sessionDisplayNames[existingBaseDisplayName].second <= 0) {
-                    _sessionDisplayNames.remove(existingBaseDisplayName);
-                }
+        // session display names are unique across the domain, so they are handed out here rather than on the slaves
+        std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
+            manageDisplayName(node);
+        });
 
-                QString baseName = avatar.getDisplayName().trimmed();
-                const QRegularExpression curses{ "fuck|shit|damn|cock|cunt" }; // POC. We may eventually want something much more elaborate (subscription?).
-                baseName = baseName.replace(curses, "*"); // Replace rather than remove, so that people have a clue that the person's a jerk.
-                const QRegularExpression trailingDigits{ "\\s*_\\d+$" }; // whitespace "_123"
-                baseName = baseName.remove(trailingDigits);
-                if (baseName.isEmpty()) {
-                    baseName = "anonymous";
-                }
+        // encode and send the other avatars to each listener across slave threads
+        _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode);
 
-                QPair<int, int>& soFar = _sessionDisplayNames[baseName]; // Inserts and answers 0, 0 if not already present, which is what we want.
-                int& highWater = soFar.first;
-                nodeData->setBaseDisplayName(baseName);
-                QString sessionDisplayName = (highWater > 0) ? baseName + "_" + QString::number(highWater) : baseName;
-                avatar.setSessionDisplayName(sessionDisplayName);
-                highWater++;
-                soFar.second++; // refcount
-                nodeData->flagIdentityChange();
-                nodeData->setAvatarSessionDisplayNameMustChange(false);
-                sendIdentityPacket(nodeData, node); // Tell node whose name changed about its new session display name. Others will find out below.
-                qDebug() << "Giving session display name" << sessionDisplayName << "to node with ID" << node->getUUID();
+        // We're done encoding this version of the otherAvatars.  Update their "lastSent" joint-states so
+        // that we can notice differences, next time around.
+        //
+        // FIXME - this seems suspicious, the code seems to consider all avatars, but not all avatars will
+        // have had their joints sent, so actually we should consider the time since they actually were sent????
+        std::for_each(cbegin, cend, [&](const SharedNodePointer& otherNode) {
+            if (!otherNode->getLinkedData() || otherNode->getType() != NodeType::Agent || !otherNode->getActiveSocket()) {
+                return;
             }
 
-            // this is an AGENT we have received head data from
-            // send back a packet with other active node data to this node
-            nodeList->eachMatchingNode(
-                [&](const SharedNodePointer& otherNode)->bool {
-                    // make sure we have data for this avatar, that it isn't the same node,
-                    // and isn't an avatar that the viewing node has ignored
-                    // or that has ignored the viewing node
-                    if (!otherNode->getLinkedData()
-                        || otherNode->getUUID() == node->getUUID()
-                        || (node->isIgnoringNodeWithID(otherNode->getUUID()) && !getsIgnoredByMe)
-                        || (otherNode->isIgnoringNodeWithID(node->getUUID()) && !getsAnyIgnored)) {
-                        return false;
-                    } else {
-                        AvatarMixerClientData* otherData = reinterpret_cast<AvatarMixerClientData*>(otherNode->getLinkedData());
-                        AvatarMixerClientData* nodeData = reinterpret_cast<AvatarMixerClientData*>(node->getLinkedData());
-                        // Check to see if the space bubble is enabled
-                        if (node->isIgnoreRadiusEnabled() || otherNode->isIgnoreRadiusEnabled()) {
-                            // Define the minimum bubble size
-                            static const glm::vec3 minBubbleSize = glm::vec3(0.3f, 1.3f, 0.3f);
-                            // Define the scale of the box for the current node
-                            glm::vec3 nodeBoxScale = (nodeData->getPosition() - nodeData->getGlobalBoundingBoxCorner()) * 2.0f;
-                            // Define the scale of the box for the current other node
-                            glm::vec3 otherNodeBoxScale = (otherData->getPosition() - otherData->getGlobalBoundingBoxCorner()) * 2.0f;
-
-                            // Set up the bounding box for the current node
-                            AABox nodeBox(nodeData->getGlobalBoundingBoxCorner(), nodeBoxScale);
-                            // Clamp the size of the bounding box to a minimum scale
-                            if (glm::any(glm::lessThan(nodeBoxScale, minBubbleSize))) {
-                                nodeBox.setScaleStayCentered(minBubbleSize);
-                            }
-                            // Set up the bounding box for the current other node
-                            AABox otherNodeBox(otherData->getGlobalBoundingBoxCorner(), otherNodeBoxScale);
-                            // Clamp the size of the bounding box to a minimum scale
-                            if (glm::any(glm::lessThan(otherNodeBoxScale, minBubbleSize))) {
-                                otherNodeBox.setScaleStayCentered(minBubbleSize);
-                            }
-                            // Quadruple the scale of both bounding boxes
-                            nodeBox.embiggen(4.0f);
-                            otherNodeBox.embiggen(4.0f);
-
-                            // Perform the collision check between the two bounding boxes
-                            if (nodeBox.touches(otherNodeBox)) {
-                                nodeData->ignoreOther(node, otherNode);
-                                return getsAnyIgnored;
-                            }
-                        }
-                        // Not close enough to ignore
-                        nodeData->removeFromRadiusIgnoringSet(node, otherNode->getUUID());
-                        return true;
-                    }
-                },
-                [&](const SharedNodePointer& otherNode) {
-                    ++numOtherAvatars;
-
-                    AvatarMixerClientData* otherNodeData = reinterpret_cast<AvatarMixerClientData*>(otherNode->getLinkedData());
-                    MutexTryLocker lock(otherNodeData->getMutex());
-                    if (!lock.isLocked()) {
-                        return;
-                    }
-
-                    // make sure we send out identity packets to and from new arrivals.
-                    bool forceSend = !otherNodeData->checkAndSetHasReceivedFirstPacketsFrom(node->getUUID());
-
-                    if (otherNodeData->getIdentityChangeTimestamp().time_since_epoch().count() > 0
-                        && (forceSend
-                            || otherNodeData->getIdentityChangeTimestamp() > _lastFrameTimestamp
-                            || distribution(generator) < IDENTITY_SEND_PROBABILITY)) {
-                        sendIdentityPacket(otherNodeData, node);
-                    }
-
-                    AvatarData& otherAvatar = otherNodeData->getAvatar();
-                    //  Decide whether to send this avatar's data based on it's distance from us
-
-                    //  The full rate distance is the distance at which EVERY update will be sent for this avatar
-                    //  at twice the full rate distance, there will be a 50% chance of sending this avatar's update
-                    glm::vec3 otherPosition = otherAvatar.getClientGlobalPosition();
-                    float distanceToAvatar = glm::length(myPosition - otherPosition);
-
-                    // potentially update the max full rate distance for this frame
-                    maxAvatarDistanceThisFrame = std::max(maxAvatarDistanceThisFrame, distanceToAvatar);
-
-                    if (distanceToAvatar != 0.0f
-                        && !getsOutOfView
-                        && distribution(generator) > (nodeData->getFullRateDistance() / distanceToAvatar)) {
-                        return;
-                    }
-
-                    AvatarDataSequenceNumber lastSeqToReceiver = nodeData->getLastBroadcastSequenceNumber(otherNode->getUUID());
-                    AvatarDataSequenceNumber lastSeqFromSender = otherNodeData->getLastReceivedSequenceNumber();
-
-                    if (lastSeqToReceiver > lastSeqFromSender && lastSeqToReceiver != UINT16_MAX) {
-                        // we got out out of order packets from the sender, track it
-                        otherNodeData->incrementNumOutOfOrderSends();
-                    }
-
-                    // make sure we haven't already sent this data from this sender to this receiver
-                    // or that somehow we haven't sent
-                    if (lastSeqToReceiver == lastSeqFromSender && lastSeqToReceiver != 0) {
-                        ++numAvatarsHeldBack;
-                        return;
-                    } else if (lastSeqFromSender - lastSeqToReceiver > 1) {
-                        // this is a skip - we still send the packet but capture the presence of the skip so we see it happening
-                        ++numAvatarsWithSkippedFrames;
-                    }
-
-                    // we're going to send this avatar
-
-                    // increment the number of avatars sent to this reciever
-                    nodeData->incrementNumAvatarsSentLastFrame();
-
-                    // set the last sent sequence number for this sender on the receiver
-                    nodeData->setLastBroadcastSequenceNumber(otherNode->getUUID(),
-                                                             otherNodeData->getLastReceivedSequenceNumber());
-
-                    // determine if avatar is in view, to determine how much data to include...
-                    glm::vec3 otherNodeBoxScale = (otherPosition - otherNodeData->getGlobalBoundingBoxCorner()) * 2.0f;
-                    AABox otherNodeBox(otherNodeData->getGlobalBoundingBoxCorner(), otherNodeBoxScale);
-                    bool isInView = nodeData->otherAvatarInView(otherNodeBox);
-
-                    // this throttles the extra data to only be sent every Nth message
-                    if (!isInView && getsOutOfView && (lastSeqToReceiver % EXTRA_AVATAR_DATA_FRAME_RATIO > 0)) {
-                        return;
-                    }
-
-                    // start a new segment in the PacketList for this avatar
-                    avatarPacketList->startSegment();
-
-                    AvatarData::AvatarDataDetail detail;
-                    if (!isInView && !getsOutOfView) {
-                        detail = AvatarData::MinimumData;
-                        nodeData->incrementAvatarOutOfView();
-                    } else {
-                        detail = distribution(generator) < AVATAR_SEND_FULL_UPDATE_RATIO
-                                        ? AvatarData::SendAllData : AvatarData::CullSmallData;
-                        nodeData->incrementAvatarInView();
-                    }
-
-                    numAvatarDataBytes += avatarPacketList->write(otherNode->getUUID().toRfc4122());
-                    auto lastEncodeForOther = nodeData->getLastOtherAvatarEncodeTime(otherNode->getUUID());
-                    QVector<JointData>& lastSentJointsForOther = nodeData->getLastOtherAvatarSentJoints(otherNode->getUUID());
-                    bool distanceAdjust = true;
-                    glm::vec3 viewerPosition = myPosition;
-                    auto bytes = otherAvatar.toByteArray(detail, lastEncodeForOther, lastSentJointsForOther, distanceAdjust, viewerPosition, &lastSentJointsForOther);
-                    numAvatarDataBytes += avatarPacketList->write(bytes);
-
-                    avatarPacketList->endSegment();
-            });
-
-            // close the current packet so that we're always sending something
-            avatarPacketList->closeCurrentPacket(true);
-
-            // send the avatar data PacketList
-            nodeList->sendPacketList(std::move(avatarPacketList), *node);
-
-            // record the bytes sent for other avatar data in the AvatarMixerClientData
-            nodeData->recordSentAvatarData(numAvatarDataBytes);
-
-            // record the number of avatars held back this frame
-            nodeData->recordNumOtherAvatarStarves(numAvatarsHeldBack);
-            nodeData->recordNumOtherAvatarSkips(numAvatarsWithSkippedFrames);
-
-            if (numOtherAvatars == 0) {
-                // update the full rate distance to FLOAT_MAX since we didn't have any other avatars to send
-                nodeData->setMaxAvatarDistance(FLT_MAX);
-            } else {
-                nodeData->setMaxAvatarDistance(maxAvatarDistanceThisFrame);
-            }
-        }
-    );
-
-    // We're done encoding this version of the otherAvatars.  Update their "lastSent" joint-states so
-    // that we can notice differences, next time around.
-    //
-    // FIXME - this seems suspicious, the code seems to consider all avatars, but not all avatars will
-    // have had their joints sent, so actually we should consider the time since they actually were sent????
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& otherNode)->bool {
-            if (!otherNode->getLinkedData()) {
-                return false;
-            }
-            if (otherNode->getType() != NodeType::Agent) {
-                return false;
-            }
-            if (!otherNode->getActiveSocket()) {
-                return false;
-            }
-            return true;
-        },
-        [&](const SharedNodePointer& otherNode) {
             AvatarMixerClientData* otherNodeData = reinterpret_cast<AvatarMixerClientData*>(otherNode->getLinkedData());
-            MutexTryLocker lock(otherNodeData->getMutex());
-            if (!lock.isLocked()) {
-                return;
-            }
             AvatarData& otherAvatar = otherNodeData->getAvatar();
             otherAvatar.doneEncoding(false);
         });
+    });
+
+    // gather the per-slave stats for this frame
+    {
+        std::lock_guard<std::mutex> lock(_statsMutex);
+
+        _slaveStats.resize(_slavePool.numThreads());
+        auto slaveStats = _slaveStats.begin();
+        _slavePool.each([&](AvatarMixerSlave& slave) {
+            _broadcastStats.accumulate(slave.stats);
+            if (slaveStats != _slaveStats.end()) {
+                slaveStats->accumulate(slave.stats);
+                ++slaveStats;
+            }
+            slave.stats.reset();
+        });
+
+        ++_numStatFrames;
+    }
 
     _lastFrameTimestamp = p_high_resolution_clock::now();
 
@@ -503,6 +206,45 @@ void AvatarMixer::broadcastAvatarData() {
 
 }
 
+void AvatarMixer::manageDisplayName(const SharedNodePointer& node) {
+    if (!node->getLinkedData() || node->getType() != NodeType::Agent || !node->getActiveSocket()) {
+        return;
+    }
+
+    AvatarMixerClientData* nodeData = reinterpret_cast<AvatarMixerClientData*>(node->getLinkedData());
+    MutexTryLocker lock(nodeData->getMutex());
+    if (!lock.isLocked() || !nodeData->getAvatarSessionDisplayNameMustChange()) {
+        return;
+    }
+
+    AvatarData& avatar = nodeData->getAvatar();
+    const QString& existingBaseDisplayName = nodeData->getBaseDisplayName();
+    if (--_sessionDisplayNames[existingBaseDisplayName].second <= 0) {
+        _sessionDisplayNames.remove(existingBaseDisplayName);
+    }
+
+    QString baseName = avatar.getDisplayName().trimmed();
+    const QRegularExpression curses{ "fuck|shit|damn|cock|cunt" }; // POC. We may eventually want something much more elaborate (subscription?).
+    baseName = baseName.replace(curses, "*"); // Replace rather than remove, so that people have a clue that the person's a jerk.
+    const QRegularExpression trailingDigits{ "\\s*_\\d+$" }; // whitespace "_123"
+    baseName = baseName.remove(trailingDigits);
+    if (baseName.isEmpty()) {
+        baseName = "anonymous";
+    }
+
+    QPair<int, int>& soFar = _sessionDisplayNames[baseName]; // Inserts and answers 0, 0 if not already present, which is what we want.
+    int& highWater = soFar.first;
+    nodeData->setBaseDisplayName(baseName);
+    QString sessionDisplayName = (highWater > 0) ? baseName + "_" + QString::number(highWater) : baseName;
+    avatar.setSessionDisplayName(sessionDisplayName);
+    highWater++;
+    soFar.second++; // refcount
+    nodeData->flagIdentityChange();
+    nodeData->setAvatarSessionDisplayNameMustChange(false);
+    sendIdentityPacket(nodeData, node); // Tell node whose name changed about its new session display name. Others will find out below.
+    qDebug() << "Giving session display name" << sessionDisplayName << "to node with ID" << node->getUUID();
+}
+
 void AvatarMixer::nodeKilled(SharedNodePointer killedNode) {
     if (killedNode->getType() == NodeType::Agent
         && killedNode->getLinkedData()) {
@@ -578,7 +320,13 @@ void AvatarMixer::handleRequestsDomainListDataPacket(QSharedPointer<ReceivedMess
 
 void AvatarMixer::handleAvatarDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto nodeList = DependencyManager::get<NodeList>();
-    nodeList->updateNodeWithDataFromPacket(message, senderNode);
+    nodeList->getOrCreateLinkedData(senderNode);
+
+    // the packet is parsed by the slave pool at the start of the next broadcast frame
+    AvatarMixerClientData* nodeData = dynamic_cast<AvatarMixerClientData*>(senderNode->getLinkedData());
+    if (nodeData != nullptr) {
+        nodeData->queuePacket(message, senderNode);
+    }
 }
 
 void AvatarMixer::handleAvatarIdentityPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -619,16 +367,60 @@ void AvatarMixer::handleRadiusIgnoreRequestPacket(QSharedPointer<ReceivedMessage
     sendingNode->parseIgnoreRadiusRequestMessage(packet);
 }
 
+static QJsonObject slaveStatsObject(const AvatarMixerSlaveStats& stats, float numStatFrames) {
+    QJsonObject slaveObject;
+    slaveObject["nodes_processed"] = stats.nodesProcessed;
+    slaveObject["packets_processed"] = stats.packetsProcessed;
+    slaveObject["nodes_broadcasted_to"] = stats.nodesBroadcastedTo;
+    slaveObject["others_included"] = stats.numOthersIncluded;
+    slaveObject["identity_packets"] = stats.numIdentityPackets;
+    slaveObject["packets_sent"] = stats.numPacketsSent;
+    slaveObject["bytes_sent"] = stats.numBytesSent;
+    slaveObject["avg_process_incoming_packets_us_per_frame"] =
+        (float) stats.processIncomingPacketsElapsedTime / numStatFrames;
+    slaveObject["avg_broadcast_avatar_data_us_per_frame"] =
+        (float) stats.broadcastAvatarDataElapsedTime / numStatFrames;
+    return slaveObject;
+}
+
 void AvatarMixer::sendStatsPacket() {
+    AvatarMixerSlaveStats broadcastStats;
+    std::vector<AvatarMixerSlaveStats> slaveStats;
+    int numStatFrames;
+    int sumIdentityPackets;
+    {
+        std::lock_guard<std::mutex> lock(_statsMutex);
+        broadcastStats = _broadcastStats;
+        slaveStats.swap(_slaveStats);
+        numStatFrames = _numStatFrames;
+        sumIdentityPackets = _sumIdentityPackets + _broadcastStats.numIdentityPackets;
+
+        _broadcastStats.reset();
+        _numStatFrames = 0;
+        _sumIdentityPackets = 0;
+    }
+    float statFrames = (float) std::max(numStatFrames, 1);
+
     QJsonObject statsObject;
-    statsObject["average_listeners_last_second"] = (float) _sumListeners / (float) _numStatFrames;
+    statsObject["average_listeners_last_second"] = (float) broadcastStats.nodesBroadcastedTo / statFrames;
 
-    statsObject["average_identity_packets_per_frame"] = (float) _sumIdentityPackets / (float) _numStatFrames;
+    statsObject["average_identity_packets_per_frame"] = (float) sumIdentityPackets / statFrames;
 
     statsObject["trailing_sleep_percentage"] = _trailingSleepRatio * 100;
     statsObject["performance_throttling_ratio"] = _performanceThrottlingRatio;
     statsObject["broadcast_loop_rate"] = _broadcastRate.rate();
 
+    statsObject["threads"] = _slavePool.numThreads();
+
+    QJsonObject slavesObject;
+    int slaveNumber = 1;
+    for (auto& stats : slaveStats) {
+        slavesObject[QString::number(slaveNumber)] = slaveStatsObject(stats, statFrames);
+        ++slaveNumber;
+    }
+    statsObject["slaves"] = slavesObject;
+    statsObject["slaves_aggregate"] = slaveStatsObject(broadcastStats, statFrames);
+
     QJsonObject avatarsObject;
 
     auto nodeList = DependencyManager::get<NodeList>();
@@ -662,10 +454,6 @@ void AvatarMixer::sendStatsPacket() {
 
     statsObject["avatars"] = avatarsObject;
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
-
-    _sumListeners = 0;
-    _sumIdentityPackets = 0;
-    _numStatFrames = 0;
 }
 
 void AvatarMixer::run() {
@@ -738,6 +526,18 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
     _maxKbpsPerNode = nodeBandwidthValue.toDouble(DEFAULT_NODE_SEND_BANDWIDTH) * KILO_PER_MEGA;
     qDebug() << "The maximum send bandwidth per node is" << _maxKbpsPerNode << "kbps.";
 
+    const QString AUTO_THREADS = "auto_threads";
+    bool autoThreads = domainSettings[AVATAR_MIXER_SETTINGS_KEY].toObject()[AUTO_THREADS].toBool();
+    if (!autoThreads) {
+        bool ok;
+        const QString NUM_THREADS = "num_threads";
+        int numThreads = domainSettings[AVATAR_MIXER_SETTINGS_KEY].toObject()[NUM_THREADS].toString().toInt(&ok);
+        if (ok) {
+            _slavePool.setNumThreads(numThreads);
+        }
+    }
+    qDebug() << "Avatar mixer will use" << _slavePool.numThreads() << "threads.";
+
     const QString AVATARS_SETTINGS_KEY = "avatars";
 
     static const QString MIN_SCALE_OPTION = "min_avatar_scale";
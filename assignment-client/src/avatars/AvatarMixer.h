@@ -15,12 +15,17 @@
 #ifndef hifi_AvatarMixer_h
 #define hifi_AvatarMixer_h
 
+#include <mutex>
+#include <vector>
+
 #include <shared/RateCounter.h>
 #include <PortableHighResolutionClock.h>
 
 #include <ThreadedAssignment.h>
 #include "AvatarMixerClientData.h"
 
+#include "AvatarMixerSlavePool.h"
+
 /// Handles assignments of type AvatarMixer - distribution of avatar data to various clients
 class AvatarMixer : public ThreadedAssignment {
     Q_OBJECT
@@ -49,6 +54,7 @@ private slots:
 
 private:
     void broadcastAvatarData();
+    void manageDisplayName(const SharedNodePointer& node);
     void parseDomainServerSettings(const QJsonObject& domainSettings);
     void sendIdentityPacket(AvatarMixerClientData* nodeData, const SharedNodePointer& destinationNode);
 
@@ -59,9 +65,8 @@ private:
     float _trailingSleepRatio { 1.0f };
     float _performanceThrottlingRatio { 0.0f };
 
-    int _sumListeners { 0 };
-    int _numStatFrames { 0 };
-    int _sumIdentityPackets { 0 };
+    int _numStatFrames { 0 }; // guarded by _statsMutex
+    int _sumIdentityPackets { 0 }; // guarded by _statsMutex
 
     float _maxKbpsPerNode = 0.0f;
 
@@ -73,6 +78,13 @@ private:
     RateCounter<> _broadcastRate;
     p_high_resolution_clock::time_point _lastDebugMessage;
     QHash<QString, QPair<int, int>> _sessionDisplayNames;
+
+    AvatarMixerSlavePool _slavePool;
+
+    // stats are gathered from the slaves on the broadcast thread and read on the main thread in sendStatsPacket
+    std::mutex _statsMutex;
+    AvatarMixerSlaveStats _broadcastStats; // guarded by _statsMutex
+    std::vector<AvatarMixerSlaveStats> _slaveStats; // guarded by _statsMutex
 };
 
 #endif // hifi_AvatarMixer_h
@@ -9,6 +9,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <assert.h>
+
 #include <udt/PacketHeaders.h>
 
 #include <DependencyManager.h>
@@ -16,6 +18,47 @@
 
 #include "AvatarMixerClientData.h"
 
+void AvatarMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
+    std::lock_guard<std::mutex> lock(_packetQueueMutex);
+    if (!_packetQueue.node) {
+        _packetQueue.node = node;
+    }
+    _packetQueue.push(message);
+}
+
+int AvatarMixerClientData::processPackets() {
+    // take the queued packets so that the main thread can keep queueing while we parse
+    PacketQueue packets;
+    {
+        std::lock_guard<std::mutex> lock(_packetQueueMutex);
+        std::swap(packets, _packetQueue);
+    }
+
+    int packetsProcessed = 0;
+    SharedNodePointer node = packets.node;
+    assert(packets.empty() || node);
+
+    while (!packets.empty()) {
+        auto& packet = packets.front();
+
+        switch (packet->getType()) {
+            case PacketType::AvatarData: {
+                QMutexLocker lock(&getMutex());
+                parseData(*packet);
+                break;
+            }
+            default:
+                Q_UNREACHABLE();
+        }
+
+        ++packetsProcessed;
+        packets.pop();
+    }
+    assert(packets.empty());
+
+    return packetsProcessed;
+}
+
 int AvatarMixerClientData::parseData(ReceivedMessage& message) {
     // pull the sequence number from the data first
     message.readPrimitive(&_lastReceivedSequenceNumber);
@@ -81,7 +124,7 @@ void AvatarMixerClientData::loadJSONStats(QJsonObject& jsonObject) const {
     jsonObject["num_avs_sent_last_frame"] = _numAvatarsSentLastFrame;
     jsonObject["avg_other_av_starves_per_second"] = getAvgNumOtherAvatarStarvesPerSecond();
     jsonObject["avg_other_av_skips_per_second"] = getAvgNumOtherAvatarSkipsPerSecond();
-    jsonObject["total_num_out_of_order_sends"] = _numOutOfOrderSends;
+    jsonObject["total_num_out_of_order_sends"] = _numOutOfOrderSends.load();
 
     jsonObject[OUTBOUND_AVATAR_DATA_STATS_KEY] = getOutboundAvatarDataKbps();
     jsonObject[INBOUND_AVATAR_DATA_STATS_KEY] = _avatar->getAverageBytesReceivedPerSecond() / (float) BYTES_PER_KILOBIT;
@@ -13,7 +13,10 @@
 #define hifi_AvatarMixerClientData_h
 
 #include <algorithm>
+#include <atomic>
 #include <cfloat>
+#include <mutex>
+#include <queue>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -21,6 +24,7 @@
 #include <QtCore/QUrl>
 
 #include <AvatarData.h>
+#include <Node.h>
 #include <NodeData.h>
 #include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
@@ -118,9 +122,17 @@ public:
         return _lastOtherAvatarSentJoints[otherAvatar];
     }
 
-    
+    // packets are queued from the main thread and parsed by the mixer's slave threads
+    void queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
+    int processPackets(); // returns number of packets processed
 
 private:
+    struct PacketQueue : public std::queue<QSharedPointer<ReceivedMessage>> {
+        QWeakPointer<Node> node;
+    };
+    std::mutex _packetQueueMutex;
+    PacketQueue _packetQueue;
+
     AvatarSharedPointer _avatar { new AvatarData() };
 
     uint16_t _lastReceivedSequenceNumber { 0 };
@@ -143,7 +155,7 @@ private:
 
     SimpleMovingAverage _otherAvatarStarves;
     SimpleMovingAverage _otherAvatarSkips;
-    int _numOutOfOrderSends = 0;
+    std::atomic<int> _numOutOfOrderSends { 0 }; // incremented by any slave that is broadcasting this avatar
 
     SimpleMovingAverage _avgOtherAvatarDataRate;
     std::unordered_set<QUuid> _radiusIgnoredOthers;
@@ -0,0 +1,369 @@
+//
+//  AvatarMixerSlave.cpp
+//  assignment-client/src/avatars
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+#include <cfloat>
+
+#include <AABox.h>
+#include <NodeList.h>
+#include <udt/PacketHeaders.h>
+#include <SharedUtil.h>
+#include <TryLocker.h>
+
+#include "AvatarMixerClientData.h"
+#include "AvatarMixerSlave.h"
+
+// An 80% chance of sending a identity packet within a 5 second interval.
+// assuming 60 htz update rate.
+const float IDENTITY_SEND_PROBABILITY = 1.0f / 187.0f;
+
+// only send extra avatar data (avatars out of view, ignored) every Nth AvatarData frame
+// Extra avatar data will be sent (AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND/EXTRA_AVATAR_DATA_FRAME_RATIO) times
+// per second.
+// This value should be a power of two for performance purposes, as the mixer performs a modulo operation every frame
+// to determine whether the extra data should be sent.
+const int EXTRA_AVATAR_DATA_FRAME_RATIO = 16;
+
+void AvatarMixerSlaveStats::reset() {
+    nodesProcessed = 0;
+    packetsProcessed = 0;
+    processIncomingPacketsElapsedTime = 0;
+    nodesBroadcastedTo = 0;
+    numOthersIncluded = 0;
+    numIdentityPackets = 0;
+    numPacketsSent = 0;
+    numBytesSent = 0;
+    broadcastAvatarDataElapsedTime = 0;
+}
+
+void AvatarMixerSlaveStats::accumulate(const AvatarMixerSlaveStats& otherStats) {
+    nodesProcessed += otherStats.nodesProcessed;
+    packetsProcessed += otherStats.packetsProcessed;
+    processIncomingPacketsElapsedTime += otherStats.processIncomingPacketsElapsedTime;
+    nodesBroadcastedTo += otherStats.nodesBroadcastedTo;
+    numOthersIncluded += otherStats.numOthersIncluded;
+    numIdentityPackets += otherStats.numIdentityPackets;
+    numPacketsSent += otherStats.numPacketsSent;
+    numBytesSent += otherStats.numBytesSent;
+    broadcastAvatarDataElapsedTime += otherStats.broadcastAvatarDataElapsedTime;
+}
+
+void AvatarMixerSlave::configure(ConstIter begin, ConstIter end) {
+    _begin = begin;
+    _end = end;
+}
+
+void AvatarMixerSlave::configureBroadcast(ConstIter begin, ConstIter end,
+        p_high_resolution_clock::time_point lastFrameTimestamp, float maxKbpsPerNode) {
+    _begin = begin;
+    _end = end;
+    _lastFrameTimestamp = lastFrameTimestamp;
+    _maxKbpsPerNode = maxKbpsPerNode;
+}
+
+void AvatarMixerSlave::processIncomingPackets(const SharedNodePointer& node) {
+    auto start = usecTimestampNow();
+    auto nodeData = dynamic_cast<AvatarMixerClientData*>(node->getLinkedData());
+    if (nodeData) {
+        stats.nodesProcessed++;
+        stats.packetsProcessed += nodeData->processPackets();
+    }
+    auto end = usecTimestampNow();
+    stats.processIncomingPacketsElapsedTime += (end - start);
+}
+
+void AvatarMixerSlave::sendIdentityPacket(AvatarMixerClientData* nodeData, const SharedNodePointer& destinationNode) {
+    QByteArray individualData = nodeData->getAvatar().identityByteArray();
+
+    auto identityPacket = NLPacket::create(PacketType::AvatarIdentity, individualData.size());
+
+    individualData.replace(0, NUM_BYTES_RFC4122_UUID, nodeData->getNodeID().toRfc4122());
+
+    identityPacket->write(individualData);
+
+    DependencyManager::get<NodeList>()->sendPacket(std::move(identityPacket), *destinationNode);
+
+    ++stats.numIdentityPackets;
+}
+
+void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
+    if (!node->getLinkedData() || node->getType() != NodeType::Agent || !node->getActiveSocket()) {
+        return;
+    }
+
+    auto start = usecTimestampNow();
+
+    AvatarMixerClientData* nodeData = reinterpret_cast<AvatarMixerClientData*>(node->getLinkedData());
+    MutexTryLocker lock(nodeData->getMutex());
+    if (!lock.isLocked()) {
+        return;
+    }
+    ++stats.nodesBroadcastedTo;
+    nodeData->resetInViewStats();
+
+    AvatarData& avatar = nodeData->getAvatar();
+    glm::vec3 myPosition = avatar.getClientGlobalPosition();
+
+    // reset the internal state for correct random number distribution
+    _distribution.reset();
+
+    // reset the max distance for this frame
+    float maxAvatarDistanceThisFrame = 0.0f;
+
+    // reset the number of sent avatars
+    nodeData->resetNumAvatarsSentLastFrame();
+
+    // keep a counter of the number of considered avatars
+    int numOtherAvatars = 0;
+
+    // keep track of outbound data rate specifically for avatar data
+    int numAvatarDataBytes = 0;
+
+    // keep track of the number of other avatars held back in this frame
+    int numAvatarsHeldBack = 0;
+
+    // keep track of the number of other avatar frames skipped
+    int numAvatarsWithSkippedFrames = 0;
+
+    // use the data rate specifically for avatar data for FRD adjustment checks
+    float avatarDataRateLastSecond = nodeData->getOutboundAvatarDataKbps();
+
+    // When this is true, the AvatarMixer will send Avatar data to a client about avatars that are not in the view frustrum
+    bool getsOutOfView = nodeData->getRequestsDomainListData();
+
+    // When this is true, the AvatarMixer will send Avatar data to a client about avatars that they've ignored
+    bool getsIgnoredByMe = getsOutOfView;
+
+    // When this is true, the AvatarMixer will send Avatar data to a client about avatars that have ignored them
+    bool getsAnyIgnored = getsIgnoredByMe && node->getCanKick();
+
+    // Check if it is time to adjust what we send this client based on the observed
+    // bandwidth to this node. We do this once a second, which is also the window for
+    // the bandwidth reported by node->getOutboundBandwidth();
+    if (nodeData->getNumFramesSinceFRDAdjustment() > AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND) {
+
+        const float FRD_ADJUSTMENT_ACCEPTABLE_RATIO = 0.8f;
+        const float HYSTERISIS_GAP = (1 - FRD_ADJUSTMENT_ACCEPTABLE_RATIO);
+        const float HYSTERISIS_MIDDLE_PERCENTAGE =  (1 - (HYSTERISIS_GAP * 0.5f));
+
+        // get the current full rate distance so we can work with it
+        float currentFullRateDistance = nodeData->getFullRateDistance();
+
+        if (avatarDataRateLastSecond > _maxKbpsPerNode) {
+
+            // is the FRD greater than the farthest avatar?
+            // if so, before we calculate anything, set it to that distance
+            currentFullRateDistance = std::min(currentFullRateDistance, nodeData->getMaxAvatarDistance());
+
+            // we're adjusting the full rate distance to target a bandwidth in the middle
+            // of the hysterisis gap
+            currentFullRateDistance *= (_maxKbpsPerNode * HYSTERISIS_MIDDLE_PERCENTAGE) / avatarDataRateLastSecond;
+
+            nodeData->setFullRateDistance(currentFullRateDistance);
+            nodeData->resetNumFramesSinceFRDAdjustment();
+        } else if (currentFullRateDistance < nodeData->getMaxAvatarDistance()
+                   && avatarDataRateLastSecond < _maxKbpsPerNode * FRD_ADJUSTMENT_ACCEPTABLE_RATIO) {
+            // we are constrained AND we've recovered to below the acceptable ratio
+            // lets adjust the full rate distance to target a bandwidth in the middle of the hyterisis gap
+            currentFullRateDistance *= (_maxKbpsPerNode * HYSTERISIS_MIDDLE_PERCENTAGE) / avatarDataRateLastSecond;
+
+            nodeData->setFullRateDistance(currentFullRateDistance);
+            nodeData->resetNumFramesSinceFRDAdjustment();
+        }
+    } else {
+        nodeData->incrementNumFramesSinceFRDAdjustment();
+    }
+
+    // setup a PacketList for the avatarPackets
+    auto avatarPacketList = NLPacketList::create(PacketType::BulkAvatarData);
+
+    // this is an AGENT we have received head data from
+    // send back a packet with other active node data to this node
+    std::for_each(_begin, _end, [&](const SharedNodePointer& otherNode) {
+        // make sure we have data for this avatar, that it isn't the same node,
+        // and isn't an avatar that the viewing node has ignored
+        // or that has ignored the viewing node
+        if (!otherNode->getLinkedData()
+            || otherNode->getUUID() == node->getUUID()
+            || (node->isIgnoringNodeWithID(otherNode->getUUID()) && !getsIgnoredByMe)
+            || (otherNode->isIgnoringNodeWithID(node->getUUID()) && !getsAnyIgnored)) {
+            return;
+        }
+
+        AvatarMixerClientData* otherNodeData = reinterpret_cast<AvatarMixerClientData*>(otherNode->getLinkedData());
+
+        // Check to see if the space bubble is enabled
+        bool inBubble = false;
+        if (node->isIgnoreRadiusEnabled() || otherNode->isIgnoreRadiusEnabled()) {
+            // Define the minimum bubble size
+            static const glm::vec3 minBubbleSize = glm::vec3(0.3f, 1.3f, 0.3f);
+            // Define the scale of the box for the current node
+            glm::vec3 nodeBoxScale = (nodeData->getPosition() - nodeData->getGlobalBoundingBoxCorner()) * 2.0f;
+            // Define the scale of the box for the current other node
+            glm::vec3 otherNodeBoxScale = (otherNodeData->getPosition() - otherNodeData->getGlobalBoundingBoxCorner()) * 2.0f;
+
+            // Set up the bounding box for the current node
+            AABox nodeBox(nodeData->getGlobalBoundingBoxCorner(), nodeBoxScale);
+            // Clamp the size of the bounding box to a minimum scale
+            if (glm::any(glm::lessThan(nodeBoxScale, minBubbleSize))) {
+                nodeBox.setScaleStayCentered(minBubbleSize);
+            }
+            // Set up the bounding box for the current other node
+            AABox otherNodeBox(otherNodeData->getGlobalBoundingBoxCorner(), otherNodeBoxScale);
+            // Clamp the size of the bounding box to a minimum scale
+            if (glm::any(glm::lessThan(otherNodeBoxScale, minBubbleSize))) {
+                otherNodeBox.setScaleStayCentered(minBubbleSize);
+            }
+            // Quadruple the scale of both bounding boxes
+            nodeBox.embiggen(4.0f);
+            otherNodeBox.embiggen(4.0f);
+
+            // Perform the collision check between the two bounding boxes
+            if (nodeBox.touches(otherNodeBox)) {
+                nodeData->ignoreOther(node, otherNode);
+                inBubble = true;
+            }
+        }
+
+        if (inBubble) {
+            if (!getsAnyIgnored) {
+                return;
+            }
+        } else {
+            // Not close enough to ignore
+            nodeData->removeFromRadiusIgnoringSet(node, otherNode->getUUID());
+        }
+
+        ++numOtherAvatars;
+
+        // the other avatar's identity can change under its lock, and encoding it writes its last sent state,
+        // so it is skipped this frame while its lock is held, by another slave or by the mixer
+        MutexTryLocker otherLock(otherNodeData->getMutex());
+        if (!otherLock.isLocked()) {
+            return;
+        }
+
+        // make sure we send out identity packets to and from new arrivals.
+        // this state is tracked on the receiving node so that slaves never write to the data of other avatars
+        bool forceSend = !nodeData->checkAndSetHasReceivedFirstPacketsFrom(otherNode->getUUID());
+
+        if (otherNodeData->getIdentityChangeTimestamp().time_since_epoch().count() > 0
+            && (forceSend
+                || otherNodeData->getIdentityChangeTimestamp() > _lastFrameTimestamp
+                || _distribution(_generator) < IDENTITY_SEND_PROBABILITY)) {
+            sendIdentityPacket(otherNodeData, node);
+        }
+
+        AvatarData& otherAvatar = otherNodeData->getAvatar();
+        //  Decide whether to send this avatar's data based on it's distance from us
+
+        //  The full rate distance is the distance at which EVERY update will be sent for this avatar
+        //  at twice the full rate distance, there will be a 50% chance of sending this avatar's update
+        glm::vec3 otherPosition = otherAvatar.getClientGlobalPosition();
+        float distanceToAvatar = glm::length(myPosition - otherPosition);
+
+        // potentially update the max full rate distance for this frame
+        maxAvatarDistanceThisFrame = std::max(maxAvatarDistanceThisFrame, distanceToAvatar);
+
+        if (distanceToAvatar != 0.0f
+            && !getsOutOfView
+            && _distribution(_generator) > (nodeData->getFullRateDistance() / distanceToAvatar)) {
+            return;
+        }
+
+        AvatarDataSequenceNumber lastSeqToReceiver = nodeData->getLastBroadcastSequenceNumber(otherNode->getUUID());
+        AvatarDataSequenceNumber lastSeqFromSender = otherNodeData->getLastReceivedSequenceNumber();
+
+        if (lastSeqToReceiver > lastSeqFromSender && lastSeqToReceiver != UINT16_MAX) {
+            // we got out out of order packets from the sender, track it
+            otherNodeData->incrementNumOutOfOrderSends();
+        }
+
+        // make sure we haven't already sent this data from this sender to this receiver
+        // or that somehow we haven't sent
+        if (lastSeqToReceiver == lastSeqFromSender && lastSeqToReceiver != 0) {
+            ++numAvatarsHeldBack;
+            return;
+        } else if (lastSeqFromSender - lastSeqToReceiver > 1) {
+            // this is a skip - we still send the packet but capture the presence of the skip so we see it happening
+            ++numAvatarsWithSkippedFrames;
+        }
+
+        // we're going to send this avatar
+
+        // increment the number of avatars sent to this reciever
+        nodeData->incrementNumAvatarsSentLastFrame();
+
+        // set the last sent sequence number for this sender on the receiver
+        nodeData->setLastBroadcastSequenceNumber(otherNode->getUUID(),
+                                                 otherNodeData->getLastReceivedSequenceNumber());
+
+        // determine if avatar is in view, to determine how much data to include...
+        glm::vec3 otherNodeBoxScale = (otherPosition - otherNodeData->getGlobalBoundingBoxCorner()) * 2.0f;
+        AABox otherNodeBox(otherNodeData->getGlobalBoundingBoxCorner(), otherNodeBoxScale);
+        bool isInView = nodeData->otherAvatarInView(otherNodeBox);
+
+        // this throttles the extra data to only be sent every Nth message
+        if (!isInView && getsOutOfView && (lastSeqToReceiver % EXTRA_AVATAR_DATA_FRAME_RATIO > 0)) {
+            return;
+        }
+
+        // start a new segment in the PacketList for this avatar
+        avatarPacketList->startSegment();
+
+        AvatarData::AvatarDataDetail detail;
+        if (!isInView && !getsOutOfView) {
+            detail = AvatarData::MinimumData;
+            nodeData->incrementAvatarOutOfView();
+        } else {
+            detail = _distribution(_generator) < AVATAR_SEND_FULL_UPDATE_RATIO
+                            ? AvatarData::SendAllData : AvatarData::CullSmallData;
+            nodeData->incrementAvatarInView();
+        }
+
+        numAvatarDataBytes += avatarPacketList->write(otherNode->getUUID().toRfc4122());
+        auto lastEncodeForOther = nodeData->getLastOtherAvatarEncodeTime(otherNode->getUUID());
+        QVector<JointData>& lastSentJointsForOther = nodeData->getLastOtherAvatarSentJoints(otherNode->getUUID());
+        bool distanceAdjust = true;
+        glm::vec3 viewerPosition = myPosition;
+        auto bytes = otherAvatar.toByteArray(detail, lastEncodeForOther, lastSentJointsForOther, distanceAdjust, viewerPosition, &lastSentJointsForOther);
+        numAvatarDataBytes += avatarPacketList->write(bytes);
+
+        avatarPacketList->endSegment();
+
+        ++stats.numOthersIncluded;
+    });
+
+    // close the current packet so that we're always sending something
+    avatarPacketList->closeCurrentPacket(true);
+
+    stats.numPacketsSent += (int)avatarPacketList->getNumPackets();
+    stats.numBytesSent += numAvatarDataBytes;
+
+    // send the avatar data PacketList
+    DependencyManager::get<NodeList>()->sendPacketList(std::move(avatarPacketList), *node);
+
+    // record the bytes sent for other avatar data in the AvatarMixerClientData
+    nodeData->recordSentAvatarData(numAvatarDataBytes);
+
+    // record the number of avatars held back this frame
+    nodeData->recordNumOtherAvatarStarves(numAvatarsHeldBack);
+    nodeData->recordNumOtherAvatarSkips(numAvatarsWithSkippedFrames);
+
+    if (numOtherAvatars == 0) {
+        // update the full rate distance to FLOAT_MAX since we didn't have any other avatars to send
+        nodeData->setMaxAvatarDistance(FLT_MAX);
+    } else {
+        nodeData->setMaxAvatarDistance(maxAvatarDistanceThisFrame);
+    }
+
+    auto end = usecTimestampNow();
+    stats.broadcastAvatarDataElapsedTime += (end - start);
+}
@@ -0,0 +1,73 @@
+//
+//  AvatarMixerSlave.h
+//  assignment-client/src/avatars
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarMixerSlave_h
+#define hifi_AvatarMixerSlave_h
+
+#include <random>
+
+#include <NodeList.h>
+#include <PortableHighResolutionClock.h>
+
+class AvatarMixerClientData;
+
+// FIXME - what we'd actually like to do is send to users at ~50% of their present rate down to 30hz. Assume 90 for now.
+const int AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 45;
+
+struct AvatarMixerSlaveStats {
+    int nodesProcessed { 0 };
+    int packetsProcessed { 0 };
+    quint64 processIncomingPacketsElapsedTime { 0 };
+
+    int nodesBroadcastedTo { 0 };
+    int numOthersIncluded { 0 };
+    int numIdentityPackets { 0 };
+    int numPacketsSent { 0 };
+    int numBytesSent { 0 };
+    quint64 broadcastAvatarDataElapsedTime { 0 };
+
+    void reset();
+    void accumulate(const AvatarMixerSlaveStats& otherStats);
+};
+
+class AvatarMixerSlave {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    // configure a round of packet processing (no state required)
+    void configure(ConstIter begin, ConstIter end);
+
+    // configure a round of broadcasting
+    void configureBroadcast(ConstIter begin, ConstIter end,
+            p_high_resolution_clock::time_point lastFrameTimestamp, float maxKbpsPerNode);
+
+    // parse the avatar data packets queued for a given node
+    void processIncomingPackets(const SharedNodePointer& node);
+
+    // encode and send the data of all other avatars to a given node (requires configuration using configureBroadcast)
+    void broadcastAvatarData(const SharedNodePointer& node);
+
+    AvatarMixerSlaveStats stats;
+
+private:
+    void sendIdentityPacket(AvatarMixerClientData* nodeData, const SharedNodePointer& destinationNode);
+
+    // frame state
+    ConstIter _begin;
+    ConstIter _end;
+    p_high_resolution_clock::time_point _lastFrameTimestamp;
+    float _maxKbpsPerNode { 0.0f };
+
+    // each slave keeps its own generator, so that threads do not contend on shared random state
+    std::mt19937 _generator { std::random_device()() };
+    std::uniform_real_distribution<float> _distribution;
+};
+
+#endif // hifi_AvatarMixerSlave_h
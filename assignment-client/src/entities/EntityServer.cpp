@@ -288,6 +288,11 @@ void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectio
     tree->setWantEditLogging(wantEditLogging);
     tree->setWantTerseEditLogging(wantTerseEditLogging);
 
+    bool wantSnapshots = false;
+    readOptionBool(QString("entitySnapshots"), settingsSectionObject, wantSnapshots);
+    qDebug("entitySnapshots=%s", debug::valueOf(wantSnapshots));
+    tree->setWantSnapshots(wantSnapshots);
+
     QString entityScriptSourceWhitelist;
     if (readOptionString("entityScriptSourceWhitelist", settingsSectionObject, entityScriptSourceWhitelist)) {
         tree->setEntityScriptSourceWhitelist(entityScriptSourceWhitelist);
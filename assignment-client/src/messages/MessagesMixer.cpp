@@ -30,8 +30,15 @@ MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(mess
 }
 
 void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
-    for (auto& channel : _channelSubscribers) {
-        channel.remove(killedNode->getUUID());
+    auto channels = _nodeChannels.take(killedNode->getUUID());
+    for (auto& channel : channels) {
+        auto it = _channelSubscribers.find(channel);
+        if (it != _channelSubscribers.end()) {
+            it->remove(killedNode->getUUID());
+            if (it->isEmpty()) {
+                _channelSubscribers.erase(it);
+            }
+        }
     }
 }
 
@@ -42,28 +49,41 @@ void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessa
     bool isText;
     MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
 
-    auto nodeList = DependencyManager::get<NodeList>();
+    auto it = _channelSubscribers.constFind(channel);
+    if (it == _channelSubscribers.constEnd()) {
+        return;
+    }
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
-        nodeList->sendPacketList(std::move(packetList), *node);
-    });
+    // encode the message once, each subscriber's packet list only copies the payload
+    QByteArray payload = MessagesClient::encodeMessagesPayload(channel, isText, isText ? message.toUtf8() : data, senderID);
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    for (auto& subscriber : *it) {
+        SharedNodePointer node = subscriber.toStrongRef();
+        if (node && node->getActiveSocket()) {
+            nodeList->sendPacketList(MessagesClient::createMessagesPacket(payload), *node);
+        }
+    }
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     QString channel = QString::fromUtf8(message->getMessage());
-    _channelSubscribers[channel] << senderNode->getUUID();
+    _channelSubscribers[channel].insert(senderNode->getUUID(), senderNode);
+    _nodeChannels[senderNode->getUUID()] << channel;
 }
 
 void MessagesMixer::handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     QString channel = QString::fromUtf8(message->getMessage());
-    if (_channelSubscribers.contains(channel)) {
-        _channelSubscribers[channel].remove(senderNode->getUUID());
+    auto it = _channelSubscribers.find(channel);
+    if (it != _channelSubscribers.end()) {
+        it->remove(senderNode->getUUID());
+        if (it->isEmpty()) {
+            _channelSubscribers.erase(it);
+        }
+    }
+    auto channelsIt = _nodeChannels.find(senderNode->getUUID());
+    if (channelsIt != _nodeChannels.end()) {
+        channelsIt->remove(channel);
     }
 }
 
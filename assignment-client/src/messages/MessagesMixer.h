@@ -34,7 +34,9 @@ private slots:
     void handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
 private:
-    QHash<QString,QSet<QUuid>> _channelSubscribers;
+    // the subscribers to each channel, kept as node pointers so a message is sent without a node list lookup per node
+    QHash<QString, QHash<QUuid, QWeakPointer<Node>>> _channelSubscribers;
+    QHash<QUuid, QSet<QString>> _nodeChannels; // the channels each node subscribes to, to unsubscribe killed nodes
 };
 
 #endif // hifi_MessagesMixer_h
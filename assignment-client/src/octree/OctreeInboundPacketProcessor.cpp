@@ -21,6 +21,7 @@
 
 static QUuid DEFAULT_NODE_ID_REF;
 const quint64 TOO_LONG_SINCE_LAST_NACK = 1 * USECS_PER_SECOND;
+const quint64 MAX_EDIT_BATCH_USECS = 4 * USECS_PER_MSEC;
 
 OctreeInboundPacketProcessor::OctreeInboundPacketProcessor(OctreeServer* myServer) :
     _myServer(myServer),
@@ -41,6 +42,10 @@ void OctreeInboundPacketProcessor::resetStats() {
     _totalLockWaitTime = 0;
     _totalElementsInPacket = 0;
     _totalPackets = 0;
+    _totalWriteLocks = 0;
+    _totalLockedEdits = 0;
+    _totalWriteLockHoldTime = 0;
+    _maxWriteLockHoldTime = 0;
     _lastNackTime = usecTimestampNow();
 
     QWriteLocker locker(&_senderStatsLock);
@@ -75,6 +80,38 @@ void OctreeInboundPacketProcessor::midProcess() {
     }
 }
 
+void OctreeInboundPacketProcessor::postProcess() {
+    // let the readers have the tree until the next messages arrive
+    endEditBatch();
+}
+
+void OctreeInboundPacketProcessor::beginEditBatch() {
+    if (!_isEditBatchLocked) {
+        _myServer->getOctree()->getLock().lockForWrite();
+        _isEditBatchLocked = true;
+        _editBatchLockedAt = usecTimestampNow();
+        _editsInBatch = 0;
+    }
+}
+
+void OctreeInboundPacketProcessor::endEditBatch() {
+    if (_isEditBatchLocked) {
+        _myServer->getOctree()->getLock().unlock();
+        _isEditBatchLocked = false;
+        trackWriteLock(_editsInBatch, usecTimestampNow() - _editBatchLockedAt);
+    }
+}
+
+void OctreeInboundPacketProcessor::trackWriteLock(int editsUnderLock, quint64 lockHoldTime) {
+    _totalWriteLocks++;
+    _totalLockedEdits += editsUnderLock;
+    _totalWriteLockHoldTime += lockHoldTime;
+
+    uint64_t maxHoldTime = _maxWriteLockHoldTime;
+    while (lockHoldTime > maxHoldTime && !_maxWriteLockHoldTime.compare_exchange_weak(maxHoldTime, lockHoldTime)) {
+    }
+}
+
 void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     if (_shuttingDown) {
         qDebug() << "OctreeInboundPacketProcessor::processPacket() while shutting down... ignoring incoming packet";
@@ -159,13 +196,27 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
 
             quint64 startProcess, startLock = usecTimestampNow();
             int editDataBytesRead;
-            _myServer->getOctree()->withWriteLock([&] {
+            if (_myServer->wantsBatchEdits()) {
+                beginEditBatch();
                 startProcess = usecTimestampNow();
                 editDataBytesRead =
                     _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
-            });
+                _editsInBatch++;
+            } else {
+                _myServer->getOctree()->withWriteLock([&] {
+                    startProcess = usecTimestampNow();
+                    editDataBytesRead =
+                        _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
+                });
+            }
             quint64 endProcess = usecTimestampNow();
 
+            if (!_myServer->wantsBatchEdits()) {
+                trackWriteLock(1, endProcess - startProcess);
+            } else if (endProcess - _editBatchLockedAt >= MAX_EDIT_BATCH_USECS) {
+                endEditBatch();
+            }
+
             if (debugProcessPacket) {
                 qDebug() << "OctreeInboundPacketProcessor::processPacket() after processEditPacketData()..."
                     << "editDataBytesRead=" << editDataBytesRead;
@@ -70,6 +70,14 @@ public:
     quint64 getAverageLockWaitTimePerElement() const
                 { return _totalElementsInPacket == 0 ? 0 : _totalLockWaitTime / _totalElementsInPacket; }
 
+    // how the edits share the tree's write lock, one edit per lock unless the server batches edits
+    quint64 getTotalWriteLocks() const { return _totalWriteLocks; }
+    float getAverageEditsPerWriteLock() const
+                { return _totalWriteLocks == 0 ? 0.0f : (float)_totalLockedEdits / (float)_totalWriteLocks; }
+    quint64 getAverageWriteLockHoldTime() const
+                { return _totalWriteLocks == 0 ? 0 : _totalWriteLockHoldTime / _totalWriteLocks; }
+    quint64 getMaxWriteLockHoldTime() const { return _maxWriteLockHoldTime; }
+
     void resetStats();
 
     NodeToSenderStatsMap getSingleSenderStats() { QReadLocker locker(&_senderStatsLock); return _singleSenderStats; }
@@ -83,11 +91,18 @@ protected:
     virtual unsigned long getMaxWait() const override;
     virtual void preProcess() override;
     virtual void midProcess() override;
+    virtual void postProcess() override;
 
 private:
     int sendNackPackets();
 
 private:
+    // when batching, the write lock is held across the edits of all the messages drained in one process(), for at most
+    // MAX_EDIT_BATCH_USECS at a time so the send threads' readers still get the tree
+    void beginEditBatch();
+    void endEditBatch();
+    void trackWriteLock(int editsUnderLock, quint64 lockHoldTime);
+
     void trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int elementsInPacket, quint64 processTime, quint64 lockWaitTime);
 
@@ -103,6 +118,15 @@ private:
     NodeToSenderStatsMap _singleSenderStats;
     QReadWriteLock _senderStatsLock;
 
+    std::atomic<uint64_t> _totalWriteLocks { 0 };
+    std::atomic<uint64_t> _totalLockedEdits { 0 };
+    std::atomic<uint64_t> _totalWriteLockHoldTime { 0 };
+    std::atomic<uint64_t> _maxWriteLockHoldTime { 0 };
+
+    bool _isEditBatchLocked { false };
+    quint64 _editBatchLockedAt { 0 };
+    int _editsInBatch { 0 };
+
     std::atomic<uint64_t> _lastNackTime;
     bool _shuttingDown;
 };
@@ -0,0 +1,220 @@
+//
+//  OctreeSendSlavePool.cpp
+//  assignment-client/src/octree
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSendSlavePool.h"
+
+#include <assert.h>
+#include <algorithm>
+#include <chrono>
+
+#include <SharedUtil.h>
+
+#include "OctreeSendThread.h"
+#include "OctreeServerConsts.h"
+
+// the least time a send thread is given to encode, however many clients share the slaves
+static const quint64 MIN_SEND_TIME_BUDGET_USECS = 1000;
+
+void OctreeSendSlaveThread::run() {
+    OctreeSendThread* sendThread;
+    while (_pool.wait(*this, sendThread)) {
+        quint64 start = usecTimestampNow();
+        bool keepSending = sendThread->process();
+        _pool.processed(sendThread, keepSending, usecTimestampNow() - start);
+    }
+}
+
+float OctreeSendSlavePool::Stats::getUtilization() const {
+    quint64 availableTime = elapsedTime * numThreads;
+    return availableTime == 0 ? 0.0f : (float)busyTime / (float)availableTime;
+}
+
+void OctreeSendSlavePool::add(OctreeSendThread* sendThread) {
+    {
+        Lock lock(_mutex);
+        assert(_queued.find(sendThread) == _queued.end() && _processing.find(sendThread) == _processing.end());
+        queue(sendThread, usecTimestampNow());
+    }
+    _slaveCondition.notify_one();
+}
+
+void OctreeSendSlavePool::remove(OctreeSendThread* sendThread) {
+    Lock lock(_mutex);
+
+    auto it = _queued.find(sendThread);
+    if (it != _queued.end()) {
+        _dueQueue.erase(it->second);
+        _queued.erase(it);
+    } else if (_processing.find(sendThread) != _processing.end()) {
+        _removing.insert(sendThread);
+        _processedCondition.wait(lock, [&] {
+            return _processing.find(sendThread) == _processing.end();
+        });
+    }
+}
+
+bool OctreeSendSlavePool::wait(OctreeSendSlaveThread& slave, OctreeSendThread*& sendThread) {
+    Lock lock(_mutex);
+
+    while (!slave._stop) {
+        if (_dueQueue.empty()) {
+            _slaveCondition.wait(lock);
+            continue;
+        }
+
+        // the queue is ordered by due time, so the front has waited longest
+        auto next = _dueQueue.begin();
+        quint64 now = usecTimestampNow();
+        if (next->first > now) {
+            _slaveCondition.wait_for(lock, std::chrono::microseconds(next->first - now));
+            continue;
+        }
+
+        quint64 lateness = now - next->first;
+        _totalLateness += lateness;
+        _maxLateness = std::max(_maxLateness, lateness);
+
+        sendThread = next->second;
+        _queued.erase(sendThread);
+        _dueQueue.erase(next);
+        _processing.insert(sendThread);
+
+        sendThread->setSendTimeBudget(getSendTimeBudget());
+        return true;
+    }
+
+    return false;
+}
+
+void OctreeSendSlavePool::processed(OctreeSendThread* sendThread, bool keepSending, quint64 processTime) {
+    {
+        Lock lock(_mutex);
+        _processing.erase(sendThread);
+
+        _busyTime += processTime;
+        ++_numProcessed;
+        if (processTime > sendThread->getSendTimeBudget()) {
+            ++_numOverBudget;
+        }
+
+        if (_removing.erase(sendThread) == 0) {
+            if (keepSending) {
+                queue(sendThread, sendThread->getNextSendTime());
+            } else {
+                // the server removes the send thread on its own thread, emit while locked so that its removal
+                // (which waits on the lock) can't delete it first
+                emit sendThread->finished();
+            }
+        }
+    }
+    _processedCondition.notify_all();
+    _slaveCondition.notify_one();
+}
+
+void OctreeSendSlavePool::queue(OctreeSendThread* sendThread, quint64 dueTime) {
+    _queued[sendThread] = _dueQueue.emplace(dueTime, sendThread);
+}
+
+quint64 OctreeSendSlavePool::getSendTimeBudget() const {
+    // share the slaves' time for one send interval among the send threads
+    int numSendThreads = (int)(_queued.size() + _processing.size());
+    quint64 budget = (quint64)OCTREE_SEND_INTERVAL_USECS * _numThreads / std::max(1, numSendThreads);
+    return std::min(std::max(budget, MIN_SEND_TIME_BUDGET_USECS), (quint64)OCTREE_SEND_INTERVAL_USECS);
+}
+
+OctreeSendSlavePool::Stats OctreeSendSlavePool::getStats() const {
+    Lock lock(_mutex);
+
+    Stats stats;
+    stats.numThreads = _numThreads;
+    stats.numSendThreads = (int)(_queued.size() + _processing.size());
+    stats.elapsedTime = usecTimestampNow() - _statsStart;
+    stats.busyTime = _busyTime;
+    stats.numProcessed = _numProcessed;
+    stats.totalLateness = _totalLateness;
+    stats.maxLateness = _maxLateness;
+    stats.numOverBudget = _numOverBudget;
+    return stats;
+}
+
+void OctreeSendSlavePool::resetStats() {
+    Lock lock(_mutex);
+
+    _statsStart = usecTimestampNow();
+    _busyTime = 0;
+    _numProcessed = 0;
+    _totalLateness = 0;
+    _maxLateness = 0;
+    _numOverBudget = 0;
+}
+
+void OctreeSendSlavePool::setNumThreads(int numThreads) {
+    // clamp to allowed size
+    {
+        int maxThreads = QThread::idealThreadCount();
+        if (maxThreads == -1) {
+            // idealThreadCount returns -1 if cores cannot be detected
+            static const int MAX_THREADS_IF_UNKNOWN = 4;
+            maxThreads = MAX_THREADS_IF_UNKNOWN;
+        }
+
+        int clampedThreads = std::min(std::max(1, numThreads), maxThreads);
+        if (clampedThreads != numThreads) {
+            qWarning("%s: clamped to %d (was %d)", __FUNCTION__, clampedThreads, numThreads);
+            numThreads = clampedThreads;
+        }
+    }
+
+    resize(numThreads);
+}
+
+void OctreeSendSlavePool::resize(int numThreads) {
+    assert(_numThreads == (int)_slaves.size());
+
+    qDebug("%s: set %d threads (was %d)", __FUNCTION__, numThreads, _numThreads);
+
+    if (numThreads > _numThreads) {
+        // start new slaves
+        for (int i = 0; i < numThreads - _numThreads; ++i) {
+            auto slave = new OctreeSendSlaveThread(*this);
+            slave->setObjectName("Octree Send Slave");
+            slave->start();
+            _slaves.emplace_back(slave);
+        }
+    } else if (numThreads < _numThreads) {
+        auto extraBegin = _slaves.begin() + numThreads;
+
+        // mark slaves to stop...
+        {
+            Lock lock(_mutex);
+            for (auto slave = extraBegin; slave != _slaves.end(); ++slave) {
+                (*slave)->_stop = true;
+            }
+        }
+        _slaveCondition.notify_all();
+
+        // ...wait for them to finish what they are processing...
+        for (auto slave = extraBegin; slave != _slaves.end(); ++slave) {
+            (*slave)->wait();
+        }
+
+        // ...and erase them
+        _slaves.erase(extraBegin, _slaves.end());
+    }
+
+    {
+        Lock lock(_mutex);
+        _numThreads = numThreads;
+        if (_statsStart == 0) {
+            _statsStart = usecTimestampNow();
+        }
+    }
+    assert(_numThreads == (int)_slaves.size());
+}
@@ -0,0 +1,114 @@
+//
+//  OctreeSendSlavePool.h
+//  assignment-client/src/octree
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeSendSlavePool_h
+#define hifi_OctreeSendSlavePool_h
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <QThread>
+
+class OctreeSendThread;
+class OctreeSendSlavePool;
+
+class OctreeSendSlaveThread : public QThread {
+    Q_OBJECT
+public:
+    OctreeSendSlaveThread(OctreeSendSlavePool& pool) : _pool(pool) {}
+
+    void run() override final;
+
+private:
+    friend class OctreeSendSlavePool;
+
+    OctreeSendSlavePool& _pool;
+    bool _stop { false }; // guarded by the pool's _mutex
+};
+
+// Slave pool for octree send threads
+//   Rather than every client's OctreeSendThread running (and sleeping) on a thread of its own, the send threads are
+//   run in non-threaded mode by a fixed number of slaves. Each process() is scheduled for when the send thread is
+//   next due, and the send thread that has waited longest is always run first, so no client is starved.
+//   add() and remove() are called from the server's thread, the slaves only ever run process().
+class OctreeSendSlavePool {
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+    using ConditionVariable = std::condition_variable;
+    using DueQueue = std::multimap<quint64, OctreeSendThread*>;
+
+public:
+    struct Stats {
+        int numThreads { 0 };
+        int numSendThreads { 0 };
+        quint64 elapsedTime { 0 }; // usecs since the stats were reset
+        quint64 busyTime { 0 }; // usecs the slaves spent in process()
+        quint64 numProcessed { 0 };
+        quint64 totalLateness { 0 }; // usecs between when each process() was due and when a slave ran it
+        quint64 maxLateness { 0 };
+        quint64 numOverBudget { 0 }; // process() calls that ran past their time budget
+
+        float getUtilization() const;
+    };
+
+    OctreeSendSlavePool(int numThreads = QThread::idealThreadCount()) { setNumThreads(numThreads); }
+    ~OctreeSendSlavePool() { resize(0); }
+
+    // schedule a (non-threaded) send thread, to be processed until its process() returns false
+    void add(OctreeSendThread* sendThread);
+
+    // stop processing a send thread, waits for a slave that is processing it to finish
+    void remove(OctreeSendThread* sendThread);
+
+    void setNumThreads(int numThreads);
+    int numThreads() const { return _numThreads; }
+
+    Stats getStats() const;
+    void resetStats();
+
+private:
+    friend class OctreeSendSlaveThread;
+
+    // called by the slaves, wait returns false when the slave should stop
+    bool wait(OctreeSendSlaveThread& slave, OctreeSendThread*& sendThread);
+    void processed(OctreeSendThread* sendThread, bool keepSending, quint64 processTime);
+
+    void queue(OctreeSendThread* sendThread, quint64 dueTime);
+    quint64 getSendTimeBudget() const;
+    void resize(int numThreads);
+
+    std::vector<std::unique_ptr<OctreeSendSlaveThread>> _slaves;
+    int _numThreads { 0 };
+
+    // synchronization state
+    mutable Mutex _mutex;
+    ConditionVariable _slaveCondition; // a send thread was queued, or slaves are stopping
+    ConditionVariable _processedCondition; // a slave finished processing a send thread
+
+    // schedule, guarded by _mutex
+    DueQueue _dueQueue;
+    std::unordered_map<OctreeSendThread*, DueQueue::iterator> _queued;
+    std::unordered_set<OctreeSendThread*> _processing;
+    std::unordered_set<OctreeSendThread*> _removing; // removed while a slave was processing them
+
+    // stats, guarded by _mutex
+    quint64 _statsStart { 0 };
+    quint64 _busyTime { 0 };
+    quint64 _numProcessed { 0 };
+    quint64 _totalLateness { 0 };
+    quint64 _maxLateness { 0 };
+    quint64 _numOverBudget { 0 };
+};
+
+#endif // hifi_OctreeSendSlavePool_h
@@ -98,8 +98,10 @@ bool OctreeSendThread::process() {
         return false; // exit early if we're shutting down
     }
 
-    // Only sleep if we're still running and we got the lock last time we tried, otherwise try to get the lock asap
-    if (isStillRunning()) {
+    _nextSendTime = start + OCTREE_SEND_INTERVAL_USECS;
+
+    // Only sleep if we're still running on our own thread, when run by the send slave pool it schedules the next call
+    if (isThreaded() && isStillRunning()) {
         // dynamically sleep until we need to fire off the next set of octree elements
         int elapsed = (usecTimestampNow() - start);
         int usecToSleep =  OCTREE_SEND_INTERVAL_USECS - elapsed;
@@ -128,6 +130,13 @@ AtomicUIntStat OctreeSendThread::_totalPackets { 0 };
 AtomicUIntStat OctreeSendThread::_totalSpecialBytes { 0 };
 AtomicUIntStat OctreeSendThread::_totalSpecialPackets { 0 };
 
+AtomicUIntStat OctreeSendThread::_totalTreeScenes { 0 };
+AtomicUIntStat OctreeSendThread::_totalTreeSceneBytes { 0 };
+AtomicUIntStat OctreeSendThread::_totalTreeSceneEncodeTime { 0 };
+AtomicUIntStat OctreeSendThread::_totalChangedElementsScenes { 0 };
+AtomicUIntStat OctreeSendThread::_totalChangedElementsSceneBytes { 0 };
+AtomicUIntStat OctreeSendThread::_totalChangedElementsSceneEncodeTime { 0 };
+
 
 int OctreeSendThread::handlePacketSend(SharedNodePointer node, OctreeQueryNode* nodeData, int& trueBytesSent,
                                        int& truePacketsSent, bool dontSuppressDuplicate) {
@@ -372,19 +381,44 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
         // TODO: add these to stats page
         //::startSceneSleepTime = _usleepTime;
 
-        nodeData->sceneStart(usecTimestampNow() - CHANGE_FUDGE);
-        // start tracking our stats
-        nodeData->stats.sceneStarted(isFullScene, viewFrustumChanged,
-                                     _myServer->getOctree()->getRoot(), _myServer->getJurisdiction());
-
-        // This is the start of "resending" the scene.
-        bool dontRestartSceneOnMove = false; // this is experimental
-        if (dontRestartSceneOnMove) {
-            if (nodeData->elementBag.isEmpty()) {
-                nodeData->elementBag.insert(_myServer->getOctree()->getRoot());
+        // once the client has a scene, start the next one from just the elements holding the changes since then, or
+        // start none at all while neither its view nor the tree changes
+        auto tree = _myServer->getOctree();
+        QVector<OctreeElementPointer> changedElements;
+        bool useChangedElements = false;
+        bool isSceneUnchanged = false;
+        tree->withReadLock([&] {
+            quint64 changeVersion = tree->getChangeVersion();
+            quint64 sentChangeVersion = nodeData->getSentChangeVersion();
+            bool isSceneChangedElements = !viewFrustumChanged && !isFullScene && sentChangeVersion > 0;
+            isSceneUnchanged = isSceneChangedElements && changeVersion == sentChangeVersion;
+            useChangedElements = isSceneChangedElements && changeVersion > sentChangeVersion &&
+                tree->getElementsChangedSince(sentChangeVersion, changedElements);
+            if (!isSceneUnchanged) {
+                nodeData->setSceneChangeVersion(changeVersion, useChangedElements);
+            }
+        });
+
+        if (!isSceneUnchanged) {
+            nodeData->sceneStart(usecTimestampNow() - CHANGE_FUDGE);
+            // start tracking our stats
+            nodeData->stats.sceneStarted(isFullScene, viewFrustumChanged, tree->getRoot(), _myServer->getJurisdiction());
+
+            // This is the start of "resending" the scene.
+            bool dontRestartSceneOnMove = false; // this is experimental
+            if (dontRestartSceneOnMove) {
+                if (nodeData->elementBag.isEmpty()) {
+                    nodeData->elementBag.insert(tree->getRoot());
+                }
+            } else if (useChangedElements) {
+                for (auto& element : changedElements) {
+                    nodeData->elementBag.insert(element);
+                }
+                _totalChangedElementsScenes++;
+            } else {
+                nodeData->elementBag.insert(tree->getRoot());
+                _totalTreeScenes++;
             }
-        } else {
-            nodeData->elementBag.insert(_myServer->getOctree()->getRoot());
         }
     }
 
@@ -400,7 +434,8 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
         int extraPackingAttempts = 0;
         bool completedScene = false;
 
-        while (somethingToSend && packetsSentThisInterval < maxPacketsPerInterval && !nodeData->isShuttingDown()) {
+        while (somethingToSend && packetsSentThisInterval < maxPacketsPerInterval && !nodeData->isShuttingDown() &&
+               usecTimestampNow() - start < _sendTimeBudget) {
             float lockWaitElapsedUsec = OctreeServer::SKIP_TIME;
             float encodeElapsedUsec = OctreeServer::SKIP_TIME;
             float compressAndWriteElapsedUsec = OctreeServer::SKIP_TIME;
@@ -457,6 +492,14 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
                     quint64 encodeEnd = usecTimestampNow();
                     encodeElapsedUsec = (float)(encodeEnd - encodeStart);
 
+                    if (nodeData->isChangedElementsScene()) {
+                        _totalChangedElementsSceneBytes += bytesWritten;
+                        _totalChangedElementsSceneEncodeTime += encodeEnd - encodeStart;
+                    } else {
+                        _totalTreeSceneBytes += bytesWritten;
+                        _totalTreeSceneEncodeTime += encodeEnd - encodeStart;
+                    }
+
                     // If after calling encodeTreeBitstream() there are no nodes left to send, then we know we've
                     // sent the entire scene. We want to know this below so we'll actually write this content into
                     // the packet and send it
@@ -593,6 +636,7 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
         if (nodeData->elementBag.isEmpty()) {
             nodeData->updateLastKnownViewFrustum();
             nodeData->setViewSent(true);
+            nodeData->sceneChangesSent();
 
             // If this was a full scene then make sure we really send out a stats packet at this point so that
             // the clients will know the scene is stable
@@ -18,6 +18,8 @@
 
 #include <GenericThread.h>
 
+#include "OctreeServerConsts.h"
+
 class OctreeQueryNode;
 class OctreeServer;
 
@@ -35,6 +37,11 @@ public:
     
     QUuid getNodeUuid() const { return _nodeUuid; }
 
+    // when run by an OctreeSendSlavePool, the time the next process() is due, and how long it may spend encoding
+    quint64 getNextSendTime() const { return _nextSendTime; }
+    quint64 getSendTimeBudget() const { return _sendTimeBudget; }
+    void setSendTimeBudget(quint64 sendTimeBudget) { _sendTimeBudget = sendTimeBudget; }
+
     static AtomicUIntStat _totalBytes;
     static AtomicUIntStat _totalWastedBytes;
     static AtomicUIntStat _totalPackets;
@@ -42,6 +49,14 @@ public:
     static AtomicUIntStat _totalSpecialBytes;
     static AtomicUIntStat _totalSpecialPackets;
 
+    // scenes started from the root, and from just the elements holding the changes the client hasn't been sent
+    static AtomicUIntStat _totalTreeScenes;
+    static AtomicUIntStat _totalTreeSceneBytes;
+    static AtomicUIntStat _totalTreeSceneEncodeTime;
+    static AtomicUIntStat _totalChangedElementsScenes;
+    static AtomicUIntStat _totalChangedElementsSceneBytes;
+    static AtomicUIntStat _totalChangedElementsSceneEncodeTime;
+
     static AtomicUIntStat _usleepTime;
     static AtomicUIntStat _usleepCalls;
 
@@ -49,6 +64,8 @@ protected:
     /// Implements generic processing behavior for this thread.
     virtual bool process() override;
 
+    friend class OctreeSendSlaveThread;
+
 private:
     int handlePacketSend(SharedNodePointer node, OctreeQueryNode* nodeData, int& trueBytesSent, int& truePacketsSent, bool dontSuppressDuplicate = false);
     int packetDistributor(SharedNodePointer node, OctreeQueryNode* nodeData, bool viewFrustumChanged);
@@ -62,6 +79,9 @@ private:
 
     int _nodeMissingCount { 0 };
     bool _isShuttingDown { false };
+
+    quint64 _nextSendTime { 0 };
+    quint64 _sendTimeBudget { OCTREE_SEND_INTERVAL_USECS };
 };
 
 #endif // hifi_OctreeSendThread_h
@@ -83,6 +83,7 @@ int OctreeServer::_noProcessWait = 0;
 
 
 void OctreeServer::resetSendingStats() {
+    _sendPool.resetStats();
     _averageLoopTime.reset();
 
     _averageEncodeTime.reset();
@@ -228,6 +229,7 @@ OctreeServer::OctreeServer(ReceivedMessage& message) :
     _debugSending(false),
     _debugReceiving(false),
     _verboseDebug(false),
+    _batchEdits(false),
     _jurisdiction(NULL),
     _jurisdictionSender(NULL),
     _octreeInboundPacketProcessor(NULL),
@@ -428,6 +430,13 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         quint64 totalOutboundSpecialPackets = OctreeSendThread::_totalSpecialPackets;
         quint64 totalOutboundSpecialBytes = OctreeSendThread::_totalSpecialBytes;
 
+        quint64 totalTreeScenes = OctreeSendThread::_totalTreeScenes;
+        quint64 totalTreeSceneBytes = OctreeSendThread::_totalTreeSceneBytes;
+        quint64 totalTreeSceneEncodeTime = OctreeSendThread::_totalTreeSceneEncodeTime;
+        quint64 totalChangedElementsScenes = OctreeSendThread::_totalChangedElementsScenes;
+        quint64 totalChangedElementsSceneBytes = OctreeSendThread::_totalChangedElementsSceneBytes;
+        quint64 totalChangedElementsSceneEncodeTime = OctreeSendThread::_totalChangedElementsSceneEncodeTime;
+
         statsString += QString("          Total Clients Connected: %1 clients\r\n")
             .arg(locale.toString((uint)getCurrentClientCount()).rightJustified(COLUMN_WIDTH, ' '));
 
@@ -442,6 +451,30 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         statsString += QString("      writeDatagram() last second: %1 clients\r\n\r\n")
             .arg(locale.toString((uint)howManyThreadsDidCallWriteDatagram(oneSecondAgo)).rightJustified(COLUMN_WIDTH, ' '));
 
+        // Send Slave Pool
+        {
+            auto poolStats = _sendPool.getStats();
+            float averageLateness = poolStats.numProcessed == 0 ? 0.0f
+                : (float)poolStats.totalLateness / (float)poolStats.numProcessed;
+            float averageProcessTime = poolStats.numProcessed == 0 ? 0.0f
+                : (float)poolStats.busyTime / (float)poolStats.numProcessed;
+
+            statsString += QString("               Send Slave Threads: %1 threads\r\n")
+                .arg(locale.toString(poolStats.numThreads).rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("           Scheduled Send Threads: %1 clients\r\n")
+                .arg(locale.toString(poolStats.numSendThreads).rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString().sprintf("           Send Slave Utilization:      %5.2f%%\r\n",
+                                             (double)(poolStats.getUtilization() * AS_PERCENT));
+            statsString += QString().sprintf("           Average process() time:    %9.2f usecs"
+                                             "                 samples: %12llu \r\n",
+                                             (double)averageProcessTime, (unsigned long long)poolStats.numProcessed);
+            statsString += QString().sprintf("       Average process() lateness:    %9.2f usecs"
+                                             "                     max: %12llu usecs\r\n",
+                                             (double)averageLateness, (unsigned long long)poolStats.maxLateness);
+            statsString += QString("       process() over time budget: %1 calls\r\n\r\n")
+                .arg(locale.toString((qulonglong)poolStats.numOverBudget).rightJustified(COLUMN_WIDTH, ' '));
+        }
+
         float averageLoopTime = getAverageLoopTime();
         statsString += QString().sprintf("           Average packetLoop() time:      %7.2f msecs"
                                          "                 samples: %12d \r\n",
@@ -625,6 +658,19 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         statsString += QString("     Total Outbound Special Bytes: %1 bytes\r\n")
             .arg(locale.toString((uint)totalOutboundSpecialBytes).rightJustified(COLUMN_WIDTH, ' '));
 
+        statsString += QString("                Total Tree Scenes: %1 scenes\r\n")
+            .arg(locale.toString((uint)totalTreeScenes).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("           Total Tree Scene Bytes: %1 bytes\r\n")
+            .arg(locale.toString((uint)totalTreeSceneBytes).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("          Total Tree Scene Encode: %1 usecs\r\n")
+            .arg(locale.toString((uint)totalTreeSceneEncodeTime).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("    Total Changed Elements Scenes: %1 scenes\r\n")
+            .arg(locale.toString((uint)totalChangedElementsScenes).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("     Changed Elements Scene Bytes: %1 bytes\r\n")
+            .arg(locale.toString((uint)totalChangedElementsSceneBytes).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("    Changed Elements Scene Encode: %1 usecs\r\n")
+            .arg(locale.toString((uint)totalChangedElementsSceneEncodeTime).rightJustified(COLUMN_WIDTH, ' '));
+
 
         statsString += QString("               Total Wasted Bytes: %1 bytes\r\n")
             .arg(locale.toString((uint)totalWastedBytes).rightJustified(COLUMN_WIDTH, ' '));
@@ -654,6 +700,10 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         quint64 averageLockWaitTimePerElement = _octreeInboundPacketProcessor->getAverageLockWaitTimePerElement();
         quint64 totalElementsProcessed = _octreeInboundPacketProcessor->getTotalElementsProcessed();
         quint64 totalPacketsProcessed = _octreeInboundPacketProcessor->getTotalPacketsProcessed();
+        quint64 totalWriteLocks = _octreeInboundPacketProcessor->getTotalWriteLocks();
+        float averageEditsPerWriteLock = _octreeInboundPacketProcessor->getAverageEditsPerWriteLock();
+        quint64 averageWriteLockHoldTime = _octreeInboundPacketProcessor->getAverageWriteLockHoldTime();
+        quint64 maxWriteLockHoldTime = _octreeInboundPacketProcessor->getMaxWriteLockHoldTime();
 
         quint64 averageDecodeTime = _tree->getAverageDecodeTime();
         quint64 averageLookupTime = _tree->getAverageLookupTime();
@@ -690,6 +740,19 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         statsString += QString("  Average Wait Lock Time/Element: %1 usecs\r\n")
             .arg(locale.toString((uint)averageLockWaitTimePerElement).rightJustified(COLUMN_WIDTH, ' '));
 
+        statsString += QString("             Batch Inbound Edits: %1\r\n")
+            .arg(QString(debug::valueOf(_batchEdits)).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("          Total Edit Write Locks: %1 locks\r\n")
+            .arg(locale.toString((uint)totalWriteLocks).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("        Average Edits/Write Lock: %1 edits/lock\r\n")
+            .arg(locale.toString(averageEditsPerWriteLock, 'f', FLOAT_PRECISION).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("    Average Write Lock Hold Time: %1 usecs\r\n")
+            .arg(locale.toString((uint)averageWriteLockHoldTime).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("        Max Write Lock Hold Time: %1 usecs\r\n")
+            .arg(locale.toString((uint)maxWriteLockHoldTime).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("     Average Send Read Lock Wait: %1 usecs\r\n\r\n")
+            .arg(locale.toString((uint)getAverageTreeWaitTime()).rightJustified(COLUMN_WIDTH, ' '));
+
         statsString += QString("             Average Decode Time: %1 usecs\r\n")
             .arg(locale.toString((uint)averageDecodeTime).rightJustified(COLUMN_WIDTH, ' '));
         statsString += QString("             Average Lookup Time: %1 usecs\r\n")
@@ -877,7 +940,10 @@ OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePo
     
     // we want to be notified when the thread finishes
     connect(sendThread.get(), &GenericThread::finished, this, &OctreeServer::removeSendThread);
-    sendThread->initialize(true);
+
+    // the send thread is run by the slave pool, rather than on a thread of its own
+    sendThread->initialize(false);
+    _sendPool.add(sendThread.get());
 
     return sendThread;
 }
@@ -901,6 +967,7 @@ void OctreeServer::handleOctreeQueryPacket(QSharedPointer<ReceivedMessage> messa
         if (it == _sendThreads.end()) {
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
         } else if (it->second->isShuttingDown()) {
+            _sendPool.remove(it->second.get());
             _sendThreads.erase(it); // Remove right away and wait on thread to be
             
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
@@ -1040,6 +1107,9 @@ void OctreeServer::readConfiguration() {
     readOptionBool(QString("debugReceiving"), settingsSectionObject, _debugReceiving);
     qDebug("debugReceiving=%s", debug::valueOf(_debugReceiving));
 
+    readOptionBool(QString("batchEdits"), settingsSectionObject, _batchEdits);
+    qDebug("batchEdits=%s", debug::valueOf(_batchEdits));
+
     readOptionBool(QString("debugTimestampNow"), settingsSectionObject, _debugTimestampNow);
     qDebug() << "debugTimestampNow=" << _debugTimestampNow;
 
@@ -1056,7 +1126,10 @@ void OctreeServer::readConfiguration() {
 
         qDebug() << "persistFilePath=" << _persistFilePath;
 
-        _persistAsFileType = "json.gz";
+        bool persistBinarySnapshot = false;
+        readOptionBool(QString("persistBinarySnapshot"), settingsSectionObject, persistBinarySnapshot);
+        _persistAsFileType = persistBinarySnapshot ? "bin" : "json.gz";
+        qDebug() << "persistAsFileType=" << _persistAsFileType;
 
         _persistInterval = OctreePersistThread::DEFAULT_PERSIST_INTERVAL;
         readOptionInt(QString("persistInterval"), settingsSectionObject, _persistInterval);
@@ -1111,6 +1184,13 @@ void OctreeServer::readConfiguration() {
     qDebug("packetsPerSecondTotalMax=%d _packetsTotalPerInterval=%d",
                     packetsPerSecondTotalMax, _packetsTotalPerInterval);
 
+    // the number of slave threads the clients' send threads share, 0 for one per core
+    int sendThreads = 0;
+    if (readOptionInt(QString("sendThreads"), settingsSectionObject, sendThreads) && sendThreads > 0) {
+        _sendPool.setNumThreads(sendThreads);
+    }
+    qDebug("sendThreads=%d", _sendPool.numThreads());
+
 
     readAdditionalConfiguration(settingsSectionObject);
 }
@@ -1350,10 +1430,10 @@ void OctreeServer::aboutToFinish() {
     for (auto& it : _sendThreads) {
         auto& sendThread = *it.second;
         sendThread.setIsShuttingDown();
+        _sendPool.remove(&sendThread);
     }
     
-    // Clear will destruct all the unique_ptr to OctreeSendThreads which will call the GenericThread's dtor
-    // which waits on the thread to be done before returning
+    // Clear will destruct all the unique_ptr to OctreeSendThreads, none of which the slave pool is processing any more
     _sendThreads.clear(); // Cleans up all the send threads.
 
     if (_persistThread) {
@@ -1471,6 +1551,11 @@ void OctreeServer::sendStatsPacket() {
     threadsStats["2. packetDistributor"] = (double)howManyThreadsDidPacketDistributor(oneSecondAgo);
     threadsStats["3. handlePacektSend"] = (double)howManyThreadsDidHandlePacketSend(oneSecondAgo);
     threadsStats["4. writeDatagram"] = (double)howManyThreadsDidCallWriteDatagram(oneSecondAgo);
+
+    auto poolStats = _sendPool.getStats();
+    threadsStats["5. sendSlaveThreads"] = poolStats.numThreads;
+    threadsStats["6. sendSlaveUtilization"] = (double)poolStats.getUtilization();
+    threadsStats["7. sendSlaveMaxLatenessUsecs"] = (double)poolStats.maxLateness;
     
     QJsonObject statsArray1;
     statsArray1["1. configuration"] = getConfiguration();
@@ -1494,6 +1579,12 @@ void OctreeServer::sendStatsPacket() {
     dataObject1["4. totalBytesOctalCodes"] = (double)OctreePacketData::getTotalBytesOfOctalCodes();
     dataObject1["5. totalBytesBitMasks"] = (double)OctreePacketData::getTotalBytesOfBitMasks();
     dataObject1["6. totalBytesBitMasks"] = (double)OctreePacketData::getTotalBytesOfColor();
+    dataObject1["7. totalTreeScenes"] = (double)OctreeSendThread::_totalTreeScenes;
+    dataObject1["8. totalTreeSceneBytes"] = (double)OctreeSendThread::_totalTreeSceneBytes;
+    dataObject1["9. totalTreeSceneEncodeUsecs"] = (double)OctreeSendThread::_totalTreeSceneEncodeTime;
+    dataObject1["10. totalChangedElementsScenes"] = (double)OctreeSendThread::_totalChangedElementsScenes;
+    dataObject1["11. totalChangedElementsSceneBytes"] = (double)OctreeSendThread::_totalChangedElementsSceneBytes;
+    dataObject1["12. totalChangedElementsSceneEncodeUsecs"] = (double)OctreeSendThread::_totalChangedElementsSceneEncodeTime;
 
     QJsonObject timingArray1;
     timingArray1["1. avgLoopTime"] = getAverageLoopTime();
@@ -1522,6 +1613,10 @@ void OctreeServer::sendStatsPacket() {
         timingArray2["3. avgLockWaitTimePerPacket"] = (double)_octreeInboundPacketProcessor->getAverageLockWaitTimePerPacket();
         timingArray2["4. avgProcessTimePerElement"] = (double)_octreeInboundPacketProcessor->getAverageProcessTimePerElement();
         timingArray2["5. avgLockWaitTimePerElement"] = (double)_octreeInboundPacketProcessor->getAverageLockWaitTimePerElement();
+        timingArray2["6. avgEditsPerWriteLock"] = (double)_octreeInboundPacketProcessor->getAverageEditsPerWriteLock();
+        timingArray2["7. avgWriteLockHoldTime"] = (double)_octreeInboundPacketProcessor->getAverageWriteLockHoldTime();
+        timingArray2["8. maxWriteLockHoldTime"] = (double)_octreeInboundPacketProcessor->getMaxWriteLockHoldTime();
+        timingArray2["9. avgSendReadLockWaitTime"] = (double)getAverageTreeWaitTime();
     }
     
     QJsonObject statsObject3;
@@ -23,6 +23,7 @@
 #include <ThreadedAssignment.h>
 
 #include "OctreePersistThread.h"
+#include "OctreeSendSlavePool.h"
 #include "OctreeSendThread.h"
 #include "OctreeServerConsts.h"
 #include "OctreeInboundPacketProcessor.h"
@@ -42,6 +43,7 @@ public:
     bool wantsDebugSending() const { return _debugSending; }
     bool wantsDebugReceiving() const { return _debugReceiving; }
     bool wantsVerboseDebug() const { return _verboseDebug; }
+    bool wantsBatchEdits() const { return _batchEdits; }
 
     OctreePointer getOctree() { return _tree; }
     JurisdictionMap* getJurisdiction() { return _jurisdiction; }
@@ -181,6 +183,7 @@ protected:
     bool _debugReceiving;
     bool _debugTimestampNow;
     bool _verboseDebug;
+    bool _batchEdits;
     JurisdictionMap* _jurisdiction;
     JurisdictionSender* _jurisdictionSender;
     OctreeInboundPacketProcessor* _octreeInboundPacketProcessor;
@@ -198,6 +201,7 @@ protected:
     QString _safeServerName;
     
     SendThreads _sendThreads;
+    OctreeSendSlavePool _sendPool; // declared after _sendThreads so its slaves stop before the send threads are deleted
 
     static int _clientCount;
     static SimpleMovingAverage _averageLoopTime;
@@ -19,6 +19,7 @@
 #include <EntityScriptingInterface.h>
 #include <LogHandler.h>
 #include <MessagesClient.h>
+#include <OctreeConstants.h>
 #include <plugins/CodecPlugin.h>
 #include <plugins/PluginManager.h>
 #include <ResourceManager.h>
@@ -101,7 +102,10 @@ void EntityScriptServer::handleReloadEntityServerScriptPacket(QSharedPointer<Rec
 
         if (_entityViewer.getTree() && !_shuttingDown) {
             qCDebug(entity_script_server) << "Reloading: " << entityID;
-            _entitiesScriptEngine->unloadEntityScript(entityID);
+            auto shard = getScriptEngineShard(entityID);
+            if (shard.engine) {
+                shard.engine->unloadEntityScript(entityID);
+            }
             checkAndCallPreload(entityID, true);
         }
     }
@@ -119,7 +123,8 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptEngine->getEntityScriptDetails(entityID, details)) {
+        auto shard = getScriptEngineShard(entityID);
+        if (shard.engine && shard.engine->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
@@ -148,6 +153,18 @@ void EntityScriptServer::handleSettings() {
 
     auto entityScriptServerSettings = settingsObject[ENTITY_SCRIPT_SERVER_SETTINGS_KEY].toObject();
 
+    static const QString SCRIPT_ENGINE_SHARDS_OPTION = "script_engine_shards";
+    if (entityScriptServerSettings.contains(SCRIPT_ENGINE_SHARDS_OPTION)) {
+        int numShards = entityScriptServerSettings[SCRIPT_ENGINE_SHARDS_OPTION].toInt(DEFAULT_SCRIPT_ENGINE_SHARDS);
+        setNumScriptEngineShards(std::min(std::max(numShards, 1), MAX_SCRIPT_ENGINE_SHARDS));
+    }
+
+    // let the scripts' entity queries read from snapshots rather than wait on the tree's lock
+    static const QString ENTITY_SNAPSHOTS_OPTION = "entity_snapshots";
+    bool wantSnapshots = entityScriptServerSettings[ENTITY_SNAPSHOTS_OPTION].toBool(false);
+    qDebug() << "Entity snapshots" << (wantSnapshots ? "enabled" : "disabled");
+    _entityViewer.getTree()->setWantSnapshots(wantSnapshots);
+
     static const QString MAX_ENTITY_PPS_OPTION = "max_total_entity_pps";
     static const QString ENTITY_PPS_PER_SCRIPT = "entity_pps_per_script";
 
@@ -164,7 +181,13 @@ void EntityScriptServer::handleSettings() {
 }
 
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptEngine->getNumRunningEntityScripts();
+    int numRunningScripts = 0;
+    {
+        std::lock_guard<std::mutex> lock(_scriptEnginesLock);
+        for (auto& shard : _scriptEngineShards) {
+            numRunningScripts += shard.engine->getNumRunningEntityScripts();
+        }
+    }
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplaction would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -251,13 +274,20 @@ void EntityScriptServer::run() {
         NodeType::EntityServer, NodeType::MessagesMixer, NodeType::AssetServer
     });
 
-    // Setup Script Engine
-    resetEntitiesScriptEngine();
+    // there can be several engines releasing the queued edits, so the sender sends them from its own thread rather
+    // than from whichever engine thread gets there first. It is threaded before any engine runs, as the engines
+    // check whether it is to know if they have to process it themselves
+    _entityEditSender.initialize(true);
+
+    // Setup Script Engines
+    resetEntitiesScriptEngines();
 
     // we need to make sure that init has been called for our EntityScriptingInterface
     // so that it actually has a jurisdiction listener when we ask it for it next
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     entityScriptingInterface->init();
+    // route the entity method calls of the scripts to the engine running the entity's script
+    entityScriptingInterface->setEntitiesScriptEngine(this);
     _entityViewer.setJurisdictionListener(entityScriptingInterface->getJurisdictionListener());
 
     _entityViewer.init();
@@ -318,12 +348,9 @@ void EntityScriptServer::nodeKilled(SharedNodePointer killedNode) {
     switch (killedNode->getType()) {
         case NodeType::EntityServer: {
             if (!_shuttingDown) {
-                if (_entitiesScriptEngine) {
-                    _entitiesScriptEngine->unloadAllEntityScripts();
-                    _entitiesScriptEngine->stop();
-                }
+                stopEntitiesScriptEngines();
 
-                resetEntitiesScriptEngine();
+                resetEntitiesScriptEngines();
 
                 _entityViewer.clear();
             }
@@ -394,55 +421,146 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
-    auto engineName = QString("Entities %1").arg(++_entitiesScriptEngineCount);
-    auto newEngine = QSharedPointer<ScriptEngine>(new ScriptEngine(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName));
-
-    auto webSocketServerConstructorValue = newEngine->newFunction(WebSocketServerClass::constructor);
-    newEngine->globalObject().setProperty("WebSocketServer", webSocketServerConstructorValue);
+EntityScriptServer::ScriptEngineShard EntityScriptServer::getScriptEngineShard(const EntityItemID& entityID) const {
+    std::lock_guard<std::mutex> lock(_scriptEnginesLock);
+    if (_scriptEngineShards.empty()) {
+        return ScriptEngineShard();
+    }
+    // the same entity always goes to the same engine, for as long as the number of engines doesn't change
+    return _scriptEngineShards[qHash(entityID) % _scriptEngineShards.size()];
+}
 
-    newEngine->registerGlobalObject("SoundCache", DependencyManager::get<SoundCache>().data());
+void EntityScriptServer::queueEntityCall(const ScriptEngineShard& shard, std::function<void()> call) {
+    auto queuedCalls = shard.queuedCalls;
+    ++(*queuedCalls);
+    shard.engine->executeOnScriptThread([queuedCalls, call] {
+        --(*queuedCalls);
+        call();
+    });
+}
 
-    // connect this script engines printedMessage signal to the global ScriptEngines these various messages
-    auto scriptEngines = DependencyManager::get<ScriptEngines>().data();
-    connect(newEngine.data(), &ScriptEngine::printedMessage, scriptEngines, &ScriptEngines::onPrintedMessage);
-    connect(newEngine.data(), &ScriptEngine::errorMessage, scriptEngines, &ScriptEngines::onErrorMessage);
-    connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
-    connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
+void EntityScriptServer::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                const QStringList& params) {
+    auto shard = getScriptEngineShard(entityID);
+    if (!shard.engine) {
+        return;
+    }
 
-    connect(newEngine.data(), &ScriptEngine::update, this, [this] {
-        _entityViewer.queryOctree();
+    QWeakPointer<ScriptEngine> weakEngine = shard.engine;
+    queueEntityCall(shard, [weakEngine, entityID, methodName, params] {
+        if (auto engine = weakEngine.toStrongRef()) {
+            engine->callEntityScriptMethod(entityID, methodName, params);
+        }
     });
+}
 
+void EntityScriptServer::resetEntitiesScriptEngines() {
+    std::vector<ScriptEngineShard> newShards;
+    for (int i = 0; i < _numScriptEngineShards; ++i) {
+        auto engineName = QString("Entities %1").arg(++_entitiesScriptEngineCount);
+        auto newEngine = QSharedPointer<ScriptEngine>(new ScriptEngine(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName));
 
-    newEngine->runInThread();
-    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(newEngine.data());
+        auto webSocketServerConstructorValue = newEngine->newFunction(WebSocketServerClass::constructor);
+        newEngine->globalObject().setProperty("WebSocketServer", webSocketServerConstructorValue);
 
-    disconnect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
-    _entitiesScriptEngine.swap(newEngine);
-    connect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
-}
+        newEngine->registerGlobalObject("SoundCache", DependencyManager::get<SoundCache>().data());
 
+        // connect this script engines printedMessage signal to the global ScriptEngines these various messages
+        auto scriptEngines = DependencyManager::get<ScriptEngines>().data();
+        connect(newEngine.data(), &ScriptEngine::printedMessage, scriptEngines, &ScriptEngines::onPrintedMessage);
+        connect(newEngine.data(), &ScriptEngine::errorMessage, scriptEngines, &ScriptEngines::onErrorMessage);
+        connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
+        connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
 
-void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptEngine) {
+        // one engine is enough to keep the entity query going
+        if (i == 0) {
+            connect(newEngine.data(), &ScriptEngine::update, this, [this] {
+                _entityViewer.queryOctree();
+            });
+        }
+
+        newEngine->runInThread();
+
+        ScriptEngineShard shard;
+        shard.engine = newEngine;
+        shard.queuedCalls = std::make_shared<std::atomic<int>>(0);
+        newShards.push_back(shard);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_scriptEnginesLock);
+        for (auto& shard : _scriptEngineShards) {
+            disconnect(shard.engine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
+        }
+        _scriptEngineShards.swap(newShards);
+        for (auto& shard : _scriptEngineShards) {
+            connect(shard.engine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
+        }
+    }
+}
+
+void EntityScriptServer::stopEntitiesScriptEngines() {
+    std::lock_guard<std::mutex> lock(_scriptEnginesLock);
+    for (auto& shard : _scriptEngineShards) {
         // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptEngine->unloadAllEntityScripts();
-        _entitiesScriptEngine->stop();
+        shard.engine->unloadAllEntityScripts();
+        shard.engine->stop();
+    }
+}
+
+void EntityScriptServer::setNumScriptEngineShards(int numShards) {
+    if (numShards == _numScriptEngineShards) {
+        return;
     }
+    _numScriptEngineShards = numShards;
+    qCDebug(entity_script_server) << "Running entity scripts in" << numShards << "script engines";
 
-    // reset the engine
+    if (_shuttingDown) {
+        return;
+    }
+    bool isRunning;
+    {
+        std::lock_guard<std::mutex> lock(_scriptEnginesLock);
+        isRunning = !_scriptEngineShards.empty();
+    }
+    if (!isRunning) {
+        return;
+    }
+
+    // restart the scripts of the entities we already have, on their new engines
+    stopEntitiesScriptEngines();
+    resetEntitiesScriptEngines();
+
+    auto tree = _entityViewer.getTree();
+    if (tree) {
+        QVector<EntityItemPointer> entities;
+        tree->withReadLock([&] {
+            tree->findEntities(AACube(glm::vec3((float)-HALF_TREE_SCALE), (float)TREE_SCALE), entities);
+        });
+        for (auto& entity : entities) {
+            checkAndCallPreload(entity->getEntityItemID());
+        }
+    }
+}
+
+void EntityScriptServer::clear() {
+    // unload and stop the engines
+    stopEntitiesScriptEngines();
+
+    // reset the engines
     if (!_shuttingDown) {
-        resetEntitiesScriptEngine();
+        resetEntitiesScriptEngines();
     }
 
     _entityViewer.clear();
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptEngine) {
-        _entitiesScriptEngine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    {
+        std::lock_guard<std::mutex> lock(_scriptEnginesLock);
+        for (auto& shard : _scriptEngineShards) {
+            shard.engine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+        }
     }
     _shuttingDown = true;
 
@@ -454,37 +572,67 @@ void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
-        _entitiesScriptEngine->unloadEntityScript(entityID);
+    auto shard = getScriptEngineShard(entityID);
+    if (_entityViewer.getTree() && !_shuttingDown && shard.engine) {
+        shard.engine->unloadEntityScript(entityID);
     }
 }
 
 void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID, const bool reload) {
-    if (_entityViewer.getTree() && !_shuttingDown) {
-        _entitiesScriptEngine->unloadEntityScript(entityID);
+    auto shard = getScriptEngineShard(entityID);
+    if (_entityViewer.getTree() && !_shuttingDown && shard.engine) {
+        shard.engine->unloadEntityScript(entityID);
         checkAndCallPreload(entityID, reload);
     }
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, const bool reload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
+    auto shard = getScriptEngineShard(entityID);
+    if (_entityViewer.getTree() && !_shuttingDown && shard.engine) {
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
         EntityScriptDetails details;
-        bool notRunning = !_entitiesScriptEngine->getEntityScriptDetails(entityID, details);
+        bool notRunning = !shard.engine->getEntityScriptDetails(entityID, details);
         if (entity && (reload || notRunning || details.scriptText != entity->getServerScripts())) {
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = ResourceManager::normalizeURL(scriptUrl);
                 qCDebug(entity_script_server) << "Loading entity server script" << scriptUrl << "for" << entityID;
-                ScriptEngine::loadEntityScript(_entitiesScriptEngine, entityID, scriptUrl, reload);
+                ScriptEngine::loadEntityScript(shard.engine, entityID, scriptUrl, reload);
             }
         }
     }
 }
 
 void EntityScriptServer::sendStatsPacket() {
+    QJsonObject statsObject, enginesObject;
+
+    auto now = usecTimestampNow();
+    auto elapsed = std::chrono::microseconds(_lastStatsTime > 0 ? now - _lastStatsTime : 0);
+    _lastStatsTime = now;
 
+    {
+        std::lock_guard<std::mutex> lock(_scriptEnginesLock);
+        for (size_t i = 0; i < _scriptEngineShards.size(); ++i) {
+            auto& shard = _scriptEngineShards[i];
+            auto busyTime = shard.engine->getBusyTime();
+            auto busySinceLastStats = busyTime - shard.lastBusyTime;
+            shard.lastBusyTime = busyTime;
+
+            QJsonObject engineStats;
+            engineStats["name"] = shard.engine->getFilename();
+            engineStats["running_scripts"] = shard.engine->getNumRunningEntityScripts();
+            engineStats["queued_calls"] = shard.queuedCalls->load();
+            engineStats["busy_time_ms"] = (double)busyTime.count() / USECS_PER_MSEC;
+            if (elapsed.count() > 0) {
+                engineStats["busy_percent"] = 100.0 * (double)busySinceLastStats.count() / (double)elapsed.count();
+            }
+            enginesObject[QString::number(i)] = engineStats;
+        }
+    }
+
+    statsObject["script_engines"] = enginesObject;
+    ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
 void EntityScriptServer::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -530,6 +678,10 @@ void EntityScriptServer::handleJurisdictionPacket(QSharedPointer<ReceivedMessage
 void EntityScriptServer::aboutToFinish() {
     shutdownScriptEngine();
 
+    _entityEditSender.terminate();
+
+    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(nullptr);
+
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
     DependencyManager::get<EntityScriptingInterface>()->setEntityTree(nullptr);
 
@@ -12,12 +12,18 @@
 #ifndef hifi_EntityScriptServer_h
 #define hifi_EntityScriptServer_h
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 
 #include <QtCore/QObject>
 #include <QtCore/QUuid>
 
+#include <EntitiesScriptEngineProvider.h>
 #include <EntityEditPacketSender.h>
 #include <EntityTreeHeadlessViewer.h>
 #include <plugins/CodecPlugin.h>
@@ -26,8 +32,10 @@
 
 static const int DEFAULT_MAX_ENTITY_PPS = 9000;
 static const int DEFAULT_ENTITY_PPS_PER_SCRIPT = 900;
+static const int DEFAULT_SCRIPT_ENGINE_SHARDS = 1;
+static const int MAX_SCRIPT_ENGINE_SHARDS = 32;
 
-class EntityScriptServer : public ThreadedAssignment {
+class EntityScriptServer : public ThreadedAssignment, public EntitiesScriptEngineProvider {
     Q_OBJECT
 
 public:
@@ -36,6 +44,10 @@ public:
 
     virtual void aboutToFinish() override;
 
+    // Calls the method on the engine running the entity's script, from any thread
+    virtual void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                        const QStringList& params = QStringList()) override;
+
 public slots:
     void run() override;
     void nodeActivated(SharedNodePointer activatedNode);
@@ -61,7 +73,19 @@ private:
     void negotiateAudioFormat();
     void selectAudioFormat(const QString& selectedCodecName);
 
-    void resetEntitiesScriptEngine();
+    // The entity scripts are shared out between the engines by entity ID, each engine running in its own thread
+    struct ScriptEngineShard {
+        QSharedPointer<ScriptEngine> engine;
+        std::shared_ptr<std::atomic<int>> queuedCalls; // calls posted to the engine thread and not yet run
+        std::chrono::microseconds lastBusyTime { 0 }; // at the last stats packet
+    };
+
+    ScriptEngineShard getScriptEngineShard(const EntityItemID& entityID) const;
+    void queueEntityCall(const ScriptEngineShard& shard, std::function<void()> call);
+
+    void resetEntitiesScriptEngines();
+    void stopEntitiesScriptEngines();
+    void setNumScriptEngineShards(int numShards);
     void clear();
     void shutdownScriptEngine();
 
@@ -75,7 +99,10 @@ private:
     bool _shuttingDown { false };
 
     static int _entitiesScriptEngineCount;
-    QSharedPointer<ScriptEngine> _entitiesScriptEngine;
+    mutable std::mutex _scriptEnginesLock;
+    std::vector<ScriptEngineShard> _scriptEngineShards;
+    int _numScriptEngineShards { DEFAULT_SCRIPT_ENGINE_SHARDS };
+    quint64 _lastStatsTime { 0 };
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
 
@@ -834,6 +834,13 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     QDataStream packetStream(message->getMessage());
     NodeConnectionData nodeRequestData = NodeConnectionData::fromDataStream(packetStream, message->getSenderSockAddr(), false);
 
+    // the version of the domain list the node has, so that it is sent only what changed since
+    quint64 knownDomainListVersion = 0;
+    packetStream >> knownDomainListVersion;
+
+    bool hasChanged = sendingNode->getPublicSocket() != nodeRequestData.publicSockAddr
+        || sendingNode->getLocalSocket() != nodeRequestData.localSockAddr;
+
     // update this node's sockets in case they have changed
     sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
     sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
@@ -847,12 +854,17 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
         safeInterestSet.remove(NodeType::Agent);
     }
 
+    hasChanged = hasChanged || nodeData->getNodeInterestSet() != safeInterestSet;
     nodeData->setNodeInterestSet(safeInterestSet);
 
     // update the connecting hostname in case it has changed
     nodeData->setPlaceName(nodeRequestData.placeName);
 
-    sendDomainListToNode(sendingNode, message->getSenderSockAddr());
+    if (hasChanged) {
+        domainListChanged(sendingNode->getUUID());
+    }
+
+    sendDomainListToNode(sendingNode, message->getSenderSockAddr(), knownDomainListVersion);
 }
 
 bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -950,6 +962,8 @@ QUrl DomainServer::oauthAuthorizationURL(const QUuid& stateUUID) {
 void DomainServer::handleConnectedNode(SharedNodePointer newNode) {
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(newNode->getLinkedData());
 
+    domainListChanged(newNode->getUUID());
+
     // reply back to the user with a PacketType::DomainList
     sendDomainListToNode(newNode, nodeData->getSendingSockAddr());
 
@@ -962,60 +976,117 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode) {
     broadcastNewNode(newNode);
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr) {
-    const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NUM_BYTES_RFC4122_UUID + 2;
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr,
+                                        quint64 knownVersion) {
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
 
-    // setup the extended header for the domain list packets
-    // this data is at the beginning of each of the domain list packets
-    QByteArray extendedHeader(NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES, 0);
-    QDataStream extendedHeaderStream(&extendedHeader, QIODevice::WriteOnly);
+    // the node is sent only the changes since the version it has if it has been sent that version, the changes since
+    // then are still known, and none of them were to the node itself (which may change which nodes it is told about)
+    QSet<QUuid> changedNodeIDs;
+    bool isDelta = knownVersion != 0 && nodeData->isAuthenticated()
+        && knownVersion >= nodeData->getFirstDomainListVersion() && knownVersion <= nodeData->getLastDomainListVersion()
+        && getDomainListChangesSince(knownVersion, changedNodeIDs) && !changedNodeIDs.contains(node->getUUID());
+
+    // the list is versioned, and a delta only applies on top of the version it was made against, so it is sent
+    // reliably and in order - the node takes the version once it has the whole list, and a lost packet is resent
+    // rather than leaving the node without the nodes it held
+    auto domainListPackets = NLPacketList::create(PacketType::DomainList, QByteArray(), true, true);
+    QDataStream domainListStream(domainListPackets.get());
 
     auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
-    extendedHeaderStream << limitedNodeList->getSessionUUID();
-    extendedHeaderStream << node->getUUID();
-    extendedHeaderStream << node->getPermissions();
-
-    auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
-
+    // the header is at the beginning of the list, which arrives as a single message
     // always send the node their own UUID back
-    QDataStream domainListStream(domainListPackets.get());
-
-    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    domainListStream << limitedNodeList->getSessionUUID();
+    domainListStream << node->getUUID();
+    domainListStream << node->getPermissions();
+    domainListStream << _domainListVersion;
+    domainListStream << isDelta;
+
+    if (isDelta) {
+        for (auto& changedNodeID : changedNodeIDs) {
+            domainListPackets->startSegment();
+
+            SharedNodePointer otherNode = limitedNodeList->nodeWithUUID(changedNodeID);
+            if (otherNode && isInInterestSet(node, otherNode)) {
+                domainListStream << static_cast<quint8>(LimitedNodeList::DomainListChange::Updated);
+                domainListStream << *otherNode.data();
+                domainListStream << connectionSecretForNodes(node, otherNode);
+            } else {
+                // the node is gone, or no longer of interest to this node
+                domainListStream << static_cast<quint8>(LimitedNodeList::DomainListChange::Removed);
+                domainListStream << changedNodeID;
+            }
 
-    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
-    auto& nodeInterestSet = nodeData->getNodeInterestSet();
+            domainListPackets->endSegment();
+        }
+    } else {
+        // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
+        auto& nodeInterestSet = nodeData->getNodeInterestSet();
 
-    if (nodeInterestSet.size() > 0) {
+        if (nodeInterestSet.size() > 0) {
 
-        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
-        if (nodeData->isAuthenticated()) {
-            // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([&](const SharedNodePointer& otherNode) {
-                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+            // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
+            if (nodeData->isAuthenticated()) {
+                // if this authenticated node has any interest types, send back those nodes as well
+                limitedNodeList->eachNode([&](const SharedNodePointer& otherNode) {
+                    if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
+                        // since we're about to add a node to the packet we start a segment
+                        domainListPackets->startSegment();
 
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
+                        // don't send avatar nodes to other avatars, that will come from avatar mixer
+                        domainListStream << *otherNode.data();
 
-                    // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+                        // pack the secret that these two nodes will use to communicate with each other
+                        domainListStream << connectionSecretForNodes(node, otherNode);
 
-                    // we've added the node we wanted so end the segment now
-                    domainListPackets->endSegment();
-                }
-            });
+                        // we've added the node we wanted so end the segment now
+                        domainListPackets->endSegment();
+                    }
+                });
+            }
         }
     }
 
-    // send an empty list to the node, in case there were no other nodes
+    nodeData->setLastDomainListVersion(_domainListVersion);
+
+    // close the last packet, which holds at least the header if there were no other nodes
     domainListPackets->closeCurrentPacket(true);
 
     // write the PacketList to this node
     limitedNodeList->sendPacketList(std::move(domainListPackets), *node);
 }
 
+void DomainServer::domainListChanged(const QUuid& nodeID) {
+    // enough for the changes during a few check-in intervals even when every node changes in each of them (as in a
+    // mass join), so that nodes checking in on time are sent deltas - older nodes are sent full lists
+    static const size_t DOMAIN_LIST_CHANGES_PER_NODE = 4;
+    static const size_t MIN_DOMAIN_LIST_CHANGES = 1000;
+    size_t maxDomainListChanges = std::max(MIN_DOMAIN_LIST_CHANGES,
+                                           DOMAIN_LIST_CHANGES_PER_NODE * DependencyManager::get<LimitedNodeList>()->size());
+
+    _domainListChanges.emplace_back(++_domainListVersion, nodeID);
+    while (_domainListChanges.size() > maxDomainListChanges) {
+        _domainListChanges.pop_front();
+    }
+}
+
+bool DomainServer::getDomainListChangesSince(quint64 version, QSet<QUuid>& changedNodeIDs) const {
+    if (version > _domainListVersion) {
+        return false;
+    }
+
+    if (version < _domainListVersion && (_domainListChanges.empty() || _domainListChanges.front().first > version + 1)) {
+        // some of the changes since this version have been dropped
+        return false;
+    }
+
+    for (auto it = _domainListChanges.rbegin(); it != _domainListChanges.rend() && it->first > version; ++it) {
+        changedNodeIDs.insert(it->second);
+    }
+    return true;
+}
+
 QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
     DomainServerNodeData* nodeAData = static_cast<DomainServerNodeData*>(nodeA->getLinkedData());
     DomainServerNodeData* nodeBData = static_cast<DomainServerNodeData*>(nodeB->getLinkedData());
@@ -2191,6 +2262,8 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
     // if this peer connected via ICE then remove them from our ICE peers hash
     _gatekeeper.removeICEPeer(node->getUUID());
 
+    domainListChanged(node->getUUID());
+
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
 
     if (nodeData) {
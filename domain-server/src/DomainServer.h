@@ -12,6 +12,8 @@
 #ifndef hifi_DomainServer_h
 #define hifi_DomainServer_h
 
+#include <deque>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QHash>
 #include <QtCore/QJsonObject>
@@ -130,7 +132,14 @@ private:
 
     void handleKillNode(SharedNodePointer nodeToKill);
 
-    void sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr& senderSockAddr);
+    // sends the node the changes to its domain list since knownVersion, or its full domain list if the changes
+    // since then aren't known
+    void sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr& senderSockAddr,
+                              quint64 knownVersion = 0);
+
+    // records that what other nodes are told about this node, or what it is told about them, has changed
+    void domainListChanged(const QUuid& nodeID);
+    bool getDomainListChangesSince(quint64 version, QSet<QUuid>& changedNodeIDs) const;
 
     bool isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
 
@@ -165,6 +174,9 @@ private:
 
     DomainGatekeeper _gatekeeper;
 
+    quint64 _domainListVersion { 1 };
+    std::deque<std::pair<quint64, QUuid>> _domainListChanges; // the version each node changed at, oldest first
+
     HTTPManager _httpManager;
     HTTPSManager* _httpsManager;
 
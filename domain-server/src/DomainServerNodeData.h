@@ -68,6 +68,16 @@ public:
 
     bool wasAssigned() const { return _wasAssigned; };
     void setWasAssigned(bool wasAssigned) { _wasAssigned = wasAssigned; }
+
+    // the first and the last domain list versions sent to this node, 0 before its first list
+    quint64 getFirstDomainListVersion() const { return _firstDomainListVersion; }
+    quint64 getLastDomainListVersion() const { return _lastDomainListVersion; }
+    void setLastDomainListVersion(quint64 version) {
+        if (_firstDomainListVersion == 0) {
+            _firstDomainListVersion = version;
+        }
+        _lastDomainListVersion = version;
+    }
     
 private:
     QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
@@ -93,6 +103,9 @@ private:
     QString _placeName;
 
     bool _wasAssigned { false };
+
+    quint64 _firstDomainListVersion { 0 };
+    quint64 _lastDomainListVersion { 0 };
 };
 
 #endif // hifi_DomainServerNodeData_h
@@ -1854,6 +1854,13 @@ void Application::initializeGL() {
     _renderEngine->load();
     _renderEngine->registerScene(_main3DScene);
 
+    // Fetch, cull and sort on job threads, as many as the environment asks for (0 to run them on the render thread)
+    static const QString RENDER_JOB_THREADS = "HIFI_RENDER_JOB_THREADS";
+    static const int DEFAULT_RENDER_JOB_THREADS = 2;
+    bool validJobThreads = false;
+    int numJobThreads = QProcessEnvironment::systemEnvironment().value(RENDER_JOB_THREADS).toInt(&validJobThreads);
+    _renderEngine->setNumJobThreads(validJobThreads ? numJobThreads : DEFAULT_RENDER_JOB_THREADS);
+
     // The UI can't be created until the primary OpenGL
     // context is created, because it needs to share
     // texture resources
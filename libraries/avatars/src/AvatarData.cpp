@@ -12,8 +12,10 @@
 
 #include "AvatarData.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <limits>
 #include <stdint.h>
 
 #include <QtCore/QDataStream>
@@ -1843,6 +1845,9 @@ void AvatarData::setRecordingBasis(std::shared_ptr<Transform> recordingBasis) {
         //recordingBasis->setScale(getTargetScale());
     }
     _recordingBasis = recordingBasis;
+    // a new basis starts a new recording, which starts with a key frame
+    _recordedFramesToKeyFrame = 0;
+    _recordedFrameNumber = 0;
 }
 
 void AvatarData::clearRecordingBasis() {
@@ -2054,24 +2059,395 @@ void AvatarData::fromJson(const QJsonObject& json, bool useFrameSkeleton) {
     }
 }
 
+// Recording frames, in the wire format of toByteArray where it applies. Clips recorded before these
+// hold the QJsonDocument binary data of toJson in their frames instead.
+namespace AvatarFramePacket {
+    const char MAGIC[4] = { 'H', 'F', 'A', 'F' };
+    const uint8_t VERSION = 1;
+
+    using Flags = uint8_t;
+    const Flags FRAME_IS_KEY_FRAME   = 1U << 0;  // every joint is in the frame, otherwise only those that changed
+    const Flags FRAME_HAS_BASIS      = 1U << 1;
+    const Flags FRAME_HAS_HEAD       = 1U << 2;
+    const Flags FRAME_HAS_IDENTITY   = 1U << 3;  // in key frames, and those where it changed
+
+    PACKED_BEGIN struct Header {
+        char magic[4];
+        uint8_t version;
+        Flags flags;
+        uint32_t frameNumber;                  // since the start of the recording, to tell the frames that follow
+    } PACKED_END;
+    const size_t HEADER_SIZE = 10;
+
+    // only present if FRAME_HAS_HEAD is set
+    PACKED_BEGIN struct Head {
+        AvatarDataPacket::SixByteQuat orientation;
+        float lookAt[3];                       // relative to the avatar
+        uint16_t numBlendshapeCoefficients;
+        // float blendshapeCoefficients[numBlendshapeCoefficients];
+    } PACKED_END;
+    const size_t HEAD_SIZE = 20;
+
+    // only present if FRAME_HAS_IDENTITY is set
+    PACKED_BEGIN struct Identity {
+        uint32_t size;
+        // uint8_t identity[size];             // skeleton model url, display name, attachments and avatar entities,
+                                               // in a QDataStream as identityByteArray
+    } PACKED_END;
+    const size_t IDENTITY_SIZE = 4;
+
+    PACKED_BEGIN struct FrameTransform {
+        float rotation[4];                     // x, y, z, w
+        float translation[3];
+        float scale[3];
+    } PACKED_END;
+    const size_t FRAME_TRANSFORM_SIZE = 40;
+
+    // basis transform, only present if FRAME_HAS_BASIS is set
+    // relative transform
+    // float scale
+
+    // variable length structure follows, as AvatarDataPacket::JointData with a uint16_t numJoints
+    const size_t JOINT_TRANSLATION_SIZE = 6;   // encoded and compressed by packFloatVec3ToSignedTwoByteFixed()
+
+    const int KEY_FRAME_INTERVAL = 60;
+}
+
+static int packFrameTransform(unsigned char* buffer, const Transform& transform) {
+    AvatarFramePacket::FrameTransform data;
+    auto rotation = transform.getRotation();
+    data.rotation[0] = rotation.x;
+    data.rotation[1] = rotation.y;
+    data.rotation[2] = rotation.z;
+    data.rotation[3] = rotation.w;
+    memcpy(data.translation, &transform.getTranslation(), sizeof(data.translation));
+    memcpy(data.scale, &transform.getScale(), sizeof(data.scale));
+    memcpy(buffer, &data, sizeof(data));
+    return sizeof(data);
+}
+
+static int unpackFrameTransform(const unsigned char* buffer, Transform& transform) {
+    AvatarFramePacket::FrameTransform data;
+    memcpy(&data, buffer, sizeof(data));
+    transform.setRotation(glm::quat(data.rotation[3], data.rotation[0], data.rotation[1], data.rotation[2]));
+    transform.setTranslation(glm::vec3(data.translation[0], data.translation[1], data.translation[2]));
+    transform.setScale(glm::vec3(data.scale[0], data.scale[1], data.scale[2]));
+    return sizeof(data);
+}
+
 // Every frame will store both a basis for the recording and a relative transform
 // This allows the application to decide whether playback should be relative to an avatar's
 // transform at the start of playback, or relative to the transform of the recorded
 // avatar
+QByteArray AvatarData::toRecordingFrame() const {
+    using namespace AvatarFramePacket;
+
+    QByteArray identity;
+    QDataStream identityStream(&identity, QIODevice::Append);
+    _avatarEntitiesLock.withReadLock([&] {
+        identityStream << getSkeletonModelURL() << getDisplayName() << getAttachmentData() << _avatarEntityData;
+    });
+
+    QVector<JointData> jointData;
+    {
+        QReadLocker readLock(&_jointDataLock);
+        jointData = _jointData;
+    }
+    int numJoints = std::min(jointData.size(), (int)std::numeric_limits<uint16_t>::max());
+
+    bool isKeyFrame = _recordedFramesToKeyFrame <= 0 || _lastRecordedJointData.size() != numJoints;
+    if (isKeyFrame) {
+        _recordedFramesToKeyFrame = KEY_FRAME_INTERVAL;
+        _lastRecordedJointData.resize(numJoints);
+    }
+    --_recordedFramesToKeyFrame;
+
+    Header header;
+    memcpy(header.magic, MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.flags = isKeyFrame ? FRAME_IS_KEY_FRAME : 0;
+    header.frameNumber = _recordedFrameNumber++;
+
+    auto recordingBasis = getRecordingBasis();
+    if (recordingBasis) {
+        header.flags |= FRAME_HAS_BASIS;
+    }
+    const HeadData* head = getHeadData();
+    if (head) {
+        header.flags |= FRAME_HAS_HEAD;
+    }
+    if (isKeyFrame || identity != _lastRecordedIdentity) {
+        header.flags |= FRAME_HAS_IDENTITY;
+        _lastRecordedIdentity = identity;
+    }
+
+    int numBlendshapeCoefficients = head ? std::min(head->getBlendshapeCoefficients().size(),
+                                                    (int)std::numeric_limits<uint16_t>::max()) : 0;
+    int validityBytes = (numJoints + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+    size_t maxFrameSize = HEADER_SIZE +
+        HEAD_SIZE + numBlendshapeCoefficients * sizeof(float) +
+        IDENTITY_SIZE + identity.size() +
+        2 * FRAME_TRANSFORM_SIZE + sizeof(float) +
+        sizeof(uint16_t) + 2 * validityBytes + numJoints * (sizeof(AvatarDataPacket::SixByteQuat) + JOINT_TRANSLATION_SIZE);
+
+    QByteArray frame(maxFrameSize, 0);
+    unsigned char* destinationBuffer = reinterpret_cast<unsigned char*>(frame.data());
+    unsigned char* startPosition = destinationBuffer;
+
+    memcpy(destinationBuffer, &header, sizeof(header));
+    destinationBuffer += sizeof(header);
+
+    if (head) {
+        auto data = reinterpret_cast<Head*>(destinationBuffer);
+        packOrientationQuatToSixBytes(data->orientation, head->getRawOrientation());
+        glm::vec3 relativeLookAt;
+        if (head->getLookAtPosition() != glm::vec3()) {
+            relativeLookAt = glm::inverse(getOrientation()) * (head->getLookAtPosition() - getPosition());
+        }
+        memcpy(data->lookAt, &relativeLookAt, sizeof(data->lookAt));
+        data->numBlendshapeCoefficients = (uint16_t)numBlendshapeCoefficients;
+        destinationBuffer += sizeof(Head);
+
+        int blendshapesSize = numBlendshapeCoefficients * sizeof(float);
+        memcpy(destinationBuffer, head->getBlendshapeCoefficients().data(), blendshapesSize);
+        destinationBuffer += blendshapesSize;
+    }
+
+    if (header.flags & FRAME_HAS_IDENTITY) {
+        auto data = reinterpret_cast<Identity*>(destinationBuffer);
+        data->size = (uint32_t)identity.size();
+        destinationBuffer += sizeof(Identity);
+        memcpy(destinationBuffer, identity.constData(), identity.size());
+        destinationBuffer += identity.size();
+    }
+
+    bool success;
+    Transform avatarTransform = getTransform(success);
+    if (!success) {
+        qCWarning(avatars) << "Warning -- AvatarData::toRecordingFrame couldn't get avatar transform";
+    }
+    avatarTransform.setScale(getDomainLimitedScale());
+    if (recordingBasis) {
+        destinationBuffer += packFrameTransform(destinationBuffer, *recordingBasis);
+        destinationBuffer += packFrameTransform(destinationBuffer, recordingBasis->relativeTransform(avatarTransform));
+    } else {
+        destinationBuffer += packFrameTransform(destinationBuffer, avatarTransform);
+    }
+
+    float scale = getDomainLimitedScale();
+    memcpy(destinationBuffer, &scale, sizeof(scale));
+    destinationBuffer += sizeof(scale);
+
+    // Skeleton pose, as the joint data of toByteArray with only the joints that changed since the last recorded frame
+    uint16_t numJointsData = (uint16_t)numJoints;
+    memcpy(destinationBuffer, &numJointsData, sizeof(numJointsData));
+    destinationBuffer += sizeof(numJointsData);
+
+    unsigned char* validityPosition = destinationBuffer;
+    memset(validityPosition, 0, validityBytes);
+    destinationBuffer += validityBytes;
+    for (int i = 0; i < numJoints; i++) {
+        const JointData& data = jointData[i];
+        JointData& lastRecorded = _lastRecordedJointData[i];
+        // The dot product for smaller rotations is a smaller number.
+        // So if the dot() is less than the value, then the rotation is a larger angle of rotation
+        if (isKeyFrame || fabsf(glm::dot(data.rotation, lastRecorded.rotation)) < AVATAR_MIN_ROTATION_DOT) {
+            validityPosition[i / BITS_IN_BYTE] |= (1 << (i % BITS_IN_BYTE));
+            destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
+            lastRecorded.rotation = data.rotation;
+        }
+    }
+
+    validityPosition = destinationBuffer;
+    memset(validityPosition, 0, validityBytes);
+    destinationBuffer += validityBytes;
+    for (int i = 0; i < numJoints; i++) {
+        const JointData& data = jointData[i];
+        JointData& lastRecorded = _lastRecordedJointData[i];
+        if (isKeyFrame || glm::distance(data.translation, lastRecorded.translation) > AVATAR_MIN_TRANSLATION) {
+            validityPosition[i / BITS_IN_BYTE] |= (1 << (i % BITS_IN_BYTE));
+            destinationBuffer +=
+                packFloatVec3ToSignedTwoByteFixed(destinationBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
+            lastRecorded.translation = data.translation;
+        }
+    }
+
+    frame.resize(destinationBuffer - startPosition);
+    return frame;
+}
+
+void AvatarData::fromRecordingFrame(const QByteArray& frameData, bool useFrameSkeleton) {
+    using namespace AvatarFramePacket;
+
+    const unsigned char* startPosition = reinterpret_cast<const unsigned char*>(frameData.constData());
+    const unsigned char* endPosition = startPosition + frameData.size();
+    const unsigned char* sourceBuffer = startPosition;
+
+    #define FRAME_READ_CHECK(ITEM_NAME, SIZE_TO_READ)                                                      \
+        if ((size_t)(endPosition - sourceBuffer) < (size_t)(SIZE_TO_READ)) {                               \
+            qCWarning(avatars) << "AvatarData::fromRecordingFrame frame too small for" << #ITEM_NAME       \
+                << "at offset" << (sourceBuffer - startPosition) << "of" << frameData.size() << "bytes";  \
+            return;                                                                                        \
+        }
+
+    FRAME_READ_CHECK(Header, sizeof(Header));
+    Header header;
+    memcpy(&header, sourceBuffer, sizeof(header));
+    sourceBuffer += sizeof(header);
+    if (header.version > VERSION) {
+        qCWarning(avatars) << "AvatarData::fromRecordingFrame unsupported frame version" << header.version;
+        return;
+    }
+
+    // The head setOrientation likes to overwrite the avatar orientation,
+    // so lets do the head first
+    if (header.flags & FRAME_HAS_HEAD) {
+        FRAME_READ_CHECK(Head, sizeof(Head));
+        Head data;
+        memcpy(&data, sourceBuffer, sizeof(data));
+        sourceBuffer += sizeof(data);
+        int blendshapesSize = data.numBlendshapeCoefficients * sizeof(float);
+        FRAME_READ_CHECK(BlendshapeCoefficients, blendshapesSize);
+
+        if (!_headData) {
+            _headData = new HeadData(this);
+        }
+        glm::quat headOrientation;
+        unpackOrientationQuatFromSixBytes(data.orientation, headOrientation);
+        if (headOrientation != glm::quat()) {
+            _headData->setOrientation(headOrientation);
+        }
+
+        glm::vec3 relativeLookAt(data.lookAt[0], data.lookAt[1], data.lookAt[2]);
+        if (glm::length2(relativeLookAt) > 0.01f) {
+            _headData->setLookAtPosition((getOrientation() * relativeLookAt) + getPosition());
+        }
+
+        if (data.numBlendshapeCoefficients > 0) {
+            QVector<float> blendshapeCoefficients(data.numBlendshapeCoefficients);
+            memcpy(blendshapeCoefficients.data(), sourceBuffer, blendshapesSize);
+            _headData->setBlendshapeCoefficients(blendshapeCoefficients);
+        }
+        sourceBuffer += blendshapesSize;
+    }
+
+    if (header.flags & FRAME_HAS_IDENTITY) {
+        FRAME_READ_CHECK(Identity, sizeof(Identity));
+        Identity data;
+        memcpy(&data, sourceBuffer, sizeof(data));
+        sourceBuffer += sizeof(data);
+        FRAME_READ_CHECK(IdentityData, data.size);
+
+        QByteArray identity = QByteArray::fromRawData(reinterpret_cast<const char*>(sourceBuffer), data.size);
+        QDataStream identityStream(identity);
+        QUrl skeletonModelURL;
+        QString displayName;
+        QVector<AttachmentData> attachments;
+        // the avatar entities that follow are kept in the clip, but not played back
+        identityStream >> skeletonModelURL >> displayName >> attachments;
+        sourceBuffer += data.size;
+
+        if (useFrameSkeleton && !skeletonModelURL.isEmpty() && skeletonModelURL != getSkeletonModelURL()) {
+            setSkeletonModelURL(skeletonModelURL);
+        }
+        if (!displayName.isEmpty() && displayName != getDisplayName()) {
+            setDisplayName(displayName);
+        }
+        setAttachmentData(attachments);
+    }
+
+    // During playback you can either have the recording basis set to the avatar current state
+    // meaning that all playback is relative to this avatars starting position, or
+    // the basis can be loaded from the recording, meaning the playback is relative to the
+    // original avatar location
+    Transform frameBasis;
+    if (header.flags & FRAME_HAS_BASIS) {
+        FRAME_READ_CHECK(BasisTransform, FRAME_TRANSFORM_SIZE);
+        sourceBuffer += unpackFrameTransform(sourceBuffer, frameBasis);
+    }
+    FRAME_READ_CHECK(RelativeTransform, FRAME_TRANSFORM_SIZE + sizeof(float));
+    Transform relativeTransform;
+    sourceBuffer += unpackFrameTransform(sourceBuffer, relativeTransform);
+    float scale;
+    memcpy(&scale, sourceBuffer, sizeof(scale));
+    sourceBuffer += sizeof(scale);
+
+    auto currentBasis = getRecordingBasis();
+    auto worldTransform = currentBasis ? currentBasis->worldTransform(relativeTransform) :
+                                         frameBasis.worldTransform(relativeTransform);
+    setPosition(worldTransform.getTranslation());
+    setOrientation(worldTransform.getRotation());
+    setTargetScale(scale);
+
+    // The joints of a frame are the changes since the frame recorded before it, so after a seek or a loop to a
+    // frame that doesn't follow the one played last, the joints are left as they are until the next key frame
+    bool isFollowingFrame = !_lastPlayedJointData.isEmpty() && header.frameNumber == _lastPlayedFrameNumber + 1;
+    _lastPlayedFrameNumber = header.frameNumber;
+    if (!(header.flags & FRAME_IS_KEY_FRAME) && !isFollowingFrame) {
+        _lastPlayedJointData.clear();
+        return;
+    }
+
+    FRAME_READ_CHECK(NumJoints, sizeof(uint16_t));
+    uint16_t numJoints;
+    memcpy(&numJoints, sourceBuffer, sizeof(numJoints));
+    sourceBuffer += sizeof(numJoints);
+    int validityBytes = (numJoints + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+
+    // Joints missing from a frame keep their value from the frames played before it
+    _lastPlayedJointData.resize(numJoints);
+
+    FRAME_READ_CHECK(JointRotationValidityBits, validityBytes);
+    const unsigned char* validityPosition = sourceBuffer;
+    sourceBuffer += validityBytes;
+    for (int i = 0; i < numJoints; i++) {
+        if (validityPosition[i / BITS_IN_BYTE] & (1 << (i % BITS_IN_BYTE))) {
+            FRAME_READ_CHECK(JointRotation, sizeof(AvatarDataPacket::SixByteQuat));
+            sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, _lastPlayedJointData[i].rotation);
+        }
+    }
+
+    FRAME_READ_CHECK(JointTranslationValidityBits, validityBytes);
+    validityPosition = sourceBuffer;
+    sourceBuffer += validityBytes;
+    for (int i = 0; i < numJoints; i++) {
+        if (validityPosition[i / BITS_IN_BYTE] & (1 << (i % BITS_IN_BYTE))) {
+            FRAME_READ_CHECK(JointTranslation, JOINT_TRANSLATION_SIZE);
+            sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, _lastPlayedJointData[i].translation,
+                                                                  TRANSLATION_COMPRESSION_RADIX);
+        }
+    }
+
+    #undef FRAME_READ_CHECK
+
+    for (int i = 0; i < numJoints; i++) {
+        JointData& joint = _lastPlayedJointData[i];
+        joint.rotationSet = true;
+        joint.translationSet = false;
+        setJointData(i, joint.rotation, joint.translation);
+    }
+    setRawJointData(_lastPlayedJointData);
+}
+
 QByteArray AvatarData::toFrame(const AvatarData& avatar) {
-    QJsonObject root = avatar.toJson();
 #ifdef WANT_JSON_DEBUG
     {
-        QJsonObject obj = root;
+        QJsonObject obj = avatar.toJson();
         obj.remove(JSON_AVATAR_JOINT_ARRAY);
         qCDebug(avatars).noquote() << QJsonDocument(obj).toJson(QJsonDocument::JsonFormat::Indented);
     }
 #endif
-    return QJsonDocument(root).toBinaryData();
+    return avatar.toRecordingFrame();
 }
 
 
 void AvatarData::fromFrame(const QByteArray& frameData, AvatarData& result, bool useFrameSkeleton) {
+    if (frameData.startsWith(QByteArray::fromRawData(AvatarFramePacket::MAGIC, sizeof(AvatarFramePacket::MAGIC)))) {
+        result.fromRecordingFrame(frameData, useFrameSkeleton);
+        return;
+    }
+
+    // older clips hold the json of every frame
     QJsonDocument doc = QJsonDocument::fromBinaryData(frameData);
 
 #ifdef WANT_JSON_DEBUG
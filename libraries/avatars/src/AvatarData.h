@@ -533,6 +533,8 @@ public:
     void setRecordingBasis(TransformPointer recordingBasis = TransformPointer());
     QJsonObject toJson() const;
     void fromJson(const QJsonObject& json, bool useFrameSkeleton = true);
+    QByteArray toRecordingFrame() const;
+    void fromRecordingFrame(const QByteArray& frameData, bool useFrameSkeleton = true);
 
     glm::vec3 getClientGlobalPosition() { return _globalPosition; }
     glm::vec3 getGlobalBoundingBoxCorner() { return _globalPosition + _globalBoundingBoxOffset - _globalBoundingBoxDimensions; }
@@ -649,6 +651,14 @@ protected:
     // During playback, it holds the origin from which to play the relative positions in the clip
     TransformPointer _recordingBasis;
 
+    // Recording frames only hold the joints that changed since the previous frame, between key frames
+    mutable int _recordedFramesToKeyFrame { 0 };
+    mutable uint32_t _recordedFrameNumber { 0 };
+    mutable QVector<JointData> _lastRecordedJointData;
+    mutable QByteArray _lastRecordedIdentity;
+    QVector<JointData> _lastPlayedJointData;
+    uint32_t _lastPlayedFrameNumber { 0 };
+
     // _globalPosition is sent along with localPosition + parent because the avatar-mixer doesn't know
     // where Entities are located.  This is currently only used by the mixer to decide how often to send
     // updates about one avatar to another.
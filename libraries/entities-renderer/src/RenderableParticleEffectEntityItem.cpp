@@ -42,11 +42,7 @@ public:
         glm::vec3 spare;
     };
     
-    struct ParticlePrimitive {
-        ParticlePrimitive(glm::vec3 xyzIn, glm::vec2 uvIn) : xyz(xyzIn), uv(uvIn) {}
-        glm::vec3 xyz; // Position
-        glm::vec2 uv; // Lifetime + seed
-    };
+    using ParticlePrimitive = RenderableParticleEffectEntityItem::ParticlePrimitive;
     
     using Payload = render::Payload<ParticlePayloadData>;
     using Pointer = Payload::DataPointer;
@@ -57,7 +53,6 @@ public:
     using Format = gpu::Stream::Format;
     using Buffer = gpu::Buffer;
     using BufferView = gpu::BufferView;
-    using ParticlePrimitives = std::vector<ParticlePrimitive>;
     
     ParticlePayloadData() {
         ParticleUniforms uniforms;
@@ -217,7 +212,6 @@ void RenderableParticleEffectEntityItem::updateRenderItem() {
     
     using ParticleUniforms = ParticlePayloadData::ParticleUniforms;
     using ParticlePrimitive = ParticlePayloadData::ParticlePrimitive;
-    using ParticlePrimitives = ParticlePayloadData::ParticlePrimitives;
 
     // Fill in Uniforms structure
     ParticleUniforms particleUniforms;
@@ -231,13 +225,6 @@ void RenderableParticleEffectEntityItem::updateRenderItem() {
     particleUniforms.color.spread = glm::vec4(getColorSpreadRGB(), getAlphaSpread());
     particleUniforms.lifespan = getLifespan();
     
-    // Build particle primitives
-    auto particlePrimitives = std::make_shared<ParticlePrimitives>();
-    particlePrimitives->reserve(_particles.size()); // Reserve space
-    for (auto& particle : _particles) {
-        particlePrimitives->emplace_back(particle.position, glm::vec2(particle.lifetime, particle.seed));
-    }
-
     bool successb, successp, successr;
     auto bounds = getAABox(successb);
     auto position = getPosition(successp);
@@ -252,6 +239,23 @@ void RenderableParticleEffectEntityItem::updateRenderItem() {
         transform.setRotation(rotation);
     }
 
+    // Build particle primitives, in those the render thread handed back if it is done with them
+    std::shared_ptr<ParticlePrimitives> particlePrimitives;
+    {
+        std::lock_guard<std::mutex> lock(_particlePrimitivesMutex);
+        particlePrimitives.swap(_spareParticlePrimitives);
+    }
+    if (!particlePrimitives) {
+        particlePrimitives = std::make_shared<ParticlePrimitives>();
+    }
+    size_t numParticles = _particles.size();
+    particlePrimitives->resize(numParticles);
+    for (size_t i = 0; i < numParticles; ++i) {
+        auto& primitive = (*particlePrimitives)[i];
+        primitive.xyz = _particles.getPosition(i);
+        primitive.uv = glm::vec2(_particles.getLifetime(i), _particles.getSeed(i));
+    }
+
 
     render::PendingChanges pendingChanges;
     pendingChanges.updateItem<ParticlePayloadData>(_renderItemId, [=](ParticlePayloadData& payload) {
@@ -264,10 +268,18 @@ void RenderableParticleEffectEntityItem::updateRenderItem() {
         auto particleBuffer = payload.getParticleBuffer();
         size_t numBytes = sizeof(ParticlePrimitive) * particlePrimitives->size();
         particleBuffer->resize(numBytes);
+        if (numBytes > 0) {
+            particleBuffer->setData(numBytes, (const gpu::Byte*)particlePrimitives->data());
+        }
+
+        // the particles are copied, hand them back under the lock so that filling them again next frame is ordered after
+        {
+            std::lock_guard<std::mutex> lock(_particlePrimitivesMutex);
+            _spareParticlePrimitives = particlePrimitives;
+        }
         if (numBytes == 0) {
             return;
         }
-        particleBuffer->setData(numBytes, (const gpu::Byte*)particlePrimitives->data());
 
         // Update transform and bounds
         payload.setModelTransform(transform);
@@ -11,6 +11,8 @@
 #ifndef hifi_RenderableParticleEffectEntityItem_h
 #define hifi_RenderableParticleEffectEntityItem_h
 
+#include <mutex>
+
 #include <ParticleEffectEntityItem.h>
 #include <TextureCache.h>
 #include "RenderableEntityItem.h"
@@ -42,6 +44,16 @@ protected:
     NetworkTexturePointer _texture;
     gpu::PipelinePointer _untexturedPipeline;
     gpu::PipelinePointer _texturedPipeline;
+
+    struct ParticlePrimitive {
+        glm::vec3 xyz; // Position
+        glm::vec2 uv; // Lifetime + seed
+    };
+    using ParticlePrimitives = std::vector<ParticlePrimitive>;
+
+    // the particles sent to the render thread, handed back once it has copied them, to be filled again next frame
+    std::mutex _particlePrimitivesMutex;
+    std::shared_ptr<ParticlePrimitives> _spareParticlePrimitives; // guarded by _particlePrimitivesMutex
 };
 
 
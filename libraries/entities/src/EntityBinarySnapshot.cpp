@@ -0,0 +1,254 @@
+//
+//  EntityBinarySnapshot.cpp
+//  libraries/entities/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityBinarySnapshot.h"
+
+#include <cstddef>
+#include <cstring>
+
+#include <QtCore/QJsonDocument>
+#include <QtScript/QScriptEngine>
+
+#include <OctreePacketData.h>
+#include <udt/PacketHeaders.h>
+
+#include "AddEntityOperator.h"
+#include "EntitiesLogging.h"
+#include "EntityItemProperties.h"
+#include "EntityTree.h"
+#include "EntityTreeElement.h"
+#include "EntityTypes.h"
+#include "VariantMapToScriptValue.h"
+
+static const char SNAPSHOT_MAGIC[4] = { 'H', 'F', 'E', 'S' };
+
+// format version 1 headers end before the persist version
+static const qint64 VERSION_1_HEADER_SIZE = offsetof(EntityBinarySnapshot::Header, persistVersion);
+
+namespace {
+
+// encodes the entity the way the entity server sends it, returns false if a property is too large for a packet
+bool appendBitstream(const EntityItemPointer& entity, QByteArray& data) {
+    OctreePacketData packetData(false, MAX_OCTREE_UNCOMRESSED_PACKET_SIZE);
+    EncodeBitstreamParams params;
+    auto extraEncodeData = std::make_shared<EntityTreeElementExtraEncodeData>();
+
+    int start = data.size();
+    while (true) {
+        packetData.reset();
+        OctreeElement::AppendState appendState = entity->appendEntityData(&packetData, params, extraEncodeData);
+
+        uint32_t chunkSize = packetData.getUncompressedSize();
+        if (appendState == OctreeElement::NONE || chunkSize == 0) {
+            // not even one property fits in an empty packet
+            data.truncate(start);
+            return false;
+        }
+
+        data.append(reinterpret_cast<const char*>(&chunkSize), sizeof(chunkSize));
+        data.append(reinterpret_cast<const char*>(packetData.getUncompressedData()), chunkSize);
+
+        if (appendState == OctreeElement::COMPLETED) {
+            return true;
+        }
+    }
+}
+
+template <typename T>
+T readColumn(const unsigned char* column, uint32_t index) {
+    T value;
+    memcpy(&value, column + index * sizeof(T), sizeof(T));
+    return value;
+}
+
+}
+
+bool EntityBinarySnapshot::isSnapshot(const unsigned char* data, qint64 size) {
+    return size >= VERSION_1_HEADER_SIZE && memcmp(data, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0;
+}
+
+bool EntityBinarySnapshot::write(const QVector<EntityItemPointer>& entities, quint64 persistVersion, QByteArray& snapshot) {
+    uint32_t numEntities = entities.size();
+
+    QByteArray ids;
+    QVector<uint64_t> offsets;
+    QVector<uint32_t> sizes;
+    QVector<uint32_t> types;
+    QVector<uint8_t> encodings;
+    ids.reserve(numEntities * NUM_BYTES_RFC4122_UUID);
+    offsets.reserve(numEntities);
+    sizes.reserve(numEntities);
+    types.reserve(numEntities);
+    encodings.reserve(numEntities);
+
+    QByteArray data;
+    QScriptEngine scriptEngine;
+    int numJSONEntities = 0;
+
+    foreach (const EntityItemPointer& entity, entities) {
+        uint64_t offset = data.size();
+        Encoding encoding = Bitstream;
+
+        if (!appendBitstream(entity, data)) {
+            QScriptValue properties = EntityItemNonDefaultPropertiesToScriptValue(&scriptEngine, entity->getProperties());
+            data.append(QJsonDocument::fromVariant(properties.toVariant()).toJson(QJsonDocument::Compact));
+            encoding = JSON;
+            ++numJSONEntities;
+        }
+
+        ids.append(entity->getID().toRfc4122());
+        offsets << offset;
+        sizes << (uint32_t)(data.size() - offset);
+        types << (uint32_t)entity->getType();
+        encodings << encoding;
+    }
+
+    if (numJSONEntities > 0) {
+        qCDebug(entities) << "Saved" << numJSONEntities << "entities too large for a packet as JSON in the snapshot";
+    }
+
+    Header header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.bitstreamVersion = versionForPacketType(PacketType::EntityData);
+    header.numEntities = numEntities;
+    header.dataOffset = sizeof(Header) + numEntities * (NUM_BYTES_RFC4122_UUID + sizeof(uint64_t) +
+                                                        sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint8_t));
+    header.dataSize = data.size();
+    header.persistVersion = persistVersion;
+
+    snapshot.clear();
+    snapshot.reserve(header.dataOffset + header.dataSize);
+    snapshot.append(reinterpret_cast<const char*>(&header), sizeof(Header));
+    snapshot.append(ids);
+    snapshot.append(reinterpret_cast<const char*>(offsets.constData()), numEntities * sizeof(uint64_t));
+    snapshot.append(reinterpret_cast<const char*>(sizes.constData()), numEntities * sizeof(uint32_t));
+    snapshot.append(reinterpret_cast<const char*>(types.constData()), numEntities * sizeof(uint32_t));
+    snapshot.append(reinterpret_cast<const char*>(encodings.constData()), numEntities * sizeof(uint8_t));
+    snapshot.append(data);
+
+    return true;
+}
+
+bool EntityBinarySnapshot::read(EntityTree& tree, const unsigned char* snapshot, qint64 size, quint64& persistVersion) {
+    if (!isSnapshot(snapshot, size)) {
+        qCWarning(entities) << "Not an entity snapshot";
+        return false;
+    }
+
+    Header header;
+    memcpy(&header, snapshot, VERSION_1_HEADER_SIZE);
+
+    if (header.formatVersion > FORMAT_VERSION) {
+        qCWarning(entities) << "Entity snapshot format version" << header.formatVersion << "is newer than"
+            << FORMAT_VERSION << "- unable to read it";
+        return false;
+    }
+
+    qint64 headerSize = VERSION_1_HEADER_SIZE;
+    header.persistVersion = 0;
+    if (header.formatVersion >= 2) {
+        headerSize = sizeof(Header);
+        if (size < headerSize) {
+            qCWarning(entities) << "Entity snapshot is truncated";
+            return false;
+        }
+        memcpy(&header, snapshot, sizeof(Header));
+    }
+    persistVersion = header.persistVersion;
+    if (header.bitstreamVersion > versionForPacketType(PacketType::EntityData)) {
+        qCWarning(entities) << "Entity snapshot was encoded with a newer entity version" << header.bitstreamVersion
+            << "- unable to read it";
+        return false;
+    }
+
+    uint32_t numEntities = header.numEntities;
+    const unsigned char* idColumn = snapshot + headerSize;
+    const unsigned char* offsetColumn = idColumn + numEntities * NUM_BYTES_RFC4122_UUID;
+    const unsigned char* sizeColumn = offsetColumn + numEntities * sizeof(uint64_t);
+    const unsigned char* typeColumn = sizeColumn + numEntities * sizeof(uint32_t);
+    const unsigned char* encodingColumn = typeColumn + numEntities * sizeof(uint32_t);
+    const unsigned char* data = snapshot + header.dataOffset;
+
+    if ((qint64)(header.dataOffset + header.dataSize) > size || encodingColumn + numEntities > data) {
+        qCWarning(entities) << "Entity snapshot is truncated";
+        return false;
+    }
+
+    ReadBitstreamToTreeParams args;
+    args.bitstreamVersion = header.bitstreamVersion;
+    QScriptEngine scriptEngine;
+
+    bool success = true;
+    for (uint32_t i = 0; i < numEntities; ++i) {
+        uint64_t offset = readColumn<uint64_t>(offsetColumn, i);
+        uint32_t entitySize = readColumn<uint32_t>(sizeColumn, i);
+        if (offset + entitySize > header.dataSize) {
+            success = false;
+            continue;
+        }
+
+        const unsigned char* entityData = data + offset;
+        EntityItemID entityID = QUuid::fromRfc4122(QByteArray::fromRawData(
+            reinterpret_cast<const char*>(idColumn + i * NUM_BYTES_RFC4122_UUID), NUM_BYTES_RFC4122_UUID));
+
+        if (encodingColumn[i] == JSON) {
+            QJsonDocument document = QJsonDocument::fromJson(
+                QByteArray::fromRawData(reinterpret_cast<const char*>(entityData), entitySize));
+            QVariantMap entityMap = document.toVariant().toMap();
+            QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
+            EntityItemProperties properties;
+            EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+            if (!tree.addEntity(entityID, properties)) {
+                qCDebug(entities) << "Adding snapshot entity failed:" << entityID << properties.getType();
+                success = false;
+            }
+            continue;
+        }
+
+        // the chunks of a large entity are read the way a client reads them from consecutive packets
+        EntityItemPointer entity;
+        const unsigned char* chunkAt = entityData;
+        const unsigned char* entityEnd = entityData + entitySize;
+        while (chunkAt + sizeof(uint32_t) <= entityEnd) {
+            uint32_t chunkSize;
+            memcpy(&chunkSize, chunkAt, sizeof(chunkSize));
+            chunkAt += sizeof(chunkSize);
+            if (chunkAt + chunkSize > entityEnd) {
+                break;
+            }
+
+            if (!entity) {
+                entity = EntityTypes::constructEntityItem(chunkAt, chunkSize, args);
+                if (!entity) {
+                    break;
+                }
+            }
+            entity->readEntityDataFromBuffer(chunkAt, chunkSize, args);
+            chunkAt += chunkSize;
+        }
+
+        if (!entity || tree.findEntityByEntityItemID(entity->getEntityItemID())) {
+            qCDebug(entities) << "Reading snapshot entity failed:" << entityID;
+            success = false;
+            continue;
+        }
+
+        if (entity->getCreated() == UNKNOWN_CREATED_TIME) {
+            entity->recordCreationTime();
+        }
+
+        AddEntityOperator theOperator(tree.getThisPointer(), entity);
+        tree.recurseTreeWithOperator(&theOperator);
+        tree.postAddEntity(entity);
+    }
+
+    return success;
+}
@@ -0,0 +1,63 @@
+//
+//  EntityBinarySnapshot.h
+//  libraries/entities/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityBinarySnapshot_h
+#define hifi_EntityBinarySnapshot_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QVector>
+
+#include "EntityItem.h"
+
+class EntityTree;
+
+// A binary snapshot of the entities in a tree, an alternative to the JSON persist file that loads without any parsing
+// of text. Every entity is stored in the encoding the entity server sends it with (EntityItem::appendEntityData), so
+// loading an entity is the same readEntityDataFromBuffer call a client makes.
+//
+// Layout (little-endian), designed to be read straight from a memory-mapped file:
+//
+//    Header
+//    ids         numEntities x 16 bytes (RFC 4122)
+//    offsets     numEntities x uint64, of each entity's data from the start of the data section
+//    sizes       numEntities x uint32
+//    types       numEntities x uint32 (EntityTypes::EntityType)
+//    encodings   numEntities x uint8 (Encoding)
+//    data        for Bitstream entities, one or more chunks of [uint32 size][appendEntityData bytes]
+//                (an entity that does not fit in one octree packet is split the way it is on the wire),
+//                for JSON entities, the entity's properties as a compact JSON object
+//
+class EntityBinarySnapshot {
+public:
+    static const uint32_t FORMAT_VERSION = 2;
+
+    enum Encoding : uint8_t {
+        Bitstream = 0,
+        JSON = 1 // for entities with a property too large to fit in an octree packet
+    };
+
+    struct Header {
+        char magic[4];
+        uint32_t formatVersion;
+        uint32_t bitstreamVersion; // PacketVersion of PacketType::EntityData the entities were encoded with
+        uint32_t numEntities;
+        uint64_t dataOffset;
+        uint64_t dataSize;
+        uint64_t persistVersion; // Octree::getPersistVersion of the tree, added in format version 2
+    };
+
+    static bool write(const QVector<EntityItemPointer>& entities, quint64 persistVersion, QByteArray& snapshot);
+    // adds the entities in the snapshot to the tree (call with the tree write locked)
+    static bool read(EntityTree& tree, const unsigned char* snapshot, qint64 size, quint64& persistVersion);
+
+    static bool isSnapshot(const unsigned char* data, qint64 size);
+};
+
+#endif // hifi_EntityBinarySnapshot_h
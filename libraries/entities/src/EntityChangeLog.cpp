@@ -0,0 +1,40 @@
+//
+//  EntityChangeLog.cpp
+//  libraries/entities/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityChangeLog.h"
+
+quint64 EntityChangeLog::getVersion() const {
+    QMutexLocker locker(&_mutex);
+    return _version;
+}
+
+quint64 EntityChangeLog::record(const EntityItemID& entityID) {
+    QMutexLocker locker(&_mutex);
+    _changes.push_back({ ++_version, entityID });
+    if ((int)_changes.size() > DEFAULT_CAPACITY) {
+        _changes.pop_front();
+    }
+    return _version;
+}
+
+bool EntityChangeLog::getChangesSince(quint64 version, QSet<EntityItemID>& changed) const {
+    QMutexLocker locker(&_mutex);
+    if (version >= _version) {
+        return true;
+    }
+    if (_changes.empty() || _changes.front().version > version + 1) {
+        return false;
+    }
+
+    for (auto it = _changes.rbegin(); it != _changes.rend() && it->version > version; ++it) {
+        changed.insert(it->entityID);
+    }
+    return true;
+}
@@ -0,0 +1,44 @@
+//
+//  EntityChangeLog.h
+//  libraries/entities/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityChangeLog_h
+#define hifi_EntityChangeLog_h
+
+#include <deque>
+
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
+
+#include "EntityItemID.h"
+
+// Numbers every change to the entities of a tree, so a sender that knows the version it last sent can find the
+// entities changed since then without searching the tree. Only the most recent changes are kept.
+class EntityChangeLog {
+public:
+    static const int DEFAULT_CAPACITY = 10000;
+
+    quint64 getVersion() const;
+    quint64 record(const EntityItemID& entityID);
+
+    // adds the entities changed after version to changed, returns false if the oldest of those changes is no longer kept
+    bool getChangesSince(quint64 version, QSet<EntityItemID>& changed) const;
+
+private:
+    struct Change {
+        quint64 version;
+        EntityItemID entityID;
+    };
+
+    mutable QMutex _mutex;
+    quint64 _version { 0 };
+    std::deque<Change> _changes; // oldest first
+};
+
+#endif // hifi_EntityChangeLog_h
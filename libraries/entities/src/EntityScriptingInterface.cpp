@@ -558,7 +558,13 @@ QVector<QUuid> EntityScriptingInterface::findEntities(const glm::vec3& center, f
     PROFILE_RANGE(script_entities, __FUNCTION__);
 
     QVector<QUuid> result;
-    if (_entityTree) {
+    if (auto snapshot = _entityTree ? _entityTree->getSnapshot() : EntityTreeSnapshotPointer()) {
+        QVector<EntitySnapshotPointer> entities;
+        snapshot->findEntities(center, radius, entities);
+        foreach (const EntitySnapshotPointer& entity, entities) {
+            result << entity->getID();
+        }
+    } else if (_entityTree) {
         QVector<EntityItemPointer> entities;
         _entityTree->withReadLock([&] {
             _entityTree->findEntities(center, radius, entities);
@@ -575,7 +581,13 @@ QVector<QUuid> EntityScriptingInterface::findEntitiesInBox(const glm::vec3& corn
     PROFILE_RANGE(script_entities, __FUNCTION__);
 
     QVector<QUuid> result;
-    if (_entityTree) {
+    if (auto snapshot = _entityTree ? _entityTree->getSnapshot() : EntityTreeSnapshotPointer()) {
+        QVector<EntitySnapshotPointer> entities;
+        snapshot->findEntities(AABox(corner, dimensions), entities);
+        foreach (const EntitySnapshotPointer& entity, entities) {
+            result << entity->getID();
+        }
+    } else if (_entityTree) {
         QVector<EntityItemPointer> entities;
         _entityTree->withReadLock([&] {
             AABox box(corner, dimensions);
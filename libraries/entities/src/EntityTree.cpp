@@ -25,6 +25,7 @@
 #include "RecurseOctreeToMapOperator.h"
 #include "LogHandler.h"
 #include "EntityEditFilters.h"
+#include "EntityBinarySnapshot.h"
 
 static const quint64 DELETED_ENTITIES_EXTRA_USECS_TO_CONSIDER = USECS_PER_MSEC * 50;
 const float EntityTree::DEFAULT_MAX_TMP_ENTITY_LIFETIME = 60 * 60; // 1 hour
@@ -91,6 +92,9 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
         foreach(EntityTreeElementPointer element, _entityToElementMap) {
             element->cleanupEntities();
         }
+        foreach(const EntityItemID& entityID, _entityToElementMap.keys()) {
+            recordChange(entityID, true);
+        }
         _entityToElementMap.clear();
     }
     Octree::eraseAllOctreeElements(createNewRoot);
@@ -126,6 +130,7 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
     }
 
     _isDirty = true;
+    recordChange(entity->getEntityItemID(), false);
     emit addingEntity(entity->getEntityItemID());
 
     // find and hook up any entities with this entity as a (previously) missing parent
@@ -192,6 +197,7 @@ bool EntityTree::updateEntityWithElement(EntityItemPointer entity, const EntityI
                 recurseTreeWithOperator(&theOperator);
                 entity->setProperties(tempProperties);
                 _isDirty = true;
+                recordChange(entity->getEntityItemID(), false);
             }
         }
     } else {
@@ -307,6 +313,7 @@ bool EntityTree::updateEntityWithElement(EntityItemPointer entity, const EntityI
         }
 
         _isDirty = true;
+        recordChange(entity->getEntityItemID(), false);
 
         uint32_t newFlags = entity->getDirtyFlags() & ~preFlags;
         if (newFlags) {
@@ -523,6 +530,7 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
         }
 
         theEntity->die();
+        recordChange(theEntity->getEntityItemID(), true);
 
         if (getIsServer()) {
             // set up the deleted entities ID
@@ -1192,6 +1200,11 @@ void EntityTree::entityChanged(EntityItemPointer entity) {
     if (_simulation) {
         _simulation->changeEntity(entity);
     }
+
+    if (_wantSnapshots) {
+        QMutexLocker locker(&_snapshotLock);
+        _snapshotChanges.insert(entity->getEntityItemID());
+    }
 }
 
 void EntityTree::fixupMissingParents() {
@@ -1285,6 +1298,11 @@ void EntityTree::update() {
             }
         });
     }
+
+    if (_wantSnapshots) {
+        // publish this frame's changes for the readers
+        getSnapshot();
+    }
 }
 
 quint64 EntityTree::getAdjustedConsiderSince(quint64 sinceTime) {
@@ -1633,11 +1651,55 @@ bool EntityTree::writeToMap(QVariantMap& entityDescription, OctreeElementPointer
         entityDescription["Entities"] = QVariantList();
     }
     QScriptEngine scriptEngine;
+
+    EntityTreeSnapshotPointer snapshot;
+    if (!element || element == _rootElement) {
+        snapshot = getSnapshot(true);
+    }
+    if (snapshot) {
+        // write the whole tree from the snapshot, rather than reading every entity with the tree locked
+        QVariantList entitiesQList = qvariant_cast<QVariantList>(entityDescription["Entities"]);
+        snapshot->forEachEntity([&](const EntitySnapshotPointer& entity) {
+            if (skipThoseWithBadParents && !entity->isParentIDValid()) {
+                return;
+            }
+            QScriptValue qScriptValues = skipDefaultValues ?
+                EntityItemNonDefaultPropertiesToScriptValue(&scriptEngine, entity->getProperties()) :
+                EntityItemPropertiesToScriptValue(&scriptEngine, entity->getProperties());
+            entitiesQList << qScriptValues.toVariant();
+        });
+        entityDescription["Entities"] = entitiesQList;
+        return true;
+    }
+
     RecurseOctreeToMapOperator theOperator(entityDescription, element, &scriptEngine, skipDefaultValues, skipThoseWithBadParents);
     recurseTreeWithOperator(&theOperator);
     return true;
 }
 
+bool EntityTree::writeToBinary(QByteArray& binaryData, OctreeElementPointer element) {
+    QVector<EntityItemPointer> entities;
+    recurseElementWithOperation(element, [](OctreeElementPointer element, void* extraData) {
+        auto entities = static_cast<QVector<EntityItemPointer>*>(extraData);
+        std::static_pointer_cast<EntityTreeElement>(element)->forEachEntity([&](EntityItemPointer entity) {
+            // like the JSON persist file, leave out entities whose parents are gone
+            if (entity->isParentIDValid()) {
+                entities->push_back(entity);
+            }
+        });
+        return true;
+    }, &entities);
+
+    return EntityBinarySnapshot::write(entities, getPersistVersion(), binaryData);
+}
+
+bool EntityTree::readFromBinary(const unsigned char* binaryData, qint64 size) {
+    quint64 persistVersion = 0;
+    bool success = EntityBinarySnapshot::read(*this, binaryData, size, persistVersion);
+    setPersistVersion(persistVersion);
+    return success;
+}
+
 bool EntityTree::readFromMap(QVariantMap& map) {
     // map will have a top-level list keyed as "Entities".  This will be extracted
     // and iterated over.  Each member of this list is converted to a QVariantMap, then
@@ -1675,6 +1737,230 @@ bool EntityTree::readFromMap(QVariantMap& map) {
     return success;
 }
 
+static const QString JOURNAL_OPERATION = "op";
+static const QString JOURNAL_EDIT = "edit";
+static const QString JOURNAL_DELETE = "delete";
+static const QString JOURNAL_ID = "id";
+static const QString JOURNAL_PROPERTIES = "properties";
+
+void EntityTree::setWantJournal(bool wantJournal) {
+    QWriteLocker locker(&_journalLock);
+    _wantJournal = wantJournal;
+    _journaledChanges.clear();
+}
+
+void EntityTree::recordChange(const EntityItemID& entityID, bool deleted) {
+    _changeLog.record(entityID);
+
+    if (_wantSnapshots) {
+        QMutexLocker locker(&_snapshotLock);
+        _snapshotChanges.insert(entityID);
+    }
+
+    QWriteLocker locker(&_journalLock);
+    if (_wantJournal) {
+        _journaledChanges[entityID] = deleted;
+    }
+}
+
+void EntityTree::setWantSnapshots(bool wantSnapshots) {
+    withReadLock([&] {
+        QList<EntityItemID> entityIDs;
+        if (wantSnapshots) {
+            QReadLocker locker(&_entityToElementLock);
+            entityIDs = _entityToElementMap.keys();
+        }
+
+        QMutexLocker locker(&_snapshotLock);
+        _wantSnapshots = wantSnapshots;
+        _snapshotChanges.clear();
+        if (wantSnapshots) {
+            // the first version has every entity
+            _snapshot = std::make_shared<EntityTreeSnapshot>();
+            for (auto& entityID : entityIDs) {
+                _snapshotChanges.insert(entityID);
+            }
+        } else {
+            _snapshot.reset();
+        }
+    });
+}
+
+EntityTreeSnapshotPointer EntityTree::getSnapshot(bool wantLatest) {
+    if (!_wantSnapshots) {
+        return EntityTreeSnapshotPointer();
+    }
+
+    bool hasChanges;
+    {
+        QMutexLocker locker(&_snapshotLock);
+        hasChanges = !_snapshotChanges.isEmpty();
+    }
+
+    if (hasChanges) {
+        if (wantLatest) {
+            withReadLock([&] {
+                QMutexLocker publishLocker(&_snapshotPublishLock);
+                publishSnapshot();
+            });
+        } else {
+            // a reader that can't have the lock right away keeps reading the last version
+            withTryReadLock([&] {
+                if (_snapshotPublishLock.tryLock()) {
+                    publishSnapshot();
+                    _snapshotPublishLock.unlock();
+                }
+            });
+        }
+    }
+
+    QMutexLocker locker(&_snapshotLock);
+    return _snapshot;
+}
+
+void EntityTree::publishSnapshot() {
+    EntityTreeSnapshotPointer previous;
+    QSet<EntityItemID> changes;
+    {
+        QMutexLocker locker(&_snapshotLock);
+        previous = _snapshot;
+        changes.swap(_snapshotChanges);
+    }
+    if (!previous || changes.isEmpty()) {
+        return;
+    }
+
+    QVector<EntitySnapshotPointer> changed;
+    QVector<EntityItemID> removed;
+    for (auto& entityID : changes) {
+        EntityItemPointer entity = findEntityByEntityItemID(entityID);
+        if (entity) {
+            changed.push_back(std::make_shared<EntitySnapshot>(*entity));
+        } else {
+            removed.push_back(entityID);
+        }
+    }
+
+    auto snapshot = std::make_shared<EntityTreeSnapshot>(*previous, changed, removed);
+
+    QMutexLocker locker(&_snapshotLock);
+    if (_snapshot == previous) {
+        _snapshot = snapshot;
+    }
+}
+
+bool EntityTree::getElementsChangedSince(quint64 version, QVector<OctreeElementPointer>& elements) {
+    // past this many changes, a scene from the root visits fewer elements than the scenes for each change
+    const int MAX_CHANGES_FOR_ELEMENT_SCENES = 1000;
+
+    QSet<EntityItemID> changed;
+    if (!_changeLog.getChangesSince(version, changed) || changed.size() > MAX_CHANGES_FOR_ELEMENT_SCENES) {
+        return false;
+    }
+
+    // an element's entities are encoded along with its siblings, by its parent
+    QSet<OctreeElement*> added;
+    for (auto& entityID : changed) {
+        EntityTreeElementPointer containingElement = getContainingElement(entityID);
+        if (!containingElement) {
+            continue; // deleted, deletes are sent separately
+        }
+
+        OctreeElementPointer parent;
+        if (containingElement != _rootElement) {
+            nodeForOctalCode(_rootElement, containingElement->getOctalCode(), &parent);
+        }
+        if (!parent) {
+            parent = _rootElement;
+        }
+        if (!added.contains(parent.get())) {
+            added.insert(parent.get());
+            elements.push_back(parent);
+        }
+    }
+    return true;
+}
+
+void EntityTree::takeJournalRecords(QVariantList& records) {
+    QHash<EntityItemID, bool> changes;
+    {
+        QWriteLocker locker(&_journalLock);
+        changes.swap(_journaledChanges);
+    }
+
+    // an entity edited several times since the last call only gets one record, holding all of its properties - they
+    // are copied with the tree locked, and turned into records after it is unlocked
+    QVector<QPair<EntityItemID, EntityItemProperties>> edits;
+    QVector<EntityItemID> deletes;
+    withReadLock([&] {
+        for (auto itr = changes.begin(); itr != changes.end(); ++itr) {
+            EntityItemPointer entity = itr.value() ? nullptr : findEntityByEntityItemID(itr.key());
+            if (entity) {
+                edits.push_back({ itr.key(), entity->getProperties() });
+            } else {
+                deletes.push_back(itr.key());
+            }
+        }
+    });
+
+    QScriptEngine scriptEngine;
+    for (auto& edit : edits) {
+        QVariantMap record;
+        record[JOURNAL_ID] = edit.first.toString();
+        record[JOURNAL_OPERATION] = JOURNAL_EDIT;
+        record[JOURNAL_PROPERTIES] = EntityItemPropertiesToScriptValue(&scriptEngine, edit.second).toVariant();
+        records << record;
+    }
+    for (auto& entityID : deletes) {
+        QVariantMap record;
+        record[JOURNAL_ID] = entityID.toString();
+        record[JOURNAL_OPERATION] = JOURNAL_DELETE;
+        records << record;
+    }
+}
+
+bool EntityTree::replayJournalRecords(const QVariantList& records) {
+    QScriptEngine scriptEngine;
+    QSet<EntityItemID> deletedIDs;
+
+    bool success = true;
+    foreach (const QVariant& recordVariant, records) {
+        QVariantMap record = recordVariant.toMap();
+        EntityItemID entityID = EntityItemID(QUuid(record[JOURNAL_ID].toString()));
+        if (entityID.isNull()) {
+            success = false;
+            continue;
+        }
+
+        if (record[JOURNAL_OPERATION].toString() == JOURNAL_DELETE) {
+            deletedIDs << entityID;
+            continue;
+        }
+        deletedIDs.remove(entityID);
+
+        QScriptValue entityScriptValue = variantMapToScriptValue(record[JOURNAL_PROPERTIES].toMap(), scriptEngine);
+        EntityItemProperties properties;
+        EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+
+        EntityItemPointer entity = findEntityByEntityItemID(entityID);
+        if (entity) {
+            // the record is the state the entity was persisted with, so it skips the checks an edit from a client gets
+            EntityTreeElementPointer containingElement = getContainingElement(entityID);
+            AACube queryCube = properties.queryAACubeChanged() ? properties.getQueryAACube() : entity->getQueryAACube();
+            UpdateEntityOperator theOperator(getThisPointer(), containingElement, entity, queryCube);
+            recurseTreeWithOperator(&theOperator);
+            entity->setProperties(properties);
+        } else if (!addEntity(entityID, properties)) {
+            qCDebug(entities) << "replaying journal, adding Entity failed:" << entityID << properties.getType();
+            success = false;
+        }
+    }
+
+    deleteEntities(deletedIDs, true);
+
+    return success;
+}
+
 void EntityTree::resetClientEditStats() {
     _treeResetTime = usecTimestampNow();
     _maxEditDelta = 0;
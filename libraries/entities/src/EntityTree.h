@@ -12,6 +12,8 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <atomic>
+
 #include <QSet>
 #include <QVector>
 
@@ -22,6 +24,8 @@ class EntityTree;
 typedef std::shared_ptr<EntityTree> EntityTreePointer;
 
 
+#include "EntityChangeLog.h"
+#include "EntityTreeSnapshot.h"
 #include "EntityTreeElement.h"
 #include "DeleteEntityOperator.h"
 
@@ -225,6 +229,26 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription) override;
+    virtual bool writeToBinary(QByteArray& binaryData, OctreeElementPointer element) override;
+    virtual bool readFromBinary(const unsigned char* binaryData, qint64 size) override;
+
+    virtual bool canJournal() const override { return true; }
+    virtual void setWantJournal(bool wantJournal) override;
+    virtual void takeJournalRecords(QVariantList& records) override;
+    virtual bool replayJournalRecords(const QVariantList& records) override;
+
+    virtual quint64 getChangeVersion() const override { return _changeLog.getVersion(); }
+    virtual bool getElementsChangedSince(quint64 version, QVector<OctreeElementPointer>& elements) override;
+
+    // records a change to an entity in the change log, and in the journal when the persist thread wants one
+    void recordChange(const EntityItemID& entityID, bool deleted);
+
+    // when snapshots are wanted, readers can get an immutable version of the entities without locking the tree.
+    // getSnapshot publishes the changes since the last version if it can get the tree's read lock without waiting,
+    // unless wantLatest is set, then it waits for the lock (call it with the tree unlocked or read locked)
+    bool wantsSnapshots() const { return _wantSnapshots; }
+    void setWantSnapshots(bool wantSnapshots);
+    EntityTreeSnapshotPointer getSnapshot(bool wantLatest = false);
 
     glm::vec3 getContentsDimensions();
     float getContentsLargestDimension();
@@ -350,6 +374,21 @@ protected:
     quint64 _maxEditDelta = 0;
     quint64 _treeResetTime = 0;
 
+    EntityChangeLog _changeLog;
+
+    void publishSnapshot(); // call with the tree locked and _snapshotPublishLock held
+
+    std::atomic<bool> _wantSnapshots { false };
+    QMutex _snapshotPublishLock;
+    mutable QMutex _snapshotLock; // guards the two below
+    EntityTreeSnapshotPointer _snapshot;
+    QSet<EntityItemID> _snapshotChanges; // entities changed since the snapshot was published
+
+    // changes since the persist thread last took the journal records, only tracked when it wants a journal
+    mutable QReadWriteLock _journalLock;
+    bool _wantJournal { false };
+    QHash<EntityItemID, bool> _journaledChanges; // true if the entity was deleted
+
     void fixupMissingParents(); // try to hook members of _missingParent to parent instances
     QVector<EntityItemWeakPointer> _missingParent; // entites with a parentID but no (yet) known parent instance
     mutable QReadWriteLock _missingParentLock;
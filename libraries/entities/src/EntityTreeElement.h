@@ -14,6 +14,9 @@
 
 #include <memory>
 
+#include <glm/gtx/transform.hpp>
+
+#include <GeometryUtil.h>
 #include <OctreeElement.h>
 #include <QList>
 
@@ -199,6 +202,12 @@ public:
     /// \param entities[out] vector of non-const EntityItemPointer
     void getEntities(const ViewFrustum& frustum, QVector<EntityItemPointer>& foundEntities);
 
+    /// the tests the getEntities above make of each entity, for an EntityItem or an EntitySnapshot of one
+    template <typename Entity>
+    static bool entityTouchesSphere(const Entity& entity, const glm::vec3& searchPosition, float searchRadius);
+    template <typename Entity>
+    static bool entityTouchesBox(const Entity& entity, const AABox& box);
+
     EntityItemPointer getEntityWithID(uint32_t id) const;
     EntityItemPointer getEntityWithEntityItemID(const EntityItemID& id) const;
     void getEntitiesInside(const AACube& box, QVector<EntityItemPointer>& foundEntities);
@@ -244,4 +253,56 @@ protected:
     EntityItems _entityItems;
 };
 
+template <typename Entity>
+bool EntityTreeElement::entityTouchesSphere(const Entity& entity, const glm::vec3& searchPosition, float searchRadius) {
+    bool success;
+    AABox entityBox = entity.getAABox(success);
+
+    // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
+    glm::vec3 penetration;
+    if (success && !entityBox.findSpherePenetration(searchPosition, searchRadius, penetration)) {
+        return false;
+    }
+
+    glm::vec3 dimensions = entity.getDimensions();
+
+    // FIXME - consider allowing the entity to determine penetration so that
+    //         entities could presumably dull actuall hull testing if they wanted to
+    // FIXME - handle entity.getShapeType() == SHAPE_TYPE_SPHERE case better in particular
+    //         can we handle the ellipsoid case better? We only currently handle perfect spheres
+    //         with centered registration points
+    if (entity.getShapeType() == SHAPE_TYPE_SPHERE && (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
+        // NOTE: entity.getRadius() doesn't return the true radius, it returns the radius of the
+        //       maximum bounding sphere, which is actually larger than our actual radius
+        float entityTrueRadius = dimensions.x / 2.0f;
+
+        glm::vec3 centerPosition = entity.getCenterPosition(success);
+        return findSphereSpherePenetration(searchPosition, searchRadius, centerPosition, entityTrueRadius, penetration) &&
+            success;
+    }
+
+    // determine the worldToEntityMatrix that doesn't include scale because
+    // we're going to use the registration aware aa box in the entity frame
+    glm::mat4 rotation = glm::mat4_cast(entity.getRotation());
+    glm::mat4 translation = glm::translate(entity.getPosition());
+    glm::mat4 entityToWorldMatrix = translation * rotation;
+    glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+
+    glm::vec3 registrationPoint = entity.getRegistrationPoint();
+    glm::vec3 corner = -(dimensions * registrationPoint);
+
+    AABox entityFrameBox(corner, dimensions);
+
+    glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(searchPosition, 1.0f));
+    return entityFrameBox.findSpherePenetration(entityFrameSearchPosition, searchRadius, penetration);
+}
+
+template <typename Entity>
+bool EntityTreeElement::entityTouchesBox(const Entity& entity, const AABox& box) {
+    bool success;
+    AABox entityBox = entity.getAABox(success);
+    // If the entities AABox touches the search box then consider it to be found
+    return !success || entityBox.touches(box);
+}
+
 #endif // hifi_EntityTreeElement_h
@@ -0,0 +1,166 @@
+//
+//  EntityTreeSnapshot.cpp
+//  libraries/entities/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeSnapshot.h"
+
+#include "EntityItem.h"
+#include "EntityTreeElement.h"
+
+// the cube of the root element of every octree
+static const AACube ROOT_CUBE(glm::vec3((float)-HALF_TREE_SCALE), (float)TREE_SCALE);
+
+EntitySnapshot::EntitySnapshot(const EntityItem& entity) :
+    _id(entity.getEntityItemID()),
+    _properties(entity.getProperties()),
+    _isParentIDValid(entity.isParentIDValid()),
+    _elementCube(entity.getElement() ? entity.getElement()->getAACube() : ROOT_CUBE),
+    _shapeType(entity.getShapeType()),
+    _dimensions(entity.getDimensions()),
+    _position(entity.getPosition()),
+    _rotation(entity.getRotation()),
+    _registrationPoint(entity.getRegistrationPoint())
+{
+    _aaBox = entity.getAABox(_hasAABox);
+    _centerPosition = entity.getCenterPosition(_hasCenterPosition);
+}
+
+EntityTreeSnapshot::EntityTreeSnapshot(const EntityTreeSnapshot& previous, const QVector<EntitySnapshotPointer>& changed,
+                                       const QVector<EntityItemID>& removed) :
+    _shards(previous._shards),
+    _root(previous._root),
+    _version(previous._version + 1),
+    _numEntities(previous._numEntities)
+{
+    // copy each shard that changes once, the rest stay shared with the previous version
+    std::array<std::shared_ptr<Shard>, NUM_SHARDS> copied;
+    auto shardToChange = [&](const EntityItemID& entityID) -> Shard& {
+        int index = shardFor(entityID);
+        if (!copied[index]) {
+            copied[index] = _shards[index] ? std::make_shared<Shard>(*_shards[index]) : std::make_shared<Shard>();
+            _shards[index] = copied[index];
+        }
+        return *copied[index];
+    };
+
+    // and each element that changes once, the entities leave the elements that held them in the previous version
+    CopiedElements copiedElements;
+    auto removeFromElement = [&](const EntityItemID& entityID) {
+        EntitySnapshotPointer entity = previous.findEntity(entityID);
+        if (entity) {
+            elementToChange(entity->getElementCube(), copiedElements).entities.removeOne(entity);
+        }
+    };
+
+    for (auto& entityID : removed) {
+        int index = shardFor(entityID);
+        if (_shards[index] && _shards[index]->contains(entityID)) {
+            removeFromElement(entityID);
+            shardToChange(entityID).remove(entityID);
+            --_numEntities;
+        }
+    }
+
+    for (auto& entity : changed) {
+        removeFromElement(entity->getID());
+        elementToChange(entity->getElementCube(), copiedElements).entities.push_back(entity);
+
+        Shard& shard = shardToChange(entity->getID());
+        auto it = shard.find(entity->getID());
+        if (it == shard.end()) {
+            shard.insert(entity->getID(), entity);
+            ++_numEntities;
+        } else {
+            it.value() = entity;
+        }
+    }
+}
+
+EntityTreeSnapshot::Element& EntityTreeSnapshot::elementToChange(const AACube& cube, CopiedElements& copied) {
+    ElementPointer* slot = &_root;
+    AACube slotCube = ROOT_CUBE;
+    while (true) {
+        Element* element = *slot ? copied.value(slot->get()) : nullptr;
+        if (!element) {
+            auto copy = *slot ? std::make_shared<Element>(**slot) : std::make_shared<Element>();
+            copy->cube = slotCube;
+            element = copy.get();
+            copied.insert(element, element);
+            *slot = copy;
+        }
+
+        if (element->cube.getScale() <= cube.getScale()) {
+            return *element;
+        }
+
+        // descend into the child holding the center of the cube
+        float childScale = element->cube.getScale() / 2.0f;
+        glm::vec3 childCorner = element->cube.getCorner();
+        glm::vec3 center = cube.calcCenter();
+        glm::vec3 elementCenter = element->cube.calcCenter();
+        int childIndex = 0;
+        for (int i = 0; i < 3; ++i) {
+            if (center[i] >= elementCenter[i]) {
+                childIndex |= 1 << i;
+                childCorner[i] += childScale;
+            }
+        }
+        slot = &element->children[childIndex];
+        slotCube = AACube(childCorner, childScale);
+    }
+}
+
+EntitySnapshotPointer EntityTreeSnapshot::findEntity(const EntityItemID& entityID) const {
+    auto& shard = _shards[shardFor(entityID)];
+    return shard ? shard->value(entityID) : EntitySnapshotPointer();
+}
+
+template <typename CubeTest, typename EntityTest>
+void EntityTreeSnapshot::findEntities(const Element& element, CubeTest cubeTest, EntityTest entityTest,
+                                      QVector<EntitySnapshotPointer>& foundEntities) {
+    // if this element doesn't touch the search, then none of its children can, so stop searching
+    if (!cubeTest(element.cube)) {
+        return;
+    }
+
+    for (auto& entity : element.entities) {
+        if (entityTest(*entity)) {
+            foundEntities.push_back(entity);
+        }
+    }
+    for (auto& child : element.children) {
+        if (child) {
+            findEntities(*child, cubeTest, entityTest, foundEntities);
+        }
+    }
+}
+
+void EntityTreeSnapshot::findEntities(const glm::vec3& center, float radius,
+                                      QVector<EntitySnapshotPointer>& foundEntities) const {
+    if (!_root) {
+        return;
+    }
+    findEntities(*_root, [&](const AACube& cube) {
+        glm::vec3 penetration;
+        return cube.findSpherePenetration(center, radius, penetration);
+    }, [&](const EntitySnapshot& entity) {
+        return EntityTreeElement::entityTouchesSphere(entity, center, radius);
+    }, foundEntities);
+}
+
+void EntityTreeSnapshot::findEntities(const AABox& box, QVector<EntitySnapshotPointer>& foundEntities) const {
+    if (!_root) {
+        return;
+    }
+    findEntities(*_root, [&](const AACube& cube) {
+        return cube.touches(box);
+    }, [&](const EntitySnapshot& entity) {
+        return EntityTreeElement::entityTouchesBox(entity, box);
+    }, foundEntities);
+}
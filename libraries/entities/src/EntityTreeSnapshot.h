@@ -0,0 +1,129 @@
+//
+//  EntityTreeSnapshot.h
+//  libraries/entities/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeSnapshot_h
+#define hifi_EntityTreeSnapshot_h
+
+#include <array>
+#include <memory>
+
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+
+#include <AABox.h>
+#include <AACube.h>
+#include <OctreeConstants.h>
+#include <ShapeInfo.h>
+
+#include "EntityItemID.h"
+#include "EntityItemProperties.h"
+
+class EntityItem;
+
+// The state of one entity when a snapshot was published, never changed once made
+class EntitySnapshot {
+public:
+    EntitySnapshot(const EntityItem& entity); // call with the entity's tree locked
+
+    const EntityItemID& getID() const { return _id; }
+    const EntityItemProperties& getProperties() const { return _properties; }
+    bool isParentIDValid() const { return _isParentIDValid; }
+    // the cube of the octree element that held the entity
+    const AACube& getElementCube() const { return _elementCube; }
+
+    // the state EntityTreeElement::entityTouchesSphere and entityTouchesBox test, named as on EntityItem
+    AABox getAABox(bool& success) const { success = _hasAABox; return _aaBox; }
+    ShapeType getShapeType() const { return _shapeType; }
+    const glm::vec3& getDimensions() const { return _dimensions; }
+    const glm::vec3& getPosition() const { return _position; }
+    const glm::quat& getRotation() const { return _rotation; }
+    const glm::vec3& getRegistrationPoint() const { return _registrationPoint; }
+    glm::vec3 getCenterPosition(bool& success) const { success = _hasCenterPosition; return _centerPosition; }
+
+private:
+    EntityItemID _id;
+    EntityItemProperties _properties;
+    bool _isParentIDValid;
+    AACube _elementCube;
+
+    bool _hasAABox;
+    AABox _aaBox;
+    ShapeType _shapeType;
+    glm::vec3 _dimensions;
+    glm::vec3 _position;
+    glm::quat _rotation;
+    glm::vec3 _registrationPoint;
+    bool _hasCenterPosition;
+    glm::vec3 _centerPosition;
+};
+
+using EntitySnapshotPointer = std::shared_ptr<const EntitySnapshot>;
+
+// An immutable version of the entities in a tree, which readers can hold on to and search without locking the tree.
+// The tree publishes a new version with the entities changed since the last one. The entities are kept in shards
+// that are shared with the previous version, so publishing copies only the shards holding the changed entities.
+// They are also kept in the octree elements that held them, so a search visits only the elements it touches, as it
+// does in the tree - the elements are shared the same way, publishing copies only those on the way to a change.
+class EntityTreeSnapshot {
+public:
+    static const int NUM_SHARDS = 64;
+
+    EntityTreeSnapshot() = default;
+    // the next version after previous, with the changed entities added or replaced and the removed ones left out
+    EntityTreeSnapshot(const EntityTreeSnapshot& previous, const QVector<EntitySnapshotPointer>& changed,
+                       const QVector<EntityItemID>& removed);
+
+    quint64 getVersion() const { return _version; }
+    int getNumEntities() const { return _numEntities; }
+
+    EntitySnapshotPointer findEntity(const EntityItemID& entityID) const;
+    void findEntities(const glm::vec3& center, float radius, QVector<EntitySnapshotPointer>& foundEntities) const;
+    void findEntities(const AABox& box, QVector<EntitySnapshotPointer>& foundEntities) const;
+
+    template <typename F>
+    void forEachEntity(F f) const {
+        for (auto& shard : _shards) {
+            if (shard) {
+                for (auto& entity : *shard) {
+                    f(entity);
+                }
+            }
+        }
+    }
+
+private:
+    using Shard = QHash<EntityItemID, EntitySnapshotPointer>;
+
+    struct Element {
+        AACube cube;
+        std::array<std::shared_ptr<const Element>, NUMBER_OF_CHILDREN> children; // null for an empty child
+        QVector<EntitySnapshotPointer> entities;
+    };
+    using ElementPointer = std::shared_ptr<const Element>;
+    using CopiedElements = QHash<const Element*, Element*>;
+
+    static int shardFor(const EntityItemID& entityID) { return qHash(entityID) % NUM_SHARDS; }
+
+    // the element with the cube, copying the elements on the way to it that are shared with the previous version
+    Element& elementToChange(const AACube& cube, CopiedElements& copied);
+
+    template <typename CubeTest, typename EntityTest>
+    static void findEntities(const Element& element, CubeTest cubeTest, EntityTest entityTest,
+                             QVector<EntitySnapshotPointer>& foundEntities);
+
+    std::array<std::shared_ptr<const Shard>, NUM_SHARDS> _shards; // null for an empty shard
+    ElementPointer _root;
+    quint64 _version { 0 };
+    int _numEntities { 0 };
+};
+
+using EntityTreeSnapshotPointer = std::shared_ptr<const EntityTreeSnapshot>;
+
+#endif // hifi_EntityTreeSnapshot_h
@@ -0,0 +1,162 @@
+//
+//  ParticleArrays.cpp
+//  libraries/entities/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParticleArrays.h"
+
+#include <algorithm>
+
+void ParticleArrays::clear() {
+    // keeps the capacity, for the next particles
+    _begin = 0;
+    _seed.clear();
+    _lifetime.clear();
+    _x.clear();
+    _y.clear();
+    _z.clear();
+    _vx.clear();
+    _vy.clear();
+    _vz.clear();
+    _ax.clear();
+    _ay.clear();
+    _az.clear();
+}
+
+void ParticleArrays::push_back(float seed, float lifetime, const glm::vec3& position, const glm::vec3& velocity,
+                               const glm::vec3& acceleration) {
+    // reuse the room of the dropped particles rather than grow, once they are as many as the live ones
+    if (_begin > 0 && _begin >= size() && _seed.size() == _seed.capacity()) {
+        compact();
+    }
+    _seed.push_back(seed);
+    _lifetime.push_back(lifetime);
+    _x.push_back(position.x);
+    _y.push_back(position.y);
+    _z.push_back(position.z);
+    _vx.push_back(velocity.x);
+    _vy.push_back(velocity.y);
+    _vz.push_back(velocity.z);
+    _ax.push_back(acceleration.x);
+    _ay.push_back(acceleration.y);
+    _az.push_back(acceleration.z);
+}
+
+void ParticleArrays::pop_front(size_t count) {
+    _begin += std::min(count, size());
+    if (empty()) {
+        clear();
+    }
+}
+
+void ParticleArrays::compact() {
+    auto drop = [this](std::vector<float>& values) {
+        values.erase(values.begin(), values.begin() + _begin);
+    };
+    drop(_seed);
+    drop(_lifetime);
+    drop(_x);
+    drop(_y);
+    drop(_z);
+    drop(_vx);
+    drop(_vy);
+    drop(_vz);
+    drop(_ax);
+    drop(_ay);
+    drop(_az);
+    _begin = 0;
+}
+
+ParticleArrays::Arrays ParticleArrays::getArrays() {
+    return Arrays {
+        _lifetime.data() + _begin,
+        _x.data() + _begin, _y.data() + _begin, _z.data() + _begin,
+        _vx.data() + _begin, _vy.data() + _begin, _vz.data() + _begin,
+        _ax.data() + _begin, _ay.data() + _begin, _az.data() + _begin,
+        size()
+    };
+}
+
+void ParticleArrays::stepSimulation(float deltaTime, float lifespan) {
+    if (empty()) {
+        return;
+    }
+    integrate(getArrays(), deltaTime);
+
+    // the particles are kept in the order they were emitted, and all age together, so those that died are the oldest
+    size_t numDead = 0;
+    size_t numParticles = size();
+    while (numDead < numParticles && _lifetime[_begin + numDead] >= lifespan) {
+        ++numDead;
+    }
+    pop_front(numDead);
+}
+
+void ParticleArrays::integrate_ref(const Arrays& particles, float deltaTime, size_t begin) {
+    float halfDeltaTimeSquared = 0.5f * deltaTime * deltaTime;
+    for (size_t i = begin; i < particles.size; ++i) {
+        particles.lifetime[i] += deltaTime;
+        particles.x[i] += particles.vx[i] * deltaTime + particles.ax[i] * halfDeltaTimeSquared;
+        particles.y[i] += particles.vy[i] * deltaTime + particles.ay[i] * halfDeltaTimeSquared;
+        particles.z[i] += particles.vz[i] * deltaTime + particles.az[i] * halfDeltaTimeSquared;
+        particles.vx[i] += particles.ax[i] * deltaTime;
+        particles.vy[i] += particles.ay[i] * deltaTime;
+        particles.vz[i] += particles.az[i] * deltaTime;
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+// on x86 architecture, assume that SSE2 is present
+#include <emmintrin.h>
+
+// The position along one axis, moved on by the velocity and acceleration, which is then moved on by the acceleration
+static inline void integrateAxis_SSE2(float* position, float* velocity, const float* acceleration,
+                                      __m128 deltaTime, __m128 halfDeltaTimeSquared) {
+    __m128 p = _mm_loadu_ps(position);
+    __m128 v = _mm_loadu_ps(velocity);
+    __m128 a = _mm_loadu_ps(acceleration);
+    p = _mm_add_ps(p, _mm_add_ps(_mm_mul_ps(v, deltaTime), _mm_mul_ps(a, halfDeltaTimeSquared)));
+    v = _mm_add_ps(v, _mm_mul_ps(a, deltaTime));
+    _mm_storeu_ps(position, p);
+    _mm_storeu_ps(velocity, v);
+}
+
+size_t ParticleArrays::integrate_SSE2(const Arrays& particles, float deltaTime) {
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 halfDtSquared = _mm_set1_ps(0.5f * deltaTime * deltaTime);
+    size_t end = particles.size & ~(size_t)3;
+
+    for (size_t i = 0; i < end; i += 4) {
+        _mm_storeu_ps(&particles.lifetime[i], _mm_add_ps(_mm_loadu_ps(&particles.lifetime[i]), dt));
+        integrateAxis_SSE2(&particles.x[i], &particles.vx[i], &particles.ax[i], dt, halfDtSquared);
+        integrateAxis_SSE2(&particles.y[i], &particles.vy[i], &particles.ay[i], dt, halfDtSquared);
+        integrateAxis_SSE2(&particles.z[i], &particles.vz[i], &particles.az[i], dt, halfDtSquared);
+    }
+    return end;
+}
+
+//
+// Runtime CPU dispatch
+//
+
+#include <CPUDetect.h>
+
+void ParticleArrays::integrate(const Arrays& particles, float deltaTime) {
+    static auto f = cpuSupportsAVX2() ? &ParticleArrays::integrate_AVX2 : &ParticleArrays::integrate_SSE2;
+    size_t begin = (*f)(particles, deltaTime);  // dispatch
+    integrate_ref(particles, deltaTime, begin);
+}
+
+#else
+
+void ParticleArrays::integrate(const Arrays& particles, float deltaTime) {
+    integrate_ref(particles, deltaTime, 0);
+}
+
+#endif
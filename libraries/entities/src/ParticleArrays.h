@@ -0,0 +1,74 @@
+//
+//  ParticleArrays.h
+//  libraries/entities/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ParticleArrays_h
+#define hifi_ParticleArrays_h
+
+#include <stddef.h>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class ParticleArraysTests;
+
+// The particles of an emitter, oldest first, with each of their values in an array of its own so that they can be
+// integrated several at a time, 8 with AVX2 or 4 with SSE2 when the cpu has them. The oldest particles are dropped
+// by moving the start of the arrays on, and the arrays are only compacted when they would otherwise grow, so
+// an emitter that has reached its particle count doesn't allocate.
+class ParticleArrays {
+    friend class ParticleArraysTests;
+public:
+    size_t size() const { return _seed.size() - _begin; }
+    bool empty() const { return size() == 0; }
+
+    void clear();
+    void push_back(float seed, float lifetime, const glm::vec3& position, const glm::vec3& velocity,
+                   const glm::vec3& acceleration);
+    void pop_front(size_t count = 1);
+
+    // Age all the particles, drop those that reach the lifespan, and move the rest on
+    void stepSimulation(float deltaTime, float lifespan);
+
+    float getSeed(size_t i) const { return _seed[_begin + i]; }
+    float getLifetime(size_t i) const { return _lifetime[_begin + i]; }
+    glm::vec3 getPosition(size_t i) const { return glm::vec3(_x[_begin + i], _y[_begin + i], _z[_begin + i]); }
+
+private:
+    struct Arrays {
+        float* lifetime;
+        float* x;
+        float* y;
+        float* z;
+        float* vx;
+        float* vy;
+        float* vz;
+        float* ax;
+        float* ay;
+        float* az;
+        size_t size;
+    };
+    Arrays getArrays();
+    void compact();
+
+    // the SIMD versions return how many particles they integrated, a multiple of their batch size,
+    // and the reference version integrates the rest from there
+    static void integrate_ref(const Arrays& particles, float deltaTime, size_t begin);
+    static size_t integrate_SSE2(const Arrays& particles, float deltaTime);
+    static size_t integrate_AVX2(const Arrays& particles, float deltaTime);
+    static void integrate(const Arrays& particles, float deltaTime);
+
+    size_t _begin { 0 }; // the oldest particle still alive
+    std::vector<float> _seed, _lifetime;
+    std::vector<float> _x, _y, _z;
+    std::vector<float> _vx, _vy, _vz;
+    std::vector<float> _ax, _ay, _az;
+};
+
+#endif // hifi_ParticleArrays_h
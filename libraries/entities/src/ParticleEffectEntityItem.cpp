@@ -591,54 +591,28 @@ void ParticleEffectEntityItem::setShapeType(ShapeType type) {
     }
 }
 
-void ParticleEffectEntityItem::integrateParticle(Particle& particle, float deltaTime) {
-    glm::vec3 atSquared = (0.5f * deltaTime * deltaTime) * particle.acceleration;
-    glm::vec3 at = particle.acceleration * deltaTime;
-    particle.position += particle.velocity * deltaTime + atSquared;
-    particle.velocity += at;
-}
-
 void ParticleEffectEntityItem::stepSimulation(float deltaTime) {
-    // update particles between head and tail
-    int popCount = 0;
-    for (Particle& particle : _particles) {
-        particle.lifetime += deltaTime;
-
-        // if particle has died.
-        if (particle.lifetime >= _lifespan) {
-            // move head forward
-            popCount++;
-        } else {
-            // Otherwise update it
-            integrateParticle(particle, deltaTime);
-        }
-    }
-    _particles.erase(_particles.begin(), _particles.begin() + popCount);
+    // update the particles, and drop those that have died
+    _particles.stepSimulation(deltaTime, _lifespan);
 
     // emit new particles, but only if we are emmitting
     if (getIsEmitting() && _emitRate > 0.0f && _lifespan > 0.0f && _polarStart <= _polarFinish) {
 
         float timeLeftInFrame = deltaTime;
         while (_timeUntilNextEmit < timeLeftInFrame) {
-            // overflow! move head forward by one.
-            // because the case of head == tail indicates an empty array, not a full one.
+            // overflow! drop the oldest particle.
             // This can drop an existing older particle, but this is by design, newer particles are a higher priority.
             if (_particles.size() >= _maxParticles) {
                 _particles.pop_front();
             }
-            
-            // emit a new particle at tail index.
-            _particles.push_back(createParticle(glm::mix(_previousPosition, getPosition(),
-                (deltaTime - timeLeftInFrame) / deltaTime)));
-            auto particle = _particles.back();
-            particle.lifetime += timeLeftInFrame;
-            
-            // Initialize it
-            integrateParticle(particle, deltaTime);
-            
+
             // Advance in frame
             timeLeftInFrame -= _timeUntilNextEmit;
             _timeUntilNextEmit = 1.0f / _emitRate;
+
+            // emit a new particle, that has lived for the rest of the frame
+            emitParticle(glm::mix(_previousPosition, getPosition(), (deltaTime - timeLeftInFrame) / deltaTime),
+                         timeLeftInFrame);
         }
 
         _timeUntilNextEmit -= timeLeftInFrame;
@@ -646,20 +620,20 @@ void ParticleEffectEntityItem::stepSimulation(float deltaTime) {
     _previousPosition = getPosition();
 }
 
-ParticleEffectEntityItem::Particle ParticleEffectEntityItem::createParticle(const glm::vec3& position) {
-    Particle particle;
-
- 
-    particle.seed = randFloatInRange(-1.0f, 1.0f);
+void ParticleEffectEntityItem::emitParticle(const glm::vec3& position, float age) {
+    float seed = randFloatInRange(-1.0f, 1.0f);
+    glm::vec3 particlePosition = Vectors::ZERO;
+    glm::vec3 velocity;
+    glm::vec3 acceleration;
     if (getEmitterShouldTrail()) {
-        particle.position = position;
+        particlePosition = position;
     }
     // Position, velocity, and acceleration
     if (_polarStart == 0.0f && _polarFinish == 0.0f && _emitDimensions.z == 0.0f) {
         // Emit along z-axis from position
 
-        particle.velocity = (_emitSpeed + 0.2f * _speedSpread) * (_emitOrientation * Vectors::UNIT_Z);
-        particle.acceleration = _emitAcceleration + randFloatInRange(-1.0f, 1.0f) * _accelerationSpread;
+        velocity = (_emitSpeed + 0.2f * _speedSpread) * (_emitOrientation * Vectors::UNIT_Z);
+        acceleration = _emitAcceleration + randFloatInRange(-1.0f, 1.0f) * _accelerationSpread;
         
     } else {
         // Emit around point or from ellipsoid
@@ -706,18 +680,22 @@ ParticleEffectEntityItem::Particle ParticleEffectEntityItem::createParticle(cons
             ));
             
             if (getEmitterShouldTrail()) {
-                particle.position += _emitOrientation * emitPosition;
+                particlePosition += _emitOrientation * emitPosition;
             }
             else {
-                particle.position = _emitOrientation * emitPosition;
+                particlePosition = _emitOrientation * emitPosition;
             }
         }
         
-        particle.velocity = (_emitSpeed + randFloatInRange(-1.0f, 1.0f) * _speedSpread) * (_emitOrientation * emitDirection);
-        particle.acceleration = _emitAcceleration + randFloatInRange(-1.0f, 1.0f) * _accelerationSpread;
+        velocity = (_emitSpeed + randFloatInRange(-1.0f, 1.0f) * _speedSpread) * (_emitOrientation * emitDirection);
+        acceleration = _emitAcceleration + randFloatInRange(-1.0f, 1.0f) * _accelerationSpread;
     }
-    
-    return particle;
+
+    // move it on for the time since it was emitted
+    particlePosition += velocity * age + (0.5f * age * age) * acceleration;
+    velocity += acceleration * age;
+
+    _particles.push_back(seed, age, particlePosition, velocity, acceleration);
 }
 
 void ParticleEffectEntityItem::setMaxParticles(quint32 maxParticles) {
@@ -725,8 +703,8 @@ void ParticleEffectEntityItem::setMaxParticles(quint32 maxParticles) {
         _maxParticles = maxParticles;
 
         // Pop all the overflowing oldest particles
-        while (_particles.size() > _maxParticles) {
-            _particles.pop_front();
+        if (_particles.size() > _maxParticles) {
+            _particles.pop_front(_particles.size() - _maxParticles);
         }
 
         // effectively clear all particles and start emitting new ones from scratch.
@@ -11,11 +11,10 @@
 #ifndef hifi_ParticleEffectEntityItem_h
 #define hifi_ParticleEffectEntityItem_h
 
-#include <deque>
-
 #include "EntityItem.h"
 
 #include "ColorUtils.h"
+#include "ParticleArrays.h"
 
 class ParticleEffectEntityItem : public EntityItem {
 public:
@@ -222,25 +221,14 @@ public:
     virtual bool supportsDetailedRayIntersection() const override { return false; }
 
 protected:
-    struct Particle;
-    using Particles = std::deque<Particle>;
-
     bool isAnimatingSomething() const;
     
-    Particle createParticle(const glm::vec3& position);
+    // emits a particle from the position, already the age given and moved on by it
+    void emitParticle(const glm::vec3& position, float age);
     void stepSimulation(float deltaTime);
-    void integrateParticle(Particle& particle, float deltaTime);
-    
-    struct Particle {
-        float seed { 0.0f };
-        float lifetime { 0.0f };
-        glm::vec3 position { Vectors::ZERO };
-        glm::vec3 velocity { Vectors::ZERO };
-        glm::vec3 acceleration { Vectors::ZERO };
-    };
     
     // Particles container
-    Particles _particles;
+    ParticleArrays _particles;
     
     // Particles properties
     rgbColor _color;
@@ -0,0 +1,48 @@
+//
+//  ParticleArrays_avx2.cpp
+//  libraries/entities/src/avx2
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <immintrin.h>
+
+#include "../ParticleArrays.h"
+
+#ifndef __AVX2__
+#error Must be compiled with /arch:AVX2 or -mavx2 -mfma.
+#endif
+
+// no fma, and the file is built without contracting the multiplies and adds into fmas either,
+// so that the particles move the same as with the other versions
+static inline void integrateAxis_AVX2(float* position, float* velocity, const float* acceleration,
+                                      __m256 deltaTime, __m256 halfDeltaTimeSquared) {
+    __m256 p = _mm256_loadu_ps(position);
+    __m256 v = _mm256_loadu_ps(velocity);
+    __m256 a = _mm256_loadu_ps(acceleration);
+    p = _mm256_add_ps(p, _mm256_add_ps(_mm256_mul_ps(v, deltaTime), _mm256_mul_ps(a, halfDeltaTimeSquared)));
+    v = _mm256_add_ps(v, _mm256_mul_ps(a, deltaTime));
+    _mm256_storeu_ps(position, p);
+    _mm256_storeu_ps(velocity, v);
+}
+
+size_t ParticleArrays::integrate_AVX2(const Arrays& particles, float deltaTime) {
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    const __m256 halfDtSquared = _mm256_set1_ps(0.5f * deltaTime * deltaTime);
+    size_t end = particles.size & ~(size_t)7;
+
+    for (size_t i = 0; i < end; i += 8) {
+        _mm256_storeu_ps(&particles.lifetime[i], _mm256_add_ps(_mm256_loadu_ps(&particles.lifetime[i]), dt));
+        integrateAxis_AVX2(&particles.x[i], &particles.vx[i], &particles.ax[i], dt, halfDtSquared);
+        integrateAxis_AVX2(&particles.y[i], &particles.vy[i], &particles.ay[i], dt, halfDtSquared);
+        integrateAxis_AVX2(&particles.z[i], &particles.vz[i], &particles.az[i], dt, halfDtSquared);
+    }
+    return end;
+}
+
+#endif
@@ -104,6 +104,154 @@ void Batch::clear() {
     _drawCallInfos.clear();
 }
 
+void Batch::startSubBatch(Batch& subBatch) const {
+    subBatch.clear();
+    subBatch._namedData.clear();
+    subBatch._queries.clear();
+    subBatch._lambdas.clear();
+    subBatch._profileRanges.clear();
+    subBatch._names.clear();
+
+    subBatch._currentModel = _currentModel;
+    subBatch._invalidModel = true;
+    subBatch._enableStereo = _enableStereo;
+    subBatch._enableSkybox = _enableSkybox;
+}
+
+static void offsetParam(Batch::Param& param, size_t offset) {
+#if (QT_POINTER_SIZE == 8)
+    param._size += offset;
+#else
+    param._uint += (uint32)offset;
+#endif
+}
+
+void Batch::appendSubBatch(Batch& subBatch) {
+    // Append the data and caches, keeping where the ones of the sub batch start...
+    size_t paramsOffset = _params.size();
+    _params.insert(_params.end(), subBatch._params.begin(), subBatch._params.end());
+    size_t dataOffset = _data.size();
+    _data.insert(_data.end(), subBatch._data.begin(), subBatch._data.end());
+    size_t objectsOffset = _objects.size();
+    _objects.insert(_objects.end(), subBatch._objects.begin(), subBatch._objects.end());
+
+    size_t buffersOffset = _buffers.append(subBatch._buffers);
+    size_t texturesOffset = _textures.append(subBatch._textures);
+    size_t streamFormatsOffset = _streamFormats.append(subBatch._streamFormats);
+    size_t transformsOffset = _transforms.append(subBatch._transforms);
+    size_t pipelinesOffset = _pipelines.append(subBatch._pipelines);
+    size_t framebuffersOffset = _framebuffers.append(subBatch._framebuffers);
+    size_t queriesOffset = _queries.append(subBatch._queries);
+    size_t lambdasOffset = _lambdas.append(subBatch._lambdas);
+    size_t profileRangesOffset = _profileRanges.append(subBatch._profileRanges);
+    size_t namesOffset = _names.append(subBatch._names);
+
+    // ...and move the params of the commands that point in them by as much
+    for (size_t i = 0; i < subBatch._commands.size(); ++i) {
+        auto command = subBatch._commands[i];
+        size_t offset = paramsOffset + subBatch._commandOffsets[i];
+        _commands.push_back(command);
+        _commandOffsets.push_back(offset);
+
+        Param* params = _params.data() + offset;
+        switch (command) {
+            case COMMAND_setInputFormat:
+                offsetParam(params[0], streamFormatsOffset);
+                break;
+            case COMMAND_setInputBuffer:
+            case COMMAND_setUniformBuffer:
+                offsetParam(params[2], buffersOffset);
+                break;
+            case COMMAND_setIndexBuffer:
+                offsetParam(params[1], buffersOffset);
+                break;
+            case COMMAND_setIndirectBuffer:
+                offsetParam(params[0], buffersOffset);
+                break;
+            case COMMAND_setViewTransform:
+                offsetParam(params[0], transformsOffset);
+                break;
+            case COMMAND_setProjectionTransform:
+            case COMMAND_setViewportTransform:
+            case COMMAND_setStateScissorRect:
+            case COMMAND_glUniform3fv:
+            case COMMAND_glUniform4fv:
+            case COMMAND_glUniform4iv:
+            case COMMAND_glUniformMatrix3fv:
+            case COMMAND_glUniformMatrix4fv:
+                offsetParam(params[0], dataOffset);
+                break;
+            case COMMAND_setPipeline:
+                offsetParam(params[0], pipelinesOffset);
+                break;
+            case COMMAND_setResourceTexture:
+            case COMMAND_generateTextureMips:
+                offsetParam(params[0], texturesOffset);
+                break;
+            case COMMAND_setFramebuffer:
+                offsetParam(params[0], framebuffersOffset);
+                break;
+            case COMMAND_blit:
+                offsetParam(params[0], framebuffersOffset);
+                offsetParam(params[5], framebuffersOffset);
+                break;
+            case COMMAND_beginQuery:
+            case COMMAND_endQuery:
+            case COMMAND_getQuery:
+                offsetParam(params[0], queriesOffset);
+                break;
+            case COMMAND_runLambda:
+                offsetParam(params[0], lambdasOffset);
+                break;
+            case COMMAND_startNamedCall:
+                offsetParam(params[0], namesOffset);
+                break;
+            case COMMAND_pushProfileRange:
+                offsetParam(params[0], profileRangesOffset);
+                break;
+            default:
+                break;
+        }
+    }
+
+    // The draw calls point in the transform objects
+    for (auto drawCallInfo : subBatch._drawCallInfos) {
+        _drawCallInfos.emplace_back((DrawCallInfo::Index)(drawCallInfo.index + objectsOffset));
+    }
+
+    // Named calls accumulate across the sub batches, in their order
+    for (auto& namedData : subBatch._namedData) {
+        auto& instance = _namedData[namedData.first];
+        auto& subInstance = namedData.second;
+        if (!instance.function) {
+            instance.function = subInstance.function;
+        }
+        for (auto drawCallInfo : subInstance.drawCallInfos) {
+            instance.drawCallInfos.emplace_back((DrawCallInfo::Index)(drawCallInfo.index + objectsOffset));
+        }
+        if (instance.buffers.size() < subInstance.buffers.size()) {
+            instance.buffers.resize(subInstance.buffers.size());
+        }
+        for (size_t i = 0; i < subInstance.buffers.size(); ++i) {
+            auto& subBuffer = subInstance.buffers[i];
+            if (!subBuffer) {
+                continue;
+            }
+            if (!instance.buffers[i]) {
+                instance.buffers[i] = subBuffer;
+            } else {
+                instance.buffers[i]->append(subBuffer->getSize(), subBuffer->getData());
+            }
+        }
+    }
+
+    // Draws following the sub batch use its model transform
+    _currentModel = subBatch._currentModel;
+    _invalidModel = subBatch._invalidModel || subBatch._objects.empty();
+
+    startSubBatch(subBatch);
+}
+
 size_t Batch::cacheData(size_t size, const void* data) {
     size_t offset = _data.size();
     size_t numBytes = size;
@@ -103,6 +103,12 @@ public:
 
     void clear();
 
+    // Sub batches record commands apart from their batch, on other threads, then are appended to it in order.
+    // Start a sub batch from the current model transform and settings of this batch
+    void startSubBatch(Batch& subBatch) const;
+    // Append the commands of a sub batch to this batch, and clear the sub batch
+    void appendSubBatch(Batch& subBatch);
+
     // Batches may need to override the context level stereo settings
     // if they're performing framebuffer copy operations, like the 
     // deferred lighting resolution mechanism
@@ -395,6 +401,13 @@ public:
                 return (_items.data() + offset)->_data;
             }
 
+            // append the items of another cache, and return the offset of the first one
+            size_t append(const Vector& vector) {
+                size_t offset = _items.size();
+                _items.insert(_items.end(), vector._items.begin(), vector._items.end());
+                return offset;
+            }
+
             void clear() {
                 _items.clear();
             }
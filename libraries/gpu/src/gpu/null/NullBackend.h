@@ -27,7 +27,7 @@ class Backend : public gpu::Backend {
     // Context Backend static interface required
     friend class gpu::Context;
     static void init() {}
-    static gpu::Backend* createBackend() { return new Backend(); }
+    static gpu::BackendPointer createBackend() { return gpu::BackendPointer(new Backend()); }
     static bool makeProgram(Shader& shader, const Shader::BindingSet& slotBindings) { return true; }
 
 protected:
@@ -44,9 +44,13 @@ public:
     // Let's try to avoid to do that as much as possible!
     void syncCache() final { }
 
+    void recycle() const final { }
+
     // This is the ugly "download the pixels to sysmem for taking a snapshot"
     // Just avoid using it, it's ugly and will break performances
     virtual void downloadFramebuffer(const FramebufferPointer& srcFramebuffer, const Vec4i& region, QImage& destImage) final { }
+
+    bool isTextureManagementSparseEnabled() const final { return false; }
 };
 
 } }
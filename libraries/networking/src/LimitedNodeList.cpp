@@ -37,6 +37,7 @@
 #include "HifiSockAddr.h"
 #include "NetworkLogging.h"
 #include "udt/Packet.h"
+#include "udt/SendQueueScheduler.h"
 #include <Trace.h>
 
 static Setting::Handle<quint16> LIMITED_NODELIST_LOCAL_PORT("LimitedNodeList.LocalPort", 0);
@@ -270,11 +271,8 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
         if (matchingNode) {
             if (!NON_VERIFIED_PACKETS.contains(headerType)) {
 
-                QByteArray packetHeaderHash = NLPacket::verificationHashInHeader(packet);
-                QByteArray expectedHash = NLPacket::hashForPacketAndSecret(packet, matchingNode->getConnectionSecret());
-
-                // check if the md5 hash in the header matches the hash we would expect
-                if (packetHeaderHash != expectedHash) {
+                // check if the hash in the header matches the hash we would expect
+                if (!NLPacket::hashInHeaderMatchesSecret(packet, matchingNode->getConnectionSecret())) {
                     static QMultiMap<QUuid, PacketType> hashDebugSuppressMap;
 
                     if (!hashDebugSuppressMap.contains(sourceID, headerType)) {
@@ -353,6 +351,31 @@ qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const HifiS
     return _nodeSocket.writePacket(packet, sockAddr);
 }
 
+qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const Node& destinationNode,
+                                             udt::DatagramBatch& batch) {
+    Q_ASSERT(!packet.isPartOfMessage());
+    Q_ASSERT_X(!packet.isReliable(), "LimitedNodeList::sendUnreliablePacket",
+               "Trying to send a reliable packet unreliably.");
+
+    if (!destinationNode.getActiveSocket()) {
+        return 0;
+    }
+
+    emit dataSent(destinationNode.getType(), packet.getDataSize());
+    destinationNode.recordBytesSent(packet.getDataSize());
+
+    collectPacketStats(packet);
+    fillPacketHeader(packet, destinationNode.getConnectionSecret());
+
+    return _nodeSocket.writePacket(packet, *destinationNode.getActiveSocket(), batch);
+}
+
+qint64 LimitedNodeList::flushUnreliableBatch(udt::DatagramBatch& batch) {
+    auto bytesWritten = _nodeSocket.writeDatagrams(batch);
+    batch.clear();
+    return bytesWritten;
+}
+
 qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const Node& destinationNode) {
     Q_ASSERT(!packet->isPartOfMessage());
     auto activeSocket = destinationNode.getActiveSocket();
@@ -701,13 +724,18 @@ std::unique_ptr<NLPacket> LimitedNodeList::constructICEPingReplyPacket(ReceivedM
 unsigned int LimitedNodeList::broadcastToNodes(std::unique_ptr<NLPacket> packet, const NodeSet& destinationNodeTypes) {
     unsigned int n = 0;
 
+    // the packet is re-written for each node, so it is copied into a batch that goes out in as few syscalls as possible
+    udt::DatagramBatch batch;
+
     eachNode([&](const SharedNodePointer& node){
         if (node && destinationNodeTypes.contains(node->getType())) {
-            sendUnreliablePacket(*packet, *node);
+            sendUnreliablePacket(*packet, *node, batch);
             ++n;
         }
     });
 
+    flushUnreliableBatch(batch);
+
     return n;
 }
 
@@ -725,12 +753,26 @@ void LimitedNodeList::getPacketStats(float& packetsInPerSecond, float& bytesInPe
     bytesOutPerSecond = (float) _numCollectedBytes / ((float) _packetStatTimer.elapsed() / 1000.0f);
 }
 
+void LimitedNodeList::setSendQueueSchedulerThreads(int numThreads) {
+    auto& scheduler = udt::SendQueueScheduler::getInstance();
+
+    // the scheduler is shared by every socket in the process, and keeps the thread count it was first started with
+    if (numThreads > 0 && !scheduler.isRunning()) {
+        scheduler.start(numThreads);
+    }
+
+    // existing send queues keep running the way they were created, only new connections change over
+    _nodeSocket.setUseSendQueueScheduler(numThreads > 0);
+}
+
 void LimitedNodeList::resetPacketStats() {
     getPacketReceiver().resetCounters();
 
     _numCollectedPackets = 0;
     _numCollectedBytes = 0;
 
+    _nodeSocket.resetSyscallStats();
+
     _packetStatTimer.restart();
 }
 
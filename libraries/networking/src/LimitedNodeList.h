@@ -104,6 +104,13 @@ public:
     };
 
     Q_ENUM(ConnectionStep);
+
+    // what each node in a domain list delta is preceded by
+    enum class DomainListChange : quint8 {
+        Updated,
+        Removed
+    };
+
     const QUuid& getSessionUUID() const { return _sessionUUID; }
     void setSessionUUID(const QUuid& sessionUUID);
 
@@ -125,6 +132,10 @@ public:
     qint64 sendUnreliablePacket(const NLPacket& packet, const HifiSockAddr& sockAddr,
                                 const QUuid& connectionSecret = QUuid());
 
+    // batched sends - the packet is copied into the batch, which is written when it fills up or is flushed
+    qint64 sendUnreliablePacket(const NLPacket& packet, const Node& destinationNode, udt::DatagramBatch& batch);
+    qint64 flushUnreliableBatch(udt::DatagramBatch& batch);
+
     qint64 sendPacket(std::unique_ptr<NLPacket> packet, const Node& destinationNode);
     qint64 sendPacket(std::unique_ptr<NLPacket> packet, const HifiSockAddr& sockAddr,
                       const QUuid& connectionSecret = QUuid());
@@ -163,6 +174,7 @@ public:
 
     void getPacketStats(float& packetsInPerSecond, float& bytesInPerSecond, float& packetsOutPerSecond, float& bytesOutPerSecond);
     void resetPacketStats();
+    udt::Socket::SyscallStats getSocketSyscallStats() const { return _nodeSocket.getSyscallStats(); }
 
     std::unique_ptr<NLPacket> constructPingPacket(PingType_t pingType = PingType::Agnostic);
     std::unique_ptr<NLPacket> constructPingReplyPacket(ReceivedMessage& message);
@@ -248,6 +260,9 @@ public:
 
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
 
+    // services the send queues of new connections from a shared pool of numThreads threads (0: one thread per queue)
+    void setSendQueueSchedulerThreads(int numThreads);
+
     void setPacketFilterOperator(udt::PacketFilterOperator filterOperator) { _nodeSocket.setPacketFilterOperator(filterOperator); }
     bool packetVersionMatch(const udt::Packet& packet);
     bool isPacketVerified(const udt::Packet& packet);
@@ -42,6 +42,11 @@ public:
     static std::unique_ptr<NLPacketList> encodeMessagesPacket(QString channel, QString message, QUuid senderID);
     static std::unique_ptr<NLPacketList> encodeMessagesDataPacket(QString channel, QByteArray data, QUuid senderID);
 
+    // the payload of a MessagesData packet list, for senders that send the same message to many nodes
+    static QByteArray encodeMessagesPayload(const QString& channel, bool isText, const QByteArray& messageData,
+                                            const QUuid& senderID);
+    static std::unique_ptr<NLPacketList> createMessagesPacket(const QByteArray& payload);
+
 signals:
     void messageReceived(QString channel, QString message, QUuid senderUUID, bool localOnly);
     void dataReceived(QString channel, QByteArray data, QUuid senderUUID, bool localOnly);
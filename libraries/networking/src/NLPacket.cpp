@@ -11,6 +11,13 @@
 
 #include "NLPacket.h"
 
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QtEndian>
+
+#include <SipHash.h>
+
+static_assert(SIPHASH_128_BYTES == NUM_BYTES_MD5_HASH, "the verification hash must fit the packet header");
+
 int NLPacket::localHeaderSize(PacketType type) {
     bool nonSourced = NON_SOURCED_PACKETS.contains(type);
     bool nonVerified = NON_VERIFIED_PACKETS.contains(type);
@@ -88,7 +95,7 @@ NLPacket::NLPacket(const NLPacket& other) : Packet(other) {
 }
 
 NLPacket::NLPacket(std::unique_ptr<char[]> data, qint64 size, const HifiSockAddr& senderSockAddr) :
-    Packet(std::move(data), size, senderSockAddr)
+    Packet(udt::PacketBufferPool::adopt(std::move(data)), size, senderSockAddr)
 {    
     // sanity check before we decrease the payloadSize with the payloadCapacity
     Q_ASSERT(_payloadSize == _payloadCapacity);
@@ -149,18 +156,48 @@ QByteArray NLPacket::verificationHashInHeader(const udt::Packet& packet) {
     return QByteArray(packet.getData() + offset, NUM_BYTES_MD5_HASH);
 }
 
-QByteArray NLPacket::hashForPacketAndSecret(const udt::Packet& packet, const QUuid& connectionSecret) {
-    QCryptographicHash hash(QCryptographicHash::Md5);
-    
+QByteArray NLPacket::hashForPacketAndSecret(const udt::Packet& packet, const QUuid& connectionSecret,
+                                            PacketVerificationVersion version) {
+    QByteArray hash(NUM_BYTES_MD5_HASH, 0);
+    computeHashForPacketAndSecret(packet, connectionSecret, version, hash.data());
+    return hash;
+}
+
+bool NLPacket::hashInHeaderMatchesSecret(const udt::Packet& packet, const QUuid& connectionSecret) {
+    int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
+        + NUM_BYTES_RFC4122_UUID;
+
+    char expectedHash[NUM_BYTES_MD5_HASH];
+    computeHashForPacketAndSecret(packet, connectionSecret, CURRENT_PACKET_VERIFICATION_VERSION, expectedHash);
+    return memcmp(packet.getData() + offset, expectedHash, NUM_BYTES_MD5_HASH) == 0;
+}
+
+void NLPacket::computeHashForPacketAndSecret(const udt::Packet& packet, const QUuid& connectionSecret,
+                                             PacketVerificationVersion version, char* result) {
     int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
         + NUM_BYTES_RFC4122_UUID + NUM_BYTES_MD5_HASH;
-    
-    // add the packet payload and the connection UUID
-    hash.addData(packet.getData() + offset, packet.getDataSize() - offset);
-    hash.addData(connectionSecret.toRfc4122());
-    
-    // return the hash
-    return hash.result();
+    const char* payload = packet.getData() + offset;
+    int payloadSize = packet.getDataSize() - offset;
+
+    // the connection secret in its RFC 4122 byte order, without allocating it
+    uint8_t secret[NUM_BYTES_RFC4122_UUID];
+    qToBigEndian(connectionSecret.data1, secret);
+    qToBigEndian(connectionSecret.data2, secret + 4);
+    qToBigEndian(connectionSecret.data3, secret + 6);
+    memcpy(secret + 8, connectionSecret.data4, sizeof(connectionSecret.data4));
+
+    if (version == PacketVerificationVersion::Md5) {
+        QCryptographicHash hash(QCryptographicHash::Md5);
+
+        // add the packet payload and the connection UUID
+        hash.addData(payload, payloadSize);
+        hash.addData(reinterpret_cast<const char*>(secret), NUM_BYTES_RFC4122_UUID);
+
+        memcpy(result, hash.result().constData(), NUM_BYTES_MD5_HASH);
+    } else {
+        // a keyed MAC of the payload, with the connection secret as the key
+        sipHash128(secret, payload, payloadSize, reinterpret_cast<uint8_t*>(result));
+    }
 }
 
 void NLPacket::writeTypeAndVersion() {
@@ -217,7 +254,5 @@ void NLPacket::writeVerificationHashGivenSecret(const QUuid& connectionSecret) c
     
     auto offset = Packet::totalHeaderSize(isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
                 + NUM_BYTES_RFC4122_UUID;
-    QByteArray verificationHash = hashForPacketAndSecret(*this, connectionSecret);
-    
-    memcpy(_packet.get() + offset, verificationHash.data(), verificationHash.size());
+    computeHashForPacketAndSecret(*this, connectionSecret, CURRENT_PACKET_VERIFICATION_VERSION, _packet.get() + offset);
 }
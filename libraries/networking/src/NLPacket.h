@@ -59,7 +59,9 @@ public:
     
     static QUuid sourceIDInHeader(const udt::Packet& packet);
     static QByteArray verificationHashInHeader(const udt::Packet& packet);
-    static QByteArray hashForPacketAndSecret(const udt::Packet& packet, const QUuid& connectionSecret);
+    static QByteArray hashForPacketAndSecret(const udt::Packet& packet, const QUuid& connectionSecret,
+                                             PacketVerificationVersion version = CURRENT_PACKET_VERIFICATION_VERSION);
+    static bool hashInHeaderMatchesSecret(const udt::Packet& packet, const QUuid& connectionSecret);
     
     PacketType getType() const { return _type; }
     void setType(PacketType type);
@@ -87,6 +89,10 @@ protected:
     // Header writers
     void writeTypeAndVersion();
 
+    // writes the NUM_BYTES_MD5_HASH bytes long verification hash of the packet to result
+    static void computeHashForPacketAndSecret(const udt::Packet& packet, const QUuid& connectionSecret,
+                                              PacketVerificationVersion version, char* result);
+
     // Header readers, used to set member variables after getting a packet from the network
     void readType();
     void readVersion();
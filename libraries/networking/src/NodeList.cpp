@@ -238,6 +238,7 @@ void NodeList::reset() {
     LimitedNodeList::reset();
 
     _numNoReplyDomainCheckIns = 0;
+    _domainListVersion = 0;
 
     // lock and clear our set of radius ignored IDs
     _radiusIgnoredSetLock.lockForWrite();
@@ -392,6 +393,11 @@ void NodeList::sendDomainServerCheckIn() {
         packetStream << _ownerType.load() << _publicSockAddr << _localSockAddr << _nodeTypesOfInterest.toList();
         packetStream << DependencyManager::get<AddressManager>()->getPlaceName();
 
+        if (domainPacketType == PacketType::DomainListRequest) {
+            // tell the domain-server the version of the domain list we have, so it sends only what changed since
+            packetStream << _domainListVersion;
+        }
+
         if (!_domainHandler.isConnected()) {
             DataServerAccountInfo& accountInfo = accountManager->getAccountInfo();
             packetStream << accountInfo.getUsername();
@@ -621,10 +627,33 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     packetStream >> newPermissions;
     setPermissions(newPermissions);
 
+    // the version of this list, and whether it holds only the nodes changed since the version we last had
+    quint64 domainListVersion;
+    bool isDelta;
+    packetStream >> domainListVersion >> isDelta;
+
     // pull each node in the packet
     while (packetStream.device()->pos() < message->getSize()) {
+        if (isDelta) {
+            quint8 change;
+            packetStream >> change;
+
+            if (change == static_cast<quint8>(DomainListChange::Removed)) {
+                QUuid nodeUUID;
+                packetStream >> nodeUUID;
+                killNodeWithUUID(nodeUUID);
+                continue;
+            }
+        }
+
         parseNodeFromPacketStream(packetStream);
     }
+
+    // the list arrives as one reliable message, so we have all of it here - but a delta is only a complete list if we
+    // had the list it was made against
+    if (!isDelta || _domainListVersion != 0) {
+        _domainListVersion = domainListVersion;
+    }
 }
 
 void NodeList::processDomainServerAddedNode(QSharedPointer<ReceivedMessage> message) {
@@ -19,6 +19,7 @@
 #include "ThreadedAssignment.h"
 
 #include "NetworkLogging.h"
+#include "udt/PacketBufferPool.h"
 
 ThreadedAssignment::ThreadedAssignment(ReceivedMessage& message) :
     Assignment(message),
@@ -87,6 +88,29 @@ void ThreadedAssignment::commonInit(const QString& targetName, NodeType_t nodeTy
 
     // stop sending stats if we disconnect
     connect(&nodeList->getDomainHandler(), &DomainHandler::disconnectedFromDomain, &_statsTimer, &QTimer::stop);
+
+    // the networking settings shared by every assignment type come in with the domain settings
+    connect(&nodeList->getDomainHandler(), &DomainHandler::settingsReceived,
+            this, &ThreadedAssignment::parseNetworkingSettings);
+}
+
+void ThreadedAssignment::parseNetworkingSettings(const QJsonObject& domainSettingsObject) {
+    static const QString NETWORKING_SETTINGS_KEY = "networking";
+    static const QString SEND_SCHEDULER_THREADS_KEY = "send_scheduler_threads";
+
+    auto networkingSettings = domainSettingsObject[NETWORKING_SETTINGS_KEY].toObject();
+
+    bool ok;
+    int numThreads = networkingSettings[SEND_SCHEDULER_THREADS_KEY].toString().toInt(&ok);
+    if (!ok || numThreads < 0) {
+        numThreads = 0;
+    }
+
+    if (numThreads > 0) {
+        qCDebug(networking) << "Servicing send queues from" << numThreads << "shared send threads.";
+    }
+
+    DependencyManager::get<NodeList>()->setSendQueueSchedulerThreads(numThreads);
 }
 
 void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObject) {
@@ -94,6 +118,7 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
 
     float packetsInPerSecond, bytesInPerSecond, packetsOutPerSecond, bytesOutPerSecond;
     nodeList->getPacketStats(packetsInPerSecond, bytesInPerSecond, packetsOutPerSecond, bytesOutPerSecond);
+    auto syscallStats = nodeList->getSocketSyscallStats();
     nodeList->resetPacketStats();
 
     QJsonObject ioStats;
@@ -101,9 +126,25 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
     ioStats["inbound_packets_per_s"] = packetsInPerSecond;
     ioStats["outbound_bytes_per_s"] = bytesOutPerSecond;
     ioStats["outbound_packets_per_s"] = packetsOutPerSecond;
+    ioStats["inbound_packets_per_recv_call"] = (syscallStats.numReceiveCalls > 0) ?
+        (float)syscallStats.numDatagramsReceived / (float)syscallStats.numReceiveCalls : 0.0f;
+    ioStats["outbound_packets_per_send_call"] = (syscallStats.numSendCalls > 0) ?
+        (float)syscallStats.numDatagramsSent / (float)syscallStats.numSendCalls : 0.0f;
 
     statsObject["io_stats"] = ioStats;
 
+    auto bufferPoolStats = udt::PacketBufferPool::getStats();
+    udt::PacketBufferPool::resetStats();
+
+    QJsonObject bufferPoolObject;
+    bufferPoolObject["allocations"] = (qint64)bufferPoolStats.numAllocations;
+    bufferPoolObject["hit_rate"] = (bufferPoolStats.numAllocations > 0) ?
+        (float)bufferPoolStats.numPoolHits / (float)bufferPoolStats.numAllocations : 0.0f;
+    bufferPoolObject["outstanding"] = (qint64)bufferPoolStats.numOutstanding;
+    bufferPoolObject["high_water_mark"] = (qint64)bufferPoolStats.highWaterMark;
+
+    statsObject["packet_buffer_pool"] = bufferPoolObject;
+
     nodeList->sendStatsToDomainServer(statsObject);
 }
 
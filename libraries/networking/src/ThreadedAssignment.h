@@ -50,6 +50,7 @@ protected slots:
     
 private slots:
     void checkInWithDomainServerOrExit();
+    void parseNetworkingSettings(const QJsonObject& domainSettingsObject);
 };
 
 typedef QSharedPointer<ThreadedAssignment> SharedAssignmentPointer;
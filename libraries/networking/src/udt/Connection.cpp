@@ -22,6 +22,7 @@
 #include "ControlPacket.h"
 #include "Packet.h"
 #include "PacketList.h"
+#include "SendQueueScheduler.h"
 #include "Socket.h"
 #include <Trace.h>
 
@@ -73,6 +74,17 @@ Connection::~Connection() {
 
 void Connection::stopSendQueue() {
     if (auto sendQueue = _sendQueue.release()) {
+        if (sendQueue->isScheduled()) {
+            // tell the send queue to stop, and wait for the scheduler to be done with it before it is deleted
+            sendQueue->stop();
+            SendQueueScheduler::getInstance().remove(sendQueue);
+            sendQueue->deleteLater();
+
+            // since we're stopping the send queue we should consider our handshake ACK not receieved
+            _hasReceivedHandshakeACK = false;
+            return;
+        }
+
         // grab the send queue thread so we can wait on it
         QThread* sendQueueThread = sendQueue->thread();
         
@@ -0,0 +1,41 @@
+//
+//  DatagramBatch.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DatagramBatch.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Constants.h"
+
+using namespace udt;
+
+DatagramBatch::DatagramBatch(int capacity) :
+    _capacity(std::min(std::max(capacity, 1), (int)MAX_DATAGRAMS)),
+    _buffer(new char[_capacity * MAX_PACKET_SIZE])
+{
+    _datagrams.reserve(_capacity);
+}
+
+int DatagramBatch::append(const char* data, qint64 size, const HifiSockAddr& sockAddr) {
+    if (isFull() || size > MAX_PACKET_SIZE) {
+        return -1;
+    }
+
+    int index = (int)_datagrams.size();
+
+    // every datagram has a fixed slot in the buffer
+    char* slot = _buffer.get() + index * MAX_PACKET_SIZE;
+    memcpy(slot, data, size);
+
+    _datagrams.push_back({ slot, size, sockAddr, 0 });
+
+    return index;
+}
@@ -0,0 +1,59 @@
+//
+//  DatagramBatch.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_DatagramBatch_h
+#define hifi_DatagramBatch_h
+
+#include <memory>
+#include <vector>
+
+#include "../HifiSockAddr.h"
+
+namespace udt {
+
+// A set of outgoing datagrams that udt::Socket::writeDatagrams puts on the wire together
+// (with a single sendmmsg call on Linux). Datagrams are copied in, so the caller can re-use or destroy its packets
+// as soon as they have been added.
+class DatagramBatch {
+public:
+    static const int MAX_DATAGRAMS = 32;
+
+    struct Datagram {
+        const char* data;
+        qint64 size;
+        HifiSockAddr sockAddr;
+        qint64 bytesWritten; // set by Socket::writeDatagrams, negative if this datagram could not be written
+    };
+
+    explicit DatagramBatch(int capacity = MAX_DATAGRAMS);
+
+    // returns the index of the datagram in the batch, or -1 if the batch is full or the datagram is too large
+    int append(const char* data, qint64 size, const HifiSockAddr& sockAddr);
+
+    bool isEmpty() const { return _datagrams.empty(); }
+    bool isFull() const { return (int)_datagrams.size() == _capacity; }
+    int size() const { return (int)_datagrams.size(); }
+
+    std::vector<Datagram>& getDatagrams() { return _datagrams; }
+    const std::vector<Datagram>& getDatagrams() const { return _datagrams; }
+
+    void clear() { _datagrams.clear(); }
+
+private:
+    int _capacity;
+    std::unique_ptr<char[]> _buffer;
+    std::vector<Datagram> _datagrams;
+};
+
+}
+
+#endif // hifi_DatagramBatch_h
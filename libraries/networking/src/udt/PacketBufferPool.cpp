@@ -0,0 +1,182 @@
+//
+//  PacketBufferPool.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPool.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "Constants.h"
+
+using namespace udt;
+
+// free buffers move between a thread's cache and the depot a batch at a time,
+// so a thread takes the depot lock at most once every BATCH_SIZE allocations or releases
+static const size_t BATCH_SIZE = 64;
+static const size_t MAX_CACHED_BUFFERS_PER_THREAD = 2 * BATCH_SIZE;
+static const size_t MAX_DEPOT_BATCHES = 64;
+
+namespace {
+
+using Batch = std::vector<char*>;
+
+void deleteBuffers(Batch& buffers) {
+    for (auto buffer : buffers) {
+        delete[] buffer;
+    }
+    buffers.clear();
+}
+
+struct Depot {
+    std::mutex mutex;
+    std::vector<Batch> batches; // guarded by mutex
+    std::atomic<size_t> numBatches { 0 }; // lets threads skip the lock when the depot is empty
+
+    ~Depot() {
+        for (auto& batch : batches) {
+            deleteBuffers(batch);
+        }
+    }
+};
+
+Depot& getDepot() {
+    static Depot depot;
+    return depot;
+}
+
+// set once a thread's cache is destroyed, as the thread exits. Buffers can still be released after that, by the
+// destructors of statics or of other thread locals, and those go straight back to the heap.
+// A bool is trivially destructible, so unlike the cache it can be read until the thread is gone.
+thread_local bool isThreadCacheDestroyed { false };
+
+struct ThreadCache {
+    Batch buffers;
+
+    // the buffers cached by a thread are freed when it exits
+    ~ThreadCache() {
+        deleteBuffers(buffers);
+        isThreadCacheDestroyed = true;
+    }
+};
+
+thread_local ThreadCache threadCache;
+
+std::atomic<uint64_t> numAllocations { 0 };
+std::atomic<uint64_t> numPoolHits { 0 };
+std::atomic<int64_t> numOutstanding { 0 };
+std::atomic<int64_t> highWaterMark { 0 };
+
+}
+
+void PacketBufferPool::Deleter::operator()(char* buffer) const {
+    if (isPooled) {
+        PacketBufferPool::release(buffer);
+    } else {
+        delete[] buffer;
+    }
+}
+
+PacketBufferPool::Buffer PacketBufferPool::allocate(qint64 size) {
+    if (size > MAX_PACKET_SIZE) {
+        // too large to be a packet we send, don't pool it
+        return Buffer(new char[size], Deleter());
+    }
+
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (isThreadCacheDestroyed) {
+        numOutstanding.fetch_add(1, std::memory_order_relaxed);
+        return Buffer(new char[MAX_PACKET_SIZE], Deleter { true });
+    }
+
+    auto& cache = threadCache.buffers;
+
+    if (cache.empty()) {
+        auto& depot = getDepot();
+        if (depot.numBatches.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(depot.mutex);
+            if (!depot.batches.empty()) {
+                cache.swap(depot.batches.back());
+                depot.batches.pop_back();
+                depot.numBatches = depot.batches.size();
+            }
+        }
+    }
+
+    char* buffer;
+    if (!cache.empty()) {
+        buffer = cache.back();
+        cache.pop_back();
+        numPoolHits.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        buffer = new char[MAX_PACKET_SIZE];
+    }
+
+    auto outstanding = numOutstanding.fetch_add(1, std::memory_order_relaxed) + 1;
+    auto currentHighWaterMark = highWaterMark.load(std::memory_order_relaxed);
+    while (outstanding > currentHighWaterMark &&
+           !highWaterMark.compare_exchange_weak(currentHighWaterMark, outstanding, std::memory_order_relaxed)) {}
+
+    return Buffer(buffer, Deleter { true });
+}
+
+PacketBufferPool::Buffer PacketBufferPool::adopt(std::unique_ptr<char[]> data) {
+    return Buffer(data.release(), Deleter());
+}
+
+void PacketBufferPool::release(char* buffer) {
+    numOutstanding.fetch_sub(1, std::memory_order_relaxed);
+
+    if (isThreadCacheDestroyed) {
+        delete[] buffer;
+        return;
+    }
+
+    auto& cache = threadCache.buffers;
+    cache.push_back(buffer);
+
+    if (cache.size() >= MAX_CACHED_BUFFERS_PER_THREAD) {
+        // this thread releases more than it allocates, hand a batch to the depot for the threads that allocate
+        Batch batch(cache.end() - BATCH_SIZE, cache.end());
+        cache.resize(cache.size() - BATCH_SIZE);
+
+        auto& depot = getDepot();
+        bool addedToDepot = false;
+        {
+            std::lock_guard<std::mutex> lock(depot.mutex);
+            if (depot.batches.size() < MAX_DEPOT_BATCHES) {
+                depot.batches.push_back(std::move(batch));
+                depot.numBatches = depot.batches.size();
+                addedToDepot = true;
+            }
+        }
+
+        if (!addedToDepot) {
+            // the depot is full, these buffers go back to the heap
+            deleteBuffers(batch);
+        }
+    }
+}
+
+PacketBufferPool::Stats PacketBufferPool::getStats() {
+    Stats stats;
+    stats.numAllocations = numAllocations.load(std::memory_order_relaxed);
+    stats.numPoolHits = numPoolHits.load(std::memory_order_relaxed);
+    stats.numOutstanding = numOutstanding.load(std::memory_order_relaxed);
+    stats.highWaterMark = highWaterMark.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void PacketBufferPool::resetStats() {
+    numAllocations = 0;
+    numPoolHits = 0;
+    highWaterMark = numOutstanding.load();
+}
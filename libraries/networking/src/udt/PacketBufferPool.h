@@ -0,0 +1,61 @@
+//
+//  PacketBufferPool.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacketBufferPool_h
+#define hifi_PacketBufferPool_h
+
+#include <cstdint>
+#include <memory>
+
+#include <QtCore/QtGlobal>
+
+namespace udt {
+
+// Recycles the MAX_PACKET_SIZE buffers behind BasePacket.
+//
+// Each thread keeps its own cache of free buffers, so allocating and releasing a buffer takes no lock.
+// Buffers are often released on a different thread than the one that allocated them (received packets are
+// handled off the socket thread), so a thread with too many free buffers hands a batch of them to a shared depot,
+// and a thread that runs out takes a batch back.
+class PacketBufferPool {
+public:
+    struct Deleter {
+        bool isPooled { false };
+        void operator()(char* buffer) const;
+    };
+
+    using Buffer = std::unique_ptr<char[], Deleter>;
+
+    struct Stats {
+        uint64_t numAllocations { 0 };
+        uint64_t numPoolHits { 0 }; // allocations served with a recycled buffer
+        int64_t numOutstanding { 0 }; // pooled buffers currently held by packets
+        int64_t highWaterMark { 0 }; // most pooled buffers held by packets at once since the last reset
+    };
+
+    // returns a buffer of at least size bytes, from the pool if size fits in a packet
+    static Buffer allocate(qint64 size);
+    // wraps a buffer allocated with new[], it is deleted (not pooled) when released
+    static Buffer adopt(std::unique_ptr<char[]> data);
+
+    static Stats getStats();
+    static void resetStats();
+
+private:
+    static void release(char* buffer);
+};
+
+using PacketBuffer = PacketBufferPool::Buffer;
+
+}
+
+#endif // hifi_PacketBufferPool_h
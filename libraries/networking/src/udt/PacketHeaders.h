@@ -122,6 +122,15 @@ const int NUM_BYTES_MD5_HASH = 16;
 
 typedef char PacketVersion;
 
+// how sourced packets are signed with the connection secret, part of the protocols signature so that every node in a
+// domain uses the same one
+enum class PacketVerificationVersion : PacketVersion {
+    Md5 = 0,
+    SipHash
+};
+
+const PacketVerificationVersion CURRENT_PACKET_VERIFICATION_VERSION = PacketVerificationVersion::SipHash;
+
 extern const QSet<PacketType> NON_VERIFIED_PACKETS;
 extern const QSet<PacketType> NON_SOURCED_PACKETS;
 
@@ -252,7 +261,14 @@ enum class DomainListVersion : PacketVersion {
     PrePermissionsGrid = 18,
     PermissionsGrid,
     GetUsernameFromUUIDSupport,
-    GetMachineFingerprintFromUUIDSupport
+    GetMachineFingerprintFromUUIDSupport,
+    DeltaUpdates,
+    ReliableDeltaUpdates
+};
+
+enum class DomainListRequestVersion : PacketVersion {
+    PreDeltaUpdates = 17,
+    DeltaUpdates
 };
 
 enum class AudioVersion : PacketVersion {
@@ -29,6 +29,7 @@
 #include "Packet.h"
 #include "PacketList.h"
 #include "../UserActivityLogger.h"
+#include "SendQueueScheduler.h"
 #include "Socket.h"
 #include <Trace.h>
 #include <Profile.h>
@@ -67,6 +68,15 @@ std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destin
     
     auto queue = std::unique_ptr<SendQueue>(new SendQueue(socket, destination));
 
+    auto& scheduler = SendQueueScheduler::getInstance();
+    if (socket->usesSendQueueScheduler() && scheduler.isRunning()) {
+        // the queue stays on the thread of its Connection and is serviced by the threads of the scheduler
+        queue->_isScheduled = true;
+        queue->_sendBatch.reset(new DatagramBatch());
+        scheduler.add(queue.get());
+        return queue;
+    }
+
     // Setup queue private thread
     QThread* thread = new QThread;
     thread->setObjectName("Networking: SendQueue " + destination.objectName()); // Name thread for easier debug
@@ -111,10 +121,10 @@ SendQueue::~SendQueue() {
 void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
     _packets.queuePacket(std::move(packet));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
+    // wake the queue in case it is sleeping waiting for packets
+    notifyActivity();
     
-    if (!this->thread()->isRunning() && _state == State::NotStarted) {
+    if (!_isScheduled && !this->thread()->isRunning() && _state == State::NotStarted) {
         this->thread()->start();
     }
 }
@@ -122,10 +132,10 @@ void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
 void SendQueue::queuePacketList(std::unique_ptr<PacketList> packetList) {
     _packets.queuePacketList(std::move(packetList));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
+    // wake the queue in case it is sleeping waiting for packets
+    notifyActivity();
     
-    if (!this->thread()->isRunning() && _state == State::NotStarted) {
+    if (!_isScheduled && !this->thread()->isRunning() && _state == State::NotStarted) {
         this->thread()->start();
     }
 }
@@ -136,11 +146,73 @@ void SendQueue::stop() {
     
     // Notify all conditions in case we're waiting somewhere
     _handshakeACKCondition.notify_one();
-    _emptyCondition.notify_one();
+    notifyActivity();
 }
     
-int SendQueue::sendPacket(const Packet& packet) {
-    return _socket->writeDatagram(packet.getData(), packet.getDataSize(), _destination);
+void SendQueue::notifyActivity() {
+    if (_isScheduled) {
+        _hasActivity = true;
+        SendQueueScheduler::getInstance().wake(this);
+    } else {
+        _emptyCondition.notify_one();
+    }
+}
+
+int SendQueue::sendPacket(const Packet& packet, int* batchIndex) {
+    return sendDatagram(packet.getData(), packet.getDataSize(), batchIndex);
+}
+
+int SendQueue::sendDatagram(const char* data, qint64 size, int* batchIndex) {
+    if (batchIndex) {
+        *batchIndex = -1;
+    }
+
+    if (_sendBatch) {
+        // a scheduled queue collects what it sends during a service and writes it all at once in flushSendBatch
+        if (_sendBatch->isFull()) {
+            flushSendBatch();
+        }
+
+        int index = _sendBatch->append(data, size, _destination);
+        if (index >= 0) {
+            if (batchIndex) {
+                *batchIndex = index;
+            }
+            return size;
+        }
+
+        // this datagram can't be batched, write it on its own
+    }
+
+    return _socket->writeDatagram(data, size, _destination);
+}
+
+void SendQueue::flushSendBatch() {
+    if (!_sendBatch || _sendBatch->isEmpty()) {
+        return;
+    }
+
+    _socket->writeDatagrams(*_sendBatch);
+
+    // new packets are reported sent, and those that didn't make it onto the wire are then short-circuit losses,
+    // as in sendNewPacketAndAddToSentList
+    auto& datagrams = _sendBatch->getDatagrams();
+    for (auto& batchedPacket : _batchedPackets) {
+        emit packetSent(batchedPacket.wireSize, batchedPacket.payloadSize, batchedPacket.sequenceNumber,
+                        p_high_resolution_clock::now());
+
+        if (datagrams[batchedPacket.batchIndex].bytesWritten < 0) {
+            {
+                std::lock_guard<std::mutex> nakLocker(_naksLock);
+                _naks.append(batchedPacket.sequenceNumber);
+            }
+
+            emit shortCircuitLoss(quint32(batchedPacket.sequenceNumber));
+        }
+    }
+
+    _batchedPackets.clear();
+    _sendBatch->clear();
 }
     
 void SendQueue::ack(SequenceNumber ack) {
@@ -169,8 +241,8 @@ void SendQueue::ack(SequenceNumber ack) {
     
     _lastACKSequenceNumber = (uint32_t) ack;
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping with a full congestion window
-    _emptyCondition.notify_one();
+    // wake the queue in case it is sleeping with a full congestion window
+    notifyActivity();
 }
 
 void SendQueue::nak(SequenceNumber start, SequenceNumber end) {
@@ -182,8 +254,8 @@ void SendQueue::nak(SequenceNumber start, SequenceNumber end) {
         _naks.insert(start, end);
     }
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the queue in case it is sleeping waiting for losses to re-send
+    notifyActivity();
 }
 
 void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
@@ -192,8 +264,8 @@ void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
         _naks.insert(ack, ack);
     }
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the queue in case it is sleeping waiting for losses to re-send
+    notifyActivity();
 }
 
 void SendQueue::overrideNAKListFromPacket(ControlPacket& packet) {
@@ -217,17 +289,15 @@ void SendQueue::overrideNAKListFromPacket(ControlPacket& packet) {
         }
     }
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the queue in case it is sleeping waiting for losses to re-send
+    notifyActivity();
 }
 
 void SendQueue::sendHandshake() {
     std::unique_lock<std::mutex> handshakeLock { _handshakeMutex };
     if (!_hasReceivedHandshakeACK) {
         // we haven't received a handshake ACK from the client, send another now
-        auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
-        handshakePacket->writePrimitive(_initialSequenceNumber);
-        _socket->writeBasePacket(*handshakePacket, _destination);
+        writeHandshake();
         
         // we wait for the ACK or the re-send interval to expire
         static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
@@ -235,6 +305,12 @@ void SendQueue::sendHandshake() {
     }
 }
 
+void SendQueue::writeHandshake() {
+    auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
+    handshakePacket->writePrimitive(_initialSequenceNumber);
+    _socket->writeBasePacket(*handshakePacket, _destination);
+}
+
 void SendQueue::handshakeACK(SequenceNumber initialSequenceNumber) {
     if (initialSequenceNumber == _initialSequenceNumber) {
         {
@@ -243,6 +319,11 @@ void SendQueue::handshakeACK(SequenceNumber initialSequenceNumber) {
         }
         // Notify on the handshake ACK condition
         _handshakeACKCondition.notify_one();
+
+        if (_isScheduled) {
+            // a scheduled queue is parked until its next handshake re-send, wake it so it starts sending now
+            notifyActivity();
+        }
     }
 }
 
@@ -259,9 +340,15 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     auto packetSize = newPacket->getWireSize();
     auto payloadSize = newPacket->getPayloadSize();
     
-    auto bytesWritten = sendPacket(*newPacket);
+    int batchIndex;
+    auto bytesWritten = sendPacket(*newPacket, &batchIndex);
 
-    emit packetSent(packetSize, payloadSize, sequenceNumber, p_high_resolution_clock::now());
+    if (batchIndex >= 0) {
+        // we only find out if this packet made it onto the wire once the batch is flushed
+        _batchedPackets.push_back({ batchIndex, sequenceNumber, packetSize, payloadSize });
+    } else {
+        emit packetSent(packetSize, payloadSize, sequenceNumber, p_high_resolution_clock::now());
+    }
 
     {
         // Insert the packet we have just sent in the sent list
@@ -398,6 +485,179 @@ void SendQueue::run() {
     }
 }
 
+bool SendQueue::serviceScheduled(p_high_resolution_clock::time_point& nextServiceTime) {
+    // this is the scheduler's equivalent of run() - it does what one iteration of that loop does,
+    // but instead of sleeping it returns the time at which it next wants to be serviced
+
+    if (_state == State::Stopped) {
+        return false;
+    }
+
+    auto now = p_high_resolution_clock::now();
+
+    if (_state == State::NotStarted) {
+        _state = State::Running;
+        _nextHandshakeTimestamp = now;
+        _nextPacketTimestamp = now;
+    }
+
+    // any wake since our last service restarts the idle and loss timeouts, like a notify does for run()
+    if (_hasActivity.exchange(false)) {
+        _idleTimeoutTimestamp = p_high_resolution_clock::time_point();
+        _lossTimeoutTimestamp = p_high_resolution_clock::time_point();
+    }
+
+    // Wait for handshake to be complete
+    if (!_hasReceivedHandshakeACK) {
+        static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
+
+        if (now >= _nextHandshakeTimestamp) {
+            writeHandshake();
+            _nextHandshakeTimestamp = now + HANDSHAKE_RESEND_INTERVAL;
+        }
+
+        // the handshake ACK will wake us before then if it comes in
+        nextServiceTime = _nextHandshakeTimestamp;
+        _nextPacketTimestamp = now;
+        return true;
+    }
+
+    if (_packetSendPeriod > 0 && now < _nextPacketTimestamp) {
+        // we were woken early (by new packets or an ACK/NAK) - respect the pacing from congestion control
+        nextServiceTime = _nextPacketTimestamp;
+        return true;
+    }
+
+    // we may have been serviced later than we asked for, so send as many packets as the pacing allows.
+    // cap the number of packets per service so that one busy queue can not starve the others
+    static const int MAX_PACKETS_PER_SERVICE = 32;
+
+    bool attemptedToSendPacket = false;
+    int numSendAttempts = 0;
+
+    while (_state == State::Running && numSendAttempts < MAX_PACKETS_PER_SERVICE) {
+        bool attemptedToSendThisTime = maybeResendPacket();
+
+        // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
+        // (this is according to the current flow window size) then we send out a new packet
+        auto newPacketCount = 0;
+        if (!attemptedToSendThisTime) {
+            newPacketCount = maybeSendNewPacket();
+            attemptedToSendThisTime = (newPacketCount > 0);
+        }
+
+        if (!attemptedToSendThisTime) {
+            break;
+        }
+
+        attemptedToSendPacket = true;
+        numSendAttempts += (newPacketCount == 2 ? 2 : 1);
+
+        if (_packetSendPeriod > 0) {
+            // push the next packet timestamp forwards by the current packet send period
+            auto nextPacketDelta = std::chrono::microseconds((newPacketCount == 2 ? 2 : 1) * _packetSendPeriod);
+            _nextPacketTimestamp += nextPacketDelta;
+
+            // as in run(), we use _nextPacketTimestamp so that we don't fall behind, not to force long waits
+            now = p_high_resolution_clock::now();
+            if (_nextPacketTimestamp > now + nextPacketDelta) {
+                _nextPacketTimestamp = now + nextPacketDelta;
+            }
+
+            if (_nextPacketTimestamp > now) {
+                // the next packet is not due yet
+                break;
+            }
+        }
+    }
+
+    flushSendBatch();
+
+    if (_state != State::Running) {
+        return false;
+    }
+
+    // check for connection timeout
+    if (hasTimedOut()) {
+        deactivate();
+        return false;
+    }
+
+    if (attemptedToSendPacket) {
+        _idleTimeoutTimestamp = p_high_resolution_clock::time_point();
+        _lossTimeoutTimestamp = p_high_resolution_clock::time_point();
+
+        // with no pacing we come back right away, after the other ready queues have had their turn
+        nextServiceTime = (_packetSendPeriod > 0) ? _nextPacketTimestamp : now;
+        return true;
+    }
+
+    // During our processing above we didn't send any packets, so there is nothing to send or the flow window is full.
+    // Wait to be woken by activity, or until the timeout that the condition_variable_any waits for in isInactive
+    now = p_high_resolution_clock::now();
+
+    bool hasNAKs;
+    {
+        std::lock_guard<std::mutex> nakLocker(_naksLock);
+        hasNAKs = !_naks.isEmpty();
+    }
+
+    if (hasNAKs || (!_packets.isEmpty() && !isFlowWindowFull())) {
+        // something showed up while we were checking, come back right away
+        nextServiceTime = now;
+        return true;
+    }
+
+    if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
+        // we've sent the client as much data as we have (and they've ACKed it)
+        // either wait for new data to send or 5 seconds before cleaning up the queue
+        static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
+
+        if (_idleTimeoutTimestamp.time_since_epoch().count() == 0) {
+            _idleTimeoutTimestamp = now + EMPTY_QUEUES_INACTIVE_TIMEOUT;
+        } else if (now >= _idleTimeoutTimestamp) {
+#ifdef UDT_CONNECTION_DEBUG
+            qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
+                << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
+                << "seconds and receiver has ACKed all packets."
+                << "The queue is now inactive and will be stopped.";
+#endif
+            deactivate();
+            return false;
+        }
+
+        nextServiceTime = _idleTimeoutTimestamp;
+    } else {
+        // We think the client is still waiting for data (based on the sequence number gap)
+        // Let's wait either for a response from the client or until the estimated timeout
+        // (plus the sync interval to allow the client to respond) has elapsed
+        if (_lossTimeoutTimestamp.time_since_epoch().count() == 0) {
+            _lossTimeoutTimestamp = now + std::chrono::microseconds(_estimatedTimeout + _syncInterval);
+        } else if (now >= _lossTimeoutTimestamp) {
+            // after a timeout if we still have sent packets that the client hasn't ACKed we
+            // add them to the loss list
+            {
+                std::lock_guard<std::mutex> nakLocker(_naksLock);
+                if (SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
+                    _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
+                }
+            }
+
+            _lossTimeoutTimestamp = p_high_resolution_clock::time_point();
+
+            emit timeout();
+
+            // come back right away to re-send what we just considered lost
+            nextServiceTime = now;
+            return true;
+        }
+
+        nextServiceTime = _lossTimeoutTimestamp;
+    }
+
+    return true;
+}
+
 void SendQueue::setProbePacketEnabled(bool enabled) {
     _shouldSendProbes = enabled;
 }
@@ -435,7 +695,7 @@ int SendQueue::maybeSendNewPacket() {
                     // send a control packet of type ProbePairTail so the receiver can still do
                     // proper bandwidth estimation
                     static auto pairTailPacket = ControlPacket::create(ControlPacket::ProbeTail);
-                    _socket->writeBasePacket(*pairTailPacket, _destination);
+                    sendDatagram(pairTailPacket->getData(), pairTailPacket->getDataSize());
                 }
 
                 // return the number of attempted packet sends
@@ -534,9 +794,7 @@ bool SendQueue::maybeResendPacket() {
     return false;
 }
 
-bool SendQueue::isInactive(bool attemptedToSendPacket) {
-    // check for connection timeout first
-
+bool SendQueue::hasTimedOut() const {
     // that will be the case if we have had 16 timeouts since hearing back from the client, and it has been
     // at least 5 seconds
     static const int NUM_TIMEOUTS_BEFORE_INACTIVE = 16;
@@ -547,14 +805,23 @@ bool SendQueue::isInactive(bool attemptedToSendPacket) {
     if (sinceLastResponse > 0 &&
         sinceLastResponse >= int64_t(NUM_TIMEOUTS_BEFORE_INACTIVE * (_estimatedTimeout / USECS_PER_MSEC)) &&
         sinceLastResponse > MIN_MS_BEFORE_INACTIVE) {
-        // If the flow window has been full for over CONSIDER_INACTIVE_AFTER,
-        // then signal the queue is inactive and return so it can be cleaned up
 
 #ifdef UDT_CONNECTION_DEBUG
         qCDebug(networking) << "SendQueue to" << _destination << "reached" << NUM_TIMEOUTS_BEFORE_INACTIVE << "timeouts"
             << "and" << MIN_MS_BEFORE_INACTIVE << "milliseconds before receiving any ACK/NAK and is now inactive. Stopping.";
 #endif
 
+        return true;
+    }
+
+    return false;
+}
+
+bool SendQueue::isInactive(bool attemptedToSendPacket) {
+    // check for connection timeout first
+    if (hasTimedOut()) {
+        // If the flow window has been full for over CONSIDER_INACTIVE_AFTER,
+        // then signal the queue is inactive and return so it can be cleaned up
         deactivate();
         return true;
     }
@@ -19,6 +19,7 @@
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include <QtCore/QObject>
 #include <QtCore/QReadWriteLock>
@@ -28,6 +29,7 @@
 #include "../HifiSockAddr.h"
 
 #include "Constants.h"
+#include "DatagramBatch.h"
 #include "PacketQueue.h"
 #include "SequenceNumber.h"
 #include "LossList.h"
@@ -52,6 +54,13 @@ public:
     
     static std::unique_ptr<SendQueue> create(Socket* socket, HifiSockAddr destination);
 
+    // true if this queue is serviced by the SendQueueScheduler instead of its own thread
+    bool isScheduled() const { return _isScheduled; }
+
+    // called by the SendQueueScheduler - sends what can be sent now without blocking
+    // returns false once the queue has stopped, otherwise sets the time at which it next wants to be serviced
+    bool serviceScheduled(p_high_resolution_clock::time_point& nextServiceTime);
+
     virtual ~SendQueue();
     
     void queuePacket(std::unique_ptr<Packet> packet);
@@ -96,14 +105,22 @@ private:
     SendQueue(SendQueue&& other) = delete;
     
     void sendHandshake();
+    void writeHandshake();
+
+    // wakes the queue if it is waiting for packets, ACKs or NAKs
+    void notifyActivity();
     
-    int sendPacket(const Packet& packet);
+    // batchIndex is set to the index of the datagram in _sendBatch if it was batched, or -1 if it was written directly
+    int sendPacket(const Packet& packet, int* batchIndex = nullptr);
+    int sendDatagram(const char* data, qint64 size, int* batchIndex = nullptr);
+    void flushSendBatch(); // writes the packets batched during a scheduled service
     bool sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket, SequenceNumber sequenceNumber);
     
     int maybeSendNewPacket(); // Figures out what packet to send next
     bool maybeResendPacket(); // Determines whether to resend a packet and which one
     
     bool isInactive(bool attemptedToSendPacket);
+    bool hasTimedOut() const; // true once the receiver has not responded for long enough to consider the queue inactive
     void deactivate(); // makes the queue inactive and cleans it up
 
     bool isFlowWindowFull() const;
@@ -147,6 +164,23 @@ private:
 
 
     std::atomic<bool> _shouldSendProbes { true };
+
+    // state used when serviced by the SendQueueScheduler (only touched by the thread currently servicing the queue)
+    bool _isScheduled { false };
+    std::atomic<bool> _hasActivity { false }; // set whenever the queue is woken, restarts the idle and timeout waits
+    p_high_resolution_clock::time_point _nextHandshakeTimestamp;
+    p_high_resolution_clock::time_point _nextPacketTimestamp;
+    p_high_resolution_clock::time_point _idleTimeoutTimestamp; // when an empty and fully ACKed queue becomes inactive
+    p_high_resolution_clock::time_point _lossTimeoutTimestamp; // when unACKed packets are considered lost
+    std::unique_ptr<DatagramBatch> _sendBatch; // packets sent in one service, written with a single syscall
+
+    struct BatchedPacket {
+        int batchIndex;
+        SequenceNumber sequenceNumber;
+        int wireSize;
+        int payloadSize;
+    };
+    std::vector<BatchedPacket> _batchedPackets; // new packets in _sendBatch, reported sent or lost once it is flushed
 };
     
 }
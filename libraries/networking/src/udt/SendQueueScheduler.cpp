@@ -0,0 +1,365 @@
+//
+//  SendQueueScheduler.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendQueueScheduler.h"
+
+#include <algorithm>
+
+#include <QtCore/QtAlgorithms>
+
+#include "../NetworkLogging.h"
+#include "SendQueue.h"
+
+using namespace udt;
+using namespace std::chrono;
+
+// each slot of the timer wheel covers 100us, a full revolution covers ~410ms
+// queues that want to be serviced further out than a revolution simply stay in their slot for more than one revolution
+static const int64_t WHEEL_SLOT_USECS = 100;
+static const uint64_t NUM_WHEEL_SLOTS = 4096;
+static const uint64_t SLOTS_PER_WORD = 64;
+static const uint64_t NUM_OCCUPIED_WORDS = NUM_WHEEL_SLOTS / SLOTS_PER_WORD;
+
+SendQueueScheduler& SendQueueScheduler::getInstance() {
+    static SendQueueScheduler instance;
+    return instance;
+}
+
+SendQueueScheduler::~SendQueueScheduler() {
+    stop();
+}
+
+void SendQueueScheduler::start(int numThreads) {
+    Lock lock(_mutex);
+
+    if (_isRunning) {
+        qCWarning(networking) << "SendQueueScheduler asked to start but is already running with"
+            << _threads.size() << "threads.";
+        return;
+    }
+
+    numThreads = std::max(numThreads, 1);
+
+    _wheel.clear();
+    _wheel.resize(NUM_WHEEL_SLOTS);
+    _occupiedSlots.assign(NUM_OCCUPIED_WORDS, 0);
+    _epoch = Clock::now();
+    _currentTick = 0;
+    _nextTick = UINT64_MAX;
+    _numTimers = 0;
+    _isStopping = false;
+    _stats = Stats();
+    _stats.numThreads = numThreads;
+
+    for (int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back([this] { run(); });
+    }
+
+    _isRunning = true;
+
+    qCDebug(networking) << "SendQueueScheduler started with" << numThreads << "threads.";
+}
+
+void SendQueueScheduler::stop() {
+    {
+        Lock lock(_mutex);
+        if (!_isRunning) {
+            return;
+        }
+
+        Q_ASSERT_X(_queues.empty(), "SendQueueScheduler::stop", "All scheduled SendQueues must be removed before stopping");
+        _isStopping = true;
+    }
+
+    _workCondition.notify_all();
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+    _threads.clear();
+
+    Lock lock(_mutex);
+    _readyQueues.clear();
+    _wheel.clear();
+    _occupiedSlots.clear();
+    _numTimers = 0;
+    _nextTick = UINT64_MAX;
+    _stats.numThreads = 0;
+    _isRunning = false;
+}
+
+void SendQueueScheduler::add(SendQueue* queue) {
+    Lock lock(_mutex);
+
+    auto& state = _queues[queue];
+    state = QueueState();
+    makeReady(queue, state);
+}
+
+void SendQueueScheduler::remove(SendQueue* queue) {
+    Lock lock(_mutex);
+
+    auto it = _queues.find(queue);
+    if (it == _queues.end()) {
+        return;
+    }
+
+    it->second.isRemoved = true;
+
+    // wait for any thread currently servicing this queue to be done with it
+    _removedCondition.wait(lock, [&] {
+        auto it = _queues.find(queue);
+        return it == _queues.end() || !it->second.isServicing;
+    });
+
+    // any entry for this queue left in the wheel is now stale, and will be discarded when its slot is expired
+    _readyQueues.erase(std::remove(_readyQueues.begin(), _readyQueues.end(), queue), _readyQueues.end());
+    _queues.erase(queue);
+}
+
+void SendQueueScheduler::wake(SendQueue* queue) {
+    Lock lock(_mutex);
+
+    auto it = _queues.find(queue);
+    if (it == _queues.end() || it->second.isRemoved) {
+        return;
+    }
+
+    auto& state = it->second;
+    if (state.isServicing) {
+        // the thread servicing the queue will make it ready again once it is done
+        state.shouldWake = true;
+    } else if (!state.isReady) {
+        ++_stats.numWakes;
+        makeReady(queue, state);
+    }
+}
+
+SendQueueScheduler::Stats SendQueueScheduler::getStats() {
+    Lock lock(_mutex);
+    _stats.numQueues = (int)_queues.size();
+    return _stats;
+}
+
+void SendQueueScheduler::run() {
+    Lock lock(_mutex);
+
+    while (!_isStopping) {
+        advanceWheel(Clock::now());
+
+        if (!_readyQueues.empty()) {
+            SendQueue* queue = _readyQueues.front();
+            _readyQueues.pop_front();
+
+            {
+                auto& state = _queues[queue];
+                state.isReady = false;
+                state.isServicing = true;
+                state.shouldWake = false;
+                ++_stats.numServices;
+            }
+
+            // service the queue without holding the scheduler lock
+            lock.unlock();
+            Clock::time_point nextServiceTime;
+            bool shouldReschedule = queue->serviceScheduled(nextServiceTime);
+            lock.lock();
+
+            // the queue is still known, remove waits for us to be done servicing it
+            auto& state = _queues[queue];
+            state.isServicing = false;
+
+            if (state.isRemoved) {
+                _removedCondition.notify_all();
+            } else if (!shouldReschedule) {
+                // the queue has stopped, it stays registered (without a timer) until its connection removes it
+            } else if (state.shouldWake) {
+                ++_stats.numWakes;
+                makeReady(queue, state);
+            } else {
+                scheduleAt(queue, state, nextServiceTime);
+            }
+
+            continue;
+        }
+
+        if (_nextTick == UINT64_MAX) {
+            _workCondition.wait(lock);
+        } else {
+            _workCondition.wait_until(lock, timeForTick(_nextTick));
+        }
+    }
+}
+
+uint64_t SendQueueScheduler::tickForTime(Clock::time_point time) const {
+    // round up, so that a queue is never serviced before the time it asked for
+    auto usecs = duration_cast<microseconds>(time - _epoch).count();
+    return usecs <= 0 ? 0 : (uint64_t)((usecs + WHEEL_SLOT_USECS - 1) / WHEEL_SLOT_USECS);
+}
+
+SendQueueScheduler::Clock::time_point SendQueueScheduler::timeForTick(uint64_t tick) const {
+    return _epoch + microseconds(tick * WHEEL_SLOT_USECS);
+}
+
+void SendQueueScheduler::makeReady(SendQueue* queue, QueueState& state) {
+    // bumping the generation invalidates any timer entry this queue still has in the wheel
+    state.generation = ++_generationCounter;
+    state.isReady = true;
+
+    _readyQueues.push_back(queue);
+    _workCondition.notify_one();
+}
+
+void SendQueueScheduler::scheduleAt(SendQueue* queue, QueueState& state, Clock::time_point time) {
+    uint64_t tick = tickForTime(time);
+
+    if (tick < _currentTick) {
+        // that tick has already been expired, this queue is ready now
+        makeReady(queue, state);
+        return;
+    }
+
+    state.generation = ++_generationCounter;
+
+    _wheel[tick % NUM_WHEEL_SLOTS].push_back({ queue, tick, state.generation });
+    markSlotOccupied(tick % NUM_WHEEL_SLOTS);
+    ++_numTimers;
+
+    if (tick < _nextTick) {
+        // this is now the earliest timer, make sure a sleeping thread wakes up for it
+        _nextTick = tick;
+        _workCondition.notify_one();
+    }
+}
+
+void SendQueueScheduler::advanceWheel(Clock::time_point now) {
+    auto usecs = duration_cast<microseconds>(now - _epoch).count();
+    uint64_t nowTick = usecs <= 0 ? 0 : (uint64_t)(usecs / WHEEL_SLOT_USECS);
+
+    if (nowTick < _currentTick) {
+        return;
+    }
+
+    if (_numTimers > 0 && _nextTick <= nowTick) {
+        // expire every occupied slot between the current tick and now - visiting each slot at most once
+        uint64_t firstTick = std::max(_currentTick, _nextTick);
+        uint64_t lastTick = std::min(nowTick, firstTick + NUM_WHEEL_SLOTS - 1);
+
+        for (uint64_t tick = findOccupiedSlot(firstTick); tick <= lastTick; tick = findOccupiedSlot(tick + 1)) {
+            auto& slot = _wheel[tick % NUM_WHEEL_SLOTS];
+
+            for (size_t i = 0; i < slot.size();) {
+                auto entry = slot[i];
+
+                if (entry.tick > nowTick) {
+                    // this entry is for a later revolution of the wheel
+                    ++i;
+                    continue;
+                }
+
+                // remove the entry from the slot
+                slot[i] = slot.back();
+                slot.pop_back();
+                --_numTimers;
+
+                auto it = _queues.find(entry.queue);
+                if (it != _queues.end() && it->second.generation == entry.generation && !it->second.isRemoved) {
+                    ++_stats.numTimerExpirations;
+                    makeReady(entry.queue, it->second);
+                }
+            }
+
+            if (slot.empty()) {
+                markSlotEmpty(tick % NUM_WHEEL_SLOTS);
+            }
+        }
+    }
+
+    bool expiredNextTick = _nextTick <= nowTick;
+    _currentTick = nowTick + 1;
+
+    if (expiredNextTick) {
+        updateNextTick();
+    }
+}
+
+void SendQueueScheduler::updateNextTick() {
+    _nextTick = UINT64_MAX;
+
+    if (_numTimers == 0) {
+        return;
+    }
+
+    // visit the occupied slots of one revolution of the wheel from the current tick,
+    // the first live entry due in this revolution is the earliest
+    uint64_t endTick = _currentTick + NUM_WHEEL_SLOTS;
+    for (uint64_t tick = findOccupiedSlot(_currentTick); tick < endTick; tick = findOccupiedSlot(tick + 1)) {
+        auto& slot = _wheel[tick % NUM_WHEEL_SLOTS];
+
+        for (size_t i = 0; i < slot.size();) {
+            auto entry = slot[i];
+
+            auto it = _queues.find(entry.queue);
+            if (it == _queues.end() || it->second.generation != entry.generation) {
+                // stale entry, drop it now so that its slot isn't visited again
+                slot[i] = slot.back();
+                slot.pop_back();
+                --_numTimers;
+                continue;
+            }
+
+            if (entry.tick <= tick) {
+                _nextTick = tick;
+                return;
+            }
+
+            _nextTick = std::min(_nextTick, entry.tick);
+            ++i;
+        }
+
+        if (slot.empty()) {
+            markSlotEmpty(tick % NUM_WHEEL_SLOTS);
+        }
+    }
+}
+
+void SendQueueScheduler::markSlotOccupied(uint64_t slot) {
+    _occupiedSlots[slot / SLOTS_PER_WORD] |= (uint64_t)1 << (slot % SLOTS_PER_WORD);
+}
+
+void SendQueueScheduler::markSlotEmpty(uint64_t slot) {
+    _occupiedSlots[slot / SLOTS_PER_WORD] &= ~((uint64_t)1 << (slot % SLOTS_PER_WORD));
+}
+
+uint64_t SendQueueScheduler::findOccupiedSlot(uint64_t fromTick) const {
+    // returns the first tick in the revolution starting at fromTick whose slot holds entries, or UINT64_MAX
+    uint64_t startSlot = fromTick % NUM_WHEEL_SLOTS;
+    uint64_t startWord = startSlot / SLOTS_PER_WORD;
+    uint64_t startBit = startSlot % SLOTS_PER_WORD;
+
+    // the start word is visited twice: first for the slots from the start slot, last for the slots before it
+    for (uint64_t i = 0; i <= NUM_OCCUPIED_WORDS; ++i) {
+        uint64_t wordIndex = (startWord + i) % NUM_OCCUPIED_WORDS;
+        uint64_t word = _occupiedSlots[wordIndex];
+
+        if (i == 0) {
+            word &= ~(uint64_t)0 << startBit;
+        } else if (i == NUM_OCCUPIED_WORDS) {
+            word &= ~(~(uint64_t)0 << startBit);
+        }
+
+        if (word != 0) {
+            uint64_t slot = wordIndex * SLOTS_PER_WORD + qCountTrailingZeroBits((quint64)word);
+            return fromTick + (slot + NUM_WHEEL_SLOTS - startSlot) % NUM_WHEEL_SLOTS;
+        }
+    }
+
+    return UINT64_MAX;
+}
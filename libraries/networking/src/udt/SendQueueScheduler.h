@@ -0,0 +1,126 @@
+//
+//  SendQueueScheduler.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SendQueueScheduler_h
+#define hifi_SendQueueScheduler_h
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <PortableHighResolutionClock.h>
+
+namespace udt {
+
+class SendQueue;
+
+// Services every scheduled SendQueue from a small, fixed pool of threads.
+//
+// Each queue is serviced until it has nothing left to send right now, and is then parked on a hashed timer wheel
+// at the time it next wants to send (its pacing deadline, handshake re-send, or timeout). Activity on a queue
+// (new packets, ACKs, NAKs, stop) wakes it early.
+//
+// Only queues of sockets that opt in with Socket::setUseSendQueueScheduler are scheduled. If the scheduler is not
+// started, SendQueue::create falls back to one thread per queue.
+class SendQueueScheduler {
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+    using Clock = p_high_resolution_clock;
+
+public:
+    struct Stats {
+        int numThreads { 0 };
+        int numQueues { 0 };
+        uint64_t numServices { 0 }; // number of times a queue was serviced
+        uint64_t numWakes { 0 }; // number of times a queue was woken early by activity
+        uint64_t numTimerExpirations { 0 }; // number of times a queue was serviced because its timer expired
+    };
+
+    static SendQueueScheduler& getInstance();
+
+    ~SendQueueScheduler();
+
+    // start servicing queues with the given number of threads (this must be called before any scheduled queue is created)
+    void start(int numThreads);
+    // stop the threads, only valid once all scheduled queues have been removed
+    void stop();
+    bool isRunning() const { return _isRunning; }
+
+    void add(SendQueue* queue);
+    // removes the queue, blocking until no thread is servicing it - the queue can then be safely deleted
+    void remove(SendQueue* queue);
+
+    // services the queue as soon as possible (or right after the current service, if it is being serviced)
+    void wake(SendQueue* queue);
+
+    Stats getStats();
+
+private:
+    SendQueueScheduler() {}
+    SendQueueScheduler(const SendQueueScheduler& other) = delete;
+
+    struct QueueState {
+        uint64_t generation { 0 }; // invalidates entries left in the timer wheel when the queue is rescheduled
+        bool isReady { false };
+        bool isServicing { false };
+        bool shouldWake { false };
+        bool isRemoved { false };
+    };
+
+    struct TimerEntry {
+        SendQueue* queue;
+        uint64_t tick;
+        uint64_t generation;
+    };
+
+    void run();
+
+    uint64_t tickForTime(Clock::time_point time) const;
+    Clock::time_point timeForTick(uint64_t tick) const;
+
+    void makeReady(SendQueue* queue, QueueState& state); // guarded by _mutex
+    void scheduleAt(SendQueue* queue, QueueState& state, Clock::time_point time); // guarded by _mutex
+    void advanceWheel(Clock::time_point now); // guarded by _mutex
+    void updateNextTick(); // guarded by _mutex
+
+    void markSlotOccupied(uint64_t slot); // guarded by _mutex
+    void markSlotEmpty(uint64_t slot); // guarded by _mutex
+    uint64_t findOccupiedSlot(uint64_t fromTick) const; // guarded by _mutex
+
+    Mutex _mutex;
+    std::condition_variable _workCondition;
+    std::condition_variable _removedCondition;
+
+    std::vector<std::thread> _threads;
+    std::atomic<bool> _isRunning { false };
+    bool _isStopping { false }; // guarded by _mutex
+
+    std::unordered_map<SendQueue*, QueueState> _queues; // guarded by _mutex
+    std::deque<SendQueue*> _readyQueues; // guarded by _mutex
+
+    Clock::time_point _epoch { Clock::now() };
+    std::vector<std::vector<TimerEntry>> _wheel; // guarded by _mutex
+    std::vector<uint64_t> _occupiedSlots; // one bit per wheel slot, set while the slot holds entries - guarded by _mutex
+    uint64_t _currentTick { 0 }; // all ticks before this one have been expired - guarded by _mutex
+    uint64_t _nextTick { UINT64_MAX }; // earliest tick with a live entry (or UINT64_MAX) - guarded by _mutex
+    int _numTimers { 0 }; // number of entries in the wheel (including stale ones) - guarded by _mutex
+    uint64_t _generationCounter { 0 }; // unique across queues, so entries of removed queues never match - guarded by _mutex
+
+    Stats _stats; // guarded by _mutex
+};
+
+}
+
+#endif // hifi_SendQueueScheduler_h
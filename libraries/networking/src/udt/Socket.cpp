@@ -15,6 +15,15 @@
 #include <sys/socket.h>
 #endif
 
+#if defined(Q_OS_LINUX)
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#endif
+
+#include <algorithm>
+
 #include <QtCore/QThread>
 
 #include <LogHandler.h>
@@ -185,10 +194,21 @@ qint64 Socket::writePacketList(std::unique_ptr<PacketList> packetList, const Hif
     }
 
     // Unerliable and Unordered
+    if (packetList->_packets.size() <= 1) {
+        return packetList->_packets.empty() ? 0 : writePacket(packetList->takeFront<Packet>(), sockAddr);
+    }
+
+    // write the packets of the list together
+    DatagramBatch batch((int)packetList->_packets.size());
     qint64 totalBytesSent = 0;
     while (!packetList->_packets.empty()) {
-        totalBytesSent += writePacket(packetList->takeFront<Packet>(), sockAddr);
+        if (batch.isFull()) {
+            totalBytesSent += writeDatagrams(batch);
+            batch.clear();
+        }
+        writePacket(*packetList->takeFront<Packet>(), sockAddr, batch);
     }
+    totalBytesSent += writeDatagrams(batch);
 
     return totalBytesSent;
 }
@@ -226,7 +246,11 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& soc
 
     qint64 bytesWritten = _udpSocket.writeDatagram(datagram, sockAddr.getAddress(), sockAddr.getPort());
 
-    if (bytesWritten < 0) {
+    ++_numSendCalls;
+
+    if (bytesWritten >= 0) {
+        ++_numDatagramsSent;
+    } else {
         // when saturating a link this isn't an uncommon message - suppress it so it doesn't bomb the debug
         static const QString WRITE_ERROR_REGEX = "Socket::writeDatagram QAbstractSocket::NetworkError - Unable to send a message";
         static QString repeatedMessage
@@ -238,6 +262,136 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& soc
     return bytesWritten;
 }
 
+qint64 Socket::writePacket(const Packet& packet, const HifiSockAddr& sockAddr, DatagramBatch& batch) {
+    Q_ASSERT_X(!packet.isReliable(), "Socket::writePacket", "Cannot send a reliable packet unreliably");
+
+    SequenceNumber sequenceNumber;
+    {
+        Lock lock(_unreliableSequenceNumbersMutex);
+        sequenceNumber = ++_unreliableSequenceNumbers[sockAddr];
+    }
+
+    // write the correct sequence number to the Packet here
+    packet.writeSequenceNumber(sequenceNumber);
+
+    return writeDatagram(packet.getData(), packet.getDataSize(), sockAddr, batch);
+}
+
+qint64 Socket::writeDatagram(const char* data, qint64 size, const HifiSockAddr& sockAddr, DatagramBatch& batch) {
+    if (batch.isFull()) {
+        writeDatagrams(batch);
+        batch.clear();
+    }
+
+    if (batch.append(data, size, sockAddr) < 0) {
+        // this datagram can't be batched, write it on its own
+        return writeDatagram(data, size, sockAddr);
+    }
+
+    return size;
+}
+
+qint64 Socket::writeDatagrams(DatagramBatch& batch) {
+    auto& datagrams = batch.getDatagrams();
+    qint64 totalBytesWritten = 0;
+
+#if defined(Q_OS_LINUX)
+    mmsghdr messages[DatagramBatch::MAX_DATAGRAMS];
+    iovec iovecs[DatagramBatch::MAX_DATAGRAMS];
+    sockaddr_in addresses[DatagramBatch::MAX_DATAGRAMS];
+    int indexes[DatagramBatch::MAX_DATAGRAMS];
+    int numMessages = 0;
+
+    for (int i = 0; i < (int)datagrams.size(); ++i) {
+        auto& datagram = datagrams[i];
+
+        if (datagram.sockAddr.getAddress().protocol() != QAbstractSocket::IPv4Protocol) {
+            // our node socket is bound to IPv4, let the QUdpSocket deal with anything else
+            datagram.bytesWritten = writeDatagram(datagram.data, datagram.size, datagram.sockAddr);
+            totalBytesWritten += std::max(datagram.bytesWritten, (qint64)0);
+            continue;
+        }
+
+        auto& address = addresses[numMessages];
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(datagram.sockAddr.getAddress().toIPv4Address());
+        address.sin_port = htons(datagram.sockAddr.getPort());
+
+        iovecs[numMessages].iov_base = const_cast<char*>(datagram.data);
+        iovecs[numMessages].iov_len = datagram.size;
+
+        auto& message = messages[numMessages];
+        memset(&message, 0, sizeof(message));
+        message.msg_hdr.msg_name = &address;
+        message.msg_hdr.msg_namelen = sizeof(address);
+        message.msg_hdr.msg_iov = &iovecs[numMessages];
+        message.msg_hdr.msg_iovlen = 1;
+
+        indexes[numMessages] = i;
+        ++numMessages;
+    }
+
+    auto sd = _udpSocket.socketDescriptor();
+    int numSent = 0;
+
+    while (numSent < numMessages) {
+        int result = ::sendmmsg(sd, messages + numSent, numMessages - numSent, 0);
+        ++_numSendCalls;
+
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            // none of the remaining datagrams were written - mark them all, so their senders see them as lost
+            static const QString WRITE_ERROR_REGEX = "Socket::writeDatagrams sendmmsg failed - .*";
+            static QString repeatedMessage
+                = LogHandler::getInstance().addRepeatedMessageRegex(WRITE_ERROR_REGEX);
+
+            qCDebug(networking) << "Socket::writeDatagrams sendmmsg failed -" << strerror(errno);
+
+            for (int i = numSent; i < numMessages; ++i) {
+                datagrams[indexes[i]].bytesWritten = -1;
+            }
+            break;
+        }
+
+        for (int i = numSent; i < numSent + result; ++i) {
+            auto& datagram = datagrams[indexes[i]];
+            datagram.bytesWritten = messages[i].msg_len;
+            totalBytesWritten += datagram.bytesWritten;
+        }
+
+        _numDatagramsSent += result;
+        numSent += result;
+    }
+#else
+    for (auto& datagram : datagrams) {
+        datagram.bytesWritten = writeDatagram(datagram.data, datagram.size, datagram.sockAddr);
+        totalBytesWritten += std::max(datagram.bytesWritten, (qint64)0);
+    }
+#endif
+
+    return totalBytesWritten;
+}
+
+Socket::SyscallStats Socket::getSyscallStats() const {
+    SyscallStats stats;
+    stats.numReceiveCalls = _numReceiveCalls;
+    stats.numDatagramsReceived = _numDatagramsReceived;
+    stats.numSendCalls = _numSendCalls;
+    stats.numDatagramsSent = _numDatagramsSent;
+    return stats;
+}
+
+void Socket::resetSyscallStats() {
+    _numReceiveCalls = 0;
+    _numDatagramsReceived = 0;
+    _numSendCalls = 0;
+    _numDatagramsSent = 0;
+}
+
 Connection* Socket::findOrCreateConnection(const HifiSockAddr& sockAddr) {
     auto it = _connectionsHash.find(sockAddr);
 
@@ -342,11 +496,12 @@ void Socket::readPendingDatagrams() {
         HifiSockAddr senderSockAddr;
 
         // setup a buffer to read the packet into
-        auto buffer = std::unique_ptr<char[]>(new char[packetSizeWithHeader]);
+        auto buffer = PacketBufferPool::allocate(packetSizeWithHeader);
 
         // pull the datagram
         auto sizeRead = _udpSocket.readDatagram(buffer.get(), packetSizeWithHeader,
                                                 senderSockAddr.getAddressPointer(), senderSockAddr.getPortPointer());
+        ++_numReceiveCalls;
 
         // save information for this packet, in case it is the one that sticks readyRead
         _lastPacketSizeRead = sizeRead;
@@ -358,65 +513,145 @@ void Socket::readPendingDatagrams() {
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+        ++_numDatagramsReceived;
 
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this HifiSockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
-            }
+        processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
+
+#if defined(Q_OS_LINUX)
+        // reading the first datagram through the QUdpSocket re-arms its readyRead notification,
+        // drain whatever else is queued on the socket in batches
+        while (readDatagramBatch() == DatagramBatch::MAX_DATAGRAMS) {}
+#endif
+    }
+}
+
+#if defined(Q_OS_LINUX)
+int Socket::readDatagramBatch() {
+    static const int MAX_DATAGRAMS_PER_READ = DatagramBatch::MAX_DATAGRAMS;
+
+    _receiveBuffers.resize(MAX_DATAGRAMS_PER_READ);
+
+    mmsghdr messages[MAX_DATAGRAMS_PER_READ];
+    iovec iovecs[MAX_DATAGRAMS_PER_READ];
+    sockaddr_storage addresses[MAX_DATAGRAMS_PER_READ];
+
+    memset(messages, 0, sizeof(messages));
+
+    for (int i = 0; i < MAX_DATAGRAMS_PER_READ; ++i) {
+        auto& buffer = _receiveBuffers[i];
+        if (!buffer) {
+            buffer = PacketBufferPool::allocate(MAX_PACKET_SIZE);
+        }
+
+        iovecs[i].iov_base = buffer.get();
+        iovecs[i].iov_len = MAX_PACKET_SIZE;
+
+        messages[i].msg_hdr.msg_name = &addresses[i];
+        messages[i].msg_hdr.msg_namelen = sizeof(addresses[i]);
+        messages[i].msg_hdr.msg_iov = &iovecs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    auto sd = _udpSocket.socketDescriptor();
+
+    int numReceived;
+    do {
+        numReceived = ::recvmmsg(sd, messages, MAX_DATAGRAMS_PER_READ, MSG_DONTWAIT, nullptr);
+    } while (numReceived < 0 && errno == EINTR);
 
+    ++_numReceiveCalls;
+
+    if (numReceived <= 0) {
+        // nothing left on the socket (EAGAIN) or an error that the next readyRead will surface
+        return 0;
+    }
+
+    _numDatagramsReceived += numReceived;
+
+    _readyReadBackupTimer->start();
+    auto receiveTime = p_high_resolution_clock::now();
+
+    for (int i = 0; i < numReceived; ++i) {
+        int size = (int)messages[i].msg_len;
+
+        HifiSockAddr senderSockAddr(reinterpret_cast<const sockaddr*>(&addresses[i]));
+
+        _lastPacketSizeRead = size;
+        _lastPacketSockAddr = senderSockAddr;
+
+        if (size <= 0 || (messages[i].msg_hdr.msg_flags & MSG_TRUNC)) {
+            // nothing we send is larger than MAX_PACKET_SIZE, drop anything that didn't fit
             continue;
         }
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        // the datagram was received straight into a pooled buffer, the packet takes it over
+        processDatagram(std::move(_receiveBuffers[i]), size, senderSockAddr, receiveTime);
+    }
+
+    return numReceived;
+}
+#endif
+
+void Socket::processDatagram(PacketBuffer buffer, int size, const HifiSockAddr& senderSockAddr,
+                             p_high_resolution_clock::time_point receiveTime) {
+    auto it = _unfilteredHandlers.find(senderSockAddr);
+
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this HifiSockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), size, senderSockAddr);
+            basePacket->setReceiveTime(receiveTime);
+            it->second(std::move(basePacket));
+        }
+
+        return;
+    }
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr);
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), size, senderSockAddr);
+        controlPacket->setReceiveTime(receiveTime);
 
-            if (connection) {
-                connection->processControl(move(controlPacket));
-            }
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr);
 
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
-
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
-
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
-                    auto connection = findOrCreateConnection(senderSockAddr);
-
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
-                        continue;
-                    }
+        if (connection) {
+            connection->processControl(move(controlPacket));
+        }
+
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), size, senderSockAddr);
+        packet->setReceiveTime(receiveTime);
+
+        // save the sequence number in case this is the packet that sticks readyRead
+        _lastReceivedSequenceNumber = packet->getSequenceNumber();
+
+        // call our verification operator to see if this packet is verified
+        if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+            if (packet->isReliable()) {
+                // if this was a reliable packet then signal the matching connection with the sequence number
+                auto connection = findOrCreateConnection(senderSockAddr);
+
+                if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                              packet->getDataSize(),
+                                                                              packet->getPayloadSize())) {
+                    // the connection could not be created or indicated that we should not continue processing this packet
+                    return;
                 }
+            }
 
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
+            if (packet->isPartOfMessage()) {
+                auto connection = findOrCreateConnection(senderSockAddr);
+                if (connection) {
+                    connection->queueReceivedMessagePacket(std::move(packet));
                 }
+            } else if (_packetHandler) {
+                // call the verified packet callback to let it handle this packet
+                _packetHandler(std::move(packet));
             }
         }
     }
@@ -14,9 +14,11 @@
 #ifndef hifi_Socket_h
 #define hifi_Socket_h
 
+#include <atomic>
 #include <functional>
 #include <unordered_map>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QObject>
 #include <QtCore/QTimer>
@@ -25,6 +27,7 @@
 #include "../HifiSockAddr.h"
 #include "TCPVegasCC.h"
 #include "Connection.h"
+#include "DatagramBatch.h"
 
 //#define UDT_CONNECTION_DEBUG
 
@@ -53,6 +56,13 @@ class Socket : public QObject {
 
 public:
     using StatsVector = std::vector<std::pair<HifiSockAddr, ConnectionStats::Stats>>;
+
+    struct SyscallStats {
+        uint64_t numReceiveCalls { 0 };
+        uint64_t numDatagramsReceived { 0 };
+        uint64_t numSendCalls { 0 };
+        uint64_t numDatagramsSent { 0 };
+    };
     
     Socket(QObject* object = 0, bool shouldChangeSocketOptions = true);
     
@@ -65,6 +75,12 @@ public:
     qint64 writePacketList(std::unique_ptr<PacketList> packetList, const HifiSockAddr& sockAddr);
     qint64 writeDatagram(const char* data, qint64 size, const HifiSockAddr& sockAddr);
     qint64 writeDatagram(const QByteArray& datagram, const HifiSockAddr& sockAddr);
+
+    // Batched writes - the batch is written when it fills up, or when the caller passes it to writeDatagrams
+    qint64 writePacket(const Packet& packet, const HifiSockAddr& sockAddr, DatagramBatch& batch);
+    qint64 writeDatagram(const char* data, qint64 size, const HifiSockAddr& sockAddr, DatagramBatch& batch);
+    // writes every datagram in the batch (with a single sendmmsg on Linux) and sets the bytesWritten of each
+    qint64 writeDatagrams(DatagramBatch& batch);
     
     void bind(const QHostAddress& address, quint16 port = 0);
     void rebind(quint16 port);
@@ -83,11 +99,18 @@ public:
     void setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory);
     void setConnectionMaxBandwidth(int maxBandwidth);
 
+    // send queues created after this is turned on are serviced by the SendQueueScheduler, if it is running
+    void setUseSendQueueScheduler(bool useSendQueueScheduler) { _useSendQueueScheduler = useSendQueueScheduler; }
+    bool usesSendQueueScheduler() const { return _useSendQueueScheduler; }
+
     void messageReceived(std::unique_ptr<Packet> packet);
     void messageFailed(Connection* connection, Packet::MessageNumber messageNumber);
     
     StatsVector sampleStatsForAllConnections();
 
+    SyscallStats getSyscallStats() const;
+    void resetSyscallStats();
+
 #if (PR_BUILD || DEV_BUILD)
     void sendFakedHandshakeRequest(const HifiSockAddr& sockAddr);
 #endif
@@ -109,6 +132,11 @@ private slots:
 
 private:
     void setSystemBufferSizes();
+    void processDatagram(PacketBuffer buffer, int size, const HifiSockAddr& senderSockAddr,
+                         p_high_resolution_clock::time_point receiveTime);
+#if defined(Q_OS_LINUX)
+    int readDatagramBatch();
+#endif
     Connection* findOrCreateConnection(const HifiSockAddr& sockAddr);
     bool socketMatchesNodeOrDomain(const HifiSockAddr& sockAddr);
    
@@ -141,10 +169,21 @@ private:
 
     int _maxBandwidth { -1 };
 
+    std::atomic<bool> _useSendQueueScheduler { false };
+
     std::unique_ptr<CongestionControlVirtualFactory> _ccFactory { new CongestionControlFactory<TCPVegasCC>() };
 
     bool _shouldChangeSocketOptions { true };
 
+    // pooled buffers that batched reads receive into - a buffer that receives a datagram is handed to its packet,
+    // and replaced before the next read
+    std::vector<PacketBuffer> _receiveBuffers;
+
+    std::atomic<uint64_t> _numReceiveCalls { 0 };
+    std::atomic<uint64_t> _numDatagramsReceived { 0 };
+    std::atomic<uint64_t> _numSendCalls { 0 };
+    std::atomic<uint64_t> _numDatagramsSent { 0 };
+
     int _lastPacketSizeRead { 0 };
     SequenceNumber _lastReceivedSequenceNumber;
     HifiSockAddr _lastPacketSockAddr;
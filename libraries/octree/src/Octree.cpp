@@ -23,6 +23,7 @@
 #include <QEventLoop>
 #include <QFile>
 #include <QFileInfo>
+#include <QSaveFile>
 #include <QNetworkRequest>
 #include <QNetworkReply>
 #include <QNetworkAccessManager>
@@ -50,7 +51,7 @@
 #include "OctreeLogging.h"
 
 
-QVector<QString> PERSIST_EXTENSIONS = {"svo", "json", "json.gz"};
+QVector<QString> PERSIST_EXTENSIONS = {"svo", "json", "json.gz", "bin"};
 
 Octree::Octree(bool shouldReaverage) :
     _rootElement(NULL),
@@ -1627,6 +1628,9 @@ bool Octree::readFromFile(const char* fileName) {
     if (qFileName.endsWith(".json.gz")) {
         return readJSONFromGzippedFile(qFileName);
     }
+    if (qFileName.endsWith(".bin")) {
+        return readFromBinaryFile(qFileName);
+    }
 
     QFile file(qFileName);
 
@@ -1670,6 +1674,28 @@ bool Octree::readJSONFromGzippedFile(QString qFileName) {
     return readJSONFromStream(-1, jsonStream);
 }
 
+bool Octree::readFromBinaryFile(QString qFileName) {
+    QFile file(qFileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Cannot open binary snapshot file for reading: " << qFileName;
+        return false;
+    }
+
+    qCDebug(octree) << "Loading binary snapshot" << qFileName << "...";
+
+    // map the file rather than reading it, the snapshot is decoded in place
+    qint64 size = file.size();
+    uchar* mapped = file.map(0, size);
+    if (mapped) {
+        bool success = readFromBinary(mapped, size);
+        file.unmap(mapped);
+        return success;
+    }
+
+    QByteArray binaryData = file.readAll();
+    return readFromBinary(reinterpret_cast<const unsigned char*>(binaryData.constData()), binaryData.size());
+}
+
 bool Octree::readFromURL(const QString& urlString) {
     auto request = std::unique_ptr<ResourceRequest>(ResourceManager::createResourceRequest(this, urlString));
 
@@ -1865,6 +1891,7 @@ bool Octree::readJSONFromStream(unsigned long streamLength, QDataStream& inputSt
     QVariant asVariant = asDocument.toVariant();
     QVariantMap asMap = asVariant.toMap();
     bool success = readFromMap(asMap);
+    _persistVersion = asMap["PersistVersion"].toULongLong();
     delete[] rawData;
     return success;
 }
@@ -1882,6 +1909,8 @@ bool Octree::writeToFile(const char* fileName, OctreeElementPointer element, QSt
         success = writeToJSONFile(cFileName, element);
     } else if (persistAsFileType == "json.gz") {
         success = writeToJSONFile(cFileName, element, true);
+    } else if (persistAsFileType == "bin") {
+        success = writeToBinaryFile(cFileName, element);
     } else {
         qCDebug(octree) << "unable to write octree to file of type" << persistAsFileType;
     }
@@ -1889,10 +1918,28 @@ bool Octree::writeToFile(const char* fileName, OctreeElementPointer element, QSt
 }
 
 bool Octree::writeToJSONFile(const char* fileName, OctreeElementPointer element, bool doGzip) {
-    QVariantMap entityDescription;
-
     qCDebug(octree, "Saving JSON SVO to file %s...", fileName);
 
+    QByteArray jsonDataForFile;
+    if (!writeToJSON(jsonDataForFile, element, doGzip)) {
+        return false;
+    }
+
+    // the file is written next to the old one, and only replaces it once it is complete
+    QSaveFile persistFile(fileName);
+    bool success = false;
+    if (persistFile.open(QIODevice::WriteOnly)) {
+        success = persistFile.write(jsonDataForFile) != -1 && persistFile.commit();
+    } else {
+        qCritical("Could not write to JSON description of entities.");
+    }
+
+    return success;
+}
+
+bool Octree::writeToJSON(QByteArray& jsonData, OctreeElementPointer element, bool doGzip) {
+    QVariantMap entityDescription;
+
     OctreeElementPointer top;
     if (element) {
         top = element;
@@ -1904,6 +1951,7 @@ bool Octree::writeToJSONFile(const char* fileName, OctreeElementPointer element,
     PacketType expectedType = expectedDataPacketType();
     PacketVersion expectedVersion = versionForPacketType(expectedType);
     entityDescription["Version"] = (int) expectedVersion;
+    entityDescription["PersistVersion"] = (qulonglong)_persistVersion;
 
     // store the entity data
     bool entityDescriptionSuccess = writeToMap(entityDescription, top, true, true);
@@ -1913,24 +1961,36 @@ bool Octree::writeToJSONFile(const char* fileName, OctreeElementPointer element,
     }
 
     // convert the QVariantMap to JSON
-    QByteArray jsonData = QJsonDocument::fromVariant(entityDescription).toJson();
-    QByteArray jsonDataForFile;
+    jsonData = QJsonDocument::fromVariant(entityDescription).toJson();
 
     if (doGzip) {
-        if (!gzip(jsonData, jsonDataForFile, -1)) {
+        QByteArray gzippedJsonData;
+        if (!gzip(jsonData, gzippedJsonData, -1)) {
             qCritical("unable to gzip data while saving to json.");
             return false;
         }
-    } else {
-        jsonDataForFile = jsonData;
+        jsonData = gzippedJsonData;
     }
 
-    QFile persistFile(fileName);
+    return true;
+}
+
+bool Octree::writeToBinaryFile(const char* fileName, OctreeElementPointer element) {
+    qCDebug(octree, "Saving binary snapshot to file %s...", fileName);
+
+    QByteArray binaryData;
+    if (!writeToBinary(binaryData, element ? element : _rootElement)) {
+        qCritical("Failed to write a binary snapshot of the octree.");
+        return false;
+    }
+
+    // the file is written next to the old one, and only replaces it once it is complete
+    QSaveFile persistFile(fileName);
     bool success = false;
     if (persistFile.open(QIODevice::WriteOnly)) {
-        success = persistFile.write(jsonDataForFile) != -1;
+        success = persistFile.write(binaryData) != -1 && persistFile.commit();
     } else {
-        qCritical("Could not write to JSON description of entities.");
+        qCritical("Could not write binary snapshot of the octree.");
     }
 
     return success;
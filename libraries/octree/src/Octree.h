@@ -12,6 +12,7 @@
 #ifndef hifi_Octree_h
 #define hifi_Octree_h
 
+#include <atomic>
 #include <memory>
 #include <set>
 
@@ -308,7 +309,9 @@ public:
     // Octree exporters
     bool writeToFile(const char* filename, OctreeElementPointer element = NULL, QString persistAsFileType = "svo");
     bool writeToJSONFile(const char* filename, OctreeElementPointer element = NULL, bool doGzip = false);
+    bool writeToJSON(QByteArray& jsonData, OctreeElementPointer element = NULL, bool doGzip = false);
     bool writeToSVOFile(const char* filename, OctreeElementPointer element = NULL);
+    bool writeToBinaryFile(const char* filename, OctreeElementPointer element = NULL);
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
 
@@ -320,6 +323,31 @@ public:
     bool readJSONFromStream(unsigned long streamLength, QDataStream& inputStream);
     bool readJSONFromGzippedFile(QString qFileName);
     virtual bool readFromMap(QVariantMap& entityDescription) = 0;
+    bool readFromBinaryFile(QString qFileName);
+
+    // Octree binary snapshots: a persist format for trees that can store their elements without converting to JSON
+    virtual bool writeToBinary(QByteArray& binaryData, OctreeElementPointer element) { return false; }
+    virtual bool readFromBinary(const unsigned char* binaryData, qint64 size) { return false; }
+
+    // Octree journaling: trees that can record which of their elements change are persisted incrementally,
+    // as a snapshot plus a journal of the changes since that snapshot
+    virtual bool canJournal() const { return false; }
+    virtual void setWantJournal(bool wantJournal) { }
+    // moves a record of each change since the last call into records (call with the tree unlocked, it is locked only
+    // long enough to copy the changed elements)
+    virtual void takeJournalRecords(QVariantList& records) { }
+    // applies records taken from this kind of tree on top of its current contents (call with the tree write locked)
+    virtual bool replayJournalRecords(const QVariantList& records) { return false; }
+    // the journal version of the changes a persist file holds - it is written with the JSON and binary persist formats,
+    // and set again when one of them is read, so that journal records already in the file are not replayed
+    quint64 getPersistVersion() const { return _persistVersion; }
+    void setPersistVersion(quint64 persistVersion) { _persistVersion = persistVersion; }
+
+    // Octree change log: trees that number their changes let a sender start a scene from just the elements that changed
+    virtual quint64 getChangeVersion() const { return 0; }
+    // adds the elements to encode to send the changes after version (call with the tree locked), returns false if the
+    // changes are no longer known, or there are so many that the scene should start from the root
+    virtual bool getElementsChangedSince(quint64 version, QVector<OctreeElementPointer>& elements) { return false; }
 
     unsigned long getOctreeElementsCount();
 
@@ -384,6 +412,7 @@ protected:
     OctreeElementPointer _rootElement = nullptr;
 
     bool _isDirty;
+    std::atomic<quint64> _persistVersion { 0 };
     bool _shouldReaverage;
     bool _stopImport;
 
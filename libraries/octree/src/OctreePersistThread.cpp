@@ -9,6 +9,7 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -24,6 +25,7 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QJsonDocument>
+#include <QSaveFile>
 
 #include <NumericalConstants.h>
 #include <PerfStat.h>
@@ -33,6 +35,10 @@
 #include "OctreePersistThread.h"
 
 const int OctreePersistThread::DEFAULT_PERSIST_INTERVAL = 1000 * 30; // every 30 seconds
+const int OctreePersistThread::DEFAULT_JOURNAL_COMPACTION_THRESHOLD = 10000;
+
+static const QString JOURNAL_SNAPSHOT_VERSION = "snapshotVersion";
+static const QString JOURNAL_RECORD_VERSION = "journalVersion";
 
 OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& filename, const QString& backupDirectory, int persistInterval,
                                          bool wantBackup, const QJsonObject& settings, bool debugTimestampNow,
@@ -47,7 +53,8 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     _wantBackup(wantBackup),
     _debugTimestampNow(debugTimestampNow),
     _lastTimeDebug(0),
-    _persistAsFileType(persistAsFileType)
+    _persistAsFileType(persistAsFileType),
+    _journalCompactionThreshold(DEFAULT_JOURNAL_COMPACTION_THRESHOLD)
 {
     parseSettings(settings);
 
@@ -56,16 +63,32 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     _filename = sansExt + "." + _persistAsFileType;
 }
 
+OctreePersistThread::~OctreePersistThread() {
+    waitForCompaction();
+}
+
 QString OctreePersistThread::getPersistFileMimeType() const {
     if (_persistAsFileType == "json") {
         return "application/json";
-    } if (_persistAsFileType == "json.gz") {
+    } if (_persistAsFileType == "json.gz" || _persistAsFileType == "bin") {
         return "application/zip";
     }
     return "";
 }
 
 void OctreePersistThread::parseSettings(const QJsonObject& settings) {
+    if (settings["persistJournal"].isBool()) {
+        _wantJournal = settings["persistJournal"].toBool();
+    }
+    QJsonValue compactionThresholdValue = settings["journalCompactionThreshold"];
+    if (compactionThresholdValue.isString()) {
+        _journalCompactionThreshold = compactionThresholdValue.toString().toInt();
+    } else if (compactionThresholdValue.isDouble()) {
+        _journalCompactionThreshold = compactionThresholdValue.toInt();
+    }
+    qCDebug(octree) << "JOURNAL:" << (_wantJournal ? "ENABLED" : "DISABLED")
+        << "compaction threshold:" << _journalCompactionThreshold << "records";
+
     if (settings["backups"].isArray()) {
         const QJsonArray& backupRules = settings["backups"].toArray();
         qCDebug(octree) << "BACKUP RULES:";
@@ -143,8 +166,9 @@ bool OctreePersistThread::process() {
         _tree->withWriteLock([&] {
             PerformanceWarning warn(true, "Loading Octree File", true);
 
-            // First check to make sure "lock" file doesn't exist. If it does exist, then
-            // our last save crashed during the save, and we want to load our most recent backup.
+            // First check to make sure "lock" file doesn't exist. If it does exist, then our last save crashed
+            // during the save, and we want to load our most recent backup. Saves no longer leave one behind, as the
+            // persist file is only replaced once it is completely written, but a server from before may have.
             QString lockFileName = _filename + ".lock";
             std::ifstream lockFile(qPrintable(lockFileName), std::ios::in | std::ios::binary | std::ios::ate);
             if (lockFile.is_open()) {
@@ -162,6 +186,7 @@ bool OctreePersistThread::process() {
             }
 
             persistantFileRead = _tree->readFromFile(qPrintable(_filename.toLocal8Bit()));
+            replayJournal();
             _tree->pruneTree();
         });
 
@@ -169,6 +194,13 @@ bool OctreePersistThread::process() {
         _loadTimeUSecs = loadDone - loadStarted;
 
         _tree->clearDirtyBit(); // the tree is clean since we just loaded it
+
+        _wantJournal = _wantJournal && _tree->canJournal();
+        if (_wantJournal) {
+            _tree->setWantJournal(true);
+        } else if (_numJournalRecords > 0) {
+            _tree->setDirtyBit(); // save the changes journaled by an earlier run in the persist file
+        }
         qCDebug(octree, "DONE loading Octrees from file... fileRead=%s", debug::valueOf(persistantFileRead));
 
         unsigned long nodeCount = OctreeElement::getNodeCount();
@@ -237,6 +269,7 @@ bool OctreePersistThread::process() {
 
 void OctreePersistThread::aboutToFinish() {
     qCDebug(octree) << "Persist thread about to finish...";
+    waitForCompaction();
     persist();
     qCDebug(octree) << "Persist thread done with about to finish...";
     _stopThread = true;
@@ -244,6 +277,16 @@ void OctreePersistThread::aboutToFinish() {
 
 QByteArray OctreePersistThread::getPersistFileContents() const {
     QByteArray fileContents;
+
+    if (_numJournalRecords > 0 || _persistAsFileType == "bin") {
+        // the persist file is missing the journaled changes, or is a binary snapshot that a download of models.json.gz
+        // can't use, so give the current contents of the tree as JSON instead
+        _tree->withReadLock([&] {
+            _tree->writeToJSON(fileContents, NULL, _persistAsFileType != "json");
+        });
+        return fileContents;
+    }
+
     QFile file(_filename);
     if (file.open(QIODevice::ReadOnly)) {
         fileContents = file.readAll();
@@ -252,8 +295,24 @@ QByteArray OctreePersistThread::getPersistFileContents() const {
 }
 
 void OctreePersistThread::persist() {
-    if (_tree->isDirty() && _initialLoadComplete) {
+    if (!_initialLoadComplete) {
+        return;
+    }
 
+    if (_wantJournal) {
+        // only write what changed, the persist file is rewritten in the background once the journal grows large
+        // enough, or a backup is due
+        if (_tree->isDirty()) {
+            appendToJournal();
+        }
+        if (!_isCompacting && (_numJournalRecords >= _journalCompactionThreshold ||
+                               (_numJournalRecords > 0 && isBackupDue()))) {
+            startCompaction();
+        }
+        return;
+    }
+
+    if (_tree->isDirty()) {
         _tree->withWriteLock([&] {
             qCDebug(octree) << "pruning Octree before saving...";
             _tree->pruneTree();
@@ -264,26 +323,205 @@ void OctreePersistThread::persist() {
         backup(); // handle backup if requested        
         qCDebug(octree) << "persist operation DONE with backup...";
 
+        // the file is only replaced once it is completely written, so a crash while saving leaves the old one
+        _tree->setPersistVersion(_journalVersion);
+        bool persisted = _tree->writeToFile(qPrintable(_filename), NULL, _persistAsFileType);
+        time(&_lastPersistTime);
+        _tree->clearDirtyBit(); // tree is clean after saving
+        qCDebug(octree) << "DONE saving Octree to file...";
 
-        // create our "lock" file to indicate we're saving.
-        QString lockFileName = _filename + ".lock";
-        std::ofstream lockFile(qPrintable(lockFileName), std::ios::out|std::ios::binary);
-        if(lockFile.is_open()) {
-            qCDebug(octree) << "saving Octree lock file created at:" << lockFileName;
+        if (persisted) {
+            // the journal of an earlier run is in the persist file
+            truncateJournal();
+        }
+    }
+}
+
+void OctreePersistThread::startCompaction() {
+    waitForCompaction();
+    _isCompacting = true;
+    _compactionThread = std::thread([this] {
+        compactJournal();
+        _isCompacting = false;
+    });
+}
 
-            _tree->writeToFile(qPrintable(_filename), NULL, _persistAsFileType);
-            time(&_lastPersistTime);
-            _tree->clearDirtyBit(); // tree is clean after saving
-            qCDebug(octree) << "DONE saving Octree to file...";
+void OctreePersistThread::waitForCompaction() {
+    if (_compactionThread.joinable()) {
+        _compactionThread.join();
+    }
+}
+
+void OctreePersistThread::compactJournal() {
+    // every record appended so far is older than the tree that is about to be written, later records are replayed
+    // on top of the persist file (at worst repeating a change it already holds)
+    quint64 persistVersion;
+    {
+        std::lock_guard<std::mutex> lock(_journalMutex);
+        persistVersion = _journalVersion;
+    }
 
-            lockFile.close();
-            qCDebug(octree) << "saving Octree lock file closed:" << lockFileName;
-            remove(qPrintable(lockFileName));
-            qCDebug(octree) << "saving Octree lock file removed:" << lockFileName;
+    _tree->withWriteLock([&] {
+        qCDebug(octree) << "pruning Octree before saving...";
+        _tree->pruneTree();
+        qCDebug(octree) << "DONE pruning Octree before saving...";
+    });
+
+    qCDebug(octree) << "persist operation calling backup...";
+    backup(); // handle backup if requested
+    qCDebug(octree) << "persist operation DONE with backup...";
+
+    _tree->setPersistVersion(persistVersion);
+    bool persisted = _tree->writeToFile(qPrintable(_filename), NULL, _persistAsFileType);
+    time(&_lastPersistTime);
+    if (!persisted) {
+        qCritical() << "Could not save Octree to" << _filename << "- keeping the whole journal";
+        return;
+    }
+    qCDebug(octree) << "DONE saving Octree to file...";
+
+    // drop the records the persist file now holds, keeping those appended while it was written
+    std::lock_guard<std::mutex> lock(_journalMutex);
+    _snapshotVersion = persistVersion;
+
+    QByteArray journalData = journalHeader(persistVersion);
+    int numJournalRecords = 0;
+    QFile journalFile(getJournalFilename());
+    if (journalFile.open(QIODevice::ReadOnly)) {
+        while (!journalFile.atEnd()) {
+            QByteArray line = journalFile.readLine().trimmed();
+            QVariantMap record = QJsonDocument::fromJson(line).toVariant().toMap();
+            if (record.contains(JOURNAL_RECORD_VERSION) && record[JOURNAL_RECORD_VERSION].toULongLong() > persistVersion) {
+                journalData += line;
+                journalData += '\n';
+                ++numJournalRecords;
+            }
         }
+        journalFile.close();
+    }
+
+    QSaveFile compactedFile(getJournalFilename());
+    if (compactedFile.open(QIODevice::WriteOnly) && compactedFile.write(journalData) != -1 && compactedFile.commit()) {
+        _numJournalRecords = numJournalRecords;
+        qCDebug(octree) << "Compacted journal," << numJournalRecords << "changes since the last save";
+    } else {
+        // the records are skipped when replayed, as the persist file holds them
+        qCritical() << "Could not compact journal" << compactedFile.fileName();
     }
 }
 
+QByteArray OctreePersistThread::journalHeader(quint64 snapshotVersion) const {
+    QVariantMap header;
+    header[JOURNAL_SNAPSHOT_VERSION] = snapshotVersion;
+    return QJsonDocument::fromVariant(header).toJson(QJsonDocument::Compact) + '\n';
+}
+
+void OctreePersistThread::replayJournal() {
+    // records up to the persist version of the file just read are already in the tree
+    quint64 persistVersion = _tree->getPersistVersion();
+    _snapshotVersion = persistVersion;
+    _journalVersion = persistVersion;
+
+    QFile journalFile(getJournalFilename());
+    if (!journalFile.open(QIODevice::ReadOnly)) {
+        _numJournalRecords = 0;
+        return;
+    }
+
+    QVariantList records;
+    int numSkippedRecords = 0;
+    while (!journalFile.atEnd()) {
+        QByteArray line = journalFile.readLine().trimmed();
+        if (line.isEmpty()) {
+            continue;
+        }
+
+        QJsonParseError error;
+        QJsonDocument document = QJsonDocument::fromJson(line, &error);
+        if (error.error != QJsonParseError::NoError) {
+            // the last record is cut short if we stopped while appending it
+            qCDebug(octree) << "Skipping unreadable journal record:" << error.errorString();
+            continue;
+        }
+
+        QVariantMap record = document.toVariant().toMap();
+        if (record.contains(JOURNAL_SNAPSHOT_VERSION)) {
+            quint64 snapshotVersion = record[JOURNAL_SNAPSHOT_VERSION].toULongLong();
+            if (snapshotVersion > persistVersion) {
+                qCWarning(octree) << "Journal" << journalFile.fileName() << "follows a newer persist file (version"
+                    << snapshotVersion << ") than the one loaded (version" << persistVersion
+                    << ") - the changes between them are lost";
+            }
+            continue;
+        }
+
+        if (record.contains(JOURNAL_RECORD_VERSION)) {
+            quint64 recordVersion = record[JOURNAL_RECORD_VERSION].toULongLong();
+            _journalVersion = std::max(_journalVersion, recordVersion);
+            if (recordVersion <= persistVersion) {
+                ++numSkippedRecords;
+                continue;
+            }
+        }
+        records << record;
+    }
+
+    if (numSkippedRecords > 0) {
+        qCDebug(octree) << "Skipped" << numSkippedRecords << "journal records already in" << _filename;
+    }
+    if (!records.isEmpty()) {
+        qCDebug(octree) << "Replaying" << records.size() << "journal records from" << journalFile.fileName() << "...";
+        bool replayed = _tree->replayJournalRecords(records);
+        qCDebug(octree, "DONE replaying journal... replayed=%s", debug::valueOf(replayed));
+    }
+    _numJournalRecords = records.size();
+}
+
+void OctreePersistThread::appendToJournal() {
+    // an edit after this dirties the tree again, and is in the records taken now or in the next ones
+    _tree->clearDirtyBit();
+
+    QVariantList records;
+    _tree->takeJournalRecords(records);
+    if (records.isEmpty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_journalMutex);
+
+    QFile journalFile(getJournalFilename());
+    QByteArray journalData;
+    if (!journalFile.exists()) {
+        journalData += journalHeader(_snapshotVersion);
+    }
+    foreach (const QVariant& recordVariant, records) {
+        QVariantMap record = recordVariant.toMap();
+        record[JOURNAL_RECORD_VERSION] = ++_journalVersion;
+        journalData += QJsonDocument::fromVariant(record).toJson(QJsonDocument::Compact);
+        journalData += '\n';
+    }
+
+    if (journalFile.open(QIODevice::WriteOnly | QIODevice::Append) && journalFile.write(journalData) != -1) {
+        journalFile.flush();
+        _numJournalRecords += records.size();
+        qCDebug(octree) << "Journaled" << records.size() << "changes," << _numJournalRecords << "since the last save";
+    } else {
+        // the tree still holds the changes, and the persist file written next is versioned past them
+        qCritical() << "Could not append to journal" << journalFile.fileName() << "- saving the whole Octree instead";
+        _numJournalRecords = _journalCompactionThreshold;
+    }
+}
+
+void OctreePersistThread::truncateJournal() {
+    std::lock_guard<std::mutex> lock(_journalMutex);
+    QFile journalFile(getJournalFilename());
+    if (journalFile.exists() && !journalFile.remove()) {
+        qCritical() << "Could not remove journal" << journalFile.fileName();
+    }
+    _snapshotVersion = _journalVersion;
+    _numJournalRecords = 0;
+}
+
 void OctreePersistThread::restoreFromMostRecentBackup() {
     qCDebug(octree) << "Restoring from most recent backup...";
     
@@ -416,6 +654,21 @@ void OctreePersistThread::rollOldBackupVersions(const BackupRule& rule) {
 }
 
 
+bool OctreePersistThread::isBackupDue() const {
+    if (!_wantBackup) {
+        return false;
+    }
+
+    quint64 now = usecTimestampNow();
+    foreach (const BackupRule& rule, _backupRules) {
+        quint64 SECS_TO_USECS = 1000 * 1000;
+        if (now - rule.lastBackup > rule.interval * SECS_TO_USECS) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void OctreePersistThread::backup() {
     qCDebug(octree) << "backup operation wantBackup:" << _wantBackup;
     if (_wantBackup) {
@@ -14,8 +14,13 @@
 #ifndef hifi_OctreePersistThread_h
 #define hifi_OctreePersistThread_h
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 #include <QString>
 #include <GenericThread.h>
+#include <PathUtils.h>
 #include "Octree.h"
 
 /// Generalized threaded processor for handling received inbound packets.
@@ -32,10 +37,12 @@ public:
     };
 
     static const int DEFAULT_PERSIST_INTERVAL;
+    static const int DEFAULT_JOURNAL_COMPACTION_THRESHOLD;
 
     OctreePersistThread(OctreePointer tree, const QString& filename, const QString& backupDirectory,
                         int persistInterval = DEFAULT_PERSIST_INTERVAL, bool wantBackup = false,
                         const QJsonObject& settings = QJsonObject(), bool debugTimestampNow = false, QString persistAsFileType="svo");
+    ~OctreePersistThread();
 
     bool isInitialLoadComplete() const { return _initialLoadComplete; }
     quint64 getLoadElapsedTime() const { return _loadTimeUSecs; }
@@ -43,6 +50,7 @@ public:
     void aboutToFinish(); /// call this to inform the persist thread that the owner is about to finish to support final persist
 
     QString getPersistFilename() const { return _filename; }
+    // the persist file is always downloaded as JSON, gzipped unless it is persisted as plain JSON
     QString getPersistFileMimeType() const;
     QByteArray getPersistFileContents() const;
 
@@ -55,12 +63,27 @@ protected:
 
     void persist();
     void backup();
+    bool isBackupDue() const;
     void rollOldBackupVersions(const BackupRule& rule);
     void restoreFromMostRecentBackup();
     bool getMostRecentBackup(const QString& format, QString& mostRecentBackupFileName, QDateTime& mostRecentBackupTime);
     quint64 getMostRecentBackupTimeInUsecs(const QString& format);
     void parseSettings(const QJsonObject& settings);
 
+    // the journal holds the changes since the persist file was last written, one JSON record per line after a header
+    // with the persist version of that file - every record has a higher journal version than the file it follows. It is
+    // named after the persist file without its extension, so it is still found when the persist file type changes.
+    QString getJournalFilename() const { return fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS) + ".journal"; }
+    void replayJournal();
+    void appendToJournal();
+    void truncateJournal();
+
+    // rewrites the persist file on a thread of its own, then drops the journal records it holds
+    void startCompaction();
+    void compactJournal();
+    void waitForCompaction();
+    QByteArray journalHeader(quint64 snapshotVersion) const;
+
 private:
     OctreePointer _tree;
     QString _filename;
@@ -79,6 +102,16 @@ private:
     quint64 _lastTimeDebug;
 
     QString _persistAsFileType;
+
+    bool _wantJournal { true };
+    int _journalCompactionThreshold; // journal records written before the persist file is rewritten
+    std::atomic<int> _numJournalRecords { 0 }; // also read by getPersistFileContents
+    quint64 _journalVersion { 0 }; // of the last record appended to the journal
+    quint64 _snapshotVersion { 0 }; // of the persist file on disk, written in the journal header
+    std::mutex _journalMutex; // guards the journal file and _journalVersion against the compaction thread
+
+    std::thread _compactionThread;
+    std::atomic<bool> _isCompacting { false };
 };
 
 #endif // hifi_OctreePersistThread_h
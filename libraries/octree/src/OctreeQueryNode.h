@@ -88,6 +88,15 @@ public:
 
     void sceneStart(quint64 sceneSendStartTime) { _sceneSendStartTime = sceneSendStartTime; }
 
+    // the tree's change version when the current scene started, which the client has once the scene is sent
+    void setSceneChangeVersion(quint64 version, bool isChangedElementsScene) {
+        _sceneChangeVersion = version;
+        _isChangedElementsScene = isChangedElementsScene;
+    }
+    void sceneChangesSent() { _sentChangeVersion = _sceneChangeVersion; }
+    quint64 getSentChangeVersion() const { return _sentChangeVersion; }
+    bool isChangedElementsScene() const { return _isChangedElementsScene; }
+
     void nodeKilled();
     bool isShuttingDown() const { return _isShuttingDown; }
 
@@ -137,6 +146,10 @@ private:
 
     quint64 _lastRootTimestamp { 0 };
 
+    quint64 _sceneChangeVersion { 0 };
+    quint64 _sentChangeVersion { 0 }; // 0 until a scene is sent
+    bool _isChangedElementsScene { false };
+
     PacketType _myPacketType { PacketType::Unknown };
     bool _isShuttingDown { false };
 
@@ -6,12 +6,15 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 #include "ClipCache.h"
+
+#include <QtCore/QBuffer>
+
+#include "impl/ChunkedClip.h"
 #include "impl/PointerClip.h"
 
 using namespace recording;
 NetworkClipLoader::NetworkClipLoader(const QUrl& url) :
-    Resource(url),
-    _clip(std::make_shared<NetworkClip>(url)) {}
+    Resource(url) {}
 
 void NetworkClip::init(const QByteArray& clipData) {
     _clipData = clipData;
@@ -19,7 +22,15 @@ void NetworkClip::init(const QByteArray& clipData) {
 }
 
 void NetworkClipLoader::downloadFinished(const QByteArray& data) {
-    _clip->init(data);
+    auto buffer = std::make_shared<QBuffer>();
+    buffer->setData(data);
+    if (buffer->open(QIODevice::ReadOnly) && ChunkedClip::isChunkedClip(*buffer)) {
+        _clip = std::make_shared<ChunkedClip>(buffer, getURL().toString());
+    } else {
+        auto clip = std::make_shared<NetworkClip>(getURL());
+        clip->init(data);
+        _clip = clip;
+    }
     finishedLoading(true);
 }
 
@@ -37,7 +37,8 @@ public:
     bool completed() { return _failedToLoad || isLoaded(); }
 
 private:
-    const NetworkClip::Pointer _clip;
+    // a NetworkClip for clips of single frames, or a ChunkedClip of the downloaded data
+    ClipPointer _clip;
 };
 
 using NetworkClipLoaderPointer = QSharedPointer<NetworkClipLoader>;
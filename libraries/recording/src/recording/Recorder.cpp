@@ -8,11 +8,15 @@
 
 #include "Recorder.h"
 
+#include <QtCore/QTemporaryFile>
+
 #include <NumericalConstants.h>
 #include <SharedUtil.h>
 
 #include "impl/BufferClip.h"
+#include "impl/ChunkedClip.h"
 #include "Frame.h"
+#include "Logging.h"
 
 using namespace recording;
 
@@ -21,6 +25,9 @@ Recorder::Recorder(QObject* parent)
 
 float Recorder::position() {
     Locker lock(_mutex);
+    if (_writer) {
+        return Frame::frameTimeToSeconds(_writer->duration());
+    }
     if (_clip) {
         return _clip->duration();
     }
@@ -31,8 +38,17 @@ void Recorder::start() {
     Locker lock(_mutex);
     if (!_recording) {
         _recording = true;
+        _writeFailed = false;
         // FIXME for now just record a new clip every time
-        _clip = std::make_shared<BufferClip>();
+        _clip.reset();
+        _file = std::make_shared<QTemporaryFile>();
+        if (_file->open()) {
+            _writer = std::make_shared<ChunkedClipWriter>(*_file);
+        } else {
+            qCWarning(recordingLog) << "Unable to open a temporary file, recording in memory";
+            _file.reset();
+            _clip = std::make_shared<BufferClip>();
+        }
         _startEpoch = usecTimestampNow();
         _timer.start();
         emit recordingStateChanged();
@@ -44,10 +60,27 @@ void Recorder::stop() {
     if (_recording) {
         _recording = false;
         _elapsed = _timer.elapsed();
+        if (_writer) {
+            if (!_writer->close()) {
+                qCWarning(recordingLog) << "Unable to write the recording to" << _file->fileName();
+            }
+            // without the index, the clip is read back from the chunks that were written
+            _clip = std::make_shared<ChunkedClip>(_file, _file->fileName());
+            _writer.reset();
+            _file.reset();
+        }
         emit recordingStateChanged();
     }
 }
 
+void Recorder::stopOnWriteFailure() {
+    Locker lock(_mutex);
+    // unless the recording was restarted in the meantime
+    if (_writeFailed) {
+        stop();
+    }
+}
+
 bool Recorder::isRecording() {
     Locker lock(_mutex);
     return _recording;
@@ -60,7 +93,7 @@ void Recorder::clear() {
 
 void Recorder::recordFrame(FrameType type, QByteArray frameData) {
     Locker lock(_mutex);
-    if (!_recording || !_clip) {
+    if (!_recording || _writeFailed || (!_writer && !_clip)) {
         return;
     }
 
@@ -68,7 +101,17 @@ void Recorder::recordFrame(FrameType type, QByteArray frameData) {
     frame->type = type;
     frame->data = frameData;
     frame->timeOffset = (usecTimestampNow() - _startEpoch) / USECS_PER_MSEC;
-    _clip->addFrame(frame);
+    if (_writer) {
+        if (!_writer->addFrame(*frame)) {
+            // the frames that follow would be lost as well. Audio frames are recorded on the audio thread,
+            // so the recording is stopped on the recorder's thread, where its state changes are handled
+            qCWarning(recordingLog) << "Unable to write the recording to" << _file->fileName() << ", stopping it";
+            _writeFailed = true;
+            QMetaObject::invokeMethod(this, "stopOnWriteFailure", Qt::QueuedConnection);
+        }
+    } else {
+        _clip->addFrame(frame);
+    }
 }
 
 ClipPointer Recorder::getClip() {
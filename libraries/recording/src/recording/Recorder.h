@@ -19,8 +19,12 @@
 
 #include "Forward.h"
 
+class QTemporaryFile;
+
 namespace recording {
 
+class ChunkedClipWriter;
+
 // An interface for interacting with clips, creating them by recording or
 // playing them back.  Also serialization to and from files / network sources
 class Recorder : public QObject, public Dependency {
@@ -50,15 +54,21 @@ signals:
     void recordingStateChanged();
 
 private:
+    Q_INVOKABLE void stopOnWriteFailure();
+
     using Mutex = std::recursive_mutex;
     using Locker = std::unique_lock<Mutex>;
 
     Mutex _mutex;
     QElapsedTimer _timer;
     ClipPointer _clip;
+    // frames are written a chunk at a time to a temporary file while recording
+    std::shared_ptr<QTemporaryFile> _file;
+    std::shared_ptr<ChunkedClipWriter> _writer;
     quint64 _elapsed { 0 };
     quint64 _startEpoch { 0 };
     bool _recording { false };
+    bool _writeFailed { false };
 };
 
 }
@@ -0,0 +1,494 @@
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ChunkedClip.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+
+#include <QtCore/QDebug>
+#include <QtCore/QIODevice>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include "../Frame.h"
+#include "../Logging.h"
+#include "PointerClip.h"
+
+using namespace recording;
+
+// A chunked clip is laid out as
+//   the header frame, as in clips of single frames
+//   chunks, each a ChunkHeader followed by its frames compressed together, every frame as
+//     FrameType type; Frame::Time timeOffset; uint32_t size; uint8_t data[size];
+//   the index
+//     uint32_t numChunks; IndexEntry chunks[numChunks];
+//     uint32_t numFrameTypes; FrameTypeEntry frameTypes[numFrameTypes];
+//     uint32_t frameTypeMapSize; uint8_t frameTypeMap[frameTypeMapSize];  json of the frame type names
+//   an IndexTrailer
+// A clip whose recording never finished has no index, and its chunks are found from the start.
+// The offsets in the index and the trailer are positions in the device, which the clip starts.
+
+static const char CHUNK_MAGIC[4] = { 'H', 'F', 'C', 'K' };
+static const char INDEX_MAGIC[4] = { 'H', 'F', 'C', 'I' };
+static const uint32_t INDEX_VERSION = 1;
+
+struct IndexTrailer {
+    quint64 indexOffset;
+    char magic[4];
+    uint32_t version;
+};
+
+static_assert(sizeof(ChunkedClip::ChunkHeader) == 20, "ChunkHeader must not be padded");
+static_assert(sizeof(ChunkedClip::IndexEntry) == 16, "IndexEntry must not be padded");
+static_assert(sizeof(ChunkedClip::FrameTypeEntry) == 12, "FrameTypeEntry must not be padded");
+static_assert(sizeof(IndexTrailer) == 16, "IndexTrailer must not be padded");
+
+static const int CHUNK_FRAME_HEADER_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(uint32_t);
+
+const size_t ChunkedClipWriter::MAX_CHUNK_SIZE = 256 * 1024;
+const Frame::Time ChunkedClipWriter::MAX_CHUNK_DURATION = 1000; // milliseconds
+
+static bool readData(QIODevice& device, void* data, qint64 size) {
+    return device.read(reinterpret_cast<char*>(data), size) == size;
+}
+
+static bool writeData(QIODevice& device, const void* data, qint64 size) {
+    return device.write(reinterpret_cast<const char*>(data), size) == size;
+}
+
+// Read the header frame at the start of a clip, and return the offset of what follows it, or -1
+static qint64 readHeaderFrame(QIODevice& device, QJsonDocument& header) {
+    FrameType type;
+    Frame::Time timeOffset;
+    FrameSize size;
+    if (!device.seek(0) ||
+        !readData(device, &type, sizeof(type)) ||
+        !readData(device, &timeOffset, sizeof(timeOffset)) ||
+        !readData(device, &size, sizeof(size)) ||
+        type != Frame::TYPE_HEADER) {
+        return -1;
+    }
+    QByteArray data = device.read(size);
+    if (data.size() != size) {
+        return -1;
+    }
+    header = QJsonDocument::fromBinaryData(data);
+    return device.pos();
+}
+
+// The frames of a chunk of a known type, with the types registered by the application
+static void parseChunk(const QByteArray& chunkData, const FrameTranslationMap& translationMap, std::vector<Frame>& frames) {
+    QByteArray data = qUncompress(chunkData);
+    const char* current = data.constData();
+    const char* end = current + data.size();
+    while (end - current >= CHUNK_FRAME_HEADER_SIZE) {
+        FrameType type;
+        Frame::Time timeOffset;
+        uint32_t size;
+        memcpy(&type, current, sizeof(type));
+        current += sizeof(type);
+        memcpy(&timeOffset, current, sizeof(timeOffset));
+        current += sizeof(timeOffset);
+        memcpy(&size, current, sizeof(size));
+        current += sizeof(size);
+        if ((size_t)(end - current) < size) {
+            qCWarning(recordingLog) << "Truncated frame in clip chunk";
+            break;
+        }
+
+        auto translatedType = translationMap.find(type);
+        if (translatedType != translationMap.end()) {
+            frames.emplace_back();
+            Frame& frame = frames.back();
+            frame.type = translatedType.value();
+            frame.timeOffset = timeOffset;
+            frame.data = QByteArray(current, size);
+        }
+        current += size;
+    }
+}
+
+// What duplicates of a clip share
+struct ChunkedClip::Source {
+    bool readIndex();
+    bool scanChunks();
+    void readChunk(size_t chunkIndex, std::vector<Frame>& frames);
+
+    std::mutex mutex; // guards the device position
+    std::shared_ptr<QIODevice> device;
+    QString name;
+
+    std::vector<IndexEntry> index;
+    FrameTranslationMap translationMap;
+    size_t frameCount { 0 };
+    Frame::Time duration { 0 };
+};
+
+bool ChunkedClip::Source::readIndex() {
+    qint64 size = device->size();
+    IndexTrailer trailer;
+    if (size < (qint64)sizeof(trailer) ||
+        !device->seek(size - sizeof(trailer)) ||
+        !readData(*device, &trailer, sizeof(trailer)) ||
+        memcmp(trailer.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0) {
+        return false;
+    }
+    if (trailer.version > INDEX_VERSION) {
+        qCWarning(recordingLog) << "Unsupported clip index version" << trailer.version;
+        return false;
+    }
+
+    uint32_t numChunks;
+    if (!device->seek(trailer.indexOffset) ||
+        !readData(*device, &numChunks, sizeof(numChunks)) ||
+        numChunks > size / sizeof(ChunkHeader)) {
+        return false;
+    }
+    index.resize(numChunks);
+    if (!readData(*device, index.data(), numChunks * sizeof(IndexEntry))) {
+        return false;
+    }
+
+    uint32_t numFrameTypes;
+    if (!readData(*device, &numFrameTypes, sizeof(numFrameTypes)) || numFrameTypes > Frame::TYPE_INVALID) {
+        return false;
+    }
+    std::vector<FrameTypeEntry> frameTypes(numFrameTypes);
+    uint32_t frameTypeMapSize;
+    if (!readData(*device, frameTypes.data(), numFrameTypes * sizeof(FrameTypeEntry)) ||
+        !readData(*device, &frameTypeMapSize, sizeof(frameTypeMapSize))) {
+        return false;
+    }
+    QByteArray frameTypeMap = device->read(frameTypeMapSize);
+    if ((uint32_t)frameTypeMap.size() != frameTypeMapSize) {
+        return false;
+    }
+    translationMap = parseTranslationMap(QJsonDocument::fromBinaryData(frameTypeMap));
+
+    // frames of types unknown to the application are skipped
+    for (const auto& frameType : frameTypes) {
+        if (translationMap.contains(frameType.type)) {
+            frameCount += frameType.frameCount;
+            duration = std::max(duration, frameType.lastTime);
+        }
+    }
+    return true;
+}
+
+bool ChunkedClip::Source::scanChunks() {
+    index.clear();
+    frameCount = 0;
+    duration = 0;
+
+    QJsonDocument header;
+    qint64 offset = readHeaderFrame(*device, header);
+    if (offset < 0) {
+        return false;
+    }
+
+    // without the index, the frame types are taken to be those of the application
+    translationMap.clear();
+    for (auto frameType : Frame::getFrameTypes()) {
+        translationMap[frameType] = frameType;
+    }
+
+    ChunkHeader chunkHeader;
+    std::vector<Frame> frames;
+    while (device->seek(offset) &&
+           readData(*device, &chunkHeader, sizeof(chunkHeader)) &&
+           memcmp(chunkHeader.magic, CHUNK_MAGIC, sizeof(CHUNK_MAGIC)) == 0) {
+        QByteArray chunkData = device->read(chunkHeader.size);
+        if ((uint32_t)chunkData.size() != chunkHeader.size) {
+            break;
+        }
+        index.push_back({ chunkHeader.startTime, chunkHeader.endTime, (quint64)offset });
+
+        frames.clear();
+        parseChunk(chunkData, translationMap, frames);
+        if (!frames.empty()) {
+            frameCount += frames.size();
+            duration = std::max(duration, frames.back().timeOffset);
+        }
+        offset = device->pos();
+    }
+    qCWarning(recordingLog) << "Clip" << name << "has no index, found" << index.size() << "chunks";
+    return !index.empty();
+}
+
+void ChunkedClip::Source::readChunk(size_t chunkIndex, std::vector<Frame>& frames) {
+    QByteArray chunkData;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ChunkHeader chunkHeader;
+        if (!device->seek(index[chunkIndex].offset) ||
+            !readData(*device, &chunkHeader, sizeof(chunkHeader)) ||
+            memcmp(chunkHeader.magic, CHUNK_MAGIC, sizeof(CHUNK_MAGIC)) != 0) {
+            qCWarning(recordingLog) << "Invalid chunk" << chunkIndex << "in clip" << name;
+            return;
+        }
+        chunkData = device->read(chunkHeader.size);
+        if ((uint32_t)chunkData.size() != chunkHeader.size) {
+            qCWarning(recordingLog) << "Truncated chunk" << chunkIndex << "in clip" << name;
+            return;
+        }
+    }
+    parseChunk(chunkData, translationMap, frames);
+}
+
+ChunkedClip::ChunkedClip(const std::shared_ptr<QIODevice>& device, const QString& name) :
+    _source(std::make_shared<Source>()) {
+    _source->device = device;
+    _source->name = name;
+    if (!_source->readIndex() && !_source->scanChunks()) {
+        qCWarning(recordingLog) << "No chunks found, invalid clip" << name;
+    }
+    loadChunk(0);
+}
+
+ChunkedClip::ChunkedClip(const std::shared_ptr<Source>& source) : _source(source) {
+    loadChunk(0);
+}
+
+bool ChunkedClip::isChunkedClip(QIODevice& device) {
+    QJsonDocument header;
+    bool result = readHeaderFrame(device, header) >= 0 && header.object()[Clip::CHUNKED_FLAG].toBool();
+    device.seek(0);
+    return result;
+}
+
+Clip::Pointer ChunkedClip::duplicate() const {
+    // the chunks are read only, so the duplicates can share them
+    return Clip::Pointer(new ChunkedClip(_source));
+}
+
+QString ChunkedClip::getName() const {
+    return _source->name;
+}
+
+float ChunkedClip::duration() const {
+    return Frame::frameTimeToSeconds(_source->duration);
+}
+
+size_t ChunkedClip::frameCount() const {
+    return _source->frameCount;
+}
+
+void ChunkedClip::seekFrameTime(Frame::Time offset) {
+    Locker lock(_mutex);
+    const auto& index = _source->index;
+    auto chunkItr = std::lower_bound(index.begin(), index.end(), offset,
+        [](const IndexEntry& a, Frame::Time b)->bool {
+            return a.endTime < b;
+        }
+    );
+    size_t chunkIndex = chunkItr - index.begin();
+    if (chunkIndex != _chunkIndex || _chunkFrames.empty()) {
+        loadChunk(chunkIndex);
+    }
+    auto frameItr = std::lower_bound(_chunkFrames.begin(), _chunkFrames.end(), offset,
+        [](const Frame& a, Frame::Time b)->bool {
+            return a.timeOffset < b;
+        }
+    );
+    _frameIndex = frameItr - _chunkFrames.begin();
+}
+
+Frame::Time ChunkedClip::positionFrameTime() const {
+    Locker lock(_mutex);
+    auto frame = currentFrame();
+    return frame ? frame->timeOffset : Frame::INVALID_TIME;
+}
+
+FrameConstPointer ChunkedClip::peekFrame() const {
+    Locker lock(_mutex);
+    FrameConstPointer result;
+    if (auto frame = currentFrame()) {
+        result = std::make_shared<Frame>(*frame);
+    }
+    return result;
+}
+
+FrameConstPointer ChunkedClip::nextFrame() {
+    Locker lock(_mutex);
+    FrameConstPointer result;
+    if (auto frame = currentFrame()) {
+        result = std::make_shared<Frame>(*frame);
+        ++_frameIndex;
+    }
+    return result;
+}
+
+void ChunkedClip::skipFrame() {
+    Locker lock(_mutex);
+    if (currentFrame()) {
+        ++_frameIndex;
+    }
+}
+
+void ChunkedClip::addFrame(FrameConstPointer) {
+    throw std::runtime_error("Chunked clips are read only, use duplicate to create a read/write clip");
+}
+
+void ChunkedClip::reset() {
+    loadChunk(0);
+}
+
+// Internal only function, needs no locking
+void ChunkedClip::loadChunk(size_t chunkIndex) const {
+    _chunkFrames.clear();
+    _frameIndex = 0;
+    for (_chunkIndex = chunkIndex; _chunkIndex < _source->index.size(); ++_chunkIndex) {
+        _source->readChunk(_chunkIndex, _chunkFrames);
+        if (!_chunkFrames.empty()) {
+            break;
+        }
+    }
+}
+
+// Internal only function, needs no locking
+const Frame* ChunkedClip::currentFrame() const {
+    if (_frameIndex >= _chunkFrames.size()) {
+        if (_chunkIndex >= _source->index.size()) {
+            return nullptr;
+        }
+        loadChunk(_chunkIndex + 1);
+        if (_frameIndex >= _chunkFrames.size()) {
+            return nullptr;
+        }
+    }
+    return &_chunkFrames[_frameIndex];
+}
+
+ChunkedClipWriter::ChunkedClipWriter(QIODevice& output) : _output(output) {
+    _chunkData.reserve((int)MAX_CHUNK_SIZE);
+    _failed = !writeHeader();
+}
+
+bool ChunkedClipWriter::writeHeader() {
+    QJsonObject rootObject;
+    rootObject.insert(Clip::FRAME_COMREPSSION_FLAG, true);
+    rootObject.insert(Clip::CHUNKED_FLAG, true);
+    QByteArray headerData = QJsonDocument(rootObject).toBinaryData();
+
+    // as the header frame of clips of single frames, never compressed
+    FrameType type = Frame::TYPE_HEADER;
+    Frame::Time timeOffset = 0;
+    FrameSize size = headerData.size();
+    return writeData(_output, &type, sizeof(type)) &&
+        writeData(_output, &timeOffset, sizeof(timeOffset)) &&
+        writeData(_output, &size, sizeof(size)) &&
+        writeData(_output, headerData.constData(), size);
+}
+
+bool ChunkedClipWriter::addFrame(const Frame& frame) {
+    if (_failed) {
+        return false;
+    }
+    if (frame.type == Frame::TYPE_INVALID) {
+        qCWarning(recordingLog) << "Attempting to write invalid frame";
+        return true;
+    }
+
+    // the frames are kept in time order, for the chunks of the index to be
+    Frame::Time timeOffset = std::max(frame.timeOffset, _lastTime);
+    if (_chunkFrameCount > 0 &&
+        ((size_t)_chunkData.size() >= MAX_CHUNK_SIZE || (timeOffset - _chunkStartTime) >= MAX_CHUNK_DURATION)) {
+        if (!flushChunk()) {
+            return false;
+        }
+    }
+    if (_chunkFrameCount == 0) {
+        _chunkStartTime = timeOffset;
+    }
+
+    uint32_t size = frame.data.size();
+    _chunkData.append(reinterpret_cast<const char*>(&frame.type), sizeof(FrameType));
+    _chunkData.append(reinterpret_cast<const char*>(&timeOffset), sizeof(timeOffset));
+    _chunkData.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    _chunkData.append(frame.data);
+    ++_chunkFrameCount;
+    _lastTime = timeOffset;
+
+    auto& frameType = _frameTypes[frame.type];
+    frameType.type = frame.type;
+    ++frameType.frameCount;
+    frameType.lastTime = timeOffset;
+    return true;
+}
+
+bool ChunkedClipWriter::flushChunk() {
+    QByteArray chunkData = qCompress(_chunkData);
+
+    ChunkedClip::ChunkHeader chunkHeader;
+    memcpy(chunkHeader.magic, CHUNK_MAGIC, sizeof(CHUNK_MAGIC));
+    chunkHeader.startTime = _chunkStartTime;
+    chunkHeader.endTime = _lastTime;
+    chunkHeader.frameCount = _chunkFrameCount;
+    chunkHeader.size = chunkData.size();
+
+    quint64 offset = _output.pos();
+    if (!writeData(_output, &chunkHeader, sizeof(chunkHeader)) ||
+        !writeData(_output, chunkData.constData(), chunkData.size())) {
+        qCWarning(recordingLog) << "Unable to write clip chunk";
+        _failed = true;
+        return false;
+    }
+    _index.push_back({ _chunkStartTime, _lastTime, offset });
+
+    // keeps the reserved capacity
+    _chunkData.resize(0);
+    _chunkFrameCount = 0;
+    return true;
+}
+
+bool ChunkedClipWriter::close() {
+    if (_failed) {
+        return false;
+    }
+    if (_chunkFrameCount > 0 && !flushChunk()) {
+        return false;
+    }
+    // nothing can be added after the index
+    _failed = true;
+
+    // Frame types get registered as they are first recorded, so their names are only known by now
+    auto frameTypeNames = Frame::getFrameTypeNames();
+    QJsonObject frameTypeObj;
+    for (auto frameType : _frameTypes.keys()) {
+        if (frameTypeNames.contains(frameType)) {
+            frameTypeObj[frameTypeNames[frameType]] = frameType;
+        }
+    }
+    QJsonObject rootObject;
+    rootObject.insert(Clip::FRAME_TYPE_MAP, frameTypeObj);
+    QByteArray frameTypeMap = QJsonDocument(rootObject).toBinaryData();
+
+    IndexTrailer trailer;
+    trailer.indexOffset = _output.pos();
+    memcpy(trailer.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    trailer.version = INDEX_VERSION;
+
+    uint32_t numChunks = (uint32_t)_index.size();
+    uint32_t numFrameTypes = (uint32_t)_frameTypes.size();
+    uint32_t frameTypeMapSize = (uint32_t)frameTypeMap.size();
+    bool written = writeData(_output, &numChunks, sizeof(numChunks)) &&
+        writeData(_output, _index.data(), numChunks * sizeof(ChunkedClip::IndexEntry)) &&
+        writeData(_output, &numFrameTypes, sizeof(numFrameTypes));
+    for (const auto& frameType : _frameTypes) {
+        written = written && writeData(_output, &frameType, sizeof(frameType));
+    }
+    written = written &&
+        writeData(_output, &frameTypeMapSize, sizeof(frameTypeMapSize)) &&
+        writeData(_output, frameTypeMap.constData(), frameTypeMapSize) &&
+        writeData(_output, &trailer, sizeof(trailer));
+    if (!written) {
+        qCWarning(recordingLog) << "Unable to write clip index";
+    }
+    return written;
+}
@@ -0,0 +1,124 @@
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Recording_Impl_ChunkedClip_h
+#define hifi_Recording_Impl_ChunkedClip_h
+
+#include "../Clip.h"
+
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QMap>
+
+class QIODevice;
+
+namespace recording {
+
+// A clip stored as a header frame, chunks of frames compressed together and an index of the chunk
+// times at the end. Only the chunk at the current position is held in memory, and seeking looks up
+// its chunk in the index.
+class ChunkedClip : public Clip {
+public:
+    using Pointer = std::shared_ptr<ChunkedClip>;
+
+    // The device must be open for reading, and is shared with the duplicates of the clip
+    ChunkedClip(const std::shared_ptr<QIODevice>& device, const QString& name);
+
+    // Test if the device holds a chunked clip, rather than a clip of single frames
+    static bool isChunkedClip(QIODevice& device);
+
+    virtual Clip::Pointer duplicate() const override;
+
+    virtual QString getName() const override;
+
+    virtual float duration() const override;
+    virtual size_t frameCount() const override;
+
+    virtual void seekFrameTime(Frame::Time offset) override;
+    virtual Frame::Time positionFrameTime() const override;
+
+    virtual FrameConstPointer peekFrame() const override;
+    virtual FrameConstPointer nextFrame() override;
+    virtual void skipFrame() override;
+    virtual void addFrame(FrameConstPointer) override;
+
+    struct ChunkHeader {
+        char magic[4];
+        Frame::Time startTime;
+        Frame::Time endTime;
+        uint32_t frameCount;
+        uint32_t size;              // of the compressed frames that follow
+    };
+
+    struct IndexEntry {
+        Frame::Time startTime;
+        Frame::Time endTime;
+        quint64 offset;             // of the chunk header, in the device
+    };
+
+    struct FrameTypeEntry {
+        FrameType type;
+        uint16_t padding;
+        uint32_t frameCount;
+        Frame::Time lastTime;
+    };
+
+protected:
+    virtual void reset() override;
+
+private:
+    struct Source;
+
+    ChunkedClip(const std::shared_ptr<Source>& source);
+
+    // Load the frames of the chunk, or of the next one holding any frames of a known type
+    void loadChunk(size_t chunkIndex) const;
+    const Frame* currentFrame() const;
+
+    std::shared_ptr<Source> _source;
+    mutable size_t _chunkIndex { 0 };
+    mutable size_t _frameIndex { 0 };
+    mutable std::vector<Frame> _chunkFrames;
+};
+
+// Writes a chunked clip as the frames are added, in time order, holding a chunk of them in memory at most
+class ChunkedClipWriter {
+public:
+    // The clip is read back from the start of the device, so the output must be at its start
+    ChunkedClipWriter(QIODevice& output);
+
+    bool addFrame(const Frame& frame);
+    // Write the remaining frames and the index
+    bool close();
+
+    Frame::Time duration() const { return _lastTime; }
+
+    static const size_t MAX_CHUNK_SIZE;
+    static const Frame::Time MAX_CHUNK_DURATION;
+
+private:
+    bool writeHeader();
+    bool flushChunk();
+
+    QIODevice& _output;
+    bool _failed { false };
+
+    QByteArray _chunkData;
+    Frame::Time _chunkStartTime { 0 };
+    uint32_t _chunkFrameCount { 0 };
+    Frame::Time _lastTime { 0 };
+
+    std::vector<ChunkedClip::IndexEntry> _index;
+    QMap<FrameType, ChunkedClip::FrameTypeEntry> _frameTypes;
+};
+
+}
+
+#endif
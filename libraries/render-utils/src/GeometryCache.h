@@ -15,6 +15,7 @@
 #include "model-networking/ModelCache.h"
 
 #include <array>
+#include <atomic>
 
 #include <QMap>
 #include <QRunnable>
@@ -385,7 +386,7 @@ private:
 
     QHash<IntPair, VerticesIndices> _coneVBOs;
 
-    int _nextID{ 1 };
+    std::atomic<int> _nextID{ 1 }; // ids are allocated by the overlays and entities, on the main and render threads
 
     QHash<int, Vec3PairVec4Pair> _lastRegisteredQuad3DTexture;
     QHash<int, BatchItemDetails> _registeredQuad3DTextures;
@@ -11,8 +11,6 @@
 
 #include "MeshPartPayload.h"
 
-#include <PerfStat.h>
-
 #include "DeferredLightingEffect.h"
 #include "Model.h"
 #include "EntityItem.h"
@@ -74,7 +72,7 @@ void MeshPartPayload::updateMaterial(model::MaterialPointer drawMaterial) {
 
 ItemKey MeshPartPayload::getKey() const {
     ItemKey::Builder builder;
-    builder.withTypeShape();
+    builder.withTypeShape().withConcurrent();
 
     if (_drawMaterial) {
         auto matKey = _drawMaterial->getKey();
@@ -268,8 +266,6 @@ void MeshPartPayload::bindTransform(gpu::Batch& batch, const ShapePipeline::Loca
 
 
 void MeshPartPayload::render(RenderArgs* args) const {
-    PerformanceTimer perfTimer("MeshPartPayload::render");
-
     gpu::Batch& batch = *(args->_batch);
 
     auto locations = args->_pipeline->locations;
@@ -289,10 +285,7 @@ void MeshPartPayload::render(RenderArgs* args) const {
     }
 
     // Draw!
-    {
-        PerformanceTimer perfTimer("batch.drawIndexed()");
-        drawCall(batch);
-    }
+    drawCall(batch);
 
     if (args) {
         const int INDICES_PER_TRIANGLE = 3;
@@ -408,8 +401,11 @@ ItemKey ModelMeshPartPayload::getKey() const {
         }
     }
 
+    // Fading in updates the payload and the model when rendering, so only faded in parts can be recorded concurrently
     if (_fadeState != FADE_COMPLETE) {
         builder.withTransparent();
+    } else {
+        builder.withConcurrent();
     }
 
     return builder.build();
@@ -555,8 +551,6 @@ float ModelMeshPartPayload::computeFadeAlpha() const {
 }
 
 void ModelMeshPartPayload::render(RenderArgs* args) const {
-    PerformanceTimer perfTimer("ModelMeshPartPayload::render");
-
     if (!_model->addedToScene() || !_model->isVisible()) {
         return; // bail asap
     }
@@ -587,7 +581,10 @@ void ModelMeshPartPayload::render(RenderArgs* args) const {
     assert(locations);
 
     // Bind the model transform and the skinCLusterMatrices if needed
-    _model->updateClusterMatrices();
+    {
+        std::lock_guard<std::mutex> lock(_model->_clusterMatricesMutex);
+        _model->updateClusterMatrices();
+    }
     bindTransform(batch, locations, args->_renderMode);
 
     //Bind the index buffer and vertex buffer and Blend shapes if needed
@@ -599,10 +596,7 @@ void ModelMeshPartPayload::render(RenderArgs* args) const {
     args->_details._materialSwitches++;
 
     // Draw!
-    {
-        PerformanceTimer perfTimer("batch.drawIndexed()");
-        drawCall(batch);
-    }
+    drawCall(batch);
 
     const int INDICES_PER_TRIANGLE = 3;
     args->_details._trianglesRendered += _drawPart._numIndices / INDICES_PER_TRIANGLE;
@@ -17,6 +17,7 @@
 #include <QUrl>
 #include <QMutex>
 
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
@@ -394,6 +395,7 @@ protected:
     bool _needsFixupInScene { true }; // needs to be removed/re-added to scene
     bool _needsReload { true };
     bool _needsUpdateClusterMatrices { true };
+    std::mutex _clusterMatricesMutex; // mesh parts can be recorded on several render job threads at once
     mutable bool _needsUpdateTextures { true };
 
     friend class ModelMeshPartPayload;
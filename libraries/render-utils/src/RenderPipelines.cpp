@@ -11,6 +11,7 @@
 //
 
 #include <functional>
+#include <mutex>
 
 #include <gpu/Context.h>
 #include <gpu/StandardShaderLib.h>
@@ -68,6 +69,17 @@ void addPlumberPipeline(ShapePlumber& plumber,
 void batchSetter(const ShapePipeline& pipeline, gpu::Batch& batch);
 void lightBatchSetter(const ShapePipeline& pipeline, gpu::Batch& batch);
 
+// The batch setters and the model payloads get the default textures when shapes are recorded, possibly on
+// several render job threads at once, so create them beforehand
+static void initDefaultTextures() {
+    auto textureCache = DependencyManager::get<TextureCache>();
+    textureCache->getWhiteTexture();
+    textureCache->getGrayTexture();
+    textureCache->getBlueTexture();
+    textureCache->getBlackTexture();
+    textureCache->getNormalFittingTexture();
+}
+
 void initOverlay3DPipelines(ShapePlumber& plumber) {
     auto vertex = gpu::Shader::createVertex(std::string(overlay3D_vert));
     auto pixel = gpu::Shader::createPixel(std::string(overlay3D_frag));
@@ -224,6 +236,8 @@ void initDeferredPipelines(render::ShapePlumber& plumber) {
     addPipeline(
         Key::Builder().withSkinned().withDepthOnly(),
         skinModelShadowVertex, modelShadowPixel);
+
+    initDefaultTextures();
 }
 
 void initForwardPipelines(render::ShapePlumber& plumber) {
@@ -271,6 +285,8 @@ void initForwardPipelines(render::ShapePlumber& plumber) {
     addPipeline(
         Key::Builder().withSkinned().withTangents().withSpecular(),
         skinModelNormalMapVertex, modelNormalSpecularMapPixel);
+
+    initDefaultTextures();
 }
 
 void addPlumberPipeline(ShapePlumber& plumber,
@@ -326,15 +342,14 @@ void batchSetter(const ShapePipeline& pipeline, gpu::Batch& batch) {
     // Set a default material
     if (pipeline.locations->materialBufferUnit >= 0) {
         // Create a default schema
-        static bool isMaterialSet = false;
+        static std::once_flag once;
         static model::Material material;
-        if (!isMaterialSet) {
+        std::call_once(once, [] {
             material.setAlbedo(vec3(1.0f));
             material.setOpacity(1.0f);
             material.setMetallic(0.1f);
             material.setRoughness(0.9f);
-            isMaterialSet = true;
-        }
+        });
 
         // Set a default schema
         batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::MATERIAL, material.getSchemaBuffer());
@@ -0,0 +1,90 @@
+//
+//  FrustumCuller_avx2.cpp
+//  render/src/avx2
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <immintrin.h>
+
+#include "../render/FrustumCuller.h"
+
+#ifndef __AVX2__
+#error Must be compiled with /arch:AVX2 or -mavx2 -mfma.
+#endif
+
+using namespace render;
+
+size_t FrustumCuller::intersect_AVX2(const FrustumCuller& culler, const BoxArrays& boxes, Intersection* results) {
+    const __m256 zero = _mm256_setzero_ps();
+    size_t end = boxes.size & ~(size_t)7;
+
+    for (size_t i = 0; i < end; i += 8) {
+        __m256 x = _mm256_loadu_ps(&boxes.x[i]);
+        __m256 y = _mm256_loadu_ps(&boxes.y[i]);
+        __m256 z = _mm256_loadu_ps(&boxes.z[i]);
+        __m256 width = _mm256_loadu_ps(&boxes.width[i]);
+        __m256 height = _mm256_loadu_ps(&boxes.height[i]);
+        __m256 depth = _mm256_loadu_ps(&boxes.depth[i]);
+
+        __m256 outside = zero;
+        __m256 partial = zero;
+        for (auto& plane : culler._planes) {
+            __m256 normalX = _mm256_set1_ps(plane.normal[0]);
+            __m256 normalY = _mm256_set1_ps(plane.normal[1]);
+            __m256 normalZ = _mm256_set1_ps(plane.normal[2]);
+            __m256 d = _mm256_set1_ps(plane.d);
+
+            // no fma, and the file is built without contracting the multiplies and adds into fmas either,
+            // so that the results are the same as the other versions
+            __m256 farX = _mm256_add_ps(x, _mm256_mul_ps(width, _mm256_set1_ps(plane.farOffset[0])));
+            __m256 farY = _mm256_add_ps(y, _mm256_mul_ps(height, _mm256_set1_ps(plane.farOffset[1])));
+            __m256 farZ = _mm256_add_ps(z, _mm256_mul_ps(depth, _mm256_set1_ps(plane.farOffset[2])));
+            __m256 farDistance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(normalX, farX), _mm256_mul_ps(normalY, farY)),
+                                                             _mm256_mul_ps(normalZ, farZ)), d);
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(farDistance, zero, _CMP_LT_OQ));
+
+            __m256 nearX = _mm256_add_ps(x, _mm256_mul_ps(width, _mm256_set1_ps(plane.nearOffset[0])));
+            __m256 nearY = _mm256_add_ps(y, _mm256_mul_ps(height, _mm256_set1_ps(plane.nearOffset[1])));
+            __m256 nearZ = _mm256_add_ps(z, _mm256_mul_ps(depth, _mm256_set1_ps(plane.nearOffset[2])));
+            __m256 nearDistance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(normalX, nearX), _mm256_mul_ps(normalY, nearY)),
+                                                              _mm256_mul_ps(normalZ, nearZ)), d);
+            partial = _mm256_or_ps(partial, _mm256_cmp_ps(nearDistance, zero, _CMP_LT_OQ));
+        }
+
+        int outsideMask = _mm256_movemask_ps(outside);
+        int partialMask = _mm256_movemask_ps(partial);
+        for (int j = 0; j < 8; ++j) {
+            results[i + j] = (outsideMask & (1 << j)) ? Outside : ((partialMask & (1 << j)) ? Intersect : Inside);
+        }
+    }
+    return end;
+}
+
+size_t FrustumCuller::testSolidAngles_AVX2(const BoxArrays& boxes, const glm::vec3& eyePos, float size, float squareTanAlpha,
+                                           float* results) {
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 eyeX = _mm256_set1_ps(eyePos.x);
+    const __m256 eyeY = _mm256_set1_ps(eyePos.y);
+    const __m256 eyeZ = _mm256_set1_ps(eyePos.z);
+    const __m256 squareSize = _mm256_set1_ps(size * size);
+    const __m256 limit = _mm256_set1_ps(squareTanAlpha);
+    size_t end = boxes.size & ~(size_t)7;
+
+    for (size_t i = 0; i < end; i += 8) {
+        __m256 eyeToCenterX = _mm256_sub_ps(_mm256_add_ps(_mm256_loadu_ps(&boxes.x[i]), _mm256_mul_ps(_mm256_loadu_ps(&boxes.width[i]), half)), eyeX);
+        __m256 eyeToCenterY = _mm256_sub_ps(_mm256_add_ps(_mm256_loadu_ps(&boxes.y[i]), _mm256_mul_ps(_mm256_loadu_ps(&boxes.height[i]), half)), eyeY);
+        __m256 eyeToCenterZ = _mm256_sub_ps(_mm256_add_ps(_mm256_loadu_ps(&boxes.z[i]), _mm256_mul_ps(_mm256_loadu_ps(&boxes.depth[i]), half)), eyeZ);
+        __m256 squareDistance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(eyeToCenterX, eyeToCenterX), _mm256_mul_ps(eyeToCenterY, eyeToCenterY)),
+                                              _mm256_mul_ps(eyeToCenterZ, eyeToCenterZ));
+        _mm256_storeu_ps(&results[i], _mm256_sub_ps(_mm256_div_ps(squareSize, squareDistance), limit));
+    }
+    return end;
+}
+
+#endif
@@ -25,11 +25,13 @@ public:
 using SceneContextPointer = std::shared_ptr<SceneContext>;
 
 class JobConfig;
+class JobSlavePool;
 
 class RenderContext {
 public:
     RenderArgs* args;
     std::shared_ptr<JobConfig> jobConfig{ nullptr };
+    JobSlavePool* jobPool{ nullptr }; // runs the concurrent jobs of the tasks, and records the sorted shapes, when set
 };
 using RenderContextPointer = std::shared_ptr<RenderContext>;
 
@@ -31,8 +31,23 @@ void render::cullItems(const RenderContextPointer& renderContext, const CullFunc
 
     details._considered += (int)inItems.size();
 
+    // Frustum test all the bounds in one batch
+    static thread_local BoxBatch boxes;
+    static thread_local std::vector<FrustumCuller::Intersection> intersections;
+    {
+        PerformanceTimer perfTimer("boxIntersectsFrustum");
+        boxes.clear();
+        boxes.reserve(inItems.size());
+        for (auto& item : inItems) {
+            boxes.push_back(item.bound);
+        }
+        intersections.resize(inItems.size());
+        FrustumCuller(frustum).intersect(boxes.getArrays(), intersections.data());
+    }
+
     // Culling / LOD
-    for (auto item : inItems) {
+    for (size_t i = 0; i < inItems.size(); ++i) {
+        auto& item = inItems[i];
         if (item.bound.isNull()) {
             outItems.emplace_back(item); // One more Item to render
             continue;
@@ -40,11 +55,7 @@ void render::cullItems(const RenderContextPointer& renderContext, const CullFunc
 
         // TODO: some entity types (like lights) might want to be rendered even
         // when they are outside of the view frustum...
-        bool inView;
-        {
-            PerformanceTimer perfTimer("boxIntersectsFrustum");
-            inView = frustum.boxIntersectsFrustum(item.bound);
-        }
+        bool inView = (intersections[i] != FrustumCuller::Outside);
         if (inView) {
             bool bigEnoughToRender;
             {
@@ -138,13 +149,20 @@ void CullSpatialSelection::run(const SceneContextPointer& sceneContext, const Re
         CullFunctor _functor;
         RenderArgs* _args;
         RenderDetails::Item& _renderDetails;
+        FrustumCuller _culler;
+        BoxBatch& _boxes;
+        std::vector<FrustumCuller::Intersection>& _intersections;
         glm::vec3 _eyePos;
         float _squareTanAlpha;
 
-        Test(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item& renderDetails) :
+        Test(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item& renderDetails,
+             BoxBatch& boxes, std::vector<FrustumCuller::Intersection>& intersections) :
             _functor(functor),
             _args(pargs),
-            _renderDetails(renderDetails)
+            _renderDetails(renderDetails),
+            _culler(pargs->getViewFrustum()),
+            _boxes(boxes),
+            _intersections(intersections)
         {
             // FIXME: Keep this code here even though we don't use it yet
             /*_eyePos = _args->getViewFrustum().getPosition();
@@ -156,12 +174,23 @@ void CullSpatialSelection::run(const SceneContextPointer& sceneContext, const Re
             */
         }
 
-        bool frustumTest(const AABox& bound) {
-            if (!_args->getViewFrustum().boxIntersectsFrustum(bound)) {
-                _renderDetails._outOfView++;
-                return false;
+        // frustum test the items in one batch, keeping those in view (which also pass the solid angle test, if asked)
+        void frustumTest(const ItemBounds& items, bool withSolidAngleTest, ItemBounds& outItems) {
+            _boxes.clear();
+            _boxes.reserve(items.size());
+            for (auto& itemBound : items) {
+                _boxes.push_back(itemBound.bound);
+            }
+            _intersections.resize(items.size());
+            _culler.intersect(_boxes.getArrays(), _intersections.data());
+
+            for (size_t i = 0; i < items.size(); ++i) {
+                if (_intersections[i] == FrustumCuller::Outside) {
+                    _renderDetails._outOfView++;
+                } else if (!withSolidAngleTest || solidAngleTest(items[i].bound)) {
+                    outItems.emplace_back(items[i]);
+                }
             }
-            return true;
         }
 
         bool solidAngleTest(const AABox& bound) {
@@ -177,7 +206,7 @@ void CullSpatialSelection::run(const SceneContextPointer& sceneContext, const Re
             return true;
         }
     };
-    Test test(_cullFunctor, args, details);
+    Test test(_cullFunctor, args, details, _boxes, _intersections);
 
     // Now we have a selection of items to render
     outItems.clear();
@@ -268,31 +297,27 @@ void CullSpatialSelection::run(const SceneContextPointer& sceneContext, const Re
         // partial & fit items: filter & frustum cull
         {
             PerformanceTimer perfTimer("partialFitItems");
+            _candidates.clear();
             for (auto id : inSelection.partialItems) {
                 auto& item = scene->getItem(id);
                 if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.frustumTest(itemBound.bound)) {
-                        outItems.emplace_back(itemBound);
-                    }
+                    _candidates.emplace_back(ItemBound(id, item.getBound()));
                 }
             }
+            test.frustumTest(_candidates, false, outItems);
         }
 
         // partial & subcell items:: filter & frutum cull & solidangle cull
         {
             PerformanceTimer perfTimer("partialSmallItems");
+            _candidates.clear();
             for (auto id : inSelection.partialSubcellItems) {
                 auto& item = scene->getItem(id);
                 if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.frustumTest(itemBound.bound)) {
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                        }
-                    }
+                    _candidates.emplace_back(ItemBound(id, item.getBound()));
                 }
             }
+            test.frustumTest(_candidates, true, outItems);
         }
     }
 
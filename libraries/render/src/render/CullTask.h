@@ -13,6 +13,7 @@
 #define hifi_render_CullTask_h
 
 #include "Engine.h"
+#include "FrustumCuller.h"
 #include "ViewFrustum.h"
 
 namespace render {
@@ -25,6 +26,7 @@ namespace render {
     class FetchNonspatialItems {
     public:
         using JobModel = Job::ModelO<FetchNonspatialItems, ItemBounds>;
+        bool isConcurrent() const { return true; }
         void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, ItemBounds& outItems);
     };
 
@@ -63,6 +65,7 @@ namespace render {
         ItemFilter _filter{ ItemFilter::Builder::opaqueShape().withoutLayered() };
 
         void configure(const Config& config);
+        bool isConcurrent() const { return true; }
         void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, ItemSpatialTree::ItemSelection& outSelection);
     };
 
@@ -89,6 +92,11 @@ namespace render {
         bool _justFrozeFrustum{ false };
         bool _skipCulling{ false };
         ViewFrustum _frozenFrutstum;
+
+        // the partial items, and their bounds, to frustum test in one batch
+        ItemBounds _candidates;
+        BoxBatch _boxes;
+        std::vector<FrustumCuller::Intersection> _intersections;
     public:
         using Config = CullSpatialSelectionConfig;
         using JobModel = Job::ModelIO<CullSpatialSelection, ItemSpatialTree::ItemSelection, ItemBounds, Config>;
@@ -106,6 +114,8 @@ namespace render {
         ItemFilter _filter{ ItemFilter::Builder::opaqueShape().withoutLayered() };
 
         void configure(const Config& config);
+        // a frozen frustum is pushed on the args while culling, which the jobs running alongside would see
+        bool isConcurrent() const { return !_freezeFrustum; }
         void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemSpatialTree::ItemSelection& inSelection, ItemBounds& outItems);
     };
 
@@ -129,6 +139,7 @@ namespace render {
         ItemFilter _filter{ ItemFilter::Builder::opaqueShape().withoutLayered() };
 
         void configure(const Config& config);
+        bool isConcurrent() const { return true; }
         void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemBounds& inItems, ItemBounds& outItems);
     };
 
@@ -155,6 +166,7 @@ namespace render {
         ItemFilterArray _filters;
 
         void configure(const Config& config) {}
+        bool isConcurrent() const { return true; }
         void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemBounds& inItems, ItemBoundsArray& outItems) {
             auto& scene = sceneContext->_scene;
             
@@ -186,6 +198,7 @@ namespace render {
 
         int _keepLayer { 0 };
 
+        bool isConcurrent() const { return true; }
         void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemBounds& inItems, ItemBounds& outItems);
     };
 }
@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <memory>
 
 #include <PerfStat.h>
 #include <ViewFrustum.h>
@@ -70,6 +71,54 @@ void render::renderShapes(const SceneContextPointer& sceneContext, const RenderC
     }
 }
 
+// A shape and the key of its pipeline, as sorted by pipeline
+using SortedShape = std::pair<const ShapeKey*, const Item*>;
+
+// Below this many shapes per sub batch, recording them on the job threads costs more than it saves
+static const int MIN_SHAPES_PER_SUB_BATCH = 256;
+
+static void renderSortedShapes(RenderArgs* args, const ShapePlumberPointer& shapeContext,
+                               const SortedShape* begin, const SortedShape* end) {
+    const ShapeKey* pipelineKey = nullptr;
+    for (auto shape = begin; shape != end; ++shape) {
+        if (shape->first != pipelineKey) {
+            pipelineKey = shape->first;
+            args->_pipeline = shapeContext->pickPipeline(args, *pipelineKey);
+        }
+        if (args->_pipeline) {
+            shape->second->render(args);
+        }
+    }
+    args->_pipeline = nullptr;
+}
+
+// Record the shapes in even runs, one sub batch per job thread, then append the sub batches in order
+// so that the batch is the same whatever thread recorded each run
+static void renderSortedShapesInSubBatches(RenderArgs* args, JobSlavePool& jobPool, const ShapePlumberPointer& shapeContext,
+                                           const std::vector<SortedShape>& shapes, size_t numSubBatches) {
+    std::vector<std::unique_ptr<gpu::Batch>> subBatches;
+    std::vector<RenderArgs> subArgs(numSubBatches, *args);
+    for (size_t i = 0; i < numSubBatches; ++i) {
+        subBatches.emplace_back(new gpu::Batch());
+        args->_batch->startSubBatch(*subBatches[i]);
+        subArgs[i]._batch = subBatches[i].get();
+        subArgs[i]._details = RenderDetails();
+    }
+
+    JobSlavePool::Dependencies dependencies(numSubBatches);
+    jobPool.run(dependencies, [&](size_t index) {
+        size_t begin = shapes.size() * index / numSubBatches;
+        size_t end = shapes.size() * (index + 1) / numSubBatches;
+        renderSortedShapes(&subArgs[index], shapeContext, shapes.data() + begin, shapes.data() + end);
+    });
+
+    for (size_t i = 0; i < numSubBatches; ++i) {
+        args->_batch->appendSubBatch(*subBatches[i]);
+        args->_details._materialSwitches += subArgs[i]._details._materialSwitches;
+        args->_details._trianglesRendered += subArgs[i]._details._trianglesRendered;
+    }
+}
+
 void render::renderStateSortShapes(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext,
     const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems) {
     auto& scene = sceneContext->_scene;
@@ -85,6 +134,8 @@ void render::renderStateSortShapes(const SceneContextPointer& sceneContext, cons
     SortedPipelines sortedPipelines;
     SortedShapes sortedShapes;
     std::vector<Item> ownPipelineBucket;
+    size_t numSortedShapes = 0;
+    size_t numConcurrentShapes = 0;
 
     for (auto i = 0; i < numItemsToDraw; ++i) {
         auto item = scene->getItem(inItems[i].id);
@@ -98,6 +149,10 @@ void render::renderStateSortShapes(const SceneContextPointer& sceneContext, cons
                     sortedPipelines.push_back(key);
                 }
                 bucket.push_back(item);
+                ++numSortedShapes;
+                if (item.getKey().isConcurrent()) {
+                    ++numConcurrentShapes;
+                }
             } else if (key.hasOwnPipeline()) {
                 ownPipelineBucket.push_back(item);
             } else {
@@ -106,18 +161,40 @@ void render::renderStateSortShapes(const SceneContextPointer& sceneContext, cons
         }
     }
 
-    // Then render
-    for (auto& pipelineKey : sortedPipelines) {
-        auto& bucket = sortedShapes[pipelineKey];
-        args->_pipeline = shapeContext->pickPipeline(args, pipelineKey);
-        if (!args->_pipeline) {
-            continue;
+    // Then render, recording the shapes using the plumber's pipelines on the job threads if there are enough of them
+    size_t numSubBatches = 0;
+    if (renderContext->jobPool) {
+        numSubBatches = std::min((size_t)renderContext->jobPool->numThreads() + 1, numConcurrentShapes / MIN_SHAPES_PER_SUB_BATCH);
+    }
+    if (numSubBatches > 1) {
+        // Only the items flagged concurrent can be recorded on the job threads, the others go after them on this thread
+        std::vector<SortedShape> concurrentShapes;
+        std::vector<SortedShape> serialShapes;
+        concurrentShapes.reserve(numConcurrentShapes);
+        serialShapes.reserve(numSortedShapes - numConcurrentShapes);
+        for (auto& pipelineKey : sortedPipelines) {
+            for (auto& item : sortedShapes[pipelineKey]) {
+                auto& shapes = item.getKey().isConcurrent() ? concurrentShapes : serialShapes;
+                shapes.emplace_back(&pipelineKey, &item);
+            }
         }
-        for (auto& item : bucket) {
-            item.render(args);
+        renderSortedShapesInSubBatches(args, *renderContext->jobPool, shapeContext, concurrentShapes, numSubBatches);
+        renderSortedShapes(args, shapeContext, serialShapes.data(), serialShapes.data() + serialShapes.size());
+    } else {
+        for (auto& pipelineKey : sortedPipelines) {
+            auto& bucket = sortedShapes[pipelineKey];
+            args->_pipeline = shapeContext->pickPipeline(args, pipelineKey);
+            if (!args->_pipeline) {
+                continue;
+            }
+            for (auto& item : bucket) {
+                item.render(args);
+            }
         }
+        args->_pipeline = nullptr;
     }
-    args->_pipeline = nullptr;
+
+    // The shapes with their own pipeline can do anything, so they are recorded on this thread
     for (auto& item : ownPipelineBucket) {
         item.render(args);
     }
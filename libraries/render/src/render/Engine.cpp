@@ -28,6 +28,16 @@ Engine::Engine() :
     addJob<EngineStats>("Stats");
 }
 
+void Engine::setNumJobThreads(int numThreads) {
+    if (numThreads <= 0) {
+        _jobPool.reset();
+    } else if (_jobPool) {
+        _jobPool->setNumThreads(numThreads);
+    } else {
+        _jobPool.reset(new JobSlavePool(numThreads));
+    }
+}
+
 void Engine::load() {
     auto config = getConfiguration();
     const QString configFile= "config/render.json";
@@ -15,6 +15,7 @@
 #include <SettingHandle.h>
 
 #include "Context.h"
+#include "JobSlavePool.h"
 #include "Task.h"
 namespace render {
 
@@ -38,13 +39,23 @@ namespace render {
         void setRenderContext(const RenderContext& renderContext) { (*_renderContext) = renderContext; }
         RenderContextPointer getRenderContext() const { return _renderContext; }
 
+        // Run the concurrent jobs of the tasks on this many job threads as well as the render thread
+        // 0 (the default) runs every job on the render thread
+        void setNumJobThreads(int numThreads);
+        int getNumJobThreads() const { return _jobPool ? _jobPool->numThreads() : 0; }
+
         // Render a frame
         // Must have a scene registered and a context set
-        void run() { assert(_sceneContext && _renderContext);  Task::run(_sceneContext, _renderContext); }
+        void run() {
+            assert(_sceneContext && _renderContext);
+            _renderContext->jobPool = _jobPool.get();
+            Task::run(_sceneContext, _renderContext);
+        }
 
     protected:
         SceneContextPointer _sceneContext;
         RenderContextPointer _renderContext;
+        std::unique_ptr<JobSlavePool> _jobPool;
     };
     using EnginePointer = std::shared_ptr<Engine>;
 
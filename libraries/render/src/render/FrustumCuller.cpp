@@ -0,0 +1,204 @@
+//
+//  FrustumCuller.cpp
+//  render/src/render
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrustumCuller.h"
+
+using namespace render;
+
+void BoxBatch::clear() {
+    _x.clear();
+    _y.clear();
+    _z.clear();
+    _width.clear();
+    _height.clear();
+    _depth.clear();
+}
+
+void BoxBatch::reserve(size_t size) {
+    _x.reserve(size);
+    _y.reserve(size);
+    _z.reserve(size);
+    _width.reserve(size);
+    _height.reserve(size);
+    _depth.reserve(size);
+}
+
+void BoxBatch::push_back(const glm::vec3& corner, const glm::vec3& dimensions) {
+    _x.push_back(corner.x);
+    _y.push_back(corner.y);
+    _z.push_back(corner.z);
+    _width.push_back(dimensions.x);
+    _height.push_back(dimensions.y);
+    _depth.push_back(dimensions.z);
+}
+
+BoxArrays BoxBatch::getArrays() const {
+    return BoxArrays { _x.data(), _y.data(), _z.data(), _width.data(), _height.data(), _depth.data(), _x.size() };
+}
+
+FrustumCuller::FrustumCuller(const glm::vec4 planes[ViewFrustum::NUM_PLANES]) {
+    for (int i = 0; i < ViewFrustum::NUM_PLANES; ++i) {
+        setPlane(i, glm::vec3(planes[i]), planes[i].w);
+    }
+}
+
+FrustumCuller::FrustumCuller(const ViewFrustum& frustum) {
+    auto planes = frustum.getPlanes();
+    for (int i = 0; i < ViewFrustum::NUM_PLANES; ++i) {
+        setPlane(i, planes[i].getNormal(), planes[i].getDCoefficient());
+    }
+}
+
+void FrustumCuller::setPlane(int index, const glm::vec3& normal, float d) {
+    Plane& plane = _planes[index];
+    for (int axis = 0; axis < 3; ++axis) {
+        plane.normal[axis] = normal[axis];
+        plane.farOffset[axis] = (normal[axis] >= 0.0f) ? 1.0f : 0.0f;
+        plane.nearOffset[axis] = (normal[axis] <= 0.0f) ? 1.0f : 0.0f;
+    }
+    plane.d = d;
+}
+
+void FrustumCuller::intersect_ref(const FrustumCuller& culler, const BoxArrays& boxes, size_t begin, Intersection* results) {
+    for (size_t i = begin; i < boxes.size; ++i) {
+        Intersection intersection = Inside;
+        for (auto& plane : culler._planes) {
+            float farX = boxes.x[i] + boxes.width[i] * plane.farOffset[0];
+            float farY = boxes.y[i] + boxes.height[i] * plane.farOffset[1];
+            float farZ = boxes.z[i] + boxes.depth[i] * plane.farOffset[2];
+            if (plane.normal[0] * farX + plane.normal[1] * farY + plane.normal[2] * farZ + plane.d < 0.0f) {
+                intersection = Outside;
+                break;
+            }
+
+            float nearX = boxes.x[i] + boxes.width[i] * plane.nearOffset[0];
+            float nearY = boxes.y[i] + boxes.height[i] * plane.nearOffset[1];
+            float nearZ = boxes.z[i] + boxes.depth[i] * plane.nearOffset[2];
+            if (plane.normal[0] * nearX + plane.normal[1] * nearY + plane.normal[2] * nearZ + plane.d < 0.0f) {
+                intersection = Intersect;
+            }
+        }
+        results[i] = intersection;
+    }
+}
+
+void FrustumCuller::testSolidAngles_ref(const BoxArrays& boxes, const glm::vec3& eyePos, float size, float squareTanAlpha,
+                                        size_t begin, float* results) {
+    float squareSize = size * size;
+    for (size_t i = begin; i < boxes.size; ++i) {
+        float eyeToCenterX = boxes.x[i] + boxes.width[i] * 0.5f - eyePos.x;
+        float eyeToCenterY = boxes.y[i] + boxes.height[i] * 0.5f - eyePos.y;
+        float eyeToCenterZ = boxes.z[i] + boxes.depth[i] * 0.5f - eyePos.z;
+        float squareDistance = eyeToCenterX * eyeToCenterX + eyeToCenterY * eyeToCenterY + eyeToCenterZ * eyeToCenterZ;
+        results[i] = squareSize / squareDistance - squareTanAlpha;
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+// on x86 architecture, assume that SSE2 is present
+#include <emmintrin.h>
+
+size_t FrustumCuller::intersect_SSE2(const FrustumCuller& culler, const BoxArrays& boxes, Intersection* results) {
+    const __m128 zero = _mm_setzero_ps();
+    size_t end = boxes.size & ~(size_t)3;
+
+    for (size_t i = 0; i < end; i += 4) {
+        __m128 x = _mm_loadu_ps(&boxes.x[i]);
+        __m128 y = _mm_loadu_ps(&boxes.y[i]);
+        __m128 z = _mm_loadu_ps(&boxes.z[i]);
+        __m128 width = _mm_loadu_ps(&boxes.width[i]);
+        __m128 height = _mm_loadu_ps(&boxes.height[i]);
+        __m128 depth = _mm_loadu_ps(&boxes.depth[i]);
+
+        __m128 outside = zero;
+        __m128 partial = zero;
+        for (auto& plane : culler._planes) {
+            __m128 normalX = _mm_set1_ps(plane.normal[0]);
+            __m128 normalY = _mm_set1_ps(plane.normal[1]);
+            __m128 normalZ = _mm_set1_ps(plane.normal[2]);
+            __m128 d = _mm_set1_ps(plane.d);
+
+            __m128 farX = _mm_add_ps(x, _mm_mul_ps(width, _mm_set1_ps(plane.farOffset[0])));
+            __m128 farY = _mm_add_ps(y, _mm_mul_ps(height, _mm_set1_ps(plane.farOffset[1])));
+            __m128 farZ = _mm_add_ps(z, _mm_mul_ps(depth, _mm_set1_ps(plane.farOffset[2])));
+            __m128 farDistance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(normalX, farX), _mm_mul_ps(normalY, farY)),
+                                                       _mm_mul_ps(normalZ, farZ)), d);
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(farDistance, zero));
+
+            __m128 nearX = _mm_add_ps(x, _mm_mul_ps(width, _mm_set1_ps(plane.nearOffset[0])));
+            __m128 nearY = _mm_add_ps(y, _mm_mul_ps(height, _mm_set1_ps(plane.nearOffset[1])));
+            __m128 nearZ = _mm_add_ps(z, _mm_mul_ps(depth, _mm_set1_ps(plane.nearOffset[2])));
+            __m128 nearDistance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(normalX, nearX), _mm_mul_ps(normalY, nearY)),
+                                                        _mm_mul_ps(normalZ, nearZ)), d);
+            partial = _mm_or_ps(partial, _mm_cmplt_ps(nearDistance, zero));
+        }
+
+        int outsideMask = _mm_movemask_ps(outside);
+        int partialMask = _mm_movemask_ps(partial);
+        for (int j = 0; j < 4; ++j) {
+            results[i + j] = (outsideMask & (1 << j)) ? Outside : ((partialMask & (1 << j)) ? Intersect : Inside);
+        }
+    }
+    return end;
+}
+
+size_t FrustumCuller::testSolidAngles_SSE2(const BoxArrays& boxes, const glm::vec3& eyePos, float size, float squareTanAlpha,
+                                           float* results) {
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 eyeX = _mm_set1_ps(eyePos.x);
+    const __m128 eyeY = _mm_set1_ps(eyePos.y);
+    const __m128 eyeZ = _mm_set1_ps(eyePos.z);
+    const __m128 squareSize = _mm_set1_ps(size * size);
+    const __m128 limit = _mm_set1_ps(squareTanAlpha);
+    size_t end = boxes.size & ~(size_t)3;
+
+    for (size_t i = 0; i < end; i += 4) {
+        __m128 eyeToCenterX = _mm_sub_ps(_mm_add_ps(_mm_loadu_ps(&boxes.x[i]), _mm_mul_ps(_mm_loadu_ps(&boxes.width[i]), half)), eyeX);
+        __m128 eyeToCenterY = _mm_sub_ps(_mm_add_ps(_mm_loadu_ps(&boxes.y[i]), _mm_mul_ps(_mm_loadu_ps(&boxes.height[i]), half)), eyeY);
+        __m128 eyeToCenterZ = _mm_sub_ps(_mm_add_ps(_mm_loadu_ps(&boxes.z[i]), _mm_mul_ps(_mm_loadu_ps(&boxes.depth[i]), half)), eyeZ);
+        __m128 squareDistance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(eyeToCenterX, eyeToCenterX), _mm_mul_ps(eyeToCenterY, eyeToCenterY)),
+                                           _mm_mul_ps(eyeToCenterZ, eyeToCenterZ));
+        _mm_storeu_ps(&results[i], _mm_sub_ps(_mm_div_ps(squareSize, squareDistance), limit));
+    }
+    return end;
+}
+
+//
+// Runtime CPU dispatch
+//
+
+#include <CPUDetect.h>
+
+void FrustumCuller::intersect(const BoxArrays& boxes, Intersection* results) const {
+    static auto f = cpuSupportsAVX2() ? &FrustumCuller::intersect_AVX2 : &FrustumCuller::intersect_SSE2;
+    size_t begin = (*f)(*this, boxes, results);    // dispatch
+    intersect_ref(*this, boxes, begin, results);
+}
+
+void FrustumCuller::testSolidAngles(const BoxArrays& boxes, const glm::vec3& eyePos, float size, float squareTanAlpha,
+                                    float* results) {
+    static auto f = cpuSupportsAVX2() ? &FrustumCuller::testSolidAngles_AVX2 : &FrustumCuller::testSolidAngles_SSE2;
+    size_t begin = (*f)(boxes, eyePos, size, squareTanAlpha, results);  // dispatch
+    testSolidAngles_ref(boxes, eyePos, size, squareTanAlpha, begin, results);
+}
+
+#else
+
+void FrustumCuller::intersect(const BoxArrays& boxes, Intersection* results) const {
+    intersect_ref(*this, boxes, 0, results);
+}
+
+void FrustumCuller::testSolidAngles(const BoxArrays& boxes, const glm::vec3& eyePos, float size, float squareTanAlpha,
+                                    float* results) {
+    testSolidAngles_ref(boxes, eyePos, size, squareTanAlpha, 0, results);
+}
+
+#endif
@@ -0,0 +1,106 @@
+//
+//  FrustumCuller.h
+//  render/src/render
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_FrustumCuller_h
+#define hifi_render_FrustumCuller_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AABox.h>
+#include <ViewFrustum.h>
+
+class FrustumCullerTests;
+
+namespace render {
+
+// Axis aligned boxes, with each coordinate of their corners and dimensions in an array of its own
+// so that they can be tested several at a time
+struct BoxArrays {
+    const float* x;
+    const float* y;
+    const float* z;
+    const float* width;
+    const float* height;
+    const float* depth;
+    size_t size;
+};
+
+// Boxes gathered to be culled in one batch
+class BoxBatch {
+public:
+    void clear();
+    void reserve(size_t size);
+    void push_back(const glm::vec3& corner, const glm::vec3& dimensions);
+    void push_back(const AABox& box) { push_back(box.getCorner(), box.getScale()); }
+
+    size_t size() const { return _x.size(); }
+    BoxArrays getArrays() const;
+
+private:
+    std::vector<float> _x, _y, _z;
+    std::vector<float> _width, _height, _depth;
+};
+
+// Tests boxes against the planes of a frustum, 8 at a time with AVX2 or 4 with SSE2 when the cpu has them
+class FrustumCuller {
+    friend class ::FrustumCullerTests;
+public:
+    enum Intersection : uint8_t {
+        Outside = 0,
+        Intersect,
+        Inside,
+    };
+
+    FrustumCuller() {}
+    // planes as (normal, d), with the normals pointing inside
+    FrustumCuller(const glm::vec4 planes[ViewFrustum::NUM_PLANES]);
+    FrustumCuller(const ViewFrustum& frustum);
+
+    // the intersection of each box with the frustum (as Octree::Location::intersectCell)
+    void intersect(const BoxArrays& boxes, Intersection* results) const;
+
+    // how far the solid angle of each box, seen from the eye as a sphere of the given size at the box center, is over
+    // the limit; negative when under it (as Octree::FrustumSelector::testSolidAngle)
+    static void testSolidAngles(const BoxArrays& boxes, const glm::vec3& eyePos, float size, float squareTanAlpha,
+                                float* results);
+
+private:
+    // the SIMD versions return how many boxes they tested, a multiple of their batch size,
+    // and the reference versions test the rest from there
+    static void intersect_ref(const FrustumCuller& culler, const BoxArrays& boxes, size_t begin, Intersection* results);
+    static size_t intersect_SSE2(const FrustumCuller& culler, const BoxArrays& boxes, Intersection* results);
+    static size_t intersect_AVX2(const FrustumCuller& culler, const BoxArrays& boxes, Intersection* results);
+
+    static void testSolidAngles_ref(const BoxArrays& boxes, const glm::vec3& eyePos, float size, float squareTanAlpha,
+                                    size_t begin, float* results);
+    static size_t testSolidAngles_SSE2(const BoxArrays& boxes, const glm::vec3& eyePos, float size, float squareTanAlpha,
+                                       float* results);
+    static size_t testSolidAngles_AVX2(const BoxArrays& boxes, const glm::vec3& eyePos, float size, float squareTanAlpha,
+                                       float* results);
+
+    struct Plane {
+        float normal[3];
+        float d;
+        // the box corners furthest along and against the normal, as 0 or 1 times each box dimension
+        float farOffset[3];
+        float nearOffset[3];
+    };
+    void setPlane(int index, const glm::vec3& normal, float d);
+
+    Plane _planes[ViewFrustum::NUM_PLANES];
+};
+
+}
+
+#endif // hifi_render_FrustumCuller_h
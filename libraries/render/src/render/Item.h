@@ -47,6 +47,7 @@ public:
         SHADOW_CASTER,    // Item cast shadows
         PICKABLE,         // Item can be picked/selected
         LAYERED,          // Item belongs to one of the layers different from the default layer
+        CONCURRENT,       // Item can be recorded on the render job threads, at the same time as other items
 
         SMALLER,
 
@@ -82,6 +83,7 @@ public:
         Builder& withShadowCaster() { _flags.set(SHADOW_CASTER); return (*this); }
         Builder& withPickable() { _flags.set(PICKABLE); return (*this); }
         Builder& withLayered() { _flags.set(LAYERED); return (*this); }
+        Builder& withConcurrent() { _flags.set(CONCURRENT); return (*this); }
 
         // Convenient standard keys that we will keep on using all over the place
         static Builder opaqueShape() { return Builder().withTypeShape(); }
@@ -117,6 +119,8 @@ public:
     bool isLayered() const { return _flags[LAYERED]; }
     bool isSpatial() const { return !isLayered(); }
 
+    bool isConcurrent() const { return _flags[CONCURRENT]; }
+
     // Probably not public, flags used by the scene
     bool isSmall() const { return _flags[SMALLER]; }
     void setSmaller(bool smaller) { (smaller ? _flags.set(SMALLER) : _flags.reset(SMALLER)); }
@@ -0,0 +1,158 @@
+//
+//  JobSlavePool.cpp
+//  render/src/render
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JobSlavePool.h"
+
+#include <assert.h>
+#include <algorithm>
+
+#include <QDebug>
+
+using namespace render;
+
+void JobSlaveThread::run() {
+    size_t index;
+    const JobSlavePool::JobFunction* runJob;
+    while (_pool.wait(*this, index, runJob)) {
+        (*runJob)(index);
+        _pool.finished(index);
+    }
+}
+
+void JobSlavePool::run(const Dependencies& dependencies, const JobFunction& runJob) {
+    Lock lock(_mutex);
+    assert(_numRemaining == 0 && _ready.empty());
+
+    size_t numJobs = dependencies.size();
+    _runJob = &runJob;
+    _dependents.assign(numJobs, std::vector<size_t>());
+    _numWaiting.assign(numJobs, 0);
+    for (size_t index = 0; index < numJobs; ++index) {
+        for (auto dependency : dependencies[index]) {
+            assert(dependency < index);
+            _dependents[dependency].push_back(index);
+        }
+        _numWaiting[index] = dependencies[index].size();
+        if (_numWaiting[index] == 0) {
+            _ready.push_back(index);
+        }
+    }
+    _numRemaining = numJobs;
+    _slaveCondition.notify_all();
+
+    while (_numRemaining > 0) {
+        if (_ready.empty()) {
+            _runCondition.wait(lock);
+            continue;
+        }
+
+        size_t index = _ready.front();
+        _ready.pop_front();
+        lock.unlock();
+        runJob(index);
+        finished(index);
+        lock.lock();
+    }
+
+    _runJob = nullptr;
+}
+
+bool JobSlavePool::wait(JobSlaveThread& slave, size_t& index, const JobFunction*& runJob) {
+    Lock lock(_mutex);
+    _slaveCondition.wait(lock, [&] {
+        return slave._stop || !_ready.empty();
+    });
+
+    if (slave._stop) {
+        return false;
+    }
+
+    index = _ready.front();
+    _ready.pop_front();
+    runJob = _runJob;
+    return true;
+}
+
+void JobSlavePool::finished(size_t index) {
+    size_t numReady = 0;
+    {
+        Lock lock(_mutex);
+        --_numRemaining;
+        for (auto dependent : _dependents[index]) {
+            if (--_numWaiting[dependent] == 0) {
+                _ready.push_back(dependent);
+                ++numReady;
+            }
+        }
+    }
+
+    if (numReady > 1) {
+        _slaveCondition.notify_all();
+    } else if (numReady == 1) {
+        _slaveCondition.notify_one();
+    }
+    _runCondition.notify_one();
+}
+
+void JobSlavePool::setNumThreads(int numThreads) {
+    // clamp to allowed size
+    {
+        int maxThreads = QThread::idealThreadCount();
+        if (maxThreads == -1) {
+            // idealThreadCount returns -1 if cores cannot be detected
+            static const int MAX_THREADS_IF_UNKNOWN = 4;
+            maxThreads = MAX_THREADS_IF_UNKNOWN;
+        }
+
+        int clampedThreads = std::min(std::max(1, numThreads), maxThreads);
+        if (clampedThreads != numThreads) {
+            qWarning("%s: clamped to %d (was %d)", __FUNCTION__, clampedThreads, numThreads);
+            numThreads = clampedThreads;
+        }
+    }
+
+    resize(numThreads);
+}
+
+void JobSlavePool::resize(int numThreads) {
+    assert(_numThreads == (int)_slaves.size());
+
+    if (numThreads > _numThreads) {
+        // start new slaves
+        for (int i = 0; i < numThreads - _numThreads; ++i) {
+            auto slave = new JobSlaveThread(*this);
+            slave->setObjectName("Render Job Slave");
+            slave->start();
+            _slaves.emplace_back(slave);
+        }
+    } else if (numThreads < _numThreads) {
+        auto extraBegin = _slaves.begin() + numThreads;
+
+        // mark slaves to stop...
+        {
+            Lock lock(_mutex);
+            for (auto slave = extraBegin; slave != _slaves.end(); ++slave) {
+                (*slave)->_stop = true;
+            }
+        }
+        _slaveCondition.notify_all();
+
+        // ...wait for them to finish...
+        for (auto slave = extraBegin; slave != _slaves.end(); ++slave) {
+            (*slave)->wait();
+        }
+
+        // ...and erase them
+        _slaves.erase(extraBegin, _slaves.end());
+    }
+
+    _numThreads = numThreads;
+    assert(_numThreads == (int)_slaves.size());
+}
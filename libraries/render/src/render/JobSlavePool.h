@@ -0,0 +1,89 @@
+//
+//  JobSlavePool.h
+//  render/src/render
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_JobSlavePool_h
+#define hifi_render_JobSlavePool_h
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QThread>
+
+namespace render {
+
+class JobSlavePool;
+
+class JobSlaveThread : public QThread {
+public:
+    JobSlaveThread(JobSlavePool& pool) : _pool(pool) {}
+
+    void run() override final;
+
+private:
+    friend class JobSlavePool;
+
+    JobSlavePool& _pool;
+    bool _stop { false }; // guarded by the pool's _mutex
+};
+
+// Slave pool for the concurrent jobs of a task
+//   The jobs of a run are given with the jobs each one depends on, and each is started as soon as those are done.
+//   The thread calling run() (the render thread) runs jobs too rather than wait idle, and run() returns once they
+//   are all done. Runs are made one at a time, from the thread owning the pool.
+class JobSlavePool {
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+    using ConditionVariable = std::condition_variable;
+
+public:
+    using JobFunction = std::function<void(size_t index)>;
+    using Dependencies = std::vector<std::vector<size_t>>; // for each job, the indices of the jobs it depends on
+
+    JobSlavePool(int numThreads = QThread::idealThreadCount()) { setNumThreads(numThreads); }
+    ~JobSlavePool() { resize(0); }
+
+    // run jobs [0, dependencies.size()), each after the jobs it depends on, which must come before it
+    void run(const Dependencies& dependencies, const JobFunction& runJob);
+
+    void setNumThreads(int numThreads);
+    int numThreads() const { return _numThreads; }
+
+private:
+    friend class JobSlaveThread;
+
+    // called by the slaves, wait returns false when the slave should stop
+    bool wait(JobSlaveThread& slave, size_t& index, const JobFunction*& runJob);
+    void finished(size_t index);
+
+    void resize(int numThreads);
+
+    std::vector<std::unique_ptr<JobSlaveThread>> _slaves;
+    int _numThreads { 0 };
+
+    // synchronization state
+    Mutex _mutex;
+    ConditionVariable _slaveCondition; // jobs are ready, or slaves are stopping
+    ConditionVariable _runCondition; // jobs are ready, or the run is done
+
+    // the run in progress, guarded by _mutex
+    const JobFunction* _runJob { nullptr };
+    Dependencies _dependents;
+    std::vector<size_t> _numWaiting; // for each job, the jobs it depends on that are not done
+    std::deque<size_t> _ready;
+    size_t _numRemaining { 0 };
+};
+
+}
+
+#endif // hifi_render_JobSlavePool_h
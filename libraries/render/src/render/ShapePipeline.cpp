@@ -105,6 +105,7 @@ const ShapePipelinePointer ShapePlumber::pickPipeline(RenderArgs* args, const Ke
     const auto& pipelineIterator = _pipelineMap.find(key);
     if (pipelineIterator == _pipelineMap.end()) {
         // The first time we can't find a pipeline, we should log it
+        std::lock_guard<std::mutex> lock(_missingKeysMutex);
         if (_missingKeys.find(key) == _missingKeys.end()) {
             _missingKeys.insert(key);
             qCDebug(renderlogging) << "Couldn't find a pipeline for" << key;
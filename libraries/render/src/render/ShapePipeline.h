@@ -12,6 +12,7 @@
 #ifndef hifi_render_ShapePipeline_h
 #define hifi_render_ShapePipeline_h
 
+#include <mutex>
 #include <unordered_set>
 
 #include <gpu/Batch.h>
@@ -281,6 +282,7 @@ protected:
 
 private:
     mutable std::unordered_set<Key, Key::Hash, Key::KeyEqual> _missingKeys;
+    mutable std::mutex _missingKeysMutex; // pipelines are picked from the job threads too
 };
 
 using ShapePlumberPointer = std::shared_ptr<ShapePlumber>;
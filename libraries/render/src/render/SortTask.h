@@ -20,6 +20,7 @@ namespace render {
     class PipelineSortShapes {
     public:
         using JobModel = Job::ModelIO<PipelineSortShapes, ItemBounds, ShapeBounds>;
+        bool isConcurrent() const { return true; }
         void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemBounds& inItems, ShapeBounds& outShapes);
     };
 
@@ -30,6 +31,7 @@ namespace render {
         bool _frontToBack;
         DepthSortShapes(bool frontToBack = true) : _frontToBack(frontToBack) {}
 
+        bool isConcurrent() const { return true; }
         void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ShapeBounds& inShapes, ShapeBounds& outShapes);
     };
 
@@ -40,6 +42,7 @@ namespace render {
         bool _frontToBack;
         DepthSortItems(bool frontToBack = true) : _frontToBack(frontToBack) {}
 
+        bool isConcurrent() const { return true; }
         void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemBounds& inItems, ItemBounds& outItems);
     };
 }
@@ -419,21 +419,13 @@ ItemSpatialTree::Index ItemSpatialTree::resetItem(Index oldCell, const ItemKey&
 }
 
 int Octree::select(CellSelection& selection, const FrustumSelector& selector) const {
-
-    Index cellID = ROOT_CELL;
-    auto cell = getConcreteCell(cellID);
     int numSelectedsIn = (int)selection.size();
 
     // Always include the root cell partially containing potentially outer objects
-    selectCellBrick(cellID, selection, false);
+    selectCellBrick(ROOT_CELL, selection, false);
 
     // then traverse deeper
-    for (int i = 0; i < NUM_OCTANTS; i++) {
-        Index subCellID = cell.child((Link)i);
-        if (subCellID != INVALID_CELL) {
-            selectTraverse(subCellID, selection, selector);
-        }
-    }
+    selectTraverseChildren(ROOT_CELL, selection, selector);
 
     return (int)selection.size() - numSelectedsIn;
 }
@@ -519,7 +511,6 @@ int Octree::selectTraverse(Index cellID, CellSelection& selection, const Frustum
             // Cell is partially in
 
             // Test for lod
-            auto cellLocation = cell.getlocation();
             float lod = selector.testSolidAngle(cellLocation.getCenter(), Octree::getCoordSubcellWidth(cellLocation.depth));
             if (lod < 0.0f) {
                 return 0;
@@ -530,12 +521,7 @@ int Octree::selectTraverse(Index cellID, CellSelection& selection, const Frustum
             selectCellBrick(cellID, selection, false);
 
             // then traverse deeper
-            for (int i = 0; i < NUM_OCTANTS; i++) {
-                Index subCellID = cell.child((Link)i);
-                if (subCellID != INVALID_CELL) {
-                    selectTraverse(subCellID, selection, selector);
-                }
-            }
+            selectTraverseChildren(cellID, selection, selector);
         }
     }
 
@@ -557,11 +543,98 @@ int  Octree::selectBranch(Index cellID, CellSelection& selection, const FrustumS
     selectCellBrick(cellID, selection, true);
 
     // then traverse deeper
-    for (int i = 0; i < NUM_OCTANTS; i++) {
-        Index subCellID = cell.child((Link)i);
-        if (subCellID != INVALID_CELL) {
-            selectBranch(subCellID, selection, selector);
+    selectBranchChildren(cellID, selection, selector);
+
+    return (int) selection.size() - numSelectedsIn;
+}
+
+namespace {
+    // The children of a cell as boxes, padded with copies of the first one to fill a batch of all the octants
+    struct CellChildren {
+        Octree::Index ids[Octree::NUM_OCTANTS];
+        int numChildren { 0 };
+        float x[Octree::NUM_OCTANTS];
+        float y[Octree::NUM_OCTANTS];
+        float z[Octree::NUM_OCTANTS];
+        float width[Octree::NUM_OCTANTS];
+        float height[Octree::NUM_OCTANTS];
+        float depth[Octree::NUM_OCTANTS];
+        float childSize { 0.0f };
+
+        CellChildren(const Octree& octree, const Octree::Cell& cell) {
+            for (int i = 0; i < Octree::NUM_OCTANTS; i++) {
+                Octree::Index childID = cell.child((Octree::Link)i);
+                if (childID != Octree::INVALID_CELL) {
+                    const auto& location = octree.getConcreteCell(childID).getlocation();
+                    float cellSize = Octree::getInvDepthDimension(location.depth);
+                    ids[numChildren] = childID;
+                    x[numChildren] = (float)location.pos.x * cellSize;
+                    y[numChildren] = (float)location.pos.y * cellSize;
+                    z[numChildren] = (float)location.pos.z * cellSize;
+                    width[numChildren] = height[numChildren] = depth[numChildren] = cellSize;
+                    childSize = Octree::getCoordSubcellWidth(location.depth);
+                    numChildren++;
+                }
+            }
+            for (int i = numChildren; i < Octree::NUM_OCTANTS && numChildren > 0; i++) {
+                x[i] = x[0];
+                y[i] = y[0];
+                z[i] = z[0];
+                width[i] = height[i] = depth[i] = width[0];
+            }
         }
+
+        BoxArrays getArrays() const { return BoxArrays { x, y, z, width, height, depth, Octree::NUM_OCTANTS }; }
+    };
+}
+
+int Octree::selectTraverseChildren(Index cellID, CellSelection& selection, const FrustumSelector& selector) const {
+    int numSelectedsIn = (int) selection.size();
+    CellChildren children(*this, getConcreteCell(cellID));
+    if (children.numChildren == 0) {
+        return 0;
+    }
+
+    FrustumCuller::Intersection intersections[NUM_OCTANTS];
+    float lods[NUM_OCTANTS];
+    selector.culler.intersect(children.getArrays(), intersections);
+    FrustumCuller::testSolidAngles(children.getArrays(), selector.eyePos, children.childSize, selector.squareTanAlpha, lods);
+
+    for (int i = 0; i < children.numChildren; i++) {
+        // cells outside or too small are not traversed, the rest are selected like selectTraverse does
+        if (intersections[i] == FrustumCuller::Outside || lods[i] < 0.0f) {
+            continue;
+        }
+        Index childID = children.ids[i];
+        if (intersections[i] == FrustumCuller::Inside) {
+            selectCellBrick(childID, selection, true);
+            selectBranchChildren(childID, selection, selector);
+        } else {
+            selectCellBrick(childID, selection, false);
+            selectTraverseChildren(childID, selection, selector);
+        }
+    }
+
+    return (int) selection.size() - numSelectedsIn;
+}
+
+int Octree::selectBranchChildren(Index cellID, CellSelection& selection, const FrustumSelector& selector) const {
+    int numSelectedsIn = (int) selection.size();
+    CellChildren children(*this, getConcreteCell(cellID));
+    if (children.numChildren == 0) {
+        return 0;
+    }
+
+    float lods[NUM_OCTANTS];
+    FrustumCuller::testSolidAngles(children.getArrays(), selector.eyePos, children.childSize, selector.squareTanAlpha, lods);
+
+    for (int i = 0; i < children.numChildren; i++) {
+        if (lods[i] < 0.0f) {
+            continue;
+        }
+        Index childID = children.ids[i];
+        selectCellBrick(childID, selection, true);
+        selectBranchChildren(childID, selection, selector);
     }
 
     return (int) selection.size() - numSelectedsIn;
@@ -590,6 +663,8 @@ int ItemSpatialTree::selectCells(CellSelection& selection, const ViewFrustum& fr
         selector.frustum[i] = Coord4f(octPlane.getNormal(), octPlane.getDCoefficient());
     }
 
+    selector.culler = FrustumCuller(selector.frustum);
+
     selector.eyePos = evalCoordf(frustum.getPosition(), ROOT_DEPTH);
     selector.setAngle(glm::radians(lodAngle));
 
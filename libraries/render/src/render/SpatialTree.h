@@ -22,6 +22,8 @@
 #include <glm/gtx/bit.hpp>
 #include <AABox.h>
 
+#include "FrustumCuller.h"
+
 // maybe we could avoid the Item inclusion here for the OCtree class?
 #include "Item.h"
 
@@ -312,6 +314,7 @@ namespace render {
         class FrustumSelector {
         public:
             Coord4f frustum[6];
+            FrustumCuller culler; // of the frustum planes, to test the children of a cell together
             Coord3f eyePos;
             float   angle;
             float   squareTanAlpha;
@@ -336,6 +339,10 @@ namespace render {
         int selectBranch(Index cellID, CellSelection& selection, const FrustumSelector& selector) const;
         int selectCellBrick(Index cellID, CellSelection& selection, bool inside) const;
 
+        // traverse or select the branches of the children of a cell, testing them in one batch
+        int selectTraverseChildren(Index cellID, CellSelection& selection, const FrustumSelector& selector) const;
+        int selectBranchChildren(Index cellID, CellSelection& selection, const FrustumSelector& selector) const;
+
 
         int getNumAllocatedCells() const { return (int)_cells.size(); }
         int getNumFreeCells() const { return (int)_freeCells.size(); }
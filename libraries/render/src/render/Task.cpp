@@ -9,10 +9,14 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
 #include <QtCore/QThread>
 
 #include "Task.h"
 
+#include "JobSlavePool.h"
+
 using namespace render;
 
 void TaskConfig::refresh() {
@@ -24,3 +28,68 @@ void TaskConfig::refresh() {
     _task->configure(*this);
 }
 
+
+void Task::updateDependencies() {
+    // a job depends on the earlier jobs with an output that is (or holds) a varying of its input
+    std::vector<VaryingIDs> outputIDs(_jobs.size());
+    _dependencies.assign(_jobs.size(), std::vector<size_t>());
+    for (size_t index = 0; index < _jobs.size(); ++index) {
+        VaryingIDs inputIDs;
+        _jobs[index].getInput().collectIDs(inputIDs);
+        for (size_t earlier = 0; earlier < index; ++earlier) {
+            auto& earlierIDs = outputIDs[earlier];
+            if (std::any_of(earlierIDs.begin(), earlierIDs.end(), [&](const void* id) { return inputIDs.count(id) > 0; })) {
+                _dependencies[index].push_back(earlier);
+            }
+        }
+        _jobs[index].getOutput().collectIDs(outputIDs[index]);
+    }
+}
+
+void Task::runJobs(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
+    JobSlavePool* jobPool = renderContext->jobPool;
+    if (!jobPool) {
+        for (auto& job : _jobs) {
+            job.run(sceneContext, renderContext);
+        }
+        return;
+    }
+
+    if (_dependencies.size() != _jobs.size()) {
+        updateDependencies();
+    }
+
+    // The jobs that aren't concurrent run on this thread, each after all the jobs before it.
+    // Between them, each run of concurrent jobs goes to the pool, where each job starts as soon as the jobs it
+    // depends on are done. They get their own render context, as the job config is set in it while they run.
+    size_t begin = 0;
+    while (begin < _jobs.size()) {
+        size_t end = begin;
+        while (end < _jobs.size() && _jobs[end].isConcurrent()) {
+            ++end;
+        }
+
+        if (end - begin < 2) {
+            _jobs[begin].run(sceneContext, renderContext);
+            ++begin;
+            continue;
+        }
+
+        JobSlavePool::Dependencies dependencies(end - begin);
+        for (size_t index = begin; index < end; ++index) {
+            for (auto dependency : _dependencies[index]) {
+                if (dependency >= begin) {
+                    dependencies[index - begin].push_back(dependency - begin);
+                }
+            }
+        }
+
+        jobPool->run(dependencies, [&](size_t index) {
+            auto jobContext = std::make_shared<RenderContext>(*renderContext);
+            // the pool runs one set of jobs at a time, so these ones can't use it
+            jobContext->jobPool = nullptr;
+            _jobs[begin + index].run(sceneContext, jobContext);
+        });
+        begin = end;
+    }
+}
@@ -11,7 +11,9 @@
 
 #ifndef hifi_render_Task_h
 #define hifi_render_Task_h
+#include <array>
 #include <tuple>
+#include <unordered_set>
 
 #include <QtCore/qobject.h>
 
@@ -32,6 +34,42 @@ namespace render {
 
 class Varying;
 
+// The identities of varyings, shared by all the copies of a varying, used to find the jobs it connects
+using VaryingIDs = std::unordered_set<const void*>;
+
+// Collect the ids of the varyings held by some data, in a varying set or array
+class NoVaryings {
+public:
+    template <class T> NoVaryings(const T&) {}
+};
+inline void collectVaryingIDs(NoVaryings, VaryingIDs& ids) {}
+template <class T> typename std::enable_if<std::is_same<T, Varying>::value>::type
+collectVaryingIDs(const T& varying, VaryingIDs& ids) {
+    varying.collectIDs(ids);
+}
+template <class T0, class T1> void collectVaryingIDs(const std::pair<T0, T1>& pair, VaryingIDs& ids);
+template <class... Ts> void collectVaryingIDs(const std::tuple<Ts...>& tuple, VaryingIDs& ids);
+template <class T, size_t N> void collectVaryingIDs(const std::array<T, N>& array, VaryingIDs& ids);
+
+template <class T0, class T1> void collectVaryingIDs(const std::pair<T0, T1>& pair, VaryingIDs& ids) {
+    collectVaryingIDs(pair.first, ids);
+    collectVaryingIDs(pair.second, ids);
+}
+template <size_t I, class... Ts> typename std::enable_if<(I == sizeof...(Ts))>::type
+collectTupleVaryingIDs(const std::tuple<Ts...>& tuple, VaryingIDs& ids) {}
+template <size_t I, class... Ts> typename std::enable_if<(I < sizeof...(Ts))>::type
+collectTupleVaryingIDs(const std::tuple<Ts...>& tuple, VaryingIDs& ids) {
+    collectVaryingIDs(std::get<I>(tuple), ids);
+    collectTupleVaryingIDs<I + 1>(tuple, ids);
+}
+template <class... Ts> void collectVaryingIDs(const std::tuple<Ts...>& tuple, VaryingIDs& ids) {
+    collectTupleVaryingIDs<0>(tuple, ids);
+}
+template <class T, size_t N> void collectVaryingIDs(const std::array<T, N>& array, VaryingIDs& ids) {
+    for (auto& element : array) {
+        collectVaryingIDs(element, ids);
+    }
+}
 
 // A varying piece of data, to be used as Job/Task I/O
 // TODO: Task IO
@@ -57,6 +95,14 @@ public:
     template <class T> Varying getN (uint8_t index) const { return get<T>()[index]; }
     template <class T> Varying editN (uint8_t index) { return edit<T>()[index]; }
 
+    // collect the id of this varying and of the varyings it holds
+    void collectIDs(VaryingIDs& ids) const {
+        if (_concept) {
+            ids.insert(_concept.get());
+            _concept->collectChildIDs(ids);
+        }
+    }
+
 protected:
     class Concept {
     public:
@@ -64,6 +110,8 @@ protected:
 
         virtual Varying operator[] (uint8_t index) const = 0;
         virtual uint8_t length() const = 0;
+
+        virtual void collectChildIDs(VaryingIDs& ids) const = 0;
     };
     template <class T> class Model : public Concept {
     public:
@@ -78,6 +126,8 @@ protected:
         }
         virtual uint8_t length() const override { return 0; }
 
+        virtual void collectChildIDs(VaryingIDs& ids) const override { collectVaryingIDs(_data, ids); }
+
         Data _data;
     };
 
@@ -457,6 +507,14 @@ template <class T, class O> void jobRun(T& data, const SceneContextPointer& scen
 template <class T, class I, class O> void jobRun(T& data, const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const I& input, O& output) {
     data.run(sceneContext, renderContext, input, output);
 }
+// A job runs on the render thread, unless it has an isConcurrent() saying that it only reads its input and the scene
+// (and only writes its output and config), so it can run on a job thread alongside the jobs it is not connected to
+template <class T> auto jobIsConcurrent(const T& data, int) -> decltype(data.isConcurrent()) {
+    return data.isConcurrent();
+}
+template <class T> bool jobIsConcurrent(const T&, long) {
+    return false;
+}
 
 class GPUJobConfig : public JobConfig {
     Q_OBJECT
@@ -516,6 +574,8 @@ public:
         virtual QConfigPointer& getConfiguration() { return _config; }
         virtual void applyConfiguration() = 0;
 
+        virtual bool isConcurrent() const { return false; }
+
         virtual void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) = 0;
 
     protected:
@@ -550,6 +610,8 @@ public:
             jobConfigure(_data, *std::static_pointer_cast<C>(_config));
         }
 
+        bool isConcurrent() const override { return jobIsConcurrent(_data, 0); }
+
         void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) override {
             renderContext->jobConfig = std::static_pointer_cast<Config>(_config);
             if (renderContext->jobConfig->alwaysEnabled || renderContext->jobConfig->isEnabled()) {
@@ -568,6 +630,7 @@ public:
     const Varying getOutput() const { return _concept->getOutput(); }
     QConfigPointer& getConfiguration() const { return _concept->getConfiguration(); }
     void applyConfiguration() { return _concept->applyConfiguration(); }
+    bool isConcurrent() const { return _concept->isConcurrent(); }
 
     template <class T> T& edit() {
         auto concept = std::static_pointer_cast<typename T::JobModel>(_concept);
@@ -623,9 +686,7 @@ public:
         void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) override {
             auto config = std::static_pointer_cast<Config>(_config);
             if (config->alwaysEnabled || config->enabled) {
-                for (auto job : _data._jobs) {
-                    job.run(sceneContext, renderContext);
-                }
+                _data.runJobs(sceneContext, renderContext);
             }
         }
     };
@@ -693,17 +754,22 @@ public:
     }
 
     void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
-        for (auto job : _jobs) {
-            job.run(sceneContext, renderContext);
-        }
+        runJobs(sceneContext, renderContext);
     }
 
 protected:
     template <class T, class C> friend class Model;
 
+    // Run the jobs in order, or, given a job pool in the render context, run the concurrent jobs on it
+    void runJobs(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext);
+    void updateDependencies();
+
     QConfigPointer _config;
     Jobs _jobs;
     Varying _output;
+
+    // for each job, the earlier jobs whose output it reads
+    std::vector<std::vector<size_t>> _dependencies;
 };
 
 }
@@ -310,6 +310,8 @@ void ScriptEngine::runDebuggable() {
             return;
         }
 
+        fireTimers();
+
         qint64 now = usecTimestampNow();
         // we check for 'now' in the past in case people set their clock back
         if (_lastUpdate < now) {
@@ -980,7 +982,10 @@ void ScriptEngine::run() {
 
             {
                 PROFILE_RANGE(script, "processEvents-sleep");
+                auto beforeEvents = clock::now();
                 QCoreApplication::processEvents(); // before we sleep again, give events a chance to process
+                fireTimers();
+                _busyTime += std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - beforeEvents).count();
             }
             processedEvents = true;
 
@@ -997,6 +1002,7 @@ void ScriptEngine::run() {
         }
 
         PROFILE_RANGE(script, "ScriptMainLoop");
+        auto frameStart = clock::now();
 
 #ifdef SCRIPT_DELAY_DEBUG
         {
@@ -1023,6 +1029,7 @@ void ScriptEngine::run() {
         if (!processedEvents) {
             PROFILE_RANGE(script, "processEvents");
             QCoreApplication::processEvents();
+            fireTimers();
         }
 
         if (_isFinished) {
@@ -1062,6 +1069,8 @@ void ScriptEngine::run() {
             reportUncaughtException();
             clearExceptions();
         }
+
+        _busyTime += std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - frameStart).count();
     }
 
     scriptInfoMessage("Script Engine stopping:" + getFilename());
@@ -1095,30 +1104,16 @@ void ScriptEngine::run() {
 // NOTE: This is private because it must be called on the same thread that created the timers, which is why
 // we want to only call it in our own run "shutdown" processing.
 void ScriptEngine::stopAllTimers() {
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    while (i.hasNext()) {
-        i.next();
-        QTimer* timer = i.key();
-        stopTimer(timer);
-    }
+    _timers.stopAll();
+    _timerFunctionMap.clear();
 }
 
 void ScriptEngine::stopAllTimersForEntityScript(const EntityItemID& entityID) {
-     // We could maintain a separate map of entityID => QTimer, but someone will have to prove to me that it's worth the complexity. -HRS
-    QVector<QTimer*> toDelete;
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    while (i.hasNext()) {
-        i.next();
-        if (i.value().definingEntityIdentifier != entityID) {
-            continue;
-        }
-        QTimer* timer = i.key();
-        toDelete << timer; // don't delete while we're iterating. save it.
-    }
-    for (auto timer:toDelete) { // now reap 'em
-        stopTimer(timer);
+    std::vector<TimerWheel::TimerID> stopped;
+    _timers.stopAll(entityID, stopped);
+    for (auto timer : stopped) {
+        _timerFunctionMap.remove(timer);
     }
-
 }
 
 void ScriptEngine::stop(bool marshal) {
@@ -1168,7 +1163,14 @@ void ScriptEngine::updateMemoryCost(const qint64& deltaSize) {
     }
 }
 
-void ScriptEngine::timerFired() {
+void ScriptEngine::fireTimers() {
+    // always advance, so the timers started next count from now
+    std::vector<TimerWheel::TimerID> expired;
+    _timers.advance(TimerWheel::Clock::now(), expired);
+    if (expired.empty()) {
+        return;
+    }
+
     {
         auto engine = DependencyManager::get<ScriptEngines>();
         if (!engine || engine->isStopped()) {
@@ -1177,74 +1179,60 @@ void ScriptEngine::timerFired() {
         }
     }
 
-    QTimer* callingTimer = reinterpret_cast<QTimer*>(sender());
-    CallbackData timerData = _timerFunctionMap.value(callingTimer);
-
-    if (!callingTimer->isActive()) {
-        // this timer is done, we can kill it
-        _timerFunctionMap.remove(callingTimer);
-        delete callingTimer;
-    }
-
-    // call the associated JS function, if it exists
-    if (timerData.function.isValid()) {
-        auto preTimer = p_high_resolution_clock::now();
-        callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
-        auto postTimer = p_high_resolution_clock::now();
-        auto elapsed = (postTimer - preTimer);
-        _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+    for (auto timer : expired) {
+        // an earlier callback may have stopped it
+        auto it = _timerFunctionMap.find(timer);
+        if (it == _timerFunctionMap.end()) {
+            continue;
+        }
+        CallbackData timerData = it.value();
+        if (!_timers.isActive(timer)) {
+            // this timer is done, we can forget it
+            _timerFunctionMap.erase(it);
+        }
 
+        // call the associated JS function, if it exists
+        if (timerData.function.isValid()) {
+            auto preTimer = p_high_resolution_clock::now();
+            callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
+            auto postTimer = p_high_resolution_clock::now();
+            auto elapsed = (postTimer - preTimer);
+            _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+        }
     }
 }
 
+int ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
+    // start the timer on the wheel, which the run loop advances, and remember its callback
+    auto timer = _timers.start(intervalMS, isSingleShot, currentEntityIdentifier);
 
-QObject* ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
-    // create the timer, add it to the map, and start it
-    QTimer* newTimer = new QTimer(this);
-    newTimer->setSingleShot(isSingleShot);
-
-    // The default timer type is not very accurate below about 200ms http://doc.qt.io/qt-5/qt.html#TimerType-enum
-    static const int MIN_TIMEOUT_FOR_COARSE_TIMER = 200;
-    if (intervalMS < MIN_TIMEOUT_FOR_COARSE_TIMER) {
-        newTimer->setTimerType(Qt::PreciseTimer);
-    }
-
-    connect(newTimer, &QTimer::timeout, this, &ScriptEngine::timerFired);
-
-    // make sure the timer stops when the script does
-    connect(this, &ScriptEngine::scriptEnding, newTimer, &QTimer::stop);
+    CallbackData timerData = { function, currentEntityIdentifier, currentSandboxURL };
+    _timerFunctionMap.insert(timer, timerData);
 
-    CallbackData timerData = {function, currentEntityIdentifier, currentSandboxURL };
-    _timerFunctionMap.insert(newTimer, timerData);
-
-    newTimer->start(intervalMS);
-    return newTimer;
+    return timer;
 }
 
-QObject* ScriptEngine::setInterval(const QScriptValue& function, int intervalMS) {
+int ScriptEngine::setInterval(const QScriptValue& function, int intervalMS) {
     if (DependencyManager::get<ScriptEngines>()->isStopped()) {
         scriptWarningMessage("Script.setInterval() while shutting down is ignored... parent script:" + getFilename());
-        return NULL; // bail early
+        return 0; // bail early
     }
 
     return setupTimerWithInterval(function, intervalMS, false);
 }
 
-QObject* ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
+int ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
     if (DependencyManager::get<ScriptEngines>()->isStopped()) {
         scriptWarningMessage("Script.setTimeout() while shutting down is ignored... parent script:" + getFilename());
-        return NULL; // bail early
+        return 0; // bail early
     }
 
     return setupTimerWithInterval(function, timeoutMS, true);
 }
 
-void ScriptEngine::stopTimer(QTimer *timer) {
-    if (_timerFunctionMap.contains(timer)) {
-        timer->stop();
-        _timerFunctionMap.remove(timer);
-        delete timer;
-    }
+void ScriptEngine::stopTimer(int timer) {
+    _timers.stop(timer);
+    _timerFunctionMap.remove(timer);
 }
 
 QUrl ScriptEngine::resolvePath(const QString& include) const {
@@ -12,6 +12,8 @@
 #ifndef hifi_ScriptEngine_h
 #define hifi_ScriptEngine_h
 
+#include <atomic>
+#include <chrono>
 #include <vector>
 
 #include <QtCore/QObject>
@@ -39,6 +41,7 @@
 #include "Mat4.h"
 #include "ScriptCache.h"
 #include "ScriptUUID.h"
+#include "TimerWheel.h"
 #include "Vec3.h"
 
 class QScriptEngineDebugger;
@@ -158,10 +161,10 @@ public:
     Q_INVOKABLE void include(const QStringList& includeFiles, QScriptValue callback = QScriptValue());
     Q_INVOKABLE void include(const QString& includeFile, QScriptValue callback = QScriptValue());
 
-    Q_INVOKABLE QObject* setInterval(const QScriptValue& function, int intervalMS);
-    Q_INVOKABLE QObject* setTimeout(const QScriptValue& function, int timeoutMS);
-    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
-    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE int setInterval(const QScriptValue& function, int intervalMS);
+    Q_INVOKABLE int setTimeout(const QScriptValue& function, int timeoutMS);
+    Q_INVOKABLE void clearInterval(int timer) { stopTimer(timer); }
+    Q_INVOKABLE void clearTimeout(int timer) { stopTimer(timer); }
     Q_INVOKABLE void print(const QString& message);
     Q_INVOKABLE QUrl resolvePath(const QString& path) const;
     Q_INVOKABLE QUrl resourcesPath() const;
@@ -211,6 +214,9 @@ public:
     int getNumRunningEntityScripts() const;
     bool getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails &details) const;
 
+    // Time the engine thread has spent running the script and handling its events, rather than sleeping, since it started
+    std::chrono::microseconds getBusyTime() const { return std::chrono::microseconds(_busyTime.load()); }
+
 public slots:
     int evaluatePending() const { return _evaluatesPending; }
     void callAnimationStateHandler(QScriptValue callback, AnimVariantMap parameters, QStringList names, bool useNames, AnimVariantResultHandler resultHandler);
@@ -241,7 +247,7 @@ protected:
     void init();
 
     QString reportUncaughtException(const QString& overrideFileName = QString());
-    void timerFired();
+    void fireTimers();
     void stopAllTimers();
     void stopAllTimersForEntityScript(const EntityItemID& entityID);
     void refreshFileScript(const EntityItemID& entityID);
@@ -249,8 +255,8 @@ protected:
     void setEntityScriptDetails(const EntityItemID& entityID, const EntityScriptDetails& details);
     void setParentURL(const QString& parentURL) { _parentURL = parentURL; }
 
-    QObject* setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
-    void stopTimer(QTimer* timer);
+    int setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
+    void stopTimer(int timer);
 
     QHash<EntityItemID, RegisteredEventHandlers> _registeredHandlers;
     void forwardHandlerCall(const EntityItemID& entityID, const QString& eventName, QScriptValueList eventHanderArgs);
@@ -270,7 +276,8 @@ protected:
     std::atomic<bool> _isStopping { false };
     int _evaluatesPending { 0 };
     bool _isInitialized { false };
-    QHash<QTimer*, CallbackData> _timerFunctionMap;
+    TimerWheel _timers; // fired from the run loop
+    QHash<TimerWheel::TimerID, CallbackData> _timerFunctionMap;
     QSet<QUrl> _includedURLs;
     QHash<EntityItemID, EntityScriptDetails> _entityScripts;
     bool _isThreaded { false };
@@ -295,6 +302,7 @@ protected:
     std::recursive_mutex _lock;
 
     std::chrono::microseconds _totalTimerExecution { 0 };
+    std::atomic<int64_t> _busyTime { 0 }; // usecs, read from other threads
 };
 
 #endif // hifi_ScriptEngine_h
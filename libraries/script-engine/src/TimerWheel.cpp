@@ -0,0 +1,194 @@
+//
+//  TimerWheel.cpp
+//  libraries/script-engine/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+TimerWheel::TimerWheel(Clock::time_point startTime) : _startTime(startTime) {
+    for (int level = 0; level < NUM_LEVELS; ++level) {
+        _levels[level].resize(levelSize(level));
+    }
+}
+
+TimerWheel::TimerID TimerWheel::start(int intervalMS, bool isSingleShot, const QUuid& owner, Clock::time_point time) {
+    TimerID id = _nextID++;
+    if (_nextID <= 0) {
+        _nextID = 1;
+    }
+
+    // a timer of no interval fires on the next tick, as a zero timer fires on the next pass of an event loop
+    Timer timer { 0, std::max(intervalMS, 1), isSingleShot, owner };
+    // the wheel only moves on when advanced, so the interval counts from the time rather than from the last tick
+    timer.expiry = std::max(_tick, tickAt(time)) + timer.interval;
+    _timers.insert(id, timer);
+    if (!owner.isNull()) {
+        _ownedTimers[owner].insert(id);
+    }
+
+    insert(id, timer.expiry);
+    return id;
+}
+
+bool TimerWheel::stop(TimerID id) {
+    auto it = _timers.find(id);
+    if (it == _timers.end()) {
+        return false;
+    }
+    release(id, it.value());
+    _timers.erase(it);
+    return true;
+}
+
+void TimerWheel::stopAll(const QUuid& owner, std::vector<TimerID>& stopped) {
+    auto it = _ownedTimers.find(owner);
+    if (it == _ownedTimers.end()) {
+        return;
+    }
+    for (auto id : it.value()) {
+        _timers.remove(id);
+        stopped.push_back(id);
+    }
+    _ownedTimers.erase(it);
+}
+
+void TimerWheel::stopAll() {
+    _timers.clear();
+    _ownedTimers.clear();
+    for (auto& level : _levels) {
+        for (auto& slot : level) {
+            slot.clear();
+        }
+    }
+    _numEntries = 0;
+}
+
+void TimerWheel::advance(Clock::time_point time, std::vector<TimerID>& expired) {
+    uint64_t targetTick = tickAt(time);
+    if (targetTick <= _tick) {
+        return;
+    }
+
+    if (_timers.isEmpty()) {
+        // nothing can expire, so skip straight to the time, dropping the slots of the stopped timers
+        if (_numEntries > 0) {
+            stopAll();
+        }
+        _tick = targetTick;
+        return;
+    }
+
+    while (_tick < targetTick) {
+        ++_tick;
+
+        // when a level comes round, the timers in the next slot of the level above are now close enough to move down
+        for (int level = 1; level < NUM_LEVELS; ++level) {
+            if ((_tick & ((1ULL << levelShift(level)) - 1)) != 0) {
+                break;
+            }
+            cascade(level);
+        }
+
+        auto& slot = _levels[0][_tick & (levelSize(0) - 1)];
+        if (slot.empty()) {
+            continue;
+        }
+
+        std::vector<TimerID> due;
+        due.swap(slot);
+        _numEntries -= (int)due.size();
+
+        for (auto id : due) {
+            auto it = _timers.find(id);
+            if (it == _timers.end()) {
+                continue; // stopped
+            }
+            auto& timer = it.value();
+            if (timer.expiry > _tick) {
+                // was beyond the reach of the wheel, or started again
+                insert(id, timer.expiry);
+                continue;
+            }
+
+            expired.push_back(id);
+
+            if (timer.isSingleShot) {
+                release(id, timer);
+                _timers.erase(it);
+            } else {
+                // don't make up for the ticks missed, they would all fire in this call
+                uint64_t nextExpiry = timer.expiry + timer.interval;
+                if (nextExpiry <= targetTick) {
+                    nextExpiry = targetTick + timer.interval;
+                }
+                timer.expiry = nextExpiry;
+                insert(id, nextExpiry);
+            }
+        }
+
+        // keep the capacity of the slot, it will likely be used again
+        if (slot.empty()) {
+            due.clear();
+            slot.swap(due);
+        }
+    }
+}
+
+uint64_t TimerWheel::tickAt(Clock::time_point time) const {
+    if (time <= _startTime) {
+        return 0;
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time - _startTime).count();
+}
+
+void TimerWheel::insert(TimerID id, uint64_t expiry) {
+    uint64_t delta = expiry > _tick ? expiry - _tick : 0;
+    for (int level = 0; level < NUM_LEVELS; ++level) {
+        uint64_t levelRange = 1ULL << levelShift(level + 1);
+        if (delta < levelRange || level == NUM_LEVELS - 1) {
+            // timers beyond the top level are parked in its last slot, and placed again when it comes round
+            uint64_t slotTick = delta < levelRange ? _tick + delta : _tick + levelRange - 1;
+            auto index = (slotTick >> levelShift(level)) & (levelSize(level) - 1);
+            _levels[level][index].push_back(id);
+            ++_numEntries;
+            return;
+        }
+    }
+}
+
+void TimerWheel::cascade(int level) {
+    auto& slot = _levels[level][(_tick >> levelShift(level)) & (levelSize(level) - 1)];
+    if (slot.empty()) {
+        return;
+    }
+
+    std::vector<TimerID> timers;
+    timers.swap(slot);
+    _numEntries -= (int)timers.size();
+    for (auto id : timers) {
+        auto it = _timers.find(id);
+        if (it != _timers.end()) {
+            insert(id, it.value().expiry);
+        }
+    }
+}
+
+void TimerWheel::release(TimerID id, const Timer& timer) {
+    if (timer.owner.isNull()) {
+        return;
+    }
+    auto it = _ownedTimers.find(timer.owner);
+    if (it != _ownedTimers.end()) {
+        it.value().remove(id);
+        if (it.value().isEmpty()) {
+            _ownedTimers.erase(it);
+        }
+    }
+}
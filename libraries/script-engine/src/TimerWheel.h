@@ -0,0 +1,82 @@
+//
+//  TimerWheel.h
+//  libraries/script-engine/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TimerWheel_h
+#define hifi_TimerWheel_h
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QUuid>
+
+// Millisecond timers on a hierarchical timing wheel, fired by the owner advancing it rather than by the event loop.
+// Starting and stopping a timer are constant time, as is advancing by a tick, and timers far in the future are
+// only moved down a level when their slot comes round. Each timer can have an owner, so all the timers of an
+// owner can be stopped without looking at the others.
+class TimerWheel {
+public:
+    using TimerID = int; // 0 is never a valid timer
+    using Clock = std::chrono::steady_clock;
+
+    TimerWheel(Clock::time_point startTime = Clock::now());
+
+    // The timer expires its interval after the time it is started at, however long ago the wheel was last advanced
+    TimerID start(int intervalMS, bool isSingleShot, const QUuid& owner = QUuid(), Clock::time_point time = Clock::now());
+    // returns false if the timer had already fired (single shot) or been stopped
+    bool stop(TimerID id);
+    // stops all the timers of the owner, and adds their ids to stopped
+    void stopAll(const QUuid& owner, std::vector<TimerID>& stopped);
+    void stopAll();
+
+    bool isActive(TimerID id) const { return _timers.contains(id); }
+    int size() const { return _timers.size(); }
+
+    // Move the wheel on to the time, adding the timers that expired to expired in the order they expired. Interval timers
+    // are started again from their expiry, or from the time if they fell behind, so they don't fire more than once a call.
+    void advance(Clock::time_point time, std::vector<TimerID>& expired);
+
+private:
+    struct Timer {
+        uint64_t expiry; // tick
+        int interval;
+        bool isSingleShot;
+        QUuid owner;
+    };
+
+    static const int NUM_LEVELS = 4;
+    static const int LEVEL_0_BITS = 8;
+    static const int LEVEL_BITS = 6;
+
+    static int levelShift(int level) { return level == 0 ? 0 : LEVEL_0_BITS + (level - 1) * LEVEL_BITS; }
+    static int levelSize(int level) { return 1 << (level == 0 ? LEVEL_0_BITS : LEVEL_BITS); }
+
+    uint64_t tickAt(Clock::time_point time) const;
+    void insert(TimerID id, uint64_t expiry);
+    void cascade(int level);
+    void release(TimerID id, const Timer& timer);
+
+    Clock::time_point _startTime;
+    uint64_t _tick { 0 }; // ms since the start time, all the timers up to it have been fired
+
+    TimerID _nextID { 1 };
+    QHash<TimerID, Timer> _timers;
+    QHash<QUuid, QSet<TimerID>> _ownedTimers;
+
+    // Each slot of a level holds the timers expiring within a slot of the level below. Stopped timers are left in their
+    // slot, and skipped when it comes round.
+    std::array<std::vector<std::vector<TimerID>>, NUM_LEVELS> _levels;
+    int _numEntries { 0 }; // in all the slots, including those of stopped timers
+};
+
+#endif // hifi_TimerWheel_h
@@ -34,14 +34,21 @@ Q_LOGGING_CATEGORY(trace_simulation_physics_detail, "trace.simulation.physics.de
 #endif
 
 static bool tracingEnabled() {
-    return DependencyManager::get<tracing::Tracer>()->isEnabled();
+    return tracing::enabled();
 }
 
-Duration::Duration(const QLoggingCategory& category, const QString& name, uint32_t argbColor, uint64_t payload, const QVariantMap& baseArgs) : _name(name), _category(category) {
+Duration::Duration(const QLoggingCategory& category, const QString& name, uint32_t argbColor, uint64_t payload, const QVariantMap& baseArgs) : _category(category) {
     if (tracingEnabled() && category.isDebugEnabled()) {
-        QVariantMap args = baseArgs;
-        args["nv_payload"] = QVariant::fromValue(payload);
-        tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
+        if (baseArgs.empty()) {
+            _isRecorded = true;
+            _nameID = tracing::internName(name);
+            tracing::traceRecord(_category, _nameID, tracing::DurationBegin, payload);
+        } else {
+            _name = name;
+            QVariantMap args = baseArgs;
+            args["nv_payload"] = QVariant::fromValue(payload);
+            tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
+        }
 
 #if defined(NSIGHT_TRACING)
         nvtxEventAttributes_t eventAttrib { 0 };
@@ -61,7 +68,12 @@ Duration::Duration(const QLoggingCategory& category, const QString& name, uint32
 
 Duration::~Duration() {
     if (tracingEnabled() && _category.isDebugEnabled()) {
-        tracing::traceEvent(_category, _name, tracing::DurationEnd);
+        // only end the ranges that were begun while tracing
+        if (_isRecorded) {
+            tracing::traceRecord(_category, _nameID, tracing::DurationEnd);
+        } else if (!_name.isEmpty()) {
+            tracing::traceEvent(_category, _name, tracing::DurationEnd);
+        }
 #ifdef NSIGHT_TRACING
         nvtxRangePop();
 #endif
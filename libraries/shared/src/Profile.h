@@ -42,8 +42,10 @@ public:
     static void endRange(const QLoggingCategory& category, uint64_t rangeId);
 
 private:
-    QString _name;
     const QLoggingCategory& _category;
+    bool _isRecorded { false }; // the range is a record in the thread's trace buffer, named _nameID
+    tracing::StringID _nameID { 0 };
+    QString _name; // the name of a range with arguments, which is a (locked) trace event
 };
 
 inline void asyncBegin(const QLoggingCategory& category, const QString& name, const QString& id, const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap()) {
@@ -68,7 +70,15 @@ inline void instant(const QLoggingCategory& category, const QString& name, const
 
 inline void counter(const QLoggingCategory& category, const QString& name, const QVariantMap& args, const QVariantMap& extra = QVariantMap()) {
     if (category.isDebugEnabled()) {
-        tracing::traceEvent(category, name, tracing::Counter, "", args, extra);
+        // a single number is recorded without locking
+        int valueType = args.size() == 1 ? args.first().userType() : QMetaType::UnknownType;
+        bool isNumber = valueType == QMetaType::Int || valueType == QMetaType::UInt || valueType == QMetaType::LongLong ||
+            valueType == QMetaType::ULongLong || valueType == QMetaType::Float || valueType == QMetaType::Double;
+        if (isNumber && extra.empty()) {
+            tracing::traceCounter(category, name, args.firstKey(), args.first().toDouble());
+        } else {
+            tracing::traceEvent(category, name, tracing::Counter, "", args, extra);
+        }
     }
 }
 
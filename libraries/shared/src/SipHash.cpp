@@ -0,0 +1,79 @@
+//
+//  SipHash.cpp
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SipHash.h"
+
+static inline uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t readLittleEndian(const uint8_t* bytes) {
+    return (uint64_t)bytes[0] | ((uint64_t)bytes[1] << 8) | ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
+        ((uint64_t)bytes[4] << 32) | ((uint64_t)bytes[5] << 40) | ((uint64_t)bytes[6] << 48) | ((uint64_t)bytes[7] << 56);
+}
+
+static inline void writeLittleEndian(uint64_t value, uint8_t* bytes) {
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static inline void sipRound(uint64_t& v0, uint64_t& v1, uint64_t& v2, uint64_t& v3) {
+    v0 += v1; v1 = rotateLeft(v1, 13); v1 ^= v0; v0 = rotateLeft(v0, 32);
+    v2 += v3; v3 = rotateLeft(v3, 16); v3 ^= v2;
+    v0 += v3; v3 = rotateLeft(v3, 21); v3 ^= v0;
+    v2 += v1; v1 = rotateLeft(v1, 17); v1 ^= v2; v2 = rotateLeft(v2, 32);
+}
+
+void sipHash128(const uint8_t key[SIPHASH_KEY_BYTES], const void* data, size_t size, uint8_t result[SIPHASH_128_BYTES]) {
+    const int COMPRESSION_ROUNDS = 2;
+    const int FINALIZATION_ROUNDS = 4;
+
+    uint64_t k0 = readLittleEndian(key);
+    uint64_t k1 = readLittleEndian(key + 8);
+    uint64_t v0 = 0x736f6d6570736575ULL ^ k0;
+    uint64_t v1 = 0x646f72616e646f6dULL ^ k1 ^ 0xee;
+    uint64_t v2 = 0x6c7967656e657261ULL ^ k0;
+    uint64_t v3 = 0x7465646279746573ULL ^ k1;
+
+    auto bytes = static_cast<const uint8_t*>(data);
+    const uint8_t* end = bytes + (size - size % 8);
+    for (; bytes != end; bytes += 8) {
+        uint64_t m = readLittleEndian(bytes);
+        v3 ^= m;
+        for (int i = 0; i < COMPRESSION_ROUNDS; ++i) {
+            sipRound(v0, v1, v2, v3);
+        }
+        v0 ^= m;
+    }
+
+    // the last block holds the remaining bytes and the low byte of the size
+    uint64_t last = (uint64_t)size << 56;
+    for (int i = 0; i < (int)(size % 8); ++i) {
+        last |= (uint64_t)bytes[i] << (8 * i);
+    }
+    v3 ^= last;
+    for (int i = 0; i < COMPRESSION_ROUNDS; ++i) {
+        sipRound(v0, v1, v2, v3);
+    }
+    v0 ^= last;
+
+    v2 ^= 0xee;
+    for (int i = 0; i < FINALIZATION_ROUNDS; ++i) {
+        sipRound(v0, v1, v2, v3);
+    }
+    writeLittleEndian(v0 ^ v1 ^ v2 ^ v3, result);
+
+    v1 ^= 0xdd;
+    for (int i = 0; i < FINALIZATION_ROUNDS; ++i) {
+        sipRound(v0, v1, v2, v3);
+    }
+    writeLittleEndian(v0 ^ v1 ^ v2 ^ v3, result + 8);
+}
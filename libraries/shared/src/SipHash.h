@@ -0,0 +1,24 @@
+//
+//  SipHash.h
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SipHash_h
+#define hifi_SipHash_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+const int SIPHASH_KEY_BYTES = 16;
+const int SIPHASH_128_BYTES = 16;
+
+// SipHash-2-4 with a 128 bit result (https://131002.net/siphash/), a keyed MAC that is much cheaper than a
+// cryptographic hash over short messages. The key and the result are little endian byte arrays.
+void sipHash128(const uint8_t key[SIPHASH_KEY_BYTES], const void* data, size_t size, uint8_t result[SIPHASH_128_BYTES]);
+
+#endif // hifi_SipHash_h
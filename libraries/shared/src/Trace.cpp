@@ -8,7 +8,9 @@
 
 #include "Trace.h"
 
+#include <atomic>
 #include <chrono>
+#include <cstring>
 
 #include <QtCore/QDebug>
 #include <QtCore/QCoreApplication>
@@ -35,28 +37,222 @@
 
 using namespace tracing;
 
+// whether records go into the threads' trace buffers, set while the Tracer is tracing
+static std::atomic<bool> recordingEnabled { false };
+
 bool tracing::enabled() {
-    return DependencyManager::get<Tracer>()->isEnabled();
+    return recordingEnabled;
+}
+
+static TraceTimestamp now() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
+}
+
+// the interned names, shared by all threads
+class StringTable {
+public:
+    StringTable() { _strings.push_back(QString()); }
+
+    StringID intern(const QString& string) {
+        std::lock_guard<std::mutex> guard(_mutex);
+        auto it = _ids.find(string);
+        if (it != _ids.end()) {
+            return it.value();
+        }
+        StringID id = (StringID)_strings.size();
+        _strings.push_back(string);
+        _ids.insert(string, id);
+        return id;
+    }
+
+    std::vector<QString> getStrings() {
+        std::lock_guard<std::mutex> guard(_mutex);
+        return _strings;
+    }
+
+private:
+    std::mutex _mutex;
+    QHash<QString, StringID> _ids;
+    std::vector<QString> _strings;
+};
+
+static StringTable stringTable;
+
+// A single producer, single consumer ring of records: the owning thread pushes, the Tracer drains
+class ThreadTraceBuffer {
+public:
+    static const size_t CAPACITY = 1 << 14; // must be a power of 2
+
+    ThreadTraceBuffer() : _threadID(int64_t(QThread::currentThreadId())), _records(new TraceRecord[CAPACITY]) {}
+
+    int64_t getThreadID() const { return _threadID; }
+
+    // called by the owning thread only
+    void push(const TraceRecord& record) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) == CAPACITY) {
+            // never wait for the Tracer, the record is lost
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        _records[head & (CAPACITY - 1)] = record;
+        _head.store(head + 1, std::memory_order_release);
+    }
+
+    StringID internName(const QString& name) {
+        auto it = _names.find(name);
+        if (it != _names.end()) {
+            return it.value();
+        }
+        StringID id = stringTable.intern(name);
+        _names.insert(name, id);
+        return id;
+    }
+
+    StringID internCategory(const QLoggingCategory& category) {
+        auto it = _categories.find(&category);
+        if (it != _categories.end()) {
+            return it.value();
+        }
+        StringID id = stringTable.intern(category.categoryName());
+        _categories.insert(&category, id);
+        return id;
+    }
+
+    // called by one thread at a time (the Tracer's drains are serialized), returns the number of dropped records
+    uint64_t drain(std::vector<TraceRecord>& records) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        size_t head = _head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            records.push_back(_records[tail & (CAPACITY - 1)]);
+        }
+        _tail.store(tail, std::memory_order_release);
+        return _dropped.exchange(0, std::memory_order_relaxed);
+    }
+
+private:
+    const int64_t _threadID;
+    std::unique_ptr<TraceRecord[]> _records;
+    std::atomic<size_t> _head { 0 };
+    std::atomic<size_t> _tail { 0 };
+    std::atomic<uint64_t> _dropped { 0 };
+
+    // the owning thread's cache of the interned strings
+    QHash<QString, StringID> _names;
+    QHash<const QLoggingCategory*, StringID> _categories;
+};
+
+// the buffers of all threads that have recorded, kept after their thread finishes until they are drained
+static std::mutex threadBuffersMutex;
+static std::vector<std::shared_ptr<ThreadTraceBuffer>> threadBuffers;
+
+static ThreadTraceBuffer& getThreadBuffer() {
+    thread_local std::shared_ptr<ThreadTraceBuffer> threadBuffer;
+    if (!threadBuffer) {
+        threadBuffer = std::make_shared<ThreadTraceBuffer>();
+        std::lock_guard<std::mutex> guard(threadBuffersMutex);
+        threadBuffers.push_back(threadBuffer);
+    }
+    return *threadBuffer;
+}
+
+StringID tracing::internName(const QString& name) {
+    return getThreadBuffer().internName(name);
+}
+
+void tracing::traceRecord(const QLoggingCategory& category, StringID nameID, EventType type, uint64_t payload) {
+    if (!recordingEnabled) {
+        return;
+    }
+
+    auto& buffer = getThreadBuffer();
+    buffer.push({ now(), payload, nameID, buffer.internCategory(category), 0, type });
+}
+
+void tracing::traceCounter(const QLoggingCategory& category, const QString& name, const QString& valueName, double value) {
+    if (!recordingEnabled) {
+        return;
+    }
+
+    auto& buffer = getThreadBuffer();
+    uint64_t payload;
+    memcpy(&payload, &value, sizeof(payload));
+    buffer.push({ now(), payload, buffer.internName(name), buffer.internCategory(category), buffer.internName(valueName),
+                  Counter });
+}
+
+Tracer::~Tracer() {
+    stopDraining();
 }
 
 void Tracer::startTracing() {
-    std::lock_guard<std::mutex> guard(_eventsMutex);
+    std::unique_lock<std::mutex> lock(_eventsMutex);
     if (_enabled) {
         qWarning() << "Tried to enable tracer, but already enabled";
         return;
     }
 
     _events.clear();
+    _records.clear();
+    _droppedRecords = 0;
     _enabled = true;
+    recordingEnabled = true;
+
+    // drain the threads' buffers often enough that they don't fill up
+    _isDraining = true;
+    _drainThread = std::thread([this] {
+        static const auto DRAIN_INTERVAL = std::chrono::milliseconds(50);
+        std::unique_lock<std::mutex> lock(_eventsMutex);
+        while (_isDraining) {
+            _drainCondition.wait_for(lock, DRAIN_INTERVAL);
+            lock.unlock();
+            drainRecords();
+            lock.lock();
+        }
+    });
 }
 
 void Tracer::stopTracing() {
+    {
+        std::lock_guard<std::mutex> guard(_eventsMutex);
+        if (!_enabled) {
+            qWarning() << "Cannot stop tracing, already disabled";
+            return;
+        }
+        _enabled = false;
+        recordingEnabled = false;
+    }
+
+    stopDraining();
+    drainRecords();
+}
+
+void Tracer::stopDraining() {
+    {
+        std::lock_guard<std::mutex> guard(_eventsMutex);
+        _isDraining = false;
+    }
+    _drainCondition.notify_all();
+    if (_drainThread.joinable()) {
+        _drainThread.join();
+    }
+}
+
+void Tracer::drainRecords() {
+    std::lock_guard<std::mutex> buffersGuard(threadBuffersMutex);
     std::lock_guard<std::mutex> guard(_eventsMutex);
-    if (!_enabled) {
-        qWarning() << "Cannot stop tracing, already disabled";
-        return;
+
+    for (auto it = threadBuffers.begin(); it != threadBuffers.end();) {
+        auto& buffer = *it;
+        _droppedRecords += buffer->drain(_records[buffer->getThreadID()]);
+
+        // nothing else holds the buffer of a finished thread, and it has just been drained
+        if (buffer.use_count() == 1) {
+            it = threadBuffers.erase(it);
+        } else {
+            ++it;
+        }
     }
-    _enabled = false;
 }
 
 void TraceEvent::writeJson(QTextStream& out) const {
@@ -104,6 +300,131 @@ void TraceEvent::writeJson(QTextStream& out) const {
 #endif
 }
 
+static const quint32 BINARY_TRACE_SIGNATURE = 0x52544648; // "HFTR"
+static const quint32 BINARY_TRACE_VERSION = 1;
+
+// Binary trace format, little endian:
+//   signature, version, process ID
+//   the interned strings, as the number of strings then each string's UTF-8 bytes (as a QByteArray)
+//   the records, as the number of threads then for each thread its ID, its number of records and the records
+//   the other events (with arguments the records can't hold), as the number of events then each event's JSON
+static QByteArray writeBinaryTrace(const std::list<TraceEvent>& events,
+                                   const std::map<int64_t, std::vector<TraceRecord>>& records) {
+    QByteArray binaryTrace;
+    QDataStream stream(&binaryTrace, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    stream << BINARY_TRACE_SIGNATURE << BINARY_TRACE_VERSION << (qint64)QCoreApplication::applicationPid();
+
+    auto strings = stringTable.getStrings();
+    stream << (quint32)strings.size();
+    for (const auto& string : strings) {
+        stream << string.toUtf8();
+    }
+
+    stream << (quint32)records.size();
+    for (const auto& threadRecords : records) {
+        stream << (qint64)threadRecords.first << (quint32)threadRecords.second.size();
+        for (const auto& record : threadRecords.second) {
+            stream << (quint64)record.timestamp << (quint64)record.payload;
+            stream << record.nameID << record.categoryID << record.valueNameID << (qint8)record.type;
+        }
+    }
+
+    stream << (quint32)events.size();
+    for (const auto& event : events) {
+        QByteArray json;
+        {
+            QTextStream out(&json);
+            event.writeJson(out);
+        }
+        stream << json;
+    }
+
+    return binaryTrace;
+}
+
+bool tracing::convertBinaryTrace(const QByteArray& binaryTrace, QByteArray& json) {
+    QDataStream stream(binaryTrace);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    quint32 signature, version;
+    qint64 processID;
+    stream >> signature >> version >> processID;
+    if (signature != BINARY_TRACE_SIGNATURE || version != BINARY_TRACE_VERSION) {
+        qWarning() << "Not a binary trace, or an unknown version of one";
+        return false;
+    }
+
+    quint32 numStrings;
+    stream >> numStrings;
+    QVector<QString> strings;
+    for (quint32 i = 0; i < numStrings && stream.status() == QDataStream::Ok; ++i) {
+        QByteArray string;
+        stream >> string;
+        strings.push_back(QString::fromUtf8(string));
+    }
+    auto stringFor = [&](StringID id) { return id < (StringID)strings.size() ? strings[id] : QString(); };
+
+    json = "[\n";
+    bool first = true;
+    auto append = [&](const QByteArray& event) {
+        if (first) {
+            first = false;
+        } else {
+            json += ",\n";
+        }
+        json += event;
+    };
+
+    quint32 numThreads;
+    stream >> numThreads;
+    for (quint32 i = 0; i < numThreads && stream.status() == QDataStream::Ok; ++i) {
+        qint64 threadID;
+        quint32 numRecords;
+        stream >> threadID >> numRecords;
+        for (quint32 j = 0; j < numRecords && stream.status() == QDataStream::Ok; ++j) {
+            quint64 timestamp, payload;
+            StringID nameID, categoryID, valueNameID;
+            qint8 type;
+            stream >> timestamp >> payload >> nameID >> categoryID >> valueNameID >> type;
+
+            QJsonObject ev {
+                { "name", stringFor(nameID) },
+                { "cat", stringFor(categoryID) },
+                { "ph", QString(QChar::fromLatin1(type)) },
+                { "ts", (qint64)timestamp },
+                { "pid", processID },
+                { "tid", threadID }
+            };
+            if (type == DurationBegin) {
+                ev["args"] = QJsonObject { { "nv_payload", (qint64)payload } };
+            } else if (type == Counter) {
+                double value;
+                memcpy(&value, &payload, sizeof(value));
+                ev["args"] = QJsonObject { { stringFor(valueNameID), value } };
+            }
+            append(QJsonDocument(ev).toJson(QJsonDocument::Compact));
+        }
+    }
+
+    quint32 numEvents;
+    stream >> numEvents;
+    for (quint32 i = 0; i < numEvents && stream.status() == QDataStream::Ok; ++i) {
+        QByteArray event;
+        stream >> event;
+        append(event);
+    }
+
+    json += "\n]";
+
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "Binary trace is truncated";
+        return false;
+    }
+    return true;
+}
+
 void Tracer::serialize(const QString& originalPath) {
 
     QString path = originalPath;
@@ -129,12 +450,21 @@ void Tracer::serialize(const QString& originalPath) {
 
 
     std::list<TraceEvent> currentEvents;
+    std::map<int64_t, std::vector<TraceRecord>> currentRecords;
+    uint64_t droppedRecords;
     {
         std::lock_guard<std::mutex> guard(_eventsMutex);
         currentEvents.swap(_events);
         for (auto& event : _metadataEvents) {
             currentEvents.push_back(event);
         }
+        currentRecords.swap(_records);
+        droppedRecords = _droppedRecords;
+        _droppedRecords = 0;
+    }
+
+    if (droppedRecords > 0) {
+        qWarning() << "Trace buffers were full," << droppedRecords << "events were dropped";
     }
 
     // If the file exists and we can't remove it, fail early
@@ -142,21 +472,12 @@ void Tracer::serialize(const QString& originalPath) {
         return;
     }
 
-    // If we can't open a temp file for writing, fail early
-    QByteArray data;
-    {
-        QTextStream out(&data);
-        out << "[\n";
-        bool first = true;
-        for (const auto& event : currentEvents) {
-            if (first) {
-                first = false;
-            } else {
-                out << ",\n";
-            }
-            event.writeJson(out);
-        }
-        out << "\n]";
+    // the JSON is converted from the binary trace, as the converter of binary trace files does
+    QByteArray data = writeBinaryTrace(currentEvents, currentRecords);
+    if (!path.endsWith(BINARY_TRACE_EXTENSION) && !path.endsWith(BINARY_TRACE_EXTENSION + ".gz")) {
+        QByteArray json;
+        convertBinaryTrace(data, json);
+        data = json;
     }
 
     if (path.endsWith(".gz")) {
@@ -247,7 +568,7 @@ void Tracer::traceEvent(const QLoggingCategory& category,
         return;
     }
 
-    auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
+    auto timestamp = now();
     auto processID = QCoreApplication::applicationPid();
     auto threadID = int64_t(QThread::currentThreadId());
 
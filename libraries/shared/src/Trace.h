@@ -10,8 +10,12 @@
 #ifndef hifi_Trace_h
 #define hifi_Trace_h
 
+#include <condition_variable>
 #include <cstdint>
+#include <map>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include <QtCore/QString>
 #include <QtCore/QVariantMap>
@@ -76,8 +80,34 @@ struct TraceEvent {
     void writeJson(QTextStream& out) const;
 };
 
+using StringID = uint32_t; // an interned name, 0 is the empty string
+
+// A fixed size event, as kept in the threads' trace buffers and written to binary traces
+struct TraceRecord {
+    TraceTimestamp timestamp;
+    uint64_t payload; // the payload of a duration, or the bits of a counter's (double) value
+    StringID nameID;
+    StringID categoryID;
+    StringID valueNameID; // the name of a counter's value
+    EventType type;
+};
+
+// Events for hot paths, which take no lock: names are interned (and cached by each thread) and the events go into a
+// ring buffer of the calling thread, which the Tracer drains while tracing
+StringID internName(const QString& name);
+void traceRecord(const QLoggingCategory& category, StringID nameID, EventType type, uint64_t payload = 0);
+void traceCounter(const QLoggingCategory& category, const QString& name, const QString& valueName, double value);
+
+// binary traces are written by Tracer::serialize to files with this extension
+const QString BINARY_TRACE_EXTENSION = ".htrace";
+
+// converts a binary trace to the Chrome trace JSON that Tracer::serialize writes to other files
+bool convertBinaryTrace(const QByteArray& binaryTrace, QByteArray& json);
+
 class Tracer : public Dependency {
 public:
+    ~Tracer();
+
     void traceEvent(const QLoggingCategory& category, 
         const QString& name, EventType type,
         const QString& id = "", 
@@ -95,10 +125,20 @@ private:
         const QString& id = "",
         const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
 
+    // moves the records in the threads' trace buffers to _records, the buffers of threads that have finished are freed
+    void drainRecords();
+    void stopDraining();
+
     bool _enabled { false };
     std::list<TraceEvent> _events;
     std::list<TraceEvent> _metadataEvents;
     std::mutex _eventsMutex;
+
+    std::thread _drainThread;
+    std::condition_variable _drainCondition;
+    bool _isDraining { false }; // guarded by _eventsMutex
+    std::map<int64_t, std::vector<TraceRecord>> _records; // by thread ID, guarded by _eventsMutex
+    uint64_t _droppedRecords { 0 };
 };
 
 inline void traceEvent(const QLoggingCategory& category, const QString& name, EventType type, const QString& id = "", const QVariantMap& args = {}, const QVariantMap& extra = {}) {
@@ -0,0 +1,150 @@
+//
+//  AvatarDataTests.cpp
+//  tests/avatars/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarDataTests.h"
+
+#include <QJsonDocument>
+
+#include <AvatarData.h>
+
+QTEST_MAIN(AvatarDataTests)
+
+static const int NUM_JOINTS = 5;
+static const int KEY_FRAME_INTERVAL = 60; // as recorded by AvatarData::toRecordingFrame
+
+// six byte quaternions and two byte fixed point translations
+static const float ROTATION_MIN_DOT = 0.9999f;
+static const float TRANSLATION_EPSILON = 0.001f;
+static const float TRANSFORM_EPSILON = 0.0001f;
+
+static glm::quat jointRotation(int frame, int joint) {
+    return glm::angleAxis(0.01f * frame + 0.3f * joint, glm::normalize(glm::vec3(1.0f, (float)joint, 0.5f)));
+}
+
+static glm::vec3 jointTranslation(int frame, int joint) {
+    return glm::vec3(0.1f * joint, 0.001f * frame, -0.2f);
+}
+
+static void setPose(AvatarData& avatar, int frame) {
+    for (int i = 0; i < NUM_JOINTS; ++i) {
+        avatar.setJointData(i, jointRotation(frame, i), jointTranslation(frame, i));
+    }
+}
+
+static void verifyPose(const AvatarData& avatar, int frame) {
+    auto joints = avatar.getRawJointData();
+    QCOMPARE(joints.size(), NUM_JOINTS);
+    for (int i = 0; i < NUM_JOINTS; ++i) {
+        QVERIFY(fabsf(glm::dot(joints[i].rotation, jointRotation(frame, i))) > ROTATION_MIN_DOT);
+        QVERIFY(glm::distance(joints[i].translation, jointTranslation(frame, i)) < TRANSLATION_EPSILON);
+    }
+}
+
+static AttachmentData createAttachment() {
+    AttachmentData attachment;
+    attachment.modelURL = QUrl("http://localhost/hat.fbx");
+    attachment.jointName = "Head";
+    attachment.translation = glm::vec3(0.0f, 0.1f, 0.0f);
+    attachment.scale = 0.5f;
+    return attachment;
+}
+
+static void setupRecordedAvatar(AvatarData& avatar) {
+    avatar.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    avatar.setOrientation(glm::angleAxis(0.5f, glm::vec3(0.0f, 1.0f, 0.0f)));
+    avatar.setTargetScale(2.5f);
+    avatar.setAttachmentData({ createAttachment() });
+    setPose(avatar, 0);
+}
+
+static void verifyPlayedAvatar(const AvatarData& avatar, const AvatarData& recorded) {
+    QVERIFY(glm::distance(avatar.getPosition(), recorded.getPosition()) < TRANSFORM_EPSILON);
+    QVERIFY(fabsf(glm::dot(avatar.getOrientation(), recorded.getOrientation())) > 1.0f - TRANSFORM_EPSILON);
+    QCOMPARE(avatar.getTargetScale(), recorded.getTargetScale());
+    QVERIFY(avatar.getAttachmentData() == recorded.getAttachmentData());
+}
+
+void AvatarDataTests::recordingFrameTest() {
+    AvatarData recorded;
+    setupRecordedAvatar(recorded);
+
+    QByteArray frame = AvatarData::toFrame(recorded);
+    QVERIFY(frame.startsWith("HFAF"));
+
+    AvatarData played;
+    AvatarData::fromFrame(frame, played);
+    verifyPlayedAvatar(played, recorded);
+    verifyPose(played, 0);
+}
+
+void AvatarDataTests::recordingFrameDefaultsTest() {
+    AvatarData recorded;
+    setupRecordedAvatar(recorded);
+
+    AvatarData played;
+    AvatarData::fromFrame(AvatarData::toFrame(recorded), played);
+    QCOMPARE(played.getTargetScale(), 2.5f);
+    QCOMPARE(played.getAttachmentData().size(), 1);
+
+    recorded.setTargetScale(1.0f);
+    recorded.setAttachmentData({});
+    AvatarData::fromFrame(AvatarData::toFrame(recorded), played);
+    QCOMPARE(played.getTargetScale(), 1.0f);
+    QVERIFY(played.getAttachmentData().isEmpty());
+}
+
+void AvatarDataTests::recordingFrameSeekTest() {
+    AvatarData recorded;
+    setupRecordedAvatar(recorded);
+
+    std::vector<QByteArray> frames;
+    for (int i = 0; i < 2 * KEY_FRAME_INTERVAL; ++i) {
+        setPose(recorded, i);
+        frames.push_back(AvatarData::toFrame(recorded));
+    }
+    // the frames between key frames leave out the identity that didn't change
+    QVERIFY(frames[1].size() < frames[0].size());
+
+    AvatarData played;
+    for (int i = 0; i < 10; ++i) {
+        AvatarData::fromFrame(frames[i], played);
+        verifyPose(played, i);
+    }
+
+    // seeking to the middle of the deltas leaves the joints as they were
+    AvatarData::fromFrame(frames[20], played);
+    verifyPose(played, 9);
+    AvatarData::fromFrame(frames[21], played);
+    verifyPose(played, 9);
+
+    // until the next key frame
+    for (int i = KEY_FRAME_INTERVAL; i < KEY_FRAME_INTERVAL + 10; ++i) {
+        AvatarData::fromFrame(frames[i], played);
+        verifyPose(played, i);
+    }
+
+    // looping back to the start of the clip
+    AvatarData::fromFrame(frames[0], played);
+    verifyPose(played, 0);
+    AvatarData::fromFrame(frames[1], played);
+    verifyPose(played, 1);
+}
+
+void AvatarDataTests::jsonFrameTest() {
+    AvatarData recorded;
+    setupRecordedAvatar(recorded);
+
+    QByteArray frame = QJsonDocument(recorded.toJson()).toBinaryData();
+
+    AvatarData played;
+    AvatarData::fromFrame(frame, played);
+    verifyPlayedAvatar(played, recorded);
+    verifyPose(played, 0);
+}
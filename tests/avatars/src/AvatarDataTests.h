@@ -0,0 +1,34 @@
+//
+//  AvatarDataTests.h
+//  tests/avatars/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarDataTests_h
+#define hifi_AvatarDataTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class AvatarDataTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a recording frame plays back the transform, scale, attachments and joints it was recorded from
+    void recordingFrameTest();
+
+    // Test that a scale of one and no attachments are played back too, over those of the frames before
+    void recordingFrameDefaultsTest();
+
+    // Test that the joint deltas play back in order, and are left alone after a seek until the next key frame
+    void recordingFrameSeekTest();
+
+    // Test that the json frames of older clips still play back
+    void jsonFrameTest();
+};
+
+#endif // hifi_AvatarDataTests_h
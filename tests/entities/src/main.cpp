@@ -10,16 +10,27 @@
 
 #include <QCoreApplication>
 #include <QFile>
+#include <QFileInfo>
 #include <QTimer>
 #include <QElapsedTimer>
 #include <QLoggingCategory>
 #include <QDir>
+#include <QProcess>
+#include <QTemporaryDir>
 #include <ByteCountCoding.h>
 
+#include <atomic>
+#include <thread>
+
 #include <ShapeEntityItem.h>
 #include <EntityItemProperties.h>
 #include <Octree.h>
 #include <PathUtils.h>
+#include <EntityTree.h>
+
+#ifndef Q_OS_WIN
+#include <sys/resource.h>
+#endif
 
 const QString& getTestResourceDir() {
     static QString dir;
@@ -135,8 +146,186 @@ void testPropertyFlags() {
     testPropertyFlags(0xFFFF);
 }
 
+// peak resident set size of this process in KB, or 0 where it isn't available
+long getPeakResidentSetSize() {
+#ifndef Q_OS_WIN
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef Q_OS_MAC
+        return usage.ru_maxrss / 1024; // bytes on OS X
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+#endif
+    return 0;
+}
+
+// loads one entities file and prints "<load msecs> <peak RSS KB>", run in a process of its own for each file
+// so the peak RSS of one load doesn't hide the other
+int loadSnapshot(const QString& fileName) {
+    DependencyManager::set<NodeList>(NodeType::Unassigned);
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+
+    StopWatch stopWatch;
+    bool success = false;
+    stopWatch.start();
+    tree->withWriteLock([&] {
+        if (fileName.endsWith(".bin")) {
+            success = tree->readFromBinaryFile(fileName);
+        } else {
+            success = tree->readJSONFromGzippedFile(fileName);
+        }
+    });
+    stopWatch.stop();
+    if (!success) {
+        return -1;
+    }
+
+    printf("%llu %ld\n", (unsigned long long)stopWatch.getLast() / USECS_PER_MSEC, getPeakResidentSetSize());
+    return 0;
+}
+
+// compares loading a models.json.gz with loading the same entities from a binary snapshot
+int snapshotBenchmark(const QString& jsonFileName) {
+    QTemporaryDir tempDir;
+    QString binaryFileName = tempDir.path() + "/models.bin";
+    {
+        DependencyManager::set<NodeList>(NodeType::Unassigned);
+        auto tree = std::make_shared<EntityTree>();
+        tree->createRootElement();
+        bool success = false;
+        tree->withWriteLock([&] {
+            success = tree->readJSONFromGzippedFile(jsonFileName) &&
+                tree->writeToFile(qPrintable(binaryFileName), NULL, "bin");
+        });
+        if (!success) {
+            qWarning() << "Unable to convert" << jsonFileName << "to a binary snapshot";
+            return -1;
+        }
+    }
+
+    const int NUM_RUNS = 3;
+    for (const QString& fileName : { jsonFileName, binaryFileName }) {
+        quint64 totalMsecs = 0;
+        long peakKB = 0;
+        for (int i = 0; i < NUM_RUNS; ++i) {
+            QProcess process;
+            process.start(QCoreApplication::applicationFilePath(), { "--load", fileName });
+            if (!process.waitForFinished(-1) || process.exitCode() != 0) {
+                qWarning() << "Loading" << fileName << "failed";
+                return -1;
+            }
+            QStringList result = QString(process.readAllStandardOutput()).trimmed().split(' ');
+            totalMsecs += result.value(0).toULongLong();
+            peakKB = std::max(peakKB, result.value(1).toLong());
+        }
+        qDebug() << fileName << QFileInfo(fileName).size() << "bytes, load" << (totalMsecs / NUM_RUNS)
+            << "msecs, peak RSS" << peakKB << "KB";
+    }
+    return 0;
+}
+
+// one writer edits entities as fast as it can while readers query them, either under the tree's read lock or from
+// snapshots, and prints the edit throughput and the readers' query latency for both
+int contentionBenchmark() {
+    DependencyManager::set<NodeList>(NodeType::Unassigned);
+
+    const int NUM_ENTITIES = 5000;
+    const int NUM_READERS = 4;
+    const float QUERY_RADIUS = 10.0f;
+    const float WORLD_SIZE = 100.0f;
+    const quint64 RUN_USECS = 3 * USECS_PER_SECOND;
+
+    for (bool useSnapshots : { false, true }) {
+        auto tree = std::make_shared<EntityTree>();
+        tree->createRootElement();
+
+        QVector<EntityItemID> entityIDs;
+        tree->withWriteLock([&] {
+            for (int i = 0; i < NUM_ENTITIES; ++i) {
+                EntityItemID entityID(QUuid::createUuid());
+                EntityItemProperties properties;
+                properties.setType(EntityTypes::Box);
+                properties.setPosition(glm::vec3(randFloat(), randFloat(), randFloat()) * WORLD_SIZE);
+                tree->addEntity(entityID, properties);
+                entityIDs.push_back(entityID);
+            }
+        });
+        tree->setWantSnapshots(useSnapshots);
+
+        std::atomic<bool> stop { false };
+        std::atomic<quint64> numEdits { 0 };
+        std::thread writer([&] {
+            EntityItemProperties properties;
+            while (!stop) {
+                properties.setPosition(glm::vec3(randFloat(), randFloat(), randFloat()) * WORLD_SIZE);
+                tree->withWriteLock([&] {
+                    tree->updateEntity(entityIDs[randIntInRange(0, NUM_ENTITIES - 1)], properties);
+                });
+                ++numEdits;
+            }
+        });
+
+        std::vector<StopWatch> stopWatches(NUM_READERS);
+        std::vector<quint64> maxLatencies(NUM_READERS, 0);
+        std::vector<std::thread> readers;
+        for (int i = 0; i < NUM_READERS; ++i) {
+            readers.emplace_back([&, i] {
+                while (!stop) {
+                    glm::vec3 center = glm::vec3(randFloat(), randFloat(), randFloat()) * WORLD_SIZE;
+                    stopWatches[i].start();
+                    if (useSnapshots) {
+                        QVector<EntitySnapshotPointer> entities;
+                        tree->getSnapshot()->findEntities(center, QUERY_RADIUS, entities);
+                    } else {
+                        QVector<EntityItemPointer> entities;
+                        tree->withReadLock([&] {
+                            tree->findEntities(center, QUERY_RADIUS, entities);
+                        });
+                    }
+                    stopWatches[i].stop();
+                    maxLatencies[i] = std::max(maxLatencies[i], stopWatches[i].getLast());
+                }
+            });
+        }
+
+        std::this_thread::sleep_for(std::chrono::microseconds(RUN_USECS));
+        stop = true;
+        writer.join();
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        float averageLatency = 0.0f;
+        quint64 maxLatency = 0;
+        for (int i = 0; i < NUM_READERS; ++i) {
+            averageLatency += stopWatches[i].getAverage() / NUM_READERS;
+            maxLatency = std::max(maxLatency, maxLatencies[i]);
+        }
+        qDebug() << (useSnapshots ? "snapshots:" : "read lock:") << (numEdits * USECS_PER_SECOND / RUN_USECS)
+            << "edits/sec, query average" << averageLatency << "usecs, max" << maxLatency << "usecs";
+    }
+    return 0;
+}
+
 int main(int argc, char** argv) {
     QCoreApplication app(argc, argv);
+
+    QStringList arguments = app.arguments();
+    int loadIndex = arguments.indexOf("--load");
+    if (loadIndex >= 0 && loadIndex + 1 < arguments.size()) {
+        return loadSnapshot(arguments[loadIndex + 1]);
+    }
+    int benchmarkIndex = arguments.indexOf("--snapshot-benchmark");
+    if (benchmarkIndex >= 0 && benchmarkIndex + 1 < arguments.size()) {
+        return snapshotBenchmark(arguments[benchmarkIndex + 1]);
+    }
+    if (arguments.contains("--contention-benchmark")) {
+        return contentionBenchmark();
+    }
+
     {
         auto start = usecTimestampNow();
         for (int i = 0; i < 1000; ++i) {
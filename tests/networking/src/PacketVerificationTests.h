@@ -0,0 +1,35 @@
+//
+//  PacketVerificationTests.h
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketVerificationTests_h
+#define hifi_PacketVerificationTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class PacketVerificationTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a signed packet verifies only with its secret and payload
+    void verifyTest();
+
+    // Test that each verification version gives its own hash
+    void versionTest();
+
+    // Test SipHash-2-4 against the known answers of the reference implementation
+    void sipHashVectorsTest();
+
+    // Compare the cost of hashing MTU sized packets with each verification version
+    void md5Benchmark();
+    void sipHashBenchmark();
+};
+
+#endif // hifi_PacketVerificationTests_h
@@ -0,0 +1,163 @@
+//
+//  ParticleArraysTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParticleArraysTests.h"
+
+#include <random>
+#include <vector>
+
+#include <CPUDetect.h>
+#include <ParticleArrays.h>
+
+QTEST_MAIN(ParticleArraysTests)
+
+// every count up to a few AVX2 batches, so that each tail length is tested, and one of many batches
+static const std::vector<size_t> PARTICLE_COUNTS = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 23, 1003 };
+
+// dropped before integrating, so that the arrays don't start at the start of their storage
+static const size_t NUM_DROPPED = 3;
+
+static const float DELTA_TIME = 1.0f / 90.0f;
+static const int NUM_STEPS = 3;
+
+static ParticleArrays createParticles(std::mt19937& generator, size_t numParticles) {
+    std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> lifetime(0.0f, 1.0f);
+
+    ParticleArrays particles;
+    for (size_t i = 0; i < numParticles + NUM_DROPPED; ++i) {
+        particles.push_back((float)i, lifetime(generator),
+                            glm::vec3(value(generator), value(generator), value(generator)),
+                            glm::vec3(value(generator), value(generator), value(generator)),
+                            glm::vec3(value(generator), value(generator), value(generator)));
+    }
+    particles.pop_front(NUM_DROPPED);
+    return particles;
+}
+
+// the velocities only show in the positions of the later steps
+static void verifyParticles(const ParticleArrays& particles, const ParticleArrays& expected) {
+    QCOMPARE(particles.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        QCOMPARE(particles.getSeed(i), expected.getSeed(i));
+        QVERIFY(particles.getLifetime(i) == expected.getLifetime(i));
+        QVERIFY(particles.getPosition(i) == expected.getPosition(i));
+    }
+}
+
+void ParticleArraysTests::integrateTest() {
+    std::mt19937 generator(1);
+
+    for (size_t numParticles : PARTICLE_COUNTS) {
+        const ParticleArrays particles = createParticles(generator, numParticles);
+
+        ParticleArrays expected = particles;
+        for (int step = 0; step < NUM_STEPS; ++step) {
+            ParticleArrays::integrate_ref(expected.getArrays(), DELTA_TIME, 0);
+        }
+
+        ParticleArrays results = particles;
+        for (int step = 0; step < NUM_STEPS; ++step) {
+            ParticleArrays::integrate(results.getArrays(), DELTA_TIME);
+        }
+        verifyParticles(results, expected);
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+        results = particles;
+        for (int step = 0; step < NUM_STEPS; ++step) {
+            auto arrays = results.getArrays();
+            size_t end = ParticleArrays::integrate_SSE2(arrays, DELTA_TIME);
+            QCOMPARE(end, numParticles & ~(size_t)3);
+            ParticleArrays::integrate_ref(arrays, DELTA_TIME, end);
+        }
+        verifyParticles(results, expected);
+
+        if (cpuSupportsAVX2()) {
+            results = particles;
+            for (int step = 0; step < NUM_STEPS; ++step) {
+                auto arrays = results.getArrays();
+                size_t end = ParticleArrays::integrate_AVX2(arrays, DELTA_TIME);
+                QCOMPARE(end, numParticles & ~(size_t)7);
+                ParticleArrays::integrate_ref(arrays, DELTA_TIME, end);
+            }
+            verifyParticles(results, expected);
+        }
+#endif
+    }
+}
+
+void ParticleArraysTests::orderTest() {
+    const glm::vec3 position(1.0f, 2.0f, 3.0f);
+    ParticleArrays particles;
+    for (int i = 0; i < 10; ++i) {
+        particles.push_back((float)i, 0.0f, position * (float)i, glm::vec3(), glm::vec3());
+    }
+
+    particles.pop_front(3);
+    QCOMPARE(particles.size(), (size_t)7);
+    for (size_t i = 0; i < particles.size(); ++i) {
+        QCOMPARE(particles.getSeed(i), (float)(i + 3));
+        QVERIFY(particles.getPosition(i) == position * (float)(i + 3));
+    }
+
+    // compacting keeps the order
+    particles.compact();
+    QCOMPARE(particles._begin, (size_t)0);
+    QCOMPARE(particles.size(), (size_t)7);
+    for (size_t i = 0; i < particles.size(); ++i) {
+        QCOMPARE(particles.getSeed(i), (float)(i + 3));
+        QVERIFY(particles.getPosition(i) == position * (float)(i + 3));
+    }
+
+    // the particles that reach the lifespan are the oldest, and are dropped
+    particles.clear();
+    const float lifetimes[] = { 0.95f, 0.92f, 0.5f, 0.2f, 0.0f };
+    for (int i = 0; i < 5; ++i) {
+        particles.push_back((float)i, lifetimes[i], position, glm::vec3(), glm::vec3());
+    }
+    particles.stepSimulation(0.1f, 1.0f);
+    QCOMPARE(particles.size(), (size_t)3);
+    QCOMPARE(particles.getSeed(0), 2.0f);
+    QCOMPARE(particles.getLifetime(2), 0.1f);
+
+    // dropping more than there are drops them all, and starts the arrays again
+    particles.pop_front(10);
+    QVERIFY(particles.empty());
+    QCOMPARE(particles._begin, (size_t)0);
+    QVERIFY(particles._seed.empty());
+}
+
+void ParticleArraysTests::capacityTest() {
+    const size_t NUM_PARTICLES = 100;
+    const int NUM_FRAMES = 1000;
+
+    // as an emitter does, dropping the oldest particle for every one emitted
+    ParticleArrays particles;
+    int nextSeed = 0;
+    for (size_t i = 0; i < NUM_PARTICLES; ++i) {
+        particles.push_back((float)nextSeed++, 0.0f, glm::vec3(), glm::vec3(), glm::vec3());
+    }
+    auto emit = [&] {
+        for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+            particles.pop_front();
+            particles.push_back((float)nextSeed++, 0.0f, glm::vec3(), glm::vec3(), glm::vec3());
+
+            QCOMPARE(particles.size(), NUM_PARTICLES);
+            QCOMPARE(particles.getSeed(0), (float)(nextSeed - (int)NUM_PARTICLES));
+            QCOMPARE(particles.getSeed(NUM_PARTICLES - 1), (float)(nextSeed - 1));
+        }
+    };
+
+    emit();
+    size_t capacity = particles._seed.capacity();
+    emit();
+    QCOMPARE(particles._seed.capacity(), capacity);
+    QVERIFY(capacity < 4 * NUM_PARTICLES);
+}
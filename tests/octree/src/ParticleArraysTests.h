@@ -0,0 +1,32 @@
+//
+//  ParticleArraysTests.h
+//  tests/octree/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ParticleArraysTests_h
+#define hifi_ParticleArraysTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class ParticleArraysTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the SSE2 and AVX2 batches move the particles exactly as the reference does, for counts that aren't a
+    // multiple of their batch size too
+    void integrateTest();
+
+    // Test that the particles stay in the order they were emitted as the oldest are dropped and the arrays compacted
+    void orderTest();
+
+    // Test that an emitter that has reached its particle count stops growing the arrays
+    void capacityTest();
+};
+
+#endif // hifi_ParticleArraysTests_h
@@ -9,6 +9,7 @@
 
 #include <recording/Clip.h>
 #include <recording/Frame.h>
+#include <recording/impl/ChunkedClip.h>
 
 #include "Constants.h"
 
@@ -97,6 +98,63 @@ void testClipOrdering() {
     Q_UNUSED(lastFrameTimeOffset); // FIXME - Unix build not yet upgraded to Qt 5.5.1 we can remove this once it is
 }
 
+void testChunkedClip() {
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+
+    // enough frames for a number of chunks
+    static const int NUM_FRAMES = 10000;
+    static const Frame::Time FRAME_INTERVAL = 10;
+    auto writeClip = Clip::newClip();
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)(i * FRAME_INTERVAL), QByteArray(i % 100, (char)i)));
+    }
+    Clip::toFile(fileName, writeClip);
+
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == NUM_FRAMES);
+    QVERIFY(readClip->duration() == writeClip->duration());
+
+    // seeking lands on the first frame from the seek time on, as with clips in memory
+    Frame::Time seekTime = (NUM_FRAMES / 2) * FRAME_INTERVAL + FRAME_INTERVAL / 2;
+    readClip->seekFrameTime(seekTime);
+    writeClip->seekFrameTime(seekTime);
+    QVERIFY(readClip->positionFrameTime() == writeClip->positionFrameTime());
+    size_t count = 0;
+    for (auto readFrame = readClip->nextFrame(), writeFrame = writeClip->nextFrame(); readFrame && writeFrame;
+        readFrame = readClip->nextFrame(), writeFrame = writeClip->nextFrame(), ++count) {
+        QVERIFY(readFrame->type == writeFrame->type);
+        QVERIFY(readFrame->timeOffset == writeFrame->timeOffset);
+        QVERIFY(readFrame->data == writeFrame->data);
+    }
+    QVERIFY(count == NUM_FRAMES / 2 - 1);
+    readClip->seekFrameTime(NUM_FRAMES * FRAME_INTERVAL);
+    QVERIFY(!readClip->peekFrame());
+
+    // A recording that was never closed has no index, but its chunks can still be played
+    {
+        QFile output(fileName);
+        QVERIFY(output.open(QFile::Truncate | QFile::WriteOnly));
+        ChunkedClipWriter writer(output);
+        writeClip->seek(0);
+        for (auto frame = writeClip->nextFrame(); frame; frame = writeClip->nextFrame()) {
+            QVERIFY(writer.addFrame(*frame));
+        }
+    }
+    readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() > 0);
+    QVERIFY(readClip->frameCount() < NUM_FRAMES);
+    readClip->seek(0);
+    writeClip->seek(0);
+    QVERIFY(readClip->peekFrame()->data == writeClip->peekFrame()->data);
+}
+
 #ifdef Q_OS_WIN32
 void myMessageHandler(QtMsgType type, const QMessageLogContext & context, const QString & msg) {
     OutputDebugStringA(msg.toLocal8Bit().toStdString().c_str());
@@ -111,4 +169,5 @@ int main(int, const char**) {
     testFrameTypeRegistration();
     testFilePersist();
     testClipOrdering();
+    testChunkedClip();
 }
\ No newline at end of file
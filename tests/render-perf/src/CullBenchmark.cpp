@@ -0,0 +1,121 @@
+//
+//  CullBenchmark.cpp
+//  tests/render-perf/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CullBenchmark.h"
+
+#include <random>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+
+#include <CPUDetect.h>
+#include <OctreeConstants.h>
+#include <ViewFrustum.h>
+#include <render/FrustumCuller.h>
+#include <render/SpatialTree.h>
+
+using namespace render;
+
+static const int NUM_ITERATIONS = 20;
+static const float ITEMS_RANGE = 1000.0f;
+static const float MIN_ITEM_SIZE = 0.1f;
+static const float MAX_ITEM_SIZE = 10.0f;
+static const float LOD_ANGLE = 2.0f;
+
+// the average time of an iteration of the test, in microseconds
+template <typename F>
+static float timeIterations(F test) {
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < NUM_ITERATIONS; ++i) {
+        test();
+    }
+    return (float)timer.nsecsElapsed() / (1000.0f * NUM_ITERATIONS);
+}
+
+static void runCullBenchmark(const ViewFrustum& frustum, size_t numItems) {
+    std::mt19937 generator(numItems);
+    std::uniform_real_distribution<float> position(-ITEMS_RANGE, ITEMS_RANGE);
+    std::uniform_real_distribution<float> size(MIN_ITEM_SIZE, MAX_ITEM_SIZE);
+
+    std::vector<AABox> bounds;
+    bounds.reserve(numItems);
+    BoxBatch boxes;
+    boxes.reserve(numItems);
+    for (size_t i = 0; i < numItems; ++i) {
+        AABox bound(glm::vec3(position(generator), position(generator), position(generator)),
+                    glm::vec3(size(generator), size(generator), size(generator)));
+        bounds.push_back(bound);
+        boxes.push_back(bound);
+    }
+
+    size_t numScalarInView = 0;
+    float scalarTime = timeIterations([&] {
+        numScalarInView = 0;
+        for (auto& bound : bounds) {
+            if (frustum.boxIntersectsFrustum(bound)) {
+                ++numScalarInView;
+            }
+        }
+    });
+
+    FrustumCuller culler(frustum);
+    std::vector<FrustumCuller::Intersection> intersections(numItems);
+    size_t numBatchInView = 0;
+    float batchTime = timeIterations([&] {
+        culler.intersect(boxes.getArrays(), intersections.data());
+        numBatchInView = 0;
+        for (auto intersection : intersections) {
+            if (intersection != FrustumCuller::Outside) {
+                ++numBatchInView;
+            }
+        }
+    });
+
+    ItemSpatialTree tree(glm::vec3(-0.5f * (float)TREE_SCALE), (float)TREE_SCALE);
+    for (size_t i = 0; i < numItems; ++i) {
+        ItemKey key = ItemKey::Builder::opaqueShape();
+        tree.resetItem(ItemSpatialTree::INVALID_CELL, key, bounds[i], (ItemID)i, key);
+    }
+    auto filter = ItemFilter::Builder::visibleWorldItems().withoutLayered();
+    ItemSpatialTree::ItemSelection selection;
+    float selectTime = timeIterations([&] {
+        selection.clear();
+        tree.selectCellItems(selection, filter, frustum, LOD_ANGLE);
+    });
+
+    // the batches must find the same boxes as the scalar test they replace
+    if (numScalarInView != numBatchInView) {
+        qFatal("Culling %d items, the batches found %d in view where the scalar test found %d",
+               (int)numItems, (int)numBatchInView, (int)numScalarInView);
+    }
+
+    qDebug() << numItems << "items:"
+        << "scalar" << scalarTime << "us," << numScalarInView << "in view;"
+        << "batch" << batchTime << "us," << numBatchInView << "in view;"
+        << "octree select" << selectTime << "us," << selection.cellSelection.size() << "bricks,"
+        << selection.numItems() << "items";
+}
+
+void runCullBenchmark() {
+    ViewFrustum frustum;
+    frustum.setProjection(glm::perspective(glm::radians(DEFAULT_FIELD_OF_VIEW_DEGREES), 16.0f / 9.0f,
+                                           DEFAULT_NEAR_CLIP, DEFAULT_FAR_CLIP));
+    frustum.setPosition(glm::vec3(0.0f));
+    frustum.setOrientation(glm::quat());
+    frustum.calculate();
+
+    qDebug() << "Culling with" << (cpuSupportsAVX2() ? "AVX2" : "SSE2 or reference") << "batches";
+    runCullBenchmark(frustum, 10000);
+    runCullBenchmark(frustum, 100000);
+}
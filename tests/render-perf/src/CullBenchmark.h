@@ -0,0 +1,17 @@
+//
+//  CullBenchmark.h
+//  tests/render-perf/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_perf_CullBenchmark_h
+#define hifi_render_perf_CullBenchmark_h
+
+// Times the scalar and batched frustum tests, and the octree selection, on 10k and 100k random item bounds
+void runCullBenchmark();
+
+#endif // hifi_render_perf_CullBenchmark_h
@@ -72,6 +72,7 @@
 #include <SceneScriptingInterface.h>
 
 #include "Camera.hpp"
+#include "CullBenchmark.h"
 
 Q_DECLARE_LOGGING_CATEGORY(renderperflogging)
 Q_LOGGING_CATEGORY(renderperflogging, "hifi.render_perf")
@@ -1157,6 +1158,12 @@ int main(int argc, char** argv) {
 
     qInstallMessageHandler(messageHandler);
     QLoggingCategory::setFilterRules(LOG_FILTER_RULES);
+
+    if (app.arguments().contains("--cull-benchmark")) {
+        runCullBenchmark();
+        return 0;
+    }
+
     QTestWindow::setup();
     QTestWindow window;
     //window.loadCommands("C:/Users/bdavis/Git/dreaming/exports2/commands.txt");
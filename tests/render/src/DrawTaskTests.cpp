@@ -0,0 +1,268 @@
+//
+//  DrawTaskTests.cpp
+//  tests/render/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DrawTaskTests.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+#include <gpu/Context.h>
+#include <gpu/Frame.h>
+#include <gpu/null/NullBackend.h>
+#include <render/DrawTask.h>
+#include <Transform.h>
+
+QTEST_MAIN(DrawTaskTests)
+
+using namespace render;
+
+static const int NUM_SHAPES = 2000;
+static const char* NAMED_CALL = "DrawTaskTests";
+
+// Records a draw with its own model transform and texture, and a named call instance
+static void recordShape(gpu::Batch& batch, int index, const gpu::TexturePointer& texture) {
+    Transform transform;
+    transform.setTranslation(glm::vec3((float)index, 0.0f, 0.0f));
+    batch.setModelTransform(transform);
+    batch.setResourceTexture(0, texture);
+
+    batch.setupNamedCalls(NAMED_CALL, [](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
+        batch.drawInstanced((gpu::uint32)data.count(), gpu::TRIANGLES, 3);
+    });
+    batch.getNamedBuffer(NAMED_CALL)->append(index);
+
+    batch.draw(gpu::TRIANGLES, 3);
+}
+
+class TestShape {
+public:
+    using Payload = render::Payload<TestShape>;
+
+    TestShape(int index, const ShapeKey& key, const gpu::TexturePointer& texture, bool isConcurrent) :
+        _index(index), _key(key), _texture(texture), _isConcurrent(isConcurrent) {}
+
+    void render(RenderArgs* args) const {
+        recordShape(*args->_batch, _index, _texture);
+        args->_details._trianglesRendered++;
+        _renderThread = std::this_thread::get_id();
+    }
+
+    int _index;
+    ShapeKey _key;
+    gpu::TexturePointer _texture;
+    bool _isConcurrent;
+    mutable std::thread::id _renderThread;
+};
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const std::shared_ptr<TestShape>& payload) {
+        auto builder = ItemKey::Builder::opaqueShape();
+        if (payload->_isConcurrent) {
+            builder.withConcurrent();
+        }
+        return builder.build();
+    }
+    template <> const ShapeKey shapeGetShapeKey(const std::shared_ptr<TestShape>& payload) {
+        return payload->_key;
+    }
+    template <> void payloadRender(const std::shared_ptr<TestShape>& payload, RenderArgs* args) {
+        payload->render(args);
+    }
+}
+
+static std::vector<gpu::TexturePointer> createTextures() {
+    return {
+        gpu::TexturePointer(gpu::Texture::create2D(gpu::Element::COLOR_RGBA_32, 1, 1)),
+        gpu::TexturePointer(gpu::Texture::create2D(gpu::Element::COLOR_RGBA_32, 1, 1))
+    };
+}
+
+// The pipeline and texture bound at each draw of a batch
+static std::vector<std::pair<gpu::PipelinePointer, gpu::TexturePointer>> getDrawStates(const gpu::Batch& batch) {
+    std::vector<std::pair<gpu::PipelinePointer, gpu::TexturePointer>> states;
+    gpu::PipelinePointer pipeline;
+    gpu::TexturePointer texture;
+    const auto& commands = batch.getCommands();
+    const auto& params = batch.getParams();
+    for (size_t i = 0; i < commands.size(); ++i) {
+        size_t offset = batch.getCommandOffsets()[i];
+        if (commands[i] == gpu::Batch::COMMAND_setPipeline) {
+            pipeline = batch._pipelines.get(params[offset]._uint);
+        } else if (commands[i] == gpu::Batch::COMMAND_setResourceTexture) {
+            texture = batch._textures.get(params[offset]._uint);
+        } else if (commands[i] == gpu::Batch::COMMAND_draw) {
+            states.emplace_back(pipeline, texture);
+        }
+    }
+    return states;
+}
+
+static void compareDraws(const gpu::Batch& batch, const gpu::Batch& expected) {
+    QVERIFY(getDrawStates(batch) == getDrawStates(expected));
+
+    QCOMPARE(batch._objects.size(), expected._objects.size());
+    for (size_t i = 0; i < batch._objects.size(); ++i) {
+        QVERIFY(batch._objects[i]._model == expected._objects[i]._model);
+    }
+
+    QCOMPARE(batch._drawCallInfos.size(), expected._drawCallInfos.size());
+    for (size_t i = 0; i < batch._drawCallInfos.size(); ++i) {
+        QCOMPARE(batch._drawCallInfos[i].index, expected._drawCallInfos[i].index);
+    }
+
+    const auto& named = batch._namedData.at(NAMED_CALL);
+    const auto& expectedNamed = expected._namedData.at(NAMED_CALL);
+    QCOMPARE(named.drawCallInfos.size(), expectedNamed.drawCallInfos.size());
+    for (size_t i = 0; i < named.drawCallInfos.size(); ++i) {
+        QCOMPARE(named.drawCallInfos[i].index, expectedNamed.drawCallInfos[i].index);
+    }
+    QCOMPARE(named.buffers.size(), (size_t)1);
+    QCOMPARE(named.buffers[0]->getSize(), expectedNamed.buffers[0]->getSize());
+    QVERIFY(memcmp(named.buffers[0]->getData(), expectedNamed.buffers[0]->getData(), named.buffers[0]->getSize()) == 0);
+}
+
+void DrawTaskTests::initTestCase() {
+    // no gl context, the batches are only recorded
+    gpu::Context::init<gpu::null::Backend>();
+}
+
+void DrawTaskTests::subBatchTest() {
+    auto textures = createTextures();
+
+    gpu::Batch expected;
+    expected.setViewTransform(Transform());
+    for (int i = 0; i < NUM_SHAPES; ++i) {
+        recordShape(expected, i, textures[i % 2]);
+    }
+    // a draw after the shapes uses the model transform of the last one
+    expected.draw(gpu::TRIANGLES, 3);
+
+    const int NUM_SUB_BATCHES = 3;
+    gpu::Batch batch;
+    batch.setViewTransform(Transform());
+    gpu::Batch subBatches[NUM_SUB_BATCHES];
+    for (int i = 0; i < NUM_SUB_BATCHES; ++i) {
+        batch.startSubBatch(subBatches[i]);
+    }
+    for (int i = 0; i < NUM_SHAPES; ++i) {
+        recordShape(subBatches[i * NUM_SUB_BATCHES / NUM_SHAPES], i, textures[i % 2]);
+    }
+    for (int i = 0; i < NUM_SUB_BATCHES; ++i) {
+        batch.appendSubBatch(subBatches[i]);
+        QVERIFY(subBatches[i].getCommands().empty());
+    }
+    batch.draw(gpu::TRIANGLES, 3);
+
+    QVERIFY(batch.getCommands() == expected.getCommands());
+    compareDraws(batch, expected);
+}
+
+// A scene of shapes using two pipelines, that can be recorded concurrently unless isSerial says otherwise
+class TestShapes {
+public:
+    TestShapes(std::function<bool(int)> isSerial) {
+        auto program = gpu::Shader::createProgram(gpu::Shader::createVertex(std::string()), gpu::Shader::createPixel(std::string()));
+        auto state = std::make_shared<gpu::State>();
+        const ShapeKey keys[] = { ShapeKey::Builder().build(), ShapeKey::Builder().withSpecular().build() };
+        for (auto& key : keys) {
+            plumber->addPipeline(key, program, state);
+        }
+
+        sceneContext->_scene = std::make_shared<Scene>(glm::vec3(-0.5f), 1.0f);
+        PendingChanges pendingChanges;
+        for (int i = 0; i < NUM_SHAPES; ++i) {
+            auto id = sceneContext->_scene->allocateID();
+            auto shape = std::make_shared<TestShape>(i, keys[(i % 3 == 0) ? 1 : 0], textures[i % 2], !isSerial(i));
+            pendingChanges.resetItem(id, std::make_shared<TestShape::Payload>(shape));
+            items.emplace_back(id);
+            shapes.push_back(shape);
+        }
+        sceneContext->_scene->enqueuePendingChanges(pendingChanges);
+        sceneContext->_scene->processPendingChangesQueue();
+    }
+
+    // Records the shapes, on the job pool threads when there is one, and returns the number of triangles rendered
+    int record(JobSlavePool* jobPool, gpu::Batch& batch) {
+        auto renderContext = std::make_shared<RenderContext>();
+        renderContext->args = &args;
+        renderContext->jobPool = jobPool;
+        args._batch = &batch;
+        args._details = RenderDetails();
+
+        batch.setViewTransform(Transform());
+        renderStateSortShapes(sceneContext, renderContext, plumber, items);
+        batch.draw(gpu::TRIANGLES, 3);
+
+        args._batch = nullptr;
+        return args._details._trianglesRendered;
+    }
+
+    std::vector<gpu::TexturePointer> textures { createTextures() };
+    ShapePlumberPointer plumber { std::make_shared<ShapePlumber>() };
+    SceneContextPointer sceneContext { std::make_shared<SceneContext>() };
+    ItemBounds items;
+    std::vector<std::shared_ptr<TestShape>> shapes;
+    RenderArgs args { std::make_shared<gpu::Context>() };
+};
+
+void DrawTaskTests::stateSortShapesTest() {
+    TestShapes testShapes([](int index) { return false; });
+
+    gpu::Batch expected;
+    QCOMPARE(testShapes.record(nullptr, expected), NUM_SHAPES);
+
+    JobSlavePool jobPool(3);
+    for (int i = 0; i < 10; ++i) {
+        gpu::Batch batch;
+        QCOMPARE(testShapes.record(&jobPool, batch), NUM_SHAPES);
+        compareDraws(batch, expected);
+    }
+
+    // The merged batch goes through a frame as any other, with its named calls drawn at the end
+    auto& context = testShapes.args._context;
+    gpu::Batch batch;
+    testShapes.record(&jobPool, batch);
+    context->beginFrame();
+    context->appendFrameBatch(batch);
+    auto frame = context->endFrame();
+    QCOMPARE(frame->batches.size(), (size_t)1);
+    const auto& commands = frame->batches[0].getCommands();
+    QCOMPARE(std::count(commands.begin(), commands.end(), gpu::Batch::COMMAND_drawInstanced), (std::ptrdiff_t)1);
+    context->executeFrame(frame);
+}
+
+void DrawTaskTests::serialShapesTest() {
+    TestShapes testShapes([](int index) { return index % 5 == 0; });
+
+    JobSlavePool jobPool(3);
+    gpu::Batch expected;
+    QCOMPARE(testShapes.record(&jobPool, expected), NUM_SHAPES);
+
+    // the shapes not flagged concurrent are all recorded on the render thread, the others are spread over the job threads
+    auto renderThread = std::this_thread::get_id();
+    int numConcurrentOnRenderThread = 0;
+    for (auto& shape : testShapes.shapes) {
+        if (!shape->_isConcurrent) {
+            QVERIFY(shape->_renderThread == renderThread);
+        } else if (shape->_renderThread == renderThread) {
+            ++numConcurrentOnRenderThread;
+        }
+    }
+    QVERIFY(numConcurrentOnRenderThread < NUM_SHAPES * 4 / 5);
+
+    for (int i = 0; i < 10; ++i) {
+        gpu::Batch batch;
+        QCOMPARE(testShapes.record(&jobPool, batch), NUM_SHAPES);
+        compareDraws(batch, expected);
+    }
+}
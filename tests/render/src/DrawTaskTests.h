@@ -0,0 +1,33 @@
+//
+//  DrawTaskTests.h
+//  tests/render/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DrawTaskTests_h
+#define hifi_DrawTaskTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class DrawTaskTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    // Test that sub batches appended in order give the batch recorded in one go
+    void subBatchTest();
+
+    // Test that the sorted shapes recorded on job threads give the same draws as on the render thread, every time
+    void stateSortShapesTest();
+
+    // Test that the shapes not flagged concurrent are recorded on the render thread, and the same way every time
+    void serialShapesTest();
+};
+
+#endif // hifi_DrawTaskTests_h
@@ -0,0 +1,145 @@
+//
+//  FrustumCullerTests.cpp
+//  tests/render/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrustumCullerTests.h"
+
+#include <random>
+#include <vector>
+
+#include <CPUDetect.h>
+#include <render/FrustumCuller.h>
+
+QTEST_MAIN(FrustumCullerTests)
+
+using namespace render;
+
+// every count up to a few AVX2 batches, so that each tail length is tested, and one of many batches
+static const std::vector<size_t> BOX_COUNTS = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 23, 1003 };
+
+static const float BOXES_RANGE = 20.0f;
+static const float MAX_BOX_SIZE = 8.0f;
+static const float MIN_PLANE_DISTANCE = 5.0f;
+static const float MAX_PLANE_DISTANCE = 15.0f;
+
+static BoxBatch createBoxes(std::mt19937& generator, size_t numBoxes) {
+    std::uniform_real_distribution<float> position(-BOXES_RANGE, BOXES_RANGE);
+    std::uniform_real_distribution<float> size(0.0f, MAX_BOX_SIZE);
+
+    BoxBatch boxes;
+    for (size_t i = 0; i < numBoxes; ++i) {
+        boxes.push_back(glm::vec3(position(generator), position(generator), position(generator)),
+                        glm::vec3(size(generator), size(generator), size(generator)));
+    }
+    return boxes;
+}
+
+// planes around the origin, some boxes are inside them all, some cross them and some are outside
+static FrustumCuller createCuller(std::mt19937& generator) {
+    std::uniform_real_distribution<float> coordinate(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> distance(MIN_PLANE_DISTANCE, MAX_PLANE_DISTANCE);
+
+    glm::vec4 planes[ViewFrustum::NUM_PLANES];
+    for (auto& plane : planes) {
+        glm::vec3 normal;
+        do {
+            normal = glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator));
+        } while (glm::length(normal) < 0.1f);
+        plane = glm::vec4(glm::normalize(normal), distance(generator));
+    }
+    return FrustumCuller(planes);
+}
+
+static bool isSolidAngleClose(float result, float expected) {
+    const float RELATIVE_EPSILON = 1.0e-5f;
+    return fabsf(result - expected) <= RELATIVE_EPSILON * std::max(1.0f, fabsf(expected));
+}
+
+void FrustumCullerTests::intersectTest() {
+    std::mt19937 generator(1);
+    int numOutcomes[3] = { 0, 0, 0 };
+
+    for (size_t numBoxes : BOX_COUNTS) {
+        FrustumCuller culler = createCuller(generator);
+        BoxBatch boxes = createBoxes(generator, numBoxes);
+        BoxArrays arrays = boxes.getArrays();
+
+        std::vector<FrustumCuller::Intersection> expected(numBoxes);
+        FrustumCuller::intersect_ref(culler, arrays, 0, expected.data());
+        for (auto intersection : expected) {
+            numOutcomes[intersection]++;
+        }
+
+        std::vector<FrustumCuller::Intersection> results(numBoxes);
+        culler.intersect(arrays, results.data());
+        QVERIFY(results == expected);
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+        std::fill(results.begin(), results.end(), FrustumCuller::Outside);
+        size_t end = FrustumCuller::intersect_SSE2(culler, arrays, results.data());
+        QCOMPARE(end, numBoxes & ~(size_t)3);
+        FrustumCuller::intersect_ref(culler, arrays, end, results.data());
+        QVERIFY(results == expected);
+
+        if (cpuSupportsAVX2()) {
+            std::fill(results.begin(), results.end(), FrustumCuller::Outside);
+            end = FrustumCuller::intersect_AVX2(culler, arrays, results.data());
+            QCOMPARE(end, numBoxes & ~(size_t)7);
+            FrustumCuller::intersect_ref(culler, arrays, end, results.data());
+            QVERIFY(results == expected);
+        }
+#endif
+    }
+
+    // the boxes tested each outcome
+    QVERIFY(numOutcomes[FrustumCuller::Outside] > 0);
+    QVERIFY(numOutcomes[FrustumCuller::Intersect] > 0);
+    QVERIFY(numOutcomes[FrustumCuller::Inside] > 0);
+}
+
+void FrustumCullerTests::solidAngleTest() {
+    std::mt19937 generator(2);
+    const glm::vec3 eyePos(1.0f, -2.0f, 3.0f);
+    const float size = 2.0f;
+    const float squareTanAlpha = 0.01f;
+
+    for (size_t numBoxes : BOX_COUNTS) {
+        BoxBatch boxes = createBoxes(generator, numBoxes);
+        BoxArrays arrays = boxes.getArrays();
+
+        std::vector<float> expected(numBoxes);
+        FrustumCuller::testSolidAngles_ref(arrays, eyePos, size, squareTanAlpha, 0, expected.data());
+
+        std::vector<float> results(numBoxes);
+        FrustumCuller::testSolidAngles(arrays, eyePos, size, squareTanAlpha, results.data());
+        for (size_t i = 0; i < numBoxes; ++i) {
+            QVERIFY(isSolidAngleClose(results[i], expected[i]));
+        }
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+        std::fill(results.begin(), results.end(), 0.0f);
+        size_t end = FrustumCuller::testSolidAngles_SSE2(arrays, eyePos, size, squareTanAlpha, results.data());
+        QCOMPARE(end, numBoxes & ~(size_t)3);
+        FrustumCuller::testSolidAngles_ref(arrays, eyePos, size, squareTanAlpha, end, results.data());
+        for (size_t i = 0; i < numBoxes; ++i) {
+            QVERIFY(isSolidAngleClose(results[i], expected[i]));
+        }
+
+        if (cpuSupportsAVX2()) {
+            std::fill(results.begin(), results.end(), 0.0f);
+            end = FrustumCuller::testSolidAngles_AVX2(arrays, eyePos, size, squareTanAlpha, results.data());
+            QCOMPARE(end, numBoxes & ~(size_t)7);
+            FrustumCuller::testSolidAngles_ref(arrays, eyePos, size, squareTanAlpha, end, results.data());
+            for (size_t i = 0; i < numBoxes; ++i) {
+                QVERIFY(isSolidAngleClose(results[i], expected[i]));
+            }
+        }
+#endif
+    }
+}
@@ -0,0 +1,29 @@
+//
+//  FrustumCullerTests.h
+//  tests/render/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FrustumCullerTests_h
+#define hifi_FrustumCullerTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class FrustumCullerTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the SSE2 and AVX2 batches intersect boxes as the reference does, for counts that aren't a multiple
+    // of their batch size too
+    void intersectTest();
+
+    // Test that the SSE2 and AVX2 batches give the solid angles the reference does
+    void solidAngleTest();
+};
+
+#endif // hifi_FrustumCullerTests_h
@@ -0,0 +1,178 @@
+//
+//  TaskTests.cpp
+//  tests/render/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TaskTests.h"
+
+#include <atomic>
+#include <initializer_list>
+
+#include <QElapsedTimer>
+
+#include <gpu/Context.h>
+#include <gpu/null/NullBackend.h>
+#include <render/Engine.h>
+
+QTEST_MAIN(TaskTests)
+
+using namespace render;
+
+class SetValue {
+public:
+    using JobModel = Job::ModelO<SetValue, int>;
+
+    SetValue(int value) : _value(value) {}
+
+    bool isConcurrent() const { return true; }
+    void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, int& output) {
+        output = _value;
+    }
+
+    int _value;
+};
+
+class AddOne {
+public:
+    using JobModel = Job::ModelIO<AddOne, int, int>;
+
+    bool isConcurrent() const { return true; }
+    void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const int& input, int& output) {
+        output = input + 1;
+    }
+};
+
+class Sum {
+public:
+    using Inputs = VaryingSet2<int, int>;
+    using JobModel = Job::ModelIO<Sum, Inputs, int>;
+
+    // not concurrent, so it runs on the render thread once every job before it is done
+    void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const Inputs& inputs, int& output) {
+        output = inputs.get0() + inputs.get1();
+    }
+};
+
+// Waits (for up to a second) for the other jobs sharing its count to be running too
+class Rendezvous {
+public:
+    using JobModel = Job::ModelO<Rendezvous, bool>;
+
+    Rendezvous(std::shared_ptr<std::atomic<int>> arrived, int numJobs) : _arrived(arrived), _numJobs(numJobs) {}
+
+    bool isConcurrent() const { return true; }
+    void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, bool& output) {
+        ++(*_arrived);
+        QElapsedTimer timer;
+        timer.start();
+        while (*_arrived < _numJobs && timer.elapsed() < 1000) {
+            QThread::yieldCurrentThread();
+        }
+        output = (*_arrived >= _numJobs);
+    }
+
+    std::shared_ptr<std::atomic<int>> _arrived;
+    int _numJobs;
+};
+
+// (1 + 1) + (10 + 1), with the two sides of the sum independent
+class CountTask : public Task {
+public:
+    using JobModel = Model<CountTask>;
+
+    CountTask() {
+        const auto one = addJob<SetValue>("One", 1);
+        const auto ten = addJob<SetValue>("Ten", 10);
+        const auto two = addJob<AddOne>("Two", one);
+        const auto eleven = addJob<AddOne>("Eleven", ten);
+        const auto sumInputs = Sum::Inputs(two, eleven).hasVarying();
+        const auto sum = addJob<Sum>("Sum", sumInputs);
+        setOutput(sum);
+    }
+
+    const std::vector<std::vector<size_t>>& getDependencies() {
+        updateDependencies();
+        return _dependencies;
+    }
+};
+
+class RendezvousTask : public Task {
+public:
+    using JobModel = Model<RendezvousTask>;
+
+    RendezvousTask() {
+        auto arrived = std::make_shared<std::atomic<int>>(0);
+        const auto first = addJob<Rendezvous>("First", arrived, 2);
+        const auto second = addJob<Rendezvous>("Second", arrived, 2);
+        setOutput(VaryingSet2<bool, bool>(first, second));
+    }
+};
+
+static std::shared_ptr<Engine> createEngine(RenderArgs& args) {
+    auto engine = std::make_shared<Engine>();
+    engine->registerScene(std::make_shared<Scene>(glm::vec3(-0.5f), 1.0f));
+    engine->getRenderContext()->args = &args;
+    return engine;
+}
+
+void TaskTests::initTestCase() {
+    // no gl context, the jobs only run on the cpu
+    gpu::Context::init<gpu::null::Backend>();
+}
+
+void TaskTests::dependenciesTest() {
+    CountTask task;
+    auto& dependencies = task.getDependencies();
+    QCOMPARE(dependencies.size(), (size_t)5);
+    QCOMPARE(dependencies[0], std::vector<size_t>());
+    QCOMPARE(dependencies[1], std::vector<size_t>());
+    QCOMPARE(dependencies[2], std::vector<size_t>({ 0 }));
+    QCOMPARE(dependencies[3], std::vector<size_t>({ 1 }));
+    QCOMPARE(dependencies[4], std::vector<size_t>({ 2, 3 }));
+}
+
+void TaskTests::sequentialRunTest() {
+    RenderArgs args(std::make_shared<gpu::Context>());
+    auto engine = createEngine(args);
+    const auto sum = engine->addJob<CountTask>("Count");
+
+    engine->run();
+    QCOMPARE(sum.get<int>(), 13);
+}
+
+void TaskTests::concurrentRunTest() {
+    RenderArgs args(std::make_shared<gpu::Context>());
+    auto engine = createEngine(args);
+    engine->setNumJobThreads(2);
+    auto sum = engine->addJob<CountTask>("Count");
+
+    for (int i = 0; i < 100; ++i) {
+        sum.edit<int>() = 0;
+        engine->run();
+        QCOMPARE(sum.get<int>(), 13);
+    }
+}
+
+void TaskTests::concurrencyTest() {
+    RenderArgs args(std::make_shared<gpu::Context>());
+    auto engine = createEngine(args);
+    engine->setNumJobThreads(1);
+    const auto met = engine->addJob<RendezvousTask>("Rendezvous").get<VaryingSet2<bool, bool>>();
+
+    engine->run();
+    QVERIFY(met.get0());
+    QVERIFY(met.get1());
+
+    auto config = engine->getConfiguration()->getConfig<RendezvousTask>("Rendezvous");
+    QVERIFY(config);
+    for (auto name : { "First", "Second" }) {
+        auto jobConfig = config->findChild<JobConfig*>(name);
+        QVERIFY(jobConfig);
+        QVERIFY(jobConfig->getCPURunTime() > 0.0);
+    }
+}
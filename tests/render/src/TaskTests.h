@@ -0,0 +1,34 @@
+//
+//  TaskTests.h
+//  tests/render/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TaskTests_h
+#define hifi_TaskTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class TaskTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    // Test that a task finds the jobs each job reads from through its input varyings
+    void dependenciesTest();
+
+    // Test that the jobs give the same outputs whether or not they run on job threads
+    void sequentialRunTest();
+    void concurrentRunTest();
+
+    // Test that jobs not connected by a varying run at the same time, and report their run time in their config
+    void concurrencyTest();
+};
+
+#endif // hifi_TaskTests_h
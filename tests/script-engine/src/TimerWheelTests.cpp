@@ -0,0 +1,234 @@
+//
+//  TimerWheelTests.cpp
+//  tests/script-engine/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheelTests.h"
+
+#include <algorithm>
+#include <ctime>
+#include <memory>
+#include <random>
+
+#include <QtCore/QEventLoop>
+#include <QtCore/QTimer>
+
+#include <TimerWheel.h>
+
+QTEST_MAIN(TimerWheelTests)
+
+using Clock = TimerWheel::Clock;
+
+static const int NUM_TIMERS = 10000;
+static const int MIN_INTERVAL = 10;
+static const int MAX_INTERVAL = 1000;
+static const int RUN_TIME = 2 * MAX_INTERVAL; // so every timer fires
+
+static std::vector<int> createIntervals() {
+    std::mt19937 generator(NUM_TIMERS);
+    std::uniform_int_distribution<int> interval(MIN_INTERVAL, MAX_INTERVAL);
+    std::vector<int> intervals(NUM_TIMERS);
+    for (auto& value : intervals) {
+        value = interval(generator);
+    }
+    return intervals;
+}
+
+// The timers that expire when advancing the wheel to the time, in milliseconds from its start
+static std::vector<TimerWheel::TimerID> advanceTo(TimerWheel& wheel, Clock::time_point startTime, int timeMS) {
+    std::vector<TimerWheel::TimerID> expired;
+    wheel.advance(startTime + std::chrono::milliseconds(timeMS), expired);
+    return expired;
+}
+
+void TimerWheelTests::singleShotTest() {
+    auto startTime = Clock::now();
+    TimerWheel wheel(startTime);
+
+    // one timer for each level of the wheel, and one beyond it
+    const int intervals[] = { 0, 5, 300, 20000, 2000000, 70000000 };
+    std::vector<TimerWheel::TimerID> timers;
+    for (auto interval : intervals) {
+        timers.push_back(wheel.start(interval, true, QUuid(), startTime));
+    }
+    QCOMPARE(wheel.size(), (int)timers.size());
+
+    int time = 0;
+    for (size_t i = 0; i < timers.size(); ++i) {
+        int expiry = std::max(intervals[i], 1);
+        // nothing fires early, even when advancing a millisecond at a time
+        if (expiry - time < 10000) {
+            for (; time < expiry - 1; ++time) {
+                QVERIFY(advanceTo(wheel, startTime, time + 1).empty());
+            }
+        } else {
+            QVERIFY(advanceTo(wheel, startTime, expiry - 1).empty());
+        }
+        time = expiry;
+        auto expired = advanceTo(wheel, startTime, time);
+        QCOMPARE(expired.size(), (size_t)1);
+        QCOMPARE(expired[0], timers[i]);
+        QVERIFY(!wheel.isActive(timers[i]));
+    }
+    QCOMPARE(wheel.size(), 0);
+    QVERIFY(advanceTo(wheel, startTime, time + RUN_TIME).empty());
+}
+
+void TimerWheelTests::intervalTest() {
+    auto startTime = Clock::now();
+    TimerWheel wheel(startTime);
+
+    auto timer = wheel.start(10, false, QUuid(), startTime);
+    QCOMPARE(advanceTo(wheel, startTime, 9).size(), (size_t)0);
+    QCOMPARE(advanceTo(wheel, startTime, 10).size(), (size_t)1);
+    QVERIFY(wheel.isActive(timer));
+
+    // the timer keeps its phase
+    QCOMPARE(advanceTo(wheel, startTime, 15).size(), (size_t)0);
+    QCOMPARE(advanceTo(wheel, startTime, 20).size(), (size_t)1);
+
+    // but after falling behind fires once, and starts again from then
+    QCOMPARE(advanceTo(wheel, startTime, 1005).size(), (size_t)1);
+    QCOMPARE(advanceTo(wheel, startTime, 1014).size(), (size_t)0);
+    QCOMPARE(advanceTo(wheel, startTime, 1015).size(), (size_t)1);
+    QVERIFY(wheel.stop(timer));
+}
+
+void TimerWheelTests::stopTest() {
+    auto startTime = Clock::now();
+    TimerWheel wheel(startTime);
+
+    auto owner = QUuid::createUuid();
+    auto otherOwner = QUuid::createUuid();
+    auto stoppedTimer = wheel.start(10, true, QUuid(), startTime);
+    auto ownedTimer = wheel.start(10, false, owner, startTime);
+    auto ownedLongTimer = wheel.start(100000, true, owner, startTime);
+    auto otherTimer = wheel.start(10, true, otherOwner, startTime);
+    auto timer = wheel.start(10, true, QUuid(), startTime);
+
+    QVERIFY(wheel.stop(stoppedTimer));
+    QVERIFY(!wheel.stop(stoppedTimer));
+
+    std::vector<TimerWheel::TimerID> stopped;
+    wheel.stopAll(owner, stopped);
+    QCOMPARE(stopped.size(), (size_t)2);
+    QVERIFY(std::find(stopped.begin(), stopped.end(), ownedTimer) != stopped.end());
+    QVERIFY(std::find(stopped.begin(), stopped.end(), ownedLongTimer) != stopped.end());
+    QVERIFY(!wheel.isActive(ownedTimer));
+
+    auto expired = advanceTo(wheel, startTime, 10);
+    QCOMPARE(expired.size(), (size_t)2);
+    QCOMPARE(expired[0], otherTimer);
+    QCOMPARE(expired[1], timer);
+    QCOMPARE(wheel.size(), 0);
+
+    // the owner of a fired timer no longer has it
+    stopped.clear();
+    wheel.stopAll(otherOwner, stopped);
+    QVERIFY(stopped.empty());
+}
+
+void TimerWheelTests::startBetweenAdvancesTest() {
+    auto startTime = Clock::now();
+    TimerWheel wheel(startTime);
+
+    QVERIFY(advanceTo(wheel, startTime, 50).empty());
+
+    // started well after the wheel was last advanced, the timer still runs its whole interval
+    auto timer = wheel.start(100, true, QUuid(), startTime + std::chrono::milliseconds(250));
+    QVERIFY(advanceTo(wheel, startTime, 300).empty());
+    QVERIFY(advanceTo(wheel, startTime, 349).empty());
+    auto expired = advanceTo(wheel, startTime, 350);
+    QCOMPARE(expired.size(), (size_t)1);
+    QCOMPARE(expired[0], timer);
+
+    // a time before the last tick counts from the tick
+    timer = wheel.start(10, true, QUuid(), startTime);
+    QVERIFY(advanceTo(wheel, startTime, 359).empty());
+    QCOMPARE(advanceTo(wheel, startTime, 360).size(), (size_t)1);
+}
+
+void TimerWheelTests::qTimerStartStopBenchmark() {
+    auto intervals = createIntervals();
+    QBENCHMARK {
+        std::vector<std::unique_ptr<QTimer>> timers;
+        timers.reserve(NUM_TIMERS);
+        for (auto interval : intervals) {
+            timers.emplace_back(new QTimer());
+            timers.back()->start(interval);
+        }
+        for (auto& timer : timers) {
+            timer->stop();
+        }
+    }
+}
+
+void TimerWheelTests::timerWheelStartStopBenchmark() {
+    auto intervals = createIntervals();
+    auto owner = QUuid::createUuid();
+    QBENCHMARK {
+        TimerWheel wheel;
+        std::vector<TimerWheel::TimerID> timers;
+        timers.reserve(NUM_TIMERS);
+        for (auto interval : intervals) {
+            timers.push_back(wheel.start(interval, false, owner));
+        }
+        for (auto timer : timers) {
+            wheel.stop(timer);
+        }
+    }
+}
+
+// The processor time, in milliseconds
+static double cpuTime() {
+    return 1000.0 * (double)std::clock() / (double)CLOCKS_PER_SEC;
+}
+
+void TimerWheelTests::qTimerFireBenchmark() {
+    auto intervals = createIntervals();
+    int numFired = 0;
+    std::vector<std::unique_ptr<QTimer>> timers;
+    for (auto interval : intervals) {
+        timers.emplace_back(new QTimer());
+        timers.back()->setTimerType(Qt::PreciseTimer);
+        connect(timers.back().get(), &QTimer::timeout, [&numFired] { ++numFired; });
+        timers.back()->start(interval);
+    }
+
+    QEventLoop loop;
+    QTimer::singleShot(RUN_TIME, &loop, &QEventLoop::quit);
+    auto startTime = cpuTime();
+    loop.exec();
+    auto elapsed = cpuTime() - startTime;
+
+    QVERIFY(numFired >= NUM_TIMERS);
+    qDebug() << NUM_TIMERS << "QTimers fired" << numFired << "times, using" << elapsed << "ms of cpu in" << RUN_TIME << "ms";
+}
+
+void TimerWheelTests::timerWheelFireBenchmark() {
+    auto intervals = createIntervals();
+    auto wheelStartTime = Clock::now();
+    TimerWheel wheel(wheelStartTime);
+    for (auto interval : intervals) {
+        wheel.start(interval, false);
+    }
+
+    // as the script engine run loop does, advancing every millisecond or so
+    size_t numFired = 0;
+    std::vector<TimerWheel::TimerID> expired;
+    auto startTime = cpuTime();
+    for (int time = 1; time <= RUN_TIME; ++time) {
+        expired.clear();
+        wheel.advance(wheelStartTime + std::chrono::milliseconds(time), expired);
+        numFired += expired.size();
+    }
+    auto elapsed = cpuTime() - startTime;
+
+    QVERIFY(numFired >= (size_t)NUM_TIMERS);
+    qDebug() << NUM_TIMERS << "wheel timers fired" << numFired << "times, using" << elapsed << "ms of cpu in" << RUN_TIME << "ms";
+}
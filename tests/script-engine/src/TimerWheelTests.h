@@ -0,0 +1,42 @@
+//
+//  TimerWheelTests.h
+//  tests/script-engine/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TimerWheelTests_h
+#define hifi_TimerWheelTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class TimerWheelTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that single shot timers fire once at their expiry, from every level of the wheel
+    void singleShotTest();
+
+    // Test that interval timers fire on their interval, without catching up on the time they fell behind
+    void intervalTest();
+
+    // Test that stopped timers don't fire, alone or with all the timers of their owner
+    void stopTest();
+
+    // Test that timers started between advances of the wheel expire their interval after they were started
+    void startBetweenAdvancesTest();
+
+    // Compare the cost of starting and stopping 10k script timers as QTimers and on the wheel
+    void qTimerStartStopBenchmark();
+    void timerWheelStartStopBenchmark();
+
+    // Compare the cost of running 10k concurrent script timers for a second of QTimers and of the wheel
+    void qTimerFireBenchmark();
+    void timerWheelFireBenchmark();
+};
+
+#endif // hifi_TimerWheelTests_h
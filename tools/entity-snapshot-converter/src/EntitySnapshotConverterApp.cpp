@@ -0,0 +1,109 @@
+//
+//  EntitySnapshotConverterApp.cpp
+//  tools/entity-snapshot-converter/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySnapshotConverterApp.h"
+
+#include <QCommandLineParser>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QFile>
+
+#include <EntityTree.h>
+#include <NodeList.h>
+
+static QString persistFileTypeFor(const QString& fileName) {
+    static const QStringList FILE_TYPES = { "json.gz", "json", "bin" };
+    foreach (const QString& fileType, FILE_TYPES) {
+        if (fileName.endsWith("." + fileType, Qt::CaseInsensitive)) {
+            return fileType;
+        }
+    }
+    return QString();
+}
+
+EntitySnapshotConverterApp::EntitySnapshotConverterApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity Entity Snapshot Converter");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption inputFilenameOption("i", "input file", "models.json.gz");
+    parser.addOption(inputFilenameOption);
+
+    const QCommandLineOption outputFilenameOption("o", "output file, .json, .json.gz or .bin", "models.bin");
+    parser.addOption(outputFilenameOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    QString inputFilename = parser.value(inputFilenameOption);
+    QString outputFilename = parser.value(outputFilenameOption);
+    QString inputType = persistFileTypeFor(inputFilename);
+    QString outputType = persistFileTypeFor(outputFilename);
+    if (inputType.isEmpty() || outputType.isEmpty()) {
+        qCritical() << "Input and output files must end in .json, .json.gz or .bin";
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    DependencyManager::set<NodeList>(NodeType::Unassigned);
+
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // read the named file itself, readFromFile would pick the newest file with any of the persist extensions
+    bool success = false;
+    tree->withWriteLock([&] {
+        if (inputType == "bin") {
+            success = tree->readFromBinaryFile(inputFilename);
+        } else if (inputType == "json.gz") {
+            success = tree->readJSONFromGzippedFile(inputFilename);
+        } else {
+            QFile file(inputFilename);
+            if (file.open(QIODevice::ReadOnly)) {
+                QDataStream inputStream(&file);
+                success = tree->readFromStream(file.size(), inputStream);
+            }
+        }
+    });
+    if (!success) {
+        qCritical() << "Failed to read entities from" << inputFilename;
+        _returnCode = 2;
+        return;
+    }
+    qDebug() << "Read" << inputFilename << "in" << timer.restart() << "msecs";
+
+    tree->withReadLock([&] {
+        success = tree->writeToFile(qPrintable(outputFilename), NULL, outputType);
+    });
+    if (!success) {
+        qCritical() << "Failed to write entities to" << outputFilename;
+        _returnCode = 3;
+        return;
+    }
+    qDebug() << "Wrote" << outputFilename << "in" << timer.elapsed() << "msecs";
+}
+
+EntitySnapshotConverterApp::~EntitySnapshotConverterApp() {
+}
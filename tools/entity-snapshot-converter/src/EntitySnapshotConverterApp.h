@@ -0,0 +1,29 @@
+//
+//  EntitySnapshotConverterApp.h
+//  tools/entity-snapshot-converter/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySnapshotConverterApp_h
+#define hifi_EntitySnapshotConverterApp_h
+
+#include <QCoreApplication>
+
+// converts an entities file between the JSON (.json, .json.gz) and binary snapshot (.bin) formats
+class EntitySnapshotConverterApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    EntitySnapshotConverterApp(int argc, char* argv[]);
+    ~EntitySnapshotConverterApp();
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    int _returnCode { 0 };
+};
+
+#endif // hifi_EntitySnapshotConverterApp_h
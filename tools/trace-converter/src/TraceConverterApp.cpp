@@ -0,0 +1,90 @@
+//
+//  TraceConverterApp.cpp
+//  tools/trace-converter/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TraceConverterApp.h"
+
+#include <QCommandLineParser>
+#include <QFile>
+
+#include <Gzip.h>
+#include <Trace.h>
+
+TraceConverterApp::TraceConverterApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity Trace Converter");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption inputFilenameOption("i", "input file, .htrace or .htrace.gz", "trace.htrace");
+    parser.addOption(inputFilenameOption);
+
+    const QCommandLineOption outputFilenameOption("o", "output file, .json or .json.gz", "trace.json");
+    parser.addOption(outputFilenameOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    QString inputFilename = parser.value(inputFilenameOption);
+    QString outputFilename = parser.value(outputFilenameOption);
+    if (inputFilename.isEmpty() || outputFilename.isEmpty()) {
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    QFile inputFile(inputFilename);
+    if (!inputFile.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open" << inputFilename;
+        _returnCode = 2;
+        return;
+    }
+    QByteArray binaryTrace = inputFile.readAll();
+    if (inputFilename.endsWith(".gz")) {
+        QByteArray uncompressed;
+        if (!gunzip(binaryTrace, uncompressed)) {
+            qCritical() << "Failed to uncompress" << inputFilename;
+            _returnCode = 2;
+            return;
+        }
+        binaryTrace = uncompressed;
+    }
+
+    QByteArray json;
+    if (!tracing::convertBinaryTrace(binaryTrace, json)) {
+        qCritical() << "Failed to convert" << inputFilename;
+        _returnCode = 3;
+        return;
+    }
+    if (outputFilename.endsWith(".gz")) {
+        QByteArray compressed;
+        gzip(json, compressed);
+        json = compressed;
+    }
+
+    QFile outputFile(outputFilename);
+    if (!outputFile.open(QIODevice::WriteOnly) || outputFile.write(json) != json.size()) {
+        qCritical() << "Failed to write" << outputFilename;
+        _returnCode = 4;
+        return;
+    }
+}
+
+TraceConverterApp::~TraceConverterApp() {
+}
@@ -0,0 +1,132 @@
+//
+//  SendQueueBenchmark.cpp
+//  tools/udt-test/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendQueueBenchmark.h"
+
+#include <ctime>
+#include <memory>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+
+#include <udt/Packet.h>
+#include <udt/SendQueueScheduler.h>
+#include <udt/Socket.h>
+
+const QStringList BENCHMARK_TABLE_HEADERS {
+    "Connections", "   Mode   ", "Send Threads", "Done", "Wall (s)", "CPU (s)", "Services", "Wakes"
+};
+
+SendQueueBenchmark::SendQueueBenchmark(std::vector<int> connectionCounts, int packetsPerConnection, int schedulerThreads) :
+    _connectionCounts(connectionCounts),
+    _packetsPerConnection(packetsPerConnection),
+    _schedulerThreads(schedulerThreads)
+{
+}
+
+void SendQueueBenchmark::run() {
+    qDebug() << "Sending" << _packetsPerConnection << "reliable packets per connection over loopback";
+    qDebug() << qPrintable(BENCHMARK_TABLE_HEADERS.join(" | "));
+
+    for (auto numConnections : _connectionCounts) {
+        printResult(runOnce(numConnections, false));
+        printResult(runOnce(numConnections, true));
+    }
+}
+
+SendQueueBenchmark::Result SendQueueBenchmark::runOnce(int numConnections, bool useScheduler) {
+    static const int PACKET_PAYLOAD_SIZE = 512;
+    static const qint64 MAX_RUN_MSECS = 60 * 1000;
+
+    Result result;
+    result.numConnections = numConnections;
+    result.usedScheduler = useScheduler;
+    result.numSendThreads = useScheduler ? _schedulerThreads : numConnections;
+
+    auto& scheduler = udt::SendQueueScheduler::getInstance();
+    if (useScheduler) {
+        scheduler.start(_schedulerThreads);
+    }
+
+    int totalPackets = numConnections * _packetsPerConnection;
+    int receivedPackets = 0;
+
+    {
+        // setup one receiving socket per connection, all fed by a single sending socket
+        std::vector<std::unique_ptr<udt::Socket>> receivers;
+        for (int i = 0; i < numConnections; ++i) {
+            auto receiver = std::unique_ptr<udt::Socket>(new udt::Socket(nullptr, false));
+            receiver->bind(QHostAddress::LocalHost);
+            receiver->setPacketHandler([&receivedPackets](std::unique_ptr<udt::Packet> packet) {
+                ++receivedPackets;
+            });
+            receivers.push_back(std::move(receiver));
+        }
+
+        udt::Socket sender(nullptr, false);
+        sender.bind(QHostAddress::LocalHost);
+        sender.setUseSendQueueScheduler(useScheduler);
+
+        QElapsedTimer timer;
+        timer.start();
+        std::clock_t cpuStart = std::clock();
+
+        for (int p = 0; p < _packetsPerConnection; ++p) {
+            for (auto& receiver : receivers) {
+                auto packet = udt::Packet::create(PACKET_PAYLOAD_SIZE, true);
+                packet->setPayloadSize(PACKET_PAYLOAD_SIZE);
+                sender.writePacket(std::move(packet), HifiSockAddr(QHostAddress::LocalHost, receiver->localPort()));
+            }
+        }
+
+        while (receivedPackets < totalPackets && timer.elapsed() < MAX_RUN_MSECS) {
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        }
+
+        result.completed = receivedPackets >= totalPackets;
+        result.wallSeconds = timer.elapsed() / 1000.0;
+        result.cpuSeconds = double(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+        if (useScheduler) {
+            auto stats = scheduler.getStats();
+            result.numServices = stats.numServices;
+            result.numWakes = stats.numWakes;
+        }
+
+        // the sender and receivers go away here, which stops their connections and send queues
+    }
+
+    // clean up the send queues that were stopped
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+
+    if (useScheduler) {
+        scheduler.stop();
+    }
+
+    return result;
+}
+
+void SendQueueBenchmark::printResult(const Result& result) {
+    int headerIndex = -1;
+
+    QStringList values {
+        QString::number(result.numConnections).rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size()),
+        QString(result.usedScheduler ? "scheduled" : "threaded").rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(result.numSendThreads).rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size()),
+        QString(result.completed ? "yes" : "no").rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(result.wallSeconds, 'f', 3).rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(result.cpuSeconds, 'f', 3).rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(result.numServices).rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(result.numWakes).rightJustified(BENCHMARK_TABLE_HEADERS[++headerIndex].size())
+    };
+
+    qDebug() << qPrintable(values.join(" | "));
+}
@@ -0,0 +1,48 @@
+//
+//  SendQueueBenchmark.h
+//  tools/udt-test/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_SendQueueBenchmark_h
+#define hifi_SendQueueBenchmark_h
+
+#include <vector>
+
+#include <QtCore/QString>
+
+// Sends reliable packets over loopback to a number of receiving sockets, once with a thread per SendQueue
+// and once with the SendQueues serviced by the SendQueueScheduler, and compares the cost of both.
+class SendQueueBenchmark {
+public:
+    SendQueueBenchmark(std::vector<int> connectionCounts, int packetsPerConnection, int schedulerThreads);
+
+    void run();
+
+private:
+    struct Result {
+        int numConnections { 0 };
+        bool usedScheduler { false };
+        int numSendThreads { 0 };
+        bool completed { false };
+        double wallSeconds { 0.0 };
+        double cpuSeconds { 0.0 };
+        quint64 numServices { 0 };
+        quint64 numWakes { 0 };
+    };
+
+    Result runOnce(int numConnections, bool useScheduler);
+    void printResult(const Result& result);
+
+    std::vector<int> _connectionCounts;
+    int _packetsPerConnection;
+    int _schedulerThreads;
+};
+
+#endif // hifi_SendQueueBenchmark_h
@@ -16,9 +16,12 @@
 #include <udt/Constants.h>
 #include <udt/Packet.h>
 #include <udt/PacketList.h>
+#include <udt/SendQueueScheduler.h>
 
 #include <LogHandler.h>
 
+#include "SendQueueBenchmark.h"
+
 const QCommandLineOption PORT_OPTION { "p", "listening port for socket (defaults to random)", "port", 0 };
 const QCommandLineOption TARGET_OPTION {
     "target", "target for sent packets (default is listen only)",
@@ -55,6 +58,17 @@ const QCommandLineOption MESSAGE_SEED {
 const QCommandLineOption STATS_INTERVAL {
     "stats-interval", "stats output interval (default is 100ms)", "milliseconds"
 };
+const QCommandLineOption SEND_SCHEDULER_THREADS {
+    "send-scheduler-threads", "service send queues from a shared pool of threads (default is a thread per send queue)",
+    "threads"
+};
+const QCommandLineOption BENCHMARK_SEND_QUEUES {
+    "benchmark-send-queues", "compare threaded and scheduled send queues for each number of loopback connections, then quit",
+    "comma separated connection counts"
+};
+const QCommandLineOption BENCHMARK_PACKETS {
+    "benchmark-packets", "reliable packets sent per connection when benchmarking send queues (default is 100)", "packets"
+};
 
 const QStringList CLIENT_STATS_TABLE_HEADERS {
     "Send (Mb/s)", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)", "Period (us)",
@@ -74,6 +88,33 @@ UDTTest::UDTTest(int& argc, char** argv) :
     qInstallMessageHandler(LogHandler::verboseMessageHandler);
     
     parseArguments();
+
+    if (_argumentParser.isSet(BENCHMARK_SEND_QUEUES)) {
+        std::vector<int> connectionCounts;
+        for (auto& count : _argumentParser.value(BENCHMARK_SEND_QUEUES).split(',', QString::SkipEmptyParts)) {
+            connectionCounts.push_back(count.toInt());
+        }
+
+        static const int DEFAULT_BENCHMARK_PACKETS = 100;
+        int packetsPerConnection = _argumentParser.isSet(BENCHMARK_PACKETS)
+            ? _argumentParser.value(BENCHMARK_PACKETS).toInt() : DEFAULT_BENCHMARK_PACKETS;
+
+        static const int DEFAULT_SCHEDULER_THREADS = 2;
+        int schedulerThreads = _argumentParser.isSet(SEND_SCHEDULER_THREADS)
+            ? _argumentParser.value(SEND_SCHEDULER_THREADS).toInt() : DEFAULT_SCHEDULER_THREADS;
+
+        // run the benchmark once the event loop is up, since the sockets need it to process packets
+        QTimer::singleShot(0, this, [this, connectionCounts, packetsPerConnection, schedulerThreads] {
+            SendQueueBenchmark(connectionCounts, packetsPerConnection, schedulerThreads).run();
+            quit();
+        });
+        return;
+    }
+
+    if (_argumentParser.isSet(SEND_SCHEDULER_THREADS)) {
+        udt::SendQueueScheduler::getInstance().start(_argumentParser.value(SEND_SCHEDULER_THREADS).toInt());
+        _socket.setUseSendQueueScheduler(true);
+    }
     
     // randomize the seed for packet size randomization
     srand(time(NULL));
@@ -228,7 +269,8 @@ void UDTTest::parseArguments() {
     _argumentParser.addOptions({
         PORT_OPTION, TARGET_OPTION, PACKET_SIZE, MIN_PACKET_SIZE, MAX_PACKET_SIZE,
         MAX_SEND_BYTES, MAX_SEND_PACKETS, UNRELIABLE_PACKETS, ORDERED_PACKETS,
-        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL
+        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL, SEND_SCHEDULER_THREADS, BENCHMARK_SEND_QUEUES,
+        BENCHMARK_PACKETS
     });
     
     if (!_argumentParser.parse(arguments())) {